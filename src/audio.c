@@ -37,6 +37,13 @@ static const int cw_mid_water  = 1024;                // target buffer filling f
 static const int cw_low_water  =  896;                // low water mark for CW
 static const int cw_high_water = 1152;                // high water mark for CW
 
+//
+// RX audio is passed to the ALSA writer thread through a ring buffer
+// holding AUDIO_RING_SIZE stereo samples (must be a power of two, and
+// a multiple of out_buffer_size)
+//
+#define AUDIO_RING_SIZE 8192
+
 #include <gtk/gtk.h>
 #include <stdint.h>
 
@@ -58,6 +65,7 @@ static const int cw_high_water = 1152;                // high water mark for CW
 #include "mode.h"
 #include "vfo.h"
 #include "message.h"
+#include "metrics.h"
 
 int audio = 0;
 GMutex audio_mutex;
@@ -71,11 +79,19 @@ static GThread *mic_read_thread_id = NULL;
 
 static int running = FALSE;
 
+//
+// Silence used to pre-fill the ALSA buffer. All formats used have at
+// most four bytes per sample, and silence is all-zero in each of them.
+//
+static int32_t *out_silence = NULL;
+
+static gpointer audio_writer_thread(gpointer arg);
+
 //
 // TODO: include SND_PCM_FORMAT_IEC958_SUBFRAME_LE, such that ALSA
 //       can directly play on HDMI monitors. Implementation is not
 //       super-easy since this case must then also be considered in
-//       audio_write.
+//       audio_convert.
 //
 #define FORMATS 3
 static snd_pcm_format_t formats[3] = {
@@ -109,6 +125,9 @@ int audio_open_output(RECEIVER *rx) {
   t_print("%s: rx=%d %s buffer_size=%d\n", __FUNCTION__, rx->id, rx->audio_name, out_buffer_size);
   int i;
   char hw[128];
+  rx->audio_delay = metric_gauge("rx%d_alsa_delay_frames", rx->id);
+  rx->audio_underruns = metric_counter("rx%d_alsa_underruns", rx->id);
+  rx->audio_overruns = metric_counter("rx%d_alsa_overruns", rx->id);
   i = 0;
 
   while (i < 127 && rx->audio_name[i] != ' ') {
@@ -178,6 +197,23 @@ int audio_open_output(RECEIVER *rx) {
     break;
   }
 
+  if (out_silence == NULL) {
+    out_silence = g_new0(int32_t, 2 * out_buflen);
+  }
+
+  //
+  // Ring buffer and writer thread for RX audio. The semaphore is
+  // initialized before the ring buffer is published, since
+  // audio_write_block() posts it as soon as it sees the ring buffer.
+  //
+  rx->local_audio_ring_inpt = 0;
+  rx->local_audio_ring_outpt = 0;
+  sem_init(&rx->local_audio_sem, 0, 0);
+  rx->local_audio_running = TRUE;
+  g_mutex_lock(&rx->local_audio_ring_mutex);
+  rx->local_audio_ring = g_new(float, 2 * AUDIO_RING_SIZE);
+  g_mutex_unlock(&rx->local_audio_ring_mutex);
+  rx->local_audio_thread = g_thread_new("audio writer", audio_writer_thread, rx);
   t_print("%s: rx=%d audio_device=%d handle=%p buffer=%p size=%d\n", __FUNCTION__, rx->id, rx->audio_device,
           rx->playback_handle, rx->local_audio_buffer, out_buffer_size);
   g_mutex_unlock(&rx->local_audio_mutex);
@@ -300,6 +336,26 @@ int audio_open_input() {
 
 void audio_close_output(RECEIVER *rx) {
   t_print("%s: rx=%d handle=%p buffer=%p\n", __FUNCTION__, rx->id, rx->playback_handle, rx->local_audio_buffer);
+
+  //
+  // Detach the ring buffer first, so audio_write_block() no longer
+  // posts the semaphore, then stop the writer thread before the
+  // semaphore is destroyed and the handle is closed.
+  //
+  g_mutex_lock(&rx->local_audio_ring_mutex);
+  float *ring = rx->local_audio_ring;
+  rx->local_audio_ring = NULL;
+  rx->local_audio_running = FALSE;
+  g_mutex_unlock(&rx->local_audio_ring_mutex);
+
+  if (rx->local_audio_thread != NULL) {
+    sem_post(&rx->local_audio_sem);
+    g_thread_join(rx->local_audio_thread);
+    rx->local_audio_thread = NULL;
+    sem_destroy(&rx->local_audio_sem);
+  }
+
+  g_free(ring);
   g_mutex_lock(&rx->local_audio_mutex);
 
   if (rx->playback_handle != NULL) {
@@ -415,6 +471,8 @@ int cw_audio_write(RECEIVER *rx, float sample) {
       // If buffer gets too empty ==> insert zero sample
       //
       if (snd_pcm_delay(rx->playback_handle, &delay) == 0) {
+        metric_set(rx->audio_delay, delay);
+
         if (delay > cw_high_water && rx->local_audio_buffer_offset > 0) {
           // delete the last sample
           rx->local_audio_buffer_offset--;
@@ -461,8 +519,10 @@ int cw_audio_write(RECEIVER *rx, float sample) {
         if (rc < 0) {
           switch (rc) {
           case -EPIPE:
+            metric_add(rx->audio_underruns, 1);
+
             if ((rc = snd_pcm_prepare (rx->playback_handle)) < 0) {
-              t_print("%s: cannot prepare audio interface for use %ld (%s)\n", __FUNCTION__, rc, snd_strerror (rc));
+              t_log(T_WARNING, "%s: cannot prepare audio interface for use %ld (%s)\n", __FUNCTION__, rc, snd_strerror (rc));
               rx->local_audio_buffer_offset = 0;
               g_mutex_unlock(&rx->local_audio_mutex);
               return rc;
@@ -471,11 +531,11 @@ int cw_audio_write(RECEIVER *rx, float sample) {
             break;
 
           default:
-            t_print("%s:  write error: %s\n", __FUNCTION__, snd_strerror(rc));
+            t_log(T_WARNING, "%s:  write error: %s\n", __FUNCTION__, snd_strerror(rc));
             break;
           }
         } else {
-          t_print("%s: short write lost=%d\n", __FUNCTION__, out_buffer_size - (int) rc);
+          t_log(T_WARNING, "%s: short write lost=%d\n", __FUNCTION__, out_buffer_size - (int) rc);
         }
       }
 
@@ -488,137 +548,198 @@ int cw_audio_write(RECEIVER *rx, float sample) {
 }
 
 //
-// if rx == active_receiver and while transmitting, DO NOTHING
-// since cw_audio_write may be active
+// Convert n float values to the output format
 //
+static void audio_convert(snd_pcm_format_t format, void *dst, const float *src, int n) {
+  switch (format) {
+  case SND_PCM_FORMAT_S16_LE: {
+    int16_t *short_buffer = (int16_t *)dst;
 
-int audio_write(RECEIVER *rx, float left_sample, float right_sample) {
-  snd_pcm_sframes_t delay;
-  int txmode = get_tx_mode();
-
-  //
-  // We have to stop the stream here if a CW side tone may occur.
-  // This might cause underflows, but we cannot use audio_write
-  // and cw_audio_write simultaneously on the same device.
-  // Instead, the side tone version will take over.
-  // If *not* doing CW, the stream continues because we might wish
-  // to listen to this rx while transmitting.
-  //
-
-  if (rx == active_receiver && isTransmitting() && (txmode == modeCWU || txmode == modeCWL)
-      && cw_keyer_sidetone_volume > 0) {
-    return 0;
+    for (int i = 0; i < n; i++) {
+      short_buffer[i] = (int16_t)(src[i] * 32767.0F);
+    }
   }
+  break;
 
-  // lock AFTER checking the "quick return" condition but BEFORE checking the pointers
-  g_mutex_lock(&rx->local_audio_mutex);
+  case SND_PCM_FORMAT_S32_LE: {
+    int32_t *long_buffer = (int32_t *)dst;
 
-  if (rx->playback_handle != NULL && rx->local_audio_buffer != NULL) {
-    switch (rx->local_audio_format) {
-    case SND_PCM_FORMAT_S16_LE: {
-      int16_t *short_buffer = (int16_t *)rx->local_audio_buffer;
-      short_buffer[rx->local_audio_buffer_offset * 2] = (int16_t)(left_sample * 32767.0F);
-      short_buffer[(rx->local_audio_buffer_offset * 2) + 1] = (int16_t)(right_sample * 32767.0F);
+    for (int i = 0; i < n; i++) {
+      long_buffer[i] = (int32_t)(src[i] * 4294967295.0F);
     }
+  }
+  break;
+
+  case SND_PCM_FORMAT_FLOAT_LE:
+    memcpy(dst, src, n * sizeof(float));
     break;
 
-    case SND_PCM_FORMAT_S32_LE: {
-      int32_t *long_buffer = (int32_t *)rx->local_audio_buffer;
-      long_buffer[rx->local_audio_buffer_offset * 2] = (int32_t)(left_sample * 4294967295.0F);
-      long_buffer[(rx->local_audio_buffer_offset * 2) + 1] = (int32_t)(right_sample * 4294967295.0F);
-    }
+  default:
+    t_print("%s: CATASTROPHIC ERROR: unknown sound format\n", __FUNCTION__);
     break;
+  }
+}
 
-    case SND_PCM_FORMAT_FLOAT_LE: {
-      float *float_buffer = (float *)rx->local_audio_buffer;
-      float_buffer[rx->local_audio_buffer_offset * 2] = left_sample;
-      float_buffer[(rx->local_audio_buffer_offset * 2) + 1] = right_sample;
+//
+// Write one buffer (out_buffer_size stereo samples) to the ALSA device.
+// This is only called from the writer thread, with the local audio mutex
+// held since cw_audio_write() may use the device as well. The DSP thread
+// does not take that mutex (see audio_write_block), so it never waits
+// for these ALSA calls.
+//
+static long audio_play_buffer(RECEIVER *rx, const void *buffer) {
+  snd_pcm_sframes_t delay;
+  long rc;
+
+  if (snd_pcm_delay(rx->playback_handle, &delay) == 0) {
+    metric_set(rx->audio_delay, delay);
+
+    if (delay < out_cw_border) {
+      //
+      // upon first occurence, or after a TX/RX transition, the buffer
+      // is empty (delay == 0), if we just come from CW TXing, delay is below
+      // out_cw_border as well.
+      // ACTION: fill buffer completely with silence to start output, then
+      //         rewind until half-filling. Just filling by half does nothing,
+      //         ALSA just does not start playing until the buffer is nearly full.
+      //
+      snd_pcm_writei (rx->playback_handle, out_silence, out_buflen - delay);
+      snd_pcm_rewind (rx->playback_handle, out_buflen / 2);
     }
-    break;
+  }
 
-    default:
-      t_print("%s: CATASTROPHIC ERROR: unknown sound format\n", __FUNCTION__);
-      break;
+  if ((rc = snd_pcm_writei (rx->playback_handle, buffer, out_buffer_size)) != out_buffer_size) {
+    if (rc < 0) {
+      switch (rc) {
+      case -EAGAIN:
+        // device buffer full, the caller drops this buffer
+        break;
+
+      case -EPIPE:
+        metric_add(rx->audio_underruns, 1);
+
+        if ((rc = snd_pcm_prepare (rx->playback_handle)) < 0) {
+          t_log(T_WARNING, "%s: cannot prepare audio interface for use %ld (%s)\n", __FUNCTION__, rc, snd_strerror (rc));
+        }
+
+        break;
+
+      default:
+        t_log(T_WARNING, "%s:  write error: %s\n", __FUNCTION__, snd_strerror(rc));
+        break;
+      }
+    } else {
+      t_log(T_WARNING, "%s: short write lost=%d\n", __FUNCTION__, out_buffer_size - (int) rc);
     }
+  }
 
-    rx->local_audio_buffer_offset++;
+  return rc;
+}
 
-    if (rx->local_audio_buffer_offset >= out_buffer_size) {
-      if (snd_pcm_delay(rx->playback_handle, &delay) == 0) {
-        if (delay < out_cw_border) {
-          //
-          // upon first occurence, or after a TX/RX transition, the buffer
-          // is empty (delay == 0), if we just come from CW TXing, delay is below
-          // out_cw_border as well.
-          // ACTION: fill buffer completely with silence to start output, then
-          //         rewind until half-filling. Just filling by half does nothing,
-          //         ALSA just does not start playing until the buffer is nearly full.
-          //
-          void *silence = NULL;
-          size_t len;
-          int num = (out_buflen - delay);
+//
+// The writer thread takes the samples from the ring buffer in
+// chunks of out_buffer_size, converts them and writes them to
+// the device. It is woken up by audio_write_block().
+//
+// If the radio clock runs faster than the sound card, the device
+// buffer (out_buflen) eventually fills up. The chunk is then dropped
+// instead of waiting for the device, since waiting would only move
+// the excess into the ring buffer and add up to AUDIO_RING_SIZE
+// samples of latency for good.
+//
+// The ring buffer is only freed after this thread has been joined,
+// so it is used through a private copy of the pointer.
+//
+static gpointer audio_writer_thread(gpointer arg) {
+  RECEIVER *rx = (RECEIVER *)arg;
+  const float *ring = rx->local_audio_ring;
+  int32_t *buffer = g_new(int32_t, 2 * out_buffer_size);  // large enough for all formats
+  t_print("%s: rx=%d started\n", __FUNCTION__, rx->id);
 
-          switch (rx->local_audio_format) {
-          case SND_PCM_FORMAT_S16_LE:
-            silence = g_new(int16_t, 2 * num);
-            len = 2 * num * sizeof(int16_t);
-            break;
+  while (rx->local_audio_running) {
+    sem_wait(&rx->local_audio_sem);
 
-          case SND_PCM_FORMAT_S32_LE:
-            silence = g_new(int32_t, 2 * num);
-            len = 2 * num * sizeof(int32_t);
-            break;
+    for (;;) {
+      int outpt = rx->local_audio_ring_outpt;
+      int avail = __atomic_load_n(&rx->local_audio_ring_inpt, __ATOMIC_ACQUIRE) - outpt;
 
-          case SND_PCM_FORMAT_FLOAT_LE:
-            silence = g_new(float, 2 * num);
-            len = 2 * num * sizeof(float);
-            break;
+      if (avail < 0) { avail += AUDIO_RING_SIZE; }
 
-          default:
-            t_print("%s: CATASTROPHIC ERROR: unknown sound format\n", __FUNCTION__);
-            silence = NULL;
-            len = 0;
-            break;
-          }
+      if (avail < out_buffer_size || !rx->local_audio_running) { break; }
 
-          if (silence) {
-            memset(silence, 0, len);
-            snd_pcm_writei (rx->playback_handle, silence, num);
-            snd_pcm_rewind (rx->playback_handle, out_buflen / 2);
-            g_free(silence);
-          }
-        }
+      audio_convert(rx->local_audio_format, buffer, &ring[2 * outpt], 2 * out_buffer_size);
+      __atomic_store_n(&rx->local_audio_ring_outpt, (outpt + out_buffer_size) & (AUDIO_RING_SIZE - 1), __ATOMIC_RELEASE);
+      g_mutex_lock(&rx->local_audio_mutex);
+
+      if (audio_play_buffer(rx, buffer) == -EAGAIN) {
+        metric_add(rx->audio_overruns, 1);
       }
 
-      long rc;
+      g_mutex_unlock(&rx->local_audio_mutex);
+    }
+  }
 
-      if ((rc = snd_pcm_writei (rx->playback_handle, rx->local_audio_buffer, out_buffer_size)) != out_buffer_size) {
-        if (rc < 0) {
-          switch (rc) {
-          case -EPIPE:
-            if ((rc = snd_pcm_prepare (rx->playback_handle)) < 0) {
-              t_print("%s: cannot prepare audio interface for use %ld (%s)\n", __FUNCTION__, rc, snd_strerror (rc));
-              rx->local_audio_buffer_offset = 0;
-              g_mutex_unlock(&rx->local_audio_mutex);
-              return rc;
-            }
+  g_free(buffer);
+  t_print("%s: rx=%d terminated\n", __FUNCTION__, rx->id);
+  return NULL;
+}
 
-            break;
+//
+// if rx == active_receiver and while transmitting, DO NOTHING
+// since cw_audio_write may be active
+//
+// Otherwise, put n stereo samples (lr[0...2n-1], left and right interleaved)
+// into the ring buffer for the writer thread. If the ring buffer is full,
+// the excess samples are dropped. This never calls ALSA, so the caller
+// (the DSP thread) cannot block on the audio device.
+//
 
-          default:
-            t_print("%s:  write error: %s\n", __FUNCTION__, snd_strerror(rc));
-            break;
-          }
-        } else {
-          t_print("%s: short write lost=%d\n", __FUNCTION__, out_buffer_size - (int) rc);
-        }
-      }
+int audio_write_block(RECEIVER *rx, const float *lr, int n) {
+  int txmode = get_tx_mode();
 
-      rx->local_audio_buffer_offset = 0;
+  //
+  // We have to stop the stream here if a CW side tone may occur.
+  // This might cause underflows, but we cannot use audio_write_block
+  // and cw_audio_write simultaneously on the same device.
+  // Instead, the side tone version will take over.
+  // If *not* doing CW, the stream continues because we might wish
+  // to listen to this rx while transmitting.
+  //
+
+  if (rx == active_receiver && isTransmitting() && (txmode == modeCWU || txmode == modeCWL)
+      && cw_keyer_sidetone_volume > 0) {
+    return 0;
+  }
+
+  //
+  // The ring mutex only makes sure the ring buffer is not destroyed while
+  // we are using it. It is never held across ALSA calls, unlike
+  // local_audio_mutex which the writer thread holds while playing a buffer.
+  //
+  g_mutex_lock(&rx->local_audio_ring_mutex);
+
+  if (rx->local_audio_ring != NULL) {
+    int inpt = rx->local_audio_ring_inpt;
+    int space = __atomic_load_n(&rx->local_audio_ring_outpt, __ATOMIC_ACQUIRE) - inpt - 1;
+
+    if (space < 0) { space += AUDIO_RING_SIZE; }
+
+    if (n > space) {
+      t_log(T_WARNING, "%s: ring buffer full, lost=%d\n", __FUNCTION__, n - space);
+      n = space;
     }
+
+    int first = AUDIO_RING_SIZE - inpt;
+
+    if (first > n) { first = n; }
+
+    memcpy(&rx->local_audio_ring[2 * inpt], lr, 2 * first * sizeof(float));
+    memcpy(rx->local_audio_ring, &lr[2 * first], 2 * (n - first) * sizeof(float));
+    __atomic_store_n(&rx->local_audio_ring_inpt, (inpt + n) & (AUDIO_RING_SIZE - 1), __ATOMIC_RELEASE);
+    sem_post(&rx->local_audio_sem);
   }
 
-  g_mutex_unlock(&rx->local_audio_mutex);
+  g_mutex_unlock(&rx->local_audio_ring_mutex);
   return 0;
 }
 
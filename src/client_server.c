@@ -33,6 +33,14 @@
   #include <endian.h>
 #endif
 #include <semaphore.h>
+#include <errno.h>
+#include <poll.h>
+#ifdef ZSTD
+  #include <zstd.h>
+#endif
+#ifdef OPUS
+  #include <opus.h>
+#endif
 
 #include "discovered.h"
 #include "adc.h"
@@ -81,7 +89,35 @@ static int listen_socket;
 static int audio_buffer_index = 0;
 AUDIO_DATA audio_data;
 
+#ifdef OPUS
+//
+// Opus encoding (server side). The RX DSP thread only collects 20 msec of
+// audio per receiver and hands it over to the encoder thread, which encodes
+// it once and queues the result for all clients that asked for Opus.
+//
+// The sequence number is assigned when a frame is complete, so a frame
+// dropped because the encoder queue is full leaves a gap which the client
+// fills by packet loss concealment.
+//
+typedef struct _opus_pcm {
+  int rx;
+  uint16_t sequence;
+  opus_int16 sample[2 * OPUS_FRAME_SIZE];
+} OPUS_PCM;
+
+#define OPUS_QUEUE_MAX 25
+
+static GAsyncQueue *opus_queue = NULL;
+static GThread *opus_thread_id;
+static int opus_clients = 0;
+static OPUS_PCM *opus_pcm[8];
+static int opus_pcm_index[8];
+static uint16_t opus_pcm_sequence[8];
+#endif
+
 static int remote_command(void * data);
+static int client_queue_socket(int s, const char *data, int len);
+static void client_sender_free(REMOTE_CLIENT *client);
 
 GMutex accumulated_mutex;
 static int accumulated_steps = 0;
@@ -106,6 +142,7 @@ void delete_client(REMOTE_CLIENT *client) {
 
   if (clients == client) {
     clients = client->next;
+    client_sender_free(client);
     g_free(client);
   } else {
     REMOTE_CLIENT* c = clients;
@@ -118,6 +155,7 @@ void delete_client(REMOTE_CLIENT *client) {
 
     if (c != NULL) {
       last_c->next = c->next;
+      client_sender_free(c);
       g_free(c);
     }
   }
@@ -132,9 +170,10 @@ static int recv_bytes(int s, char *buffer, int bytes) {
   while (bytes_read != bytes) {
     int rc = recv(s, &buffer[bytes_read], bytes - bytes_read, 0);
 
-    if (rc < 0) {
+    if (rc <= 0) {
       // return -1, so we need not check downstream
-      // on incomplete messages received
+      // on incomplete messages received (rc == 0 means
+      // the peer has closed or shut down the connection)
       t_print("%s: read %d bytes, but expected %d.\n", __FUNCTION__, bytes_read, bytes);
       bytes_read = -1;
       t_perror("recv_bytes");
@@ -152,6 +191,15 @@ static int send_bytes(int s, char *buffer, int bytes) {
 
   if (s < 0) { return -1; }
 
+  //
+  // On the server, everything that goes to a client is put into
+  // that client's send queue, such that it cannot interleave with
+  // audio and spectrum data sent by the client's sender thread.
+  //
+  if (hpsdr_server && client_queue_socket(s, buffer, bytes) == 0) {
+    return bytes;
+  }
+
   while (bytes_sent != bytes) {
     int rc = send(s, &buffer[bytes_sent], bytes - bytes_sent, 0);
 
@@ -170,30 +218,696 @@ static int send_bytes(int s, char *buffer, int bytes) {
   return bytes_sent;
 }
 
+//
+// Per-client send queues.
+//
+// Nothing sent from the server to a client is written to the socket by the
+// thread that produces it (the RX DSP thread for audio, the GTK thread for
+// spectrum and control data). Instead, a copy is put into the client's send
+// queue, and a sender thread per client writes the queue to the socket,
+// using non-blocking send() calls and poll() in-between. Thus a slow client
+// on a congested link only fills up its own queue.
+//
+// The queue size is limited to CLIENT_QUEUE_MAX_BYTES. If a new message does
+// not fit, queued spectrum frames are dropped first (oldest first), then
+// (only for a new audio buffer) queued audio buffers. If it still does not
+// fit, the new message itself is dropped. Control messages are small and
+// must not get lost, so they are always queued. Furthermore, a new spectrum
+// frame supersedes a queued one of the same receiver that has not yet been
+// sent.
+//
+// The head of the queue may be in the process of being sent (without the
+// lock held), therefore it is never dropped.
+//
+typedef struct _client_msg {
+  int type;                              // CLIENT_MSG_AUDIO etc.
+  int rx;
+  int len;
+  int sent;                              // bytes already written to the socket
+  int packed;                            // spectrum frame already converted
+  char data[];
+} CLIENT_MSG;
+
+static const char *client_msg_name[3] = {"audio", "spectrum", "control"};
+
+//
+// Drop queued messages of the given type (and receiver, if rx >= 0),
+// oldest first, until the queue size is at most limit bytes.
+// Must be called with send_mutex held.
+//
+static void client_drop(REMOTE_CLIENT *client, int type, int rx, int limit) {
+  GList *link = client->send_queue->head;
+
+  if (link != NULL) { link = link->next; }
+
+  while (link != NULL && client->send_queue_bytes > limit) {
+    GList *next = link->next;
+    CLIENT_MSG *m = (CLIENT_MSG *)link->data;
+
+    if (m->type == type && (rx < 0 || m->rx == rx)) {
+      client->send_queue_bytes -= m->len;
+      client->msgs_dropped[type]++;
+      metric_add(client->m_msgs_dropped[type], 1);
+      g_queue_delete_link(client->send_queue, link);
+      g_free(m);
+    }
+
+    link = next;
+  }
+}
+
+//
+// Put a copy of a message into the send queue of a client.
+// Returns -1 if the client's sender thread is not (any longer) running.
+//
+static int client_queue_msg(REMOTE_CLIENT *client, int type, int rx, const void *data, int len) {
+  g_mutex_lock(&client->send_mutex);
+
+  if (!client->sender_running) {
+    g_mutex_unlock(&client->send_mutex);
+    return -1;
+  }
+
+  if (type == CLIENT_MSG_SPECTRUM) {
+    client_drop(client, CLIENT_MSG_SPECTRUM, rx, 0);
+  }
+
+  if (type != CLIENT_MSG_CONTROL && client->send_queue_bytes + len > CLIENT_QUEUE_MAX_BYTES) {
+    client_drop(client, CLIENT_MSG_SPECTRUM, -1, CLIENT_QUEUE_MAX_BYTES - len);
+
+    if (type == CLIENT_MSG_AUDIO) {
+      client_drop(client, CLIENT_MSG_AUDIO, -1, CLIENT_QUEUE_MAX_BYTES - len);
+    }
+
+    if (client->send_queue_bytes + len > CLIENT_QUEUE_MAX_BYTES) {
+      client->msgs_dropped[type]++;
+      metric_add(client->m_msgs_dropped[type], 1);
+      g_mutex_unlock(&client->send_mutex);
+      return 0;
+    }
+  }
+
+  CLIENT_MSG *m = g_malloc(sizeof(CLIENT_MSG) + len);
+  m->type = type;
+  m->rx = rx;
+  m->len = len;
+  m->sent = 0;
+  m->packed = 0;
+  memcpy(m->data, data, len);
+  g_queue_push_tail(client->send_queue, m);
+  client->send_queue_bytes += len;
+
+  if (client->send_queue_bytes > client->send_queue_max) {
+    client->send_queue_max = client->send_queue_bytes;
+  }
+
+  metric_set(client->m_send_queue, client->send_queue_bytes);
+
+  g_cond_signal(&client->send_cond);
+  g_mutex_unlock(&client->send_mutex);
+  return 0;
+}
+
+//
+// Queue a control message for the client connected to socket s.
+// Returns -1 if there is no such client.
+//
+static int client_queue_socket(int s, const char *data, int len) {
+  int rc = -1;
+  g_mutex_lock(&client_mutex);
+
+  for (REMOTE_CLIENT *c = clients; c != NULL; c = c->next) {
+    if (c->socket == s) {
+      rc = client_queue_msg(c, CLIENT_MSG_CONTROL, -1, data, len);
+      break;
+    }
+  }
+
+  g_mutex_unlock(&client_mutex);
+  return rc;
+}
+
+//
+// Rice coding of packed spectrum frames (SPECTRUM_PACKED_RICE).
+//
+// Each quantized sample is predicted from its left neighbour (a) and from
+// the same (b) and the left (c) sample of the previous frame, using the
+// median edge detector of LOCO-I: min(a,b) if c >= max(a,b), max(a,b) if
+// c <= min(a,b), else a + b - c. In a key frame the prediction is the left
+// neighbour. The prediction error d is mapped to u = 2d (d >= 0) or
+// -2d - 1 (d < 0) and sent as u >> k in unary (ones, terminated by a zero)
+// followed by the k low bits of u. k follows the mean of the recent values
+// of u, and since the decoder does the same, it is not sent. If u >> k
+// reaches SPECTRUM_RICE_ESCAPE, that many ones are followed by u in 9 bits.
+// Bits are filled into the bytes LSB first.
+//
+// Unlike a fixed-size code, a single large change (a signal coming up) only
+// costs a few extra bits for that sample, not for the whole frame.
+//
+#define SPECTRUM_RICE_ESCAPE 12
+
+static int spectrum_predict(const uint8_t *prev, const uint8_t *q, int i, int key) {
+  if (i == 0) { return key ? 0 : prev[0]; }
+
+  int a = q[i - 1];
+
+  if (key) { return a; }
+
+  int b = prev[i];
+  int c = prev[i - 1];
+  int max = a > b ? a : b;
+  int min = a < b ? a : b;
+
+  if (c >= max) { return min; }
+
+  if (c <= min) { return max; }
+
+  return a + b - c;
+}
+
+static int spectrum_rice_k(int sum, int count) {
+  int k = 0;
+
+  while (k < 8 && (count << k) < sum) { k++; }
+
+  return k;
+}
+
+static void spectrum_rice_update(int *sum, int *count, int u) {
+  *sum += u;
+
+  if (++*count >= 16) {
+    *sum >>= 1;
+    *count >>= 1;
+  }
+}
+
+//
+// Rice-code the quantized samples q (prev: those of the previous frame).
+// Returns the number of bytes, or -1 if that would be more than max.
+//
+static int spectrum_rice_encode(const uint8_t *prev, const uint8_t *q, int width, int key, uint8_t *out, int max) {
+  int pos = 0;
+  int sum = 4;
+  int count = 1;
+  memset(out, 0, max);
+
+  for (int i = 0; i < width; i++) {
+    int d = q[i] - spectrum_predict(prev, q, i, key);
+    unsigned int u = d >= 0 ? 2 * d : -2 * d - 1;
+    int k = spectrum_rice_k(sum, count);
+    unsigned int code;
+    int bits;
+
+    if ((u >> k) < SPECTRUM_RICE_ESCAPE) {
+      // u >> k ones, a zero, then k bits of u
+      bits = (u >> k) + 1 + k;
+      code = ((1U << (u >> k)) - 1) | ((u & ((1U << k) - 1)) << ((u >> k) + 1));
+    } else {
+      bits = SPECTRUM_RICE_ESCAPE + 9;
+      code = ((1U << SPECTRUM_RICE_ESCAPE) - 1) | (u << SPECTRUM_RICE_ESCAPE);
+    }
+
+    if (pos + bits > 8 * max) { return -1; }
+
+    for (int j = 0; j < bits; j++, pos++) {
+      if (code & (1U << j)) { out[pos >> 3] |= 1 << (pos & 7); }
+    }
+
+    spectrum_rice_update(&sum, &count, u);
+  }
+
+  return (pos + 7) >> 3;
+}
+
+//
+// Read n bits, LSB first. Returns -1 if the data is exhausted.
+//
+static int spectrum_get_bits(const uint8_t *in, int len, int *pos, int n) {
+  int v = 0;
+
+  if (*pos + n > 8 * len) { return -1; }
+
+  for (int j = 0; j < n; j++, (*pos)++) {
+    v |= ((in[*pos >> 3] >> (*pos & 7)) & 1) << j;
+  }
+
+  return v;
+}
+
+//
+// Inverse of spectrum_rice_encode(). Returns -1 if the data is corrupt.
+//
+static int spectrum_rice_decode(const uint8_t *prev, uint8_t *q, int width, int key, const uint8_t *in, int len) {
+  int pos = 0;
+  int sum = 4;
+  int count = 1;
+
+  for (int i = 0; i < width; i++) {
+    int k = spectrum_rice_k(sum, count);
+    int ones = 0;
+    int u;
+
+    while (ones < SPECTRUM_RICE_ESCAPE) {
+      int b = spectrum_get_bits(in, len, &pos, 1);
+
+      if (b < 0) { return -1; }
+
+      if (b == 0) { break; }
+
+      ones++;
+    }
+
+    if (ones == SPECTRUM_RICE_ESCAPE) {
+      u = spectrum_get_bits(in, len, &pos, 9);
+    } else {
+      u = spectrum_get_bits(in, len, &pos, k);
+
+      if (u >= 0) { u |= ones << k; }
+    }
+
+    if (u < 0) { return -1; }
+
+    int v = spectrum_predict(prev, q, i, key) + ((u & 1) ? -(u + 1) / 2 : u / 2);
+
+    if (v < 0 || v > 255) { return -1; }
+
+    q[i] = v;
+    spectrum_rice_update(&sum, &count, u);
+  }
+
+  return 0;
+}
+
+//
+// Convert a SPECTRUM_DATA frame into a SPECTRUM_PACKED frame. This is done
+// by the sender thread just before the frame goes out, so the encoder state
+// (the previous frame) always matches what the client has received, even
+// if queued spectrum frames have been dropped.
+//
+static CLIENT_MSG *client_pack_spectrum(REMOTE_CLIENT *client, const CLIENT_MSG *m) {
+  const SPECTRUM_DATA *sd = (const SPECTRUM_DATA *)m->data;
+  REMOTE_RX *rrx = &client->receiver[sd->rx];
+  SPECTRUM_PACKED sp;
+  short sample[SPECTRUM_DATA_SIZE];
+  uint8_t q[SPECTRUM_DATA_SIZE];
+  uint64_t vfos[6];
+  int width = ntohs(sd->samples);
+  int min = 32767;
+  int max = -32768;
+  int flags = 0;
+  int n = 0;
+
+  if (width > SPECTRUM_DATA_SIZE) { width = SPECTRUM_DATA_SIZE; }
+
+  for (int i = 0; i < width; i++) {
+    sample[i] = (short)ntohs(sd->sample[i]);
+
+    if (sample[i] < min) { min = sample[i]; }
+
+    if (sample[i] > max) { max = sample[i]; }
+  }
+
+  //
+  // A key frame is sent if the width has changed, if the samples do not fit
+  // into the range of the current offset, and periodically such that a client
+  // that (re-)starts the spectrum gets in sync again. The offset is put a few
+  // dB below the minimum, otherwise the next dip of the noise floor would
+  // already force another key frame.
+  //
+  if (width != rrx->spectrum_width || rrx->spectrum_frames >= SPECTRUM_KEY_INTERVAL
+      || min < rrx->spectrum_offset || max > rrx->spectrum_offset + 255) {
+    flags |= SPECTRUM_PACKED_KEY;
+    rrx->spectrum_width = width;
+    rrx->spectrum_offset = min - SPECTRUM_KEY_MARGIN;
+    rrx->spectrum_frames = 0;
+  }
+
+  rrx->spectrum_frames++;
+  vfos[0] = sd->vfo_a_freq;
+  vfos[1] = sd->vfo_b_freq;
+  vfos[2] = sd->vfo_a_ctun_freq;
+  vfos[3] = sd->vfo_b_ctun_freq;
+  vfos[4] = sd->vfo_a_offset;
+  vfos[5] = sd->vfo_b_offset;
+
+  if ((flags & SPECTRUM_PACKED_KEY) || memcmp(vfos, rrx->spectrum_vfo, sizeof(vfos)) != 0) {
+    flags |= SPECTRUM_PACKED_VFO;
+    memcpy(rrx->spectrum_vfo, vfos, sizeof(vfos));
+    memcpy(sp.payload, vfos, sizeof(vfos));
+    n = sizeof(vfos);
+  }
+
+  //
+  // Quantize. Only a key frame can have samples above the range of the
+  // offset, the others would have forced a key frame.
+  //
+  for (int i = 0; i < width; i++) {
+    int v = sample[i] - rrx->spectrum_offset;
+    q[i] = v > 255 ? 255 : v;
+  }
+
+  int rice = spectrum_rice_encode(rrx->spectrum_q, q, width, flags & SPECTRUM_PACKED_KEY, sp.payload + n, width);
+
+  if (rice >= 0) {
+    flags |= SPECTRUM_PACKED_RICE;
+    n += rice;
+  } else if (flags & SPECTRUM_PACKED_KEY) {
+    memcpy(sp.payload + n, q, width);
+    n += width;
+  } else {
+    for (int i = 0; i < width; i++) {
+      sp.payload[n++] = q[i] - rrx->spectrum_q[i];
+    }
+  }
+
+  memcpy(rrx->spectrum_q, q, width);
+
+#ifdef ZSTD
+
+  if (client->spectrum_zstd && client->zstd_ctx != NULL) {
+    uint8_t z[SPECTRUM_PACKED_MAX_PAYLOAD];
+    size_t zlen = ZSTD_compressCCtx((ZSTD_CCtx *)client->zstd_ctx, z, sizeof(z), sp.payload, n, 1);
+
+    if (!ZSTD_isError(zlen) && (int)zlen < n) {
+      flags |= SPECTRUM_PACKED_ZSTD;
+      memcpy(sp.payload, z, zlen);
+      n = zlen;
+    }
+  }
+
+#endif
+  sp.header.sync = REMOTE_SYNC;
+  sp.header.data_type = htons(INFO_SPECTRUM_PACKED);
+  sp.header.version = htonll(CLIENT_SERVER_VERSION);
+  sp.rx = sd->rx;
+  sp.flags = flags;
+  sp.samples = htons(width);
+  sp.offset = htons((uint16_t)rrx->spectrum_offset);
+  sp.meter = sd->meter;
+  sp.length = htons(n);
+  int len = sizeof(SPECTRUM_PACKED) - SPECTRUM_PACKED_MAX_PAYLOAD + n;
+  CLIENT_MSG *p = g_malloc(sizeof(CLIENT_MSG) + len);
+  p->type = m->type;
+  p->rx = m->rx;
+  p->len = len;
+  p->sent = 0;
+  p->packed = 1;
+  memcpy(p->data, &sp, len);
+  return p;
+}
+
+static gpointer client_sender_thread(gpointer arg) {
+  REMOTE_CLIENT *client = (REMOTE_CLIENT *)arg;
+#ifdef MSG_NOSIGNAL
+  int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+  int flags = MSG_DONTWAIT;
+#endif
+  g_mutex_lock(&client->send_mutex);
+
+  while (client->sender_running) {
+    CLIENT_MSG *m = g_queue_peek_head(client->send_queue);
+
+    if (m == NULL) {
+      g_cond_wait(&client->send_cond, &client->send_mutex);
+      continue;
+    }
+
+    g_mutex_unlock(&client->send_mutex);
+
+    if (m->type == CLIENT_MSG_SPECTRUM && client->spectrum_packed && !m->packed) {
+      //
+      // The head of the queue is not touched by anyone else,
+      // so it can be replaced by its packed version
+      //
+      CLIENT_MSG *p = client_pack_spectrum(client, m);
+      g_mutex_lock(&client->send_mutex);
+      client->send_queue->head->data = p;
+      client->send_queue_bytes += p->len - m->len;
+      g_mutex_unlock(&client->send_mutex);
+      g_free(m);
+      m = p;
+    }
+
+    int rc = send(client->socket, m->data + m->sent, m->len - m->sent, flags);
+
+    if (rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      //
+      // socket buffer full: wait until there is room again, but
+      // with a time-out such that we can be stopped
+      //
+      struct pollfd pfd;
+      pfd.fd = client->socket;
+      pfd.events = POLLOUT;
+      pfd.revents = 0;
+      poll(&pfd, 1, 100);
+      rc = 0;
+    }
+
+    g_mutex_lock(&client->send_mutex);
+
+    if (rc < 0) {
+      t_perror("client_sender_thread");
+      //
+      // This makes the client's receive thread terminate
+      //
+      shutdown(client->socket, SHUT_RDWR);
+      client->sender_running = FALSE;
+      break;
+    }
+
+    m->sent += rc;
+    client->bytes_sent += rc;
+    metric_add(client->m_bytes_sent, rc);
+
+    if (m->sent == m->len) {
+      g_queue_pop_head(client->send_queue);
+      client->send_queue_bytes -= m->len;
+      client->msgs_sent[m->type]++;
+      metric_add(client->m_msgs_sent[m->type], 1);
+      metric_set(client->m_send_queue, client->send_queue_bytes);
+      g_free(m);
+    }
+  }
+
+  g_mutex_unlock(&client->send_mutex);
+  return NULL;
+}
+
+//
+// The statistics are also registered as metrics (see metrics.h), such that
+// they can be watched while a slow client is dropping messages. Since metrics
+// cannot be removed, a client gets the lowest number not used by another
+// connected client, and the counters of that number continue to count
+// for the next client that gets it.
+//
+static void client_metrics_init(REMOTE_CLIENT *client) {
+  int index = 0;
+  g_mutex_lock(&client_mutex);
+  REMOTE_CLIENT *c = clients;
+
+  while (c != NULL) {
+    if (c->index == index) {
+      index++;
+      c = clients;
+    } else {
+      c = c->next;
+    }
+  }
+
+  g_mutex_unlock(&client_mutex);
+  client->index = index;
+  client->m_bytes_sent = metric_counter("client%d_bytes_sent", index);
+  client->m_send_queue = metric_gauge("client%d_send_queue_bytes", index);
+
+  for (int i = 0; i < 3; i++) {
+    client->m_msgs_sent[i] = metric_counter("client%d_%s_msgs_sent", index, client_msg_name[i]);
+    client->m_msgs_dropped[i] = metric_counter("client%d_%s_msgs_dropped", index, client_msg_name[i]);
+  }
+}
+
+static void client_sender_start(REMOTE_CLIENT *client) {
+  client_metrics_init(client);
+  g_mutex_init(&client->send_mutex);
+  g_cond_init(&client->send_cond);
+  client->send_queue = g_queue_new();
+  client->send_queue_bytes = 0;
+  client->send_queue_max = 0;
+  client->bytes_sent = 0;
+
+  for (int i = 0; i < 3; i++) {
+    client->msgs_sent[i] = 0;
+    client->msgs_dropped[i] = 0;
+  }
+
+  client->spectrum_packed = FALSE;
+  client->spectrum_zstd = FALSE;
+  client->audio_opus = FALSE;
+  client->zstd_ctx = NULL;
+
+  for (int i = 0; i < 8; i++) {
+    client->receiver[i].spectrum_width = 0;
+    client->receiver[i].spectrum_offset = 0;
+    client->receiver[i].spectrum_frames = 0;
+  }
+
+#ifdef ZSTD
+  client->zstd_ctx = ZSTD_createCCtx();
+#endif
+  client->sender_running = TRUE;
+  client->sender_thread_id = g_thread_new("SSDR_send", client_sender_thread, client);
+}
+
+static void client_sender_stop(REMOTE_CLIENT *client) {
+  g_mutex_lock(&client->send_mutex);
+  client->sender_running = FALSE;
+  g_cond_signal(&client->send_cond);
+  g_mutex_unlock(&client->send_mutex);
+  g_thread_join(client->sender_thread_id);
+  t_print("%s: sent %" G_GUINT64_FORMAT " bytes, queue max=%d now=%d bytes\n", __FUNCTION__,
+          client->bytes_sent, client->send_queue_max, client->send_queue_bytes);
+
+  for (int i = 0; i < 3; i++) {
+    t_print("%s: %-8s sent=%" G_GUINT64_FORMAT " dropped=%" G_GUINT64_FORMAT "\n", __FUNCTION__,
+            client_msg_name[i], client->msgs_sent[i], client->msgs_dropped[i]);
+  }
+}
+
+//
+// Called by delete_client() when the client has been removed from the list,
+// so no-one can queue messages any more
+//
+static void client_sender_free(REMOTE_CLIENT *client) {
+  g_queue_free_full(client->send_queue, g_free);
+  client->send_queue = NULL;
+#ifdef ZSTD
+
+  if (client->zstd_ctx != NULL) {
+    ZSTD_freeCCtx((ZSTD_CCtx *)client->zstd_ctx);
+    client->zstd_ctx = NULL;
+  }
+
+#endif
+  g_cond_clear(&client->send_cond);
+  g_mutex_clear(&client->send_mutex);
+}
+
+#ifdef OPUS
+static gpointer opus_encoder_thread(gpointer arg) {
+  OpusEncoder *encoder[8] = {NULL};
+  uint16_t sequence[8] = {0};       // next sequence number expected from opus_collect
+  OPUS_DATA od;
+
+  for (;;) {
+    OPUS_PCM *pcm = g_async_queue_pop(opus_queue);
+    int r = pcm->rx;
+
+    if (encoder[r] == NULL) {
+      int err;
+      encoder[r] = opus_encoder_create(48000, 2, OPUS_APPLICATION_AUDIO, &err);
+
+      if (err != OPUS_OK) {
+        t_print("%s: RX%d: %s\n", __FUNCTION__, r + 1, opus_strerror(err));
+        encoder[r] = NULL;
+        g_free(pcm);
+        continue;
+      }
+
+      opus_encoder_ctl(encoder[r], OPUS_SET_BITRATE(OPUS_BITRATE));
+      opus_encoder_ctl(encoder[r], OPUS_SET_INBAND_FEC(1));
+      opus_encoder_ctl(encoder[r], OPUS_SET_PACKET_LOSS_PERC(10));
+    } else if (pcm->sequence != sequence[r]) {
+      //
+      // Frames have been dropped before they reached the encoder. The FEC
+      // data of the next frame would describe the frame encoded before
+      // the gap, so start afresh, then the client conceals the gap.
+      //
+      opus_encoder_ctl(encoder[r], OPUS_RESET_STATE);
+    }
+
+    sequence[r] = pcm->sequence + 1;
+    od.sequence = htons(pcm->sequence);
+    int len = opus_encode(encoder[r], pcm->sample, OPUS_FRAME_SIZE, od.data, OPUS_DATA_MAX);
+    g_free(pcm);
+
+    if (len < 0) {
+      t_print("%s: RX%d: %s\n", __FUNCTION__, r + 1, opus_strerror(len));
+      continue;
+    }
+
+    od.header.sync = REMOTE_SYNC;
+    od.header.data_type = htons(INFO_AUDIO_OPUS);
+    od.header.version = htonll(CLIENT_SERVER_VERSION);
+    od.rx = r;
+    od.length = htons(len);
+    g_mutex_lock(&client_mutex);
+
+    for (REMOTE_CLIENT *c = clients; c != NULL; c = c->next) {
+      if (c->socket != -1 && c->audio_opus) {
+        client_queue_msg(c, CLIENT_MSG_AUDIO, r, &od, sizeof(OPUS_DATA) - OPUS_DATA_MAX + len);
+      }
+    }
+
+    g_mutex_unlock(&client_mutex);
+  }
+
+  return NULL;
+}
+
+static void opus_collect(int r, short left_sample, short right_sample) {
+  if (opus_pcm[r] == NULL) {
+    opus_pcm[r] = g_new(OPUS_PCM, 1);
+    opus_pcm[r]->rx = r;
+    opus_pcm_index[r] = 0;
+  }
+
+  int i = 2 * opus_pcm_index[r];
+  opus_pcm[r]->sample[i] = left_sample;
+  opus_pcm[r]->sample[i + 1] = right_sample;
+
+  if (++opus_pcm_index[r] >= OPUS_FRAME_SIZE) {
+    //
+    // If the encoder thread does not keep up, drop the frame here
+    // rather than let the queue grow. It still uses up a sequence number.
+    //
+    opus_pcm[r]->sequence = opus_pcm_sequence[r]++;
+
+    if (g_async_queue_length(opus_queue) < OPUS_QUEUE_MAX) {
+      g_async_queue_push(opus_queue, opus_pcm[r]);
+      opus_pcm[r] = NULL;
+    } else {
+      opus_pcm_index[r] = 0;
+    }
+  }
+}
+#endif
+
 void remote_audio(const RECEIVER *rx, short left_sample, short right_sample) {
   int i = audio_buffer_index * 2;
   audio_data.sample[i] = htons(left_sample);
   audio_data.sample[i + 1] = htons(right_sample);
   audio_buffer_index++;
+#ifdef OPUS
+
+  if (g_atomic_int_get(&opus_clients) > 0 && rx->id < 8) {
+    opus_collect(rx->id, left_sample, right_sample);
+  }
+
+#endif
 
   if (audio_buffer_index >= AUDIO_DATA_SIZE) {
+    audio_data.header.sync = REMOTE_SYNC;
+    audio_data.header.data_type = htons(INFO_AUDIO);
+    audio_data.header.version = htonll(CLIENT_SERVER_VERSION);
+    audio_data.rx = rx->id;
+    audio_data.samples = ntohs(audio_buffer_index);
     g_mutex_lock(&client_mutex);
-    REMOTE_CLIENT *c = clients;
-
-    while (c != NULL && c->socket != -1) {
-      audio_data.header.sync = REMOTE_SYNC;
-      audio_data.header.data_type = htons(INFO_AUDIO);
-      audio_data.header.version = htonll(CLIENT_SERVER_VERSION);
-      audio_data.rx = rx->id;
-      audio_data.samples = ntohs(audio_buffer_index);
-      int bytes_sent = send_bytes(c->socket, (char *)&audio_data, sizeof(audio_data));
 
-      if (bytes_sent < 0) {
-        t_perror("remote_audio");
-        close(c->socket);
+    for (REMOTE_CLIENT *c = clients; c != NULL; c = c->next) {
+      if (c->socket != -1 && !c->audio_opus) {
+        client_queue_msg(c, CLIENT_MSG_AUDIO, rx->id, &audio_data, sizeof(audio_data));
       }
-
-      c = c->next;
     }
 
     g_mutex_unlock(&client_mutex);
@@ -240,10 +954,8 @@ static int send_spectrum(void *arg) {
           spectrum_data.sample[i] = htons(s);
         }
 
-        // send the buffer
-        int bytes_sent = send_bytes(client->socket, (char *)&spectrum_data, sizeof(spectrum_data));
-
-        if (bytes_sent < 0) {
+        // queue the buffer
+        if (client_queue_msg(client, CLIENT_MSG_SPECTRUM, r, &spectrum_data, sizeof(spectrum_data)) < 0) {
           result = FALSE;
         }
 
@@ -465,8 +1177,7 @@ static void *server_client_thread(void *arg) {
       if (bytes_read <= 0) {
         t_print("server_client_thread: short read for SPECTRUM_COMMAND\n");
         t_perror("server_client_thread");
-        // dialog box?
-        return NULL;
+        goto disconnect;
       }
 
       // cppcheck-suppress uninitStructMember
@@ -477,6 +1188,22 @@ static void *server_client_thread(void *arg) {
               client->spectrum_update_timer_id);
 
       if (state) {
+        uint64_t version = ntohll(header.version);
+        client->spectrum_packed = (version & CLIENT_SERVER_VERSION_MASK) >= 1;
+#ifdef ZSTD
+        client->spectrum_zstd = (version & CLIENT_SERVER_CAP_ZSTD) != 0;
+#endif
+#ifdef OPUS
+
+        if (!client->audio_opus && (version & CLIENT_SERVER_CAP_OPUS)) {
+          client->audio_opus = TRUE;
+          g_atomic_int_inc(&opus_clients);
+        }
+
+#endif
+        t_print("server_client_thread: client version=%d packed=%d zstd=%d opus=%d\n",
+                (int)(version & CLIENT_SERVER_VERSION_MASK), client->spectrum_packed, client->spectrum_zstd,
+                client->audio_opus);
         client->receiver[rx].receiver = rx;
         client->receiver[rx].spectrum_fps = receiver[rx]->fps;
         client->receiver[rx].spectrum_port = 0;
@@ -508,8 +1235,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for FREQ_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(freq_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, freq_command);
@@ -528,8 +1255,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for STEP_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(step_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, step_command);
@@ -548,8 +1275,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for MOVE_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(move_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, move_command);
@@ -568,8 +1295,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for MOVE_TO_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(move_to_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, move_to_command);
@@ -588,8 +1315,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for ZOOM_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(zoom_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, zoom_command);
@@ -608,8 +1335,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for PAN_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(pan_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, pan_command);
@@ -628,8 +1355,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for VOLUME_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(volume_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, volume_command);
@@ -648,8 +1375,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for AGC_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(agc_command);
+          goto disconnect;
         }
 
         t_print("CMD_RESP_RX_AGC: id=%d agc=%d\n", agc_command->id, ntohs(agc_command->agc));
@@ -669,8 +1396,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for AGC_GAIN_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(agc_gain_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, agc_gain_command);
@@ -689,8 +1416,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RFGAIN_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, command);
@@ -709,8 +1436,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for ATTENUATION_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(attenuation_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, attenuation_command);
@@ -729,8 +1456,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for SQUELCH_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(squelch_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, squelch_command);
@@ -749,8 +1476,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for NOISE_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(noise_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, noise_command);
@@ -769,8 +1496,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for BAND_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(band_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, band_command);
@@ -789,8 +1516,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for MODE_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(mode_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, mode_command);
@@ -809,8 +1536,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for FILTER_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(filter_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, filter_command);
@@ -829,8 +1556,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for SPLIT_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(split_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, split_command);
@@ -849,8 +1576,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for SAT_COMMAND\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(sat_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, sat_command);
@@ -869,8 +1596,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for DUP\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(dup_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, dup_command);
@@ -889,8 +1616,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for LOCK\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(lock_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, lock_command);
@@ -909,8 +1636,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for CTUN\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(ctun_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, ctun_command);
@@ -929,8 +1656,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for FPS\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(fps_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, fps_command);
@@ -949,8 +1676,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RX_SELECT\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(rx_select_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, rx_select_command);
@@ -969,8 +1696,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for VFO\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(vfo_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, vfo_command);
@@ -989,8 +1716,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RIT_TOGGLE\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(rit_toggle_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, rit_toggle_command);
@@ -1009,8 +1736,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RIT_CLEAR\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(rit_clear_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, rit_clear_command);
@@ -1029,8 +1756,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RIT\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(rit_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, rit_command);
@@ -1082,8 +1809,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for SAMPLE_RATE\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(sample_rate_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, sample_rate_command);
@@ -1103,8 +1830,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RECEIVERS\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(receivers_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, receivers_command);
@@ -1124,8 +1851,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for RIT_INCREMENT\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(rit_increment_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, rit_increment_command);
@@ -1145,8 +1872,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for FILTER_BOARD\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(filter_board_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, filter_board_command);
@@ -1165,8 +1892,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for SWAP_IQ\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(swap_iq_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, swap_iq_command);
@@ -1185,8 +1912,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for REGION\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(region_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, region_command);
@@ -1205,8 +1932,8 @@ static void *server_client_thread(void *arg) {
         if (bytes_read <= 0) {
           t_print("server_client_thread: short read for MUTE_RX\n");
           t_perror("server_client_thread");
-          // dialog box?
-          return NULL;
+          g_free(mute_rx_command);
+          goto disconnect;
         }
 
         g_idle_add(remote_command, mute_rx_command);
@@ -1219,8 +1946,18 @@ static void *server_client_thread(void *arg) {
     }
   }
 
+disconnect:
   // close the socket to force listen to terminate
   t_print("client disconnected\n");
+  client_sender_stop(client);
+#ifdef OPUS
+
+  if (client->audio_opus) {
+    client->audio_opus = FALSE;
+    g_atomic_int_dec_and_test(&opus_clients);
+  }
+
+#endif
 
   if (client->socket != -1) {
     close(client->socket);
@@ -1235,7 +1972,14 @@ void send_start_spectrum(int s, int rx) {
   SPECTRUM_COMMAND command;
   command.header.sync = REMOTE_SYNC;
   command.header.data_type = htons(CMD_RESP_SPECTRUM);
-  command.header.version = htonl(CLIENT_SERVER_VERSION);
+  uint64_t version = CLIENT_SERVER_VERSION;
+#ifdef ZSTD
+  version |= CLIENT_SERVER_CAP_ZSTD;
+#endif
+#ifdef OPUS
+  version |= CLIENT_SERVER_CAP_OPUS;
+#endif
+  command.header.version = htonll(version);
   command.id = rx;
   command.start_stop = 1;
   int bytes_sent = send_bytes(s, (char *)&command, sizeof(command));
@@ -1938,8 +2682,9 @@ static void *listen_thread(void *arg) {
     char s[128];
     inet_ntop(AF_INET, &(((struct sockaddr_in *)&client->address)->sin_addr), s, 128);
     t_print("Client_connected from %s\n", s);
-    client->thread_id = g_thread_new("SSDR_client", server_client_thread, client);
+    client_sender_start(client);
     add_client(client);
+    client->thread_id = g_thread_new("SSDR_client", server_client_thread, client);
     close(listen_socket);
     (void) g_thread_join(client->thread_id);
   }
@@ -1952,6 +2697,14 @@ int create_hpsdr_server() {
   g_mutex_init(&client_mutex);
   clients = NULL;
   running = TRUE;
+#ifdef OPUS
+
+  if (opus_queue == NULL) {
+    opus_queue = g_async_queue_new();
+    opus_thread_id = g_thread_new("SSDR_opus", opus_encoder_thread, NULL);
+  }
+
+#endif
   listen_thread_id = g_thread_new( "HPSDR_listen", listen_thread, NULL);
   return 0;
 }
@@ -2006,6 +2759,193 @@ void start_vfo_timer() {
   t_print("check_vfo_timer_id %d\n", check_vfo_timer_id);
 }
 
+//
+// Store the spectrum data received from the server in the receiver,
+// update the VFOs if they have changed, and trigger a display update.
+// The VFO data is still in network byte order.
+//
+static void client_spectrum_update(int r, double meter, int samples, const short *sample, const uint64_t *vfos) {
+  long long frequency_a = ntohll(vfos[0]);
+  long long frequency_b = ntohll(vfos[1]);
+  long long ctun_frequency_a = ntohll(vfos[2]);
+  long long ctun_frequency_b = ntohll(vfos[3]);
+  long long offset_a = ntohll(vfos[4]);
+  long long offset_b = ntohll(vfos[5]);
+  receiver[r]->meter = meter;
+
+  if (receiver[r]->pixel_samples == NULL) {
+    receiver[r]->pixel_samples = g_new(float, (int)samples);
+  }
+
+  for (int i = 0; i < samples; i++) {
+    receiver[r]->pixel_samples[i] = (float)sample[i];
+  }
+
+  if (vfo[VFO_A].frequency != frequency_a || vfo[VFO_B].frequency != frequency_b
+      || vfo[VFO_A].ctun_frequency != ctun_frequency_a || vfo[VFO_B].ctun_frequency != ctun_frequency_b
+      || vfo[VFO_A].offset != offset_a || vfo[VFO_B].offset != offset_b) {
+    vfo[VFO_A].frequency = frequency_a;
+    vfo[VFO_B].frequency = frequency_b;
+    vfo[VFO_A].ctun_frequency = ctun_frequency_a;
+    vfo[VFO_B].ctun_frequency = ctun_frequency_b;
+    vfo[VFO_A].offset = offset_a;
+    vfo[VFO_B].offset = offset_b;
+    g_idle_add(ext_vfo_update, NULL);
+  }
+
+  g_idle_add(ext_receiver_remote_update_display, receiver[r]);
+}
+
+//
+// Decoder state for packed spectrum frames, per receiver
+//
+static int spectrum_width[8];
+static int spectrum_offset[8];
+static uint8_t spectrum_q[8][SPECTRUM_DATA_SIZE];
+static uint64_t spectrum_vfo[8][6];
+
+static void client_spectrum_unpack(SPECTRUM_PACKED *sp) {
+  int r = sp->rx;
+  int flags = sp->flags;
+  int width = ntohs(sp->samples);
+  int length = ntohs(sp->length);
+  const uint8_t *p = sp->payload;
+  short sample[SPECTRUM_DATA_SIZE];
+
+  if (r >= 8 || r >= receivers || width > SPECTRUM_DATA_SIZE) { return; }
+
+#ifdef ZSTD
+  uint8_t z[SPECTRUM_PACKED_MAX_PAYLOAD];
+
+  if (flags & SPECTRUM_PACKED_ZSTD) {
+    size_t zlen = ZSTD_decompress(z, sizeof(z), sp->payload, length);
+
+    if (ZSTD_isError(zlen)) {
+      t_print("%s: %s\n", __FUNCTION__, ZSTD_getErrorName(zlen));
+      spectrum_width[r] = 0;
+      return;
+    }
+
+    p = z;
+    length = zlen;
+  }
+
+#else
+
+  if (flags & SPECTRUM_PACKED_ZSTD) { return; }
+
+#endif
+
+  if (flags & SPECTRUM_PACKED_VFO) {
+    if (length < (int)SPECTRUM_PACKED_VFO_SIZE) { return; }
+
+    memcpy(spectrum_vfo[r], p, SPECTRUM_PACKED_VFO_SIZE);
+    p += SPECTRUM_PACKED_VFO_SIZE;
+    length -= SPECTRUM_PACKED_VFO_SIZE;
+  }
+
+  int key = flags & SPECTRUM_PACKED_KEY;
+
+  //
+  // A difference frame can only be applied to the frame it was made for.
+  // If we missed the key frame, wait for the next one.
+  //
+  if (!key && spectrum_width[r] != width) { return; }
+
+  if (flags & SPECTRUM_PACKED_RICE) {
+    uint8_t q[SPECTRUM_DATA_SIZE];
+
+    if (spectrum_rice_decode(spectrum_q[r], q, width, key, p, length) < 0) {
+      t_print("%s: RX%d: corrupt frame\n", __FUNCTION__, r + 1);
+      spectrum_width[r] = 0;
+      return;
+    }
+
+    memcpy(spectrum_q[r], q, width);
+  } else {
+    if (length < width) { return; }
+
+    for (int i = 0; i < width; i++) {
+      spectrum_q[r][i] = key ? p[i] : spectrum_q[r][i] + p[i];
+    }
+  }
+
+  if (key) {
+    spectrum_width[r] = width;
+    spectrum_offset[r] = (short)ntohs(sp->offset);
+  }
+
+  for (int i = 0; i < width; i++) {
+    sample[i] = spectrum_offset[r] + spectrum_q[r][i];
+  }
+
+  client_spectrum_update(r, ntohd(sp->meter), width, sample, spectrum_vfo[r]);
+}
+
+#ifdef OPUS
+//
+// Opus decoder state (client side), per receiver
+//
+static OpusDecoder *opus_decoder[8];
+static int opus_sequence[8];
+
+//
+// If frames are missing, the last one is recovered from the FEC data
+// contained in the current frame, and the ones before (at most a few)
+// are filled by packet loss concealment.
+//
+#define OPUS_MAX_CONCEAL 5
+
+static void client_opus_decode(const OPUS_DATA *od) {
+  int r = od->rx;
+  int sequence = ntohs(od->sequence);
+  int length = ntohs(od->length);
+  float lr[2 * OPUS_FRAME_SIZE];
+
+  if (r >= 8 || r >= receivers) { return; }
+
+  RECEIVER *rx = receiver[r];
+
+  if (opus_decoder[r] == NULL) {
+    int err;
+    opus_decoder[r] = opus_decoder_create(48000, 2, &err);
+
+    if (err != OPUS_OK) {
+      t_print("%s: RX%d: %s\n", __FUNCTION__, r + 1, opus_strerror(err));
+      opus_decoder[r] = NULL;
+      return;
+    }
+
+    opus_sequence[r] = sequence;
+  }
+
+  int missing = (sequence - opus_sequence[r]) & 0xFFFF;
+  opus_sequence[r] = (sequence + 1) & 0xFFFF;
+
+  if (missing > 0 && missing < 0x8000) {
+    if (missing > OPUS_MAX_CONCEAL + 1) { missing = OPUS_MAX_CONCEAL + 1; }
+
+    for (int i = 0; i < missing; i++) {
+      int fec = (i == missing - 1);
+      int n = opus_decode_float(opus_decoder[r], fec ? od->data : NULL, fec ? length : 0, lr, OPUS_FRAME_SIZE, fec);
+
+      if (n > 0 && rx->local_audio) { audio_write_block(rx, lr, n); }
+    }
+  }
+
+  int n = opus_decode_float(opus_decoder[r], od->data, length, lr, OPUS_FRAME_SIZE, 0);
+
+  if (n < 0) {
+    t_print("%s: RX%d: %s\n", __FUNCTION__, r + 1, opus_strerror(n));
+    return;
+  }
+
+  if (rx->local_audio) {
+    audio_write_block(rx, lr, n);
+  }
+}
+#endif
+
 static void *client_thread(void* arg) {
   int bytes_read;
   HEADER header;
@@ -2170,6 +3110,11 @@ static void *client_thread(void* arg) {
       receiver[rx]->local_audio_buffer = NULL;
       receiver[rx]->local_audio = 0;
       g_mutex_init(&receiver[rx]->local_audio_mutex);
+#ifdef ALSA
+      receiver[rx]->local_audio_ring = NULL;
+      receiver[rx]->local_audio_thread = NULL;
+      g_mutex_init(&receiver[rx]->local_audio_ring_mutex);
+#endif
       receiver[rx]->mute_when_not_active = 0;
       receiver[rx]->audio_channel = STEREO;
       receiver[rx]->audio_device = -1;
@@ -2241,40 +3186,84 @@ static void *client_thread(void* arg) {
 
       // cppcheck-suppress uninitStructMember
       int r = spectrum_data.rx;
-      long long frequency_a = ntohll(spectrum_data.vfo_a_freq);
-      long long frequency_b = ntohll(spectrum_data.vfo_b_freq);
-      long long ctun_frequency_a = ntohll(spectrum_data.vfo_a_ctun_freq);
-      long long ctun_frequency_b = ntohll(spectrum_data.vfo_b_ctun_freq);
-      long long offset_a = ntohll(spectrum_data.vfo_a_offset);
-      long long offset_b = ntohll(spectrum_data.vfo_b_offset);
-      receiver[r]->meter = ntohd(spectrum_data.meter);
-      short samples = ntohs(spectrum_data.samples);
+      uint64_t vfos[6];
+      short sample[SPECTRUM_DATA_SIZE];
+      int samples = ntohs(spectrum_data.samples);
 
-      if (receiver[r]->pixel_samples == NULL) {
-        receiver[r]->pixel_samples = g_new(float, (int)samples);
-      }
+      if (samples > SPECTRUM_DATA_SIZE) { samples = SPECTRUM_DATA_SIZE; }
+
+      vfos[0] = spectrum_data.vfo_a_freq;
+      vfos[1] = spectrum_data.vfo_b_freq;
+      vfos[2] = spectrum_data.vfo_a_ctun_freq;
+      vfos[3] = spectrum_data.vfo_b_ctun_freq;
+      vfos[4] = spectrum_data.vfo_a_offset;
+      vfos[5] = spectrum_data.vfo_b_offset;
 
       for (int i = 0; i < samples; i++) {
-        short sample = ntohs(spectrum_data.sample[i]);
-        receiver[r]->pixel_samples[i] = (float)sample;
-      }
-
-      if (vfo[VFO_A].frequency != frequency_a || vfo[VFO_B].frequency != frequency_b
-          || vfo[VFO_A].ctun_frequency != ctun_frequency_a || vfo[VFO_B].ctun_frequency != ctun_frequency_b
-          || vfo[VFO_A].offset != offset_a || vfo[VFO_B].offset != offset_b) {
-        vfo[VFO_A].frequency = frequency_a;
-        vfo[VFO_B].frequency = frequency_b;
-        vfo[VFO_A].ctun_frequency = ctun_frequency_a;
-        vfo[VFO_B].ctun_frequency = ctun_frequency_b;
-        vfo[VFO_A].offset = offset_a;
-        vfo[VFO_B].offset = offset_b;
-        g_idle_add(ext_vfo_update, NULL);
+        sample[i] = ntohs(spectrum_data.sample[i]);
+      }
+
+      client_spectrum_update(r, ntohd(spectrum_data.meter), samples, sample, vfos);
+    }
+    break;
+
+    case INFO_SPECTRUM_PACKED: {
+      SPECTRUM_PACKED sp;
+      int fixed = sizeof(sp) - sizeof(header) - SPECTRUM_PACKED_MAX_PAYLOAD;
+      bytes_read = recv_bytes(client_socket, (char *)&sp.rx, fixed);
+
+      if (bytes_read > 0) {
+        int length = ntohs(sp.length);
+
+        if (length > SPECTRUM_PACKED_MAX_PAYLOAD) {
+          t_print("client_thread: SPECTRUM_PACKED payload too large (%d)\n", length);
+          return NULL;
+        }
+
+        bytes_read = recv_bytes(client_socket, (char *)sp.payload, length);
+      }
+
+      if (bytes_read <= 0) {
+        t_print("client_thread: short read for SPECTRUM_PACKED\n");
+        t_perror("client_thread");
+        // dialog box?
+        return NULL;
       }
 
-      g_idle_add(ext_receiver_remote_update_display, receiver[r]);
+      client_spectrum_unpack(&sp);
     }
     break;
 
+#ifdef OPUS
+
+    case INFO_AUDIO_OPUS: {
+      OPUS_DATA od;
+      int fixed = sizeof(od) - sizeof(header) - OPUS_DATA_MAX;
+      bytes_read = recv_bytes(client_socket, (char *)&od.rx, fixed);
+
+      if (bytes_read > 0) {
+        int length = ntohs(od.length);
+
+        if (length > OPUS_DATA_MAX) {
+          t_print("client_thread: OPUS_DATA too large (%d)\n", length);
+          return NULL;
+        }
+
+        bytes_read = recv_bytes(client_socket, (char *)od.data, length);
+      }
+
+      if (bytes_read <= 0) {
+        t_print("client_thread: short read for OPUS_DATA\n");
+        t_perror("client_thread");
+        // dialog box?
+        return NULL;
+      }
+
+      client_opus_decode(&od);
+    }
+    break;
+#endif
+
     case INFO_AUDIO: {
       AUDIO_DATA adata;
       bytes_read = recv_bytes(client_socket, (char *)&adata.rx, sizeof(adata) - sizeof(header));
@@ -2291,11 +3280,15 @@ static void *client_thread(void* arg) {
       int samples = ntohs(adata.samples);
 
       if (rx->local_audio) {
-        for (int i = 0; i < samples; i++) {
-          short left_sample = ntohs(adata.sample[(i * 2)]);
-          short right_sample = ntohs(adata.sample[(i * 2) + 1]);
-          audio_write(rx, (float)left_sample / 32767.0, (float)right_sample / 32767.0);
+        float lr[2 * AUDIO_DATA_SIZE];
+
+        if (samples > AUDIO_DATA_SIZE) { samples = AUDIO_DATA_SIZE; }
+
+        for (int i = 0; i < 2 * samples; i++) {
+          lr[i] = (float)(short)ntohs(adata.sample[i]) / 32767.0F;
         }
+
+        audio_write_block(rx, lr, samples);
       }
     }
     break;
@@ -20,6 +20,7 @@
 #define HPSDR_SERVER_H
 
 #include <stdint.h>
+#include "metrics.h"
 
 #ifndef __APPLE__
   #define htonll htobe64
@@ -87,6 +88,8 @@ enum _header_type_enum {
   CMD_RESP_SWAP_IQ,
   CMD_RESP_REGION,
   CMD_RESP_MUTE_RX,
+  INFO_SPECTRUM_PACKED,
+  INFO_AUDIO_OPUS,
 };
 
 enum _vfo_action_enum {
@@ -95,13 +98,35 @@ enum _vfo_action_enum {
   VFO_A_SWAP_B,
 };
 
-#define CLIENT_SERVER_VERSION 0LL
+//
+// Version 1: the client understands INFO_SPECTRUM_PACKED frames.
+// A client puts its version, together with capability flags in the
+// upper 32 bits, into the header of the CMD_RESP_SPECTRUM command,
+// and the server only sends packed frames if the client can decode them.
+//
+#define CLIENT_SERVER_VERSION 1LL
+#define CLIENT_SERVER_VERSION_MASK 0xFFFFFFFFLL
+#define CLIENT_SERVER_CAP_ZSTD (1LL << 32)
+#define CLIENT_SERVER_CAP_OPUS (1LL << 33)
 
 #define SPECTRUM_DATA_SIZE 800
 #define AUDIO_DATA_SIZE 1024
 
 #define REMOTE_SYNC (uint16_t)0xFAFA
 
+//
+// Message classes in the per-client send queue. If the queue is full,
+// spectrum frames are dropped first, then audio. Control messages
+// are never dropped.
+//
+enum _client_msg_enum {
+  CLIENT_MSG_AUDIO,
+  CLIENT_MSG_SPECTRUM,
+  CLIENT_MSG_CONTROL,
+};
+
+#define CLIENT_QUEUE_MAX_BYTES (512 * 1024)
+
 typedef struct _remote_rx {
   int receiver;
   gboolean send_audio;
@@ -112,6 +137,14 @@ typedef struct _remote_rx {
   int spectrum_fps;
   int spectrum_port;
   struct sockaddr_in spectrum_address;
+  //
+  // state of the packed spectrum encoder (only used by the sender thread)
+  //
+  int spectrum_width;                    // width of the last key frame, 0: none sent yet
+  int spectrum_offset;                   // dB value of quantization level 0
+  int spectrum_frames;                   // frames sent since last key frame
+  uint64_t spectrum_vfo[6];              // VFO data last sent (network byte order)
+  uint8_t spectrum_q[SPECTRUM_DATA_SIZE];  // quantized samples last sent
 } REMOTE_RX;
 
 typedef struct _remote_client {
@@ -124,6 +157,31 @@ typedef struct _remote_client {
   int receivers;
   guint spectrum_update_timer_id;
   REMOTE_RX receiver[8];
+  //
+  // Outbound queue, drained by a per-client sender thread
+  //
+  GMutex send_mutex;
+  GCond send_cond;
+  GQueue *send_queue;
+  int send_queue_bytes;                  // bytes currently queued
+  gboolean sender_running;
+  GThread *sender_thread_id;
+  //
+  // statistics (indexed by CLIENT_MSG_AUDIO etc.)
+  //
+  guint64 bytes_sent;
+  guint64 msgs_sent[3];
+  guint64 msgs_dropped[3];
+  int send_queue_max;                    // high-water mark of send_queue_bytes
+  int index;                             // number of this client in the metric names
+  METRIC *m_bytes_sent;
+  METRIC *m_msgs_sent[3];
+  METRIC *m_msgs_dropped[3];
+  METRIC *m_send_queue;
+  gboolean spectrum_packed;              // client understands INFO_SPECTRUM_PACKED
+  gboolean spectrum_zstd;                // client can decompress zstd payloads
+  gboolean audio_opus;                   // client gets INFO_AUDIO_OPUS rather than INFO_AUDIO
+  void *zstd_ctx;
   void *next;
 } REMOTE_CLIENT;
 
@@ -245,6 +303,39 @@ typedef struct __attribute__((__packed__)) _spectrum_data {
   uint16_t sample[SPECTRUM_DATA_SIZE];
 } SPECTRUM_DATA;
 
+//
+// Packed spectrum frame. The samples (integer dB values) are quantized
+// to 8 bits relative to a per-frame offset. A key frame stands alone, other
+// frames are coded relative to the previous frame. The payload that follows
+// the fixed part consists of
+//  - the six VFO values (as in SPECTRUM_DATA), if SPECTRUM_PACKED_VFO is set
+//  - if SPECTRUM_PACKED_RICE is set, the Rice-coded prediction errors of
+//    the quantized samples (see client_server.c), otherwise one byte per
+//    sample: the quantized value in a key frame, else the difference
+//    (modulo 256) to the previous frame
+// and it is zstd-compressed as a whole if SPECTRUM_PACKED_ZSTD is set.
+//
+#define SPECTRUM_PACKED_KEY    0x01
+#define SPECTRUM_PACKED_RICE   0x02
+#define SPECTRUM_PACKED_VFO    0x04
+#define SPECTRUM_PACKED_ZSTD   0x08
+
+#define SPECTRUM_PACKED_VFO_SIZE (6 * sizeof(uint64_t))
+#define SPECTRUM_PACKED_MAX_PAYLOAD (SPECTRUM_PACKED_VFO_SIZE + SPECTRUM_DATA_SIZE + 128)
+#define SPECTRUM_KEY_INTERVAL 25
+#define SPECTRUM_KEY_MARGIN   6         // dB headroom below the minimum of a key frame
+
+typedef struct __attribute__((__packed__)) _spectrum_packed {
+  HEADER header;
+  uint8_t rx;
+  uint8_t flags;
+  uint16_t samples;
+  uint16_t offset;
+  uint16_t meter;
+  uint16_t length;
+  uint8_t payload[SPECTRUM_PACKED_MAX_PAYLOAD];
+} SPECTRUM_PACKED;
+
 typedef struct __attribute__((__packed__)) _audio_data {
   HEADER header;
   uint8_t rx;
@@ -252,6 +343,25 @@ typedef struct __attribute__((__packed__)) _audio_data {
   uint16_t sample[AUDIO_DATA_SIZE * 2];
 } AUDIO_DATA;
 
+//
+// Opus-compressed audio: one 20 msec frame (960 stereo samples at 48 kHz),
+// encoded with in-band forward error correction. The sequence number lets
+// the client detect frames that have been dropped by the server's send queue,
+// and recover them from the FEC data in the next frame or by packet loss
+// concealment.
+//
+#define OPUS_FRAME_SIZE 960
+#define OPUS_DATA_MAX 1276
+#define OPUS_BITRATE 32000
+
+typedef struct __attribute__((__packed__)) _opus_data {
+  HEADER header;
+  uint8_t rx;
+  uint16_t sequence;
+  uint16_t length;
+  uint8_t data[OPUS_DATA_MAX];
+} OPUS_DATA;
+
 typedef struct __attribute__((__packed__)) _spectrum_command {
   HEADER header;
   uint8_t id;
@@ -0,0 +1,138 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Diagnostics menu: shows the performance counters from the metrics
+// registry, refreshed once per second. Counters are shown as rates
+// (per second), gauges with their current and largest value, and
+// histograms with the number of values, average, percentiles and maximum.
+//
+
+#include <gtk/gtk.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "new_menu.h"
+#include "diag_menu.h"
+#include "metrics.h"
+
+static GtkWidget *dialog = NULL;
+static GtkWidget *label;
+static guint diag_timer_id = 0;
+
+static long diag_last[MAX_METRICS];
+static int diag_last_count = 0;
+static gint64 diag_last_time = 0;
+
+static void cleanup() {
+  if (diag_timer_id != 0) {
+    g_source_remove(diag_timer_id);
+    diag_timer_id = 0;
+  }
+
+  if (dialog != NULL) {
+    GtkWidget *tmp = dialog;
+    dialog = NULL;
+    gtk_widget_destroy(tmp);
+    sub_menu = NULL;
+    active_menu  = NO_MENU;
+  }
+}
+
+static gboolean close_cb () {
+  cleanup();
+  return TRUE;
+}
+
+static gboolean diag_update(gpointer data) {
+  gint64 now = g_get_monotonic_time();
+  double secs = diag_last_time > 0 ? (now - diag_last_time) * 1.0E-6 : 0.0;
+  int n = metrics_count();
+  GString *text = g_string_new("<tt>");
+  diag_last_time = now;
+
+  for (int i = 0; i < n; i++) {
+    const METRIC *m = metric_get(i);
+    long value = m->value;
+
+    switch (m->type) {
+    case METRIC_COUNTER:
+      g_string_append_printf(text, "%-32s %12ld  %10.1f/s\n", m->name, value,
+                             secs > 0.0 && i < diag_last_count ? (value - diag_last[i]) / secs : 0.0);
+      break;
+
+    case METRIC_GAUGE:
+      g_string_append_printf(text, "%-32s %12ld  max=%ld\n", m->name, value, m->max);
+      break;
+
+    case METRIC_HISTOGRAM:
+      if (value > 0) {
+        g_string_append_printf(text, "%-32s %12ld  avg=%llu p50&lt;%ld p99&lt;%ld max=%ld\n",
+                               m->name, value, m->sum / value, metric_percentile(m, 0.5),
+                               metric_percentile(m, 0.99), m->max);
+      } else {
+        g_string_append_printf(text, "%-32s %12ld\n", m->name, value);
+      }
+
+      break;
+    }
+
+    diag_last[i] = value;
+  }
+
+  diag_last_count = n;
+
+  if (n == 0) {
+    g_string_append(text, "No performance counters registered");
+  }
+
+  g_string_append(text, "</tt>");
+  gtk_label_set_markup(GTK_LABEL(label), text->str);
+  g_string_free(text, TRUE);
+  return G_SOURCE_CONTINUE;
+}
+
+void diag_menu(GtkWidget *parent) {
+  dialog = gtk_dialog_new();
+  gtk_window_set_transient_for(GTK_WINDOW(dialog), GTK_WINDOW(parent));
+  GtkWidget *headerbar = gtk_header_bar_new();
+  gtk_window_set_titlebar(GTK_WINDOW(dialog), headerbar);
+  gtk_header_bar_set_show_close_button(GTK_HEADER_BAR(headerbar), TRUE);
+  gtk_header_bar_set_title(GTK_HEADER_BAR(headerbar), "piHPSDR - Diagnostics");
+  g_signal_connect (dialog, "delete_event", G_CALLBACK (close_cb), NULL);
+  g_signal_connect (dialog, "destroy", G_CALLBACK (close_cb), NULL);
+  GtkWidget *content = gtk_dialog_get_content_area(GTK_DIALOG(dialog));
+  GtkWidget *grid = gtk_grid_new();
+  gtk_grid_set_column_spacing (GTK_GRID(grid), 4);
+  GtkWidget *close_b = gtk_button_new_with_label("Close");
+  gtk_widget_set_name(close_b, "close_button");
+  g_signal_connect (close_b, "button-press-event", G_CALLBACK(close_cb), NULL);
+  gtk_grid_attach(GTK_GRID(grid), close_b, 0, 0, 1, 1);
+  label = gtk_label_new(NULL);
+  gtk_widget_set_name(label, "small_button");
+  gtk_widget_set_halign(label, GTK_ALIGN_START);
+  GtkWidget *scrolled = gtk_scrolled_window_new(NULL, NULL);
+  gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrolled), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_widget_set_size_request(scrolled, -1, 400);
+  gtk_container_add(GTK_CONTAINER(scrolled), label);
+  gtk_grid_attach(GTK_GRID(grid), scrolled, 0, 1, 4, 1);
+  gtk_container_add(GTK_CONTAINER(content), grid);
+  diag_last_time = 0;
+  diag_update(NULL);
+  diag_timer_id = g_timeout_add(1000, diag_update, NULL);
+  sub_menu = dialog;
+  gtk_widget_show_all(dialog);
+}
@@ -0,0 +1,203 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Unpacking of 24-bit big-endian samples.
+//
+// A sample value is converted to a signed 32-bit integer by putting its
+// three bytes into the upper three bytes of a (little-endian) 32-bit word and
+// doing an arithmetic right shift by 8 bits. Both the conversion to
+// float/double and the multiplication with 1/2^23 are exact, so all kernels
+// produce bit-identical results.
+//
+// On x86_64, an SSSE3 kernel (using the byte shuffle instruction) is used if
+// the CPU supports it. On 64-bit ARM, NEON is always present. Otherwise, the
+// scalar kernel is used. The vector kernels process four sample values per
+// step but load 16 bytes, so they stop when less than 16 bytes are left in
+// the input and leave the rest to the scalar code.
+//
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+  #define IQUNPACK_SSSE3
+#endif
+
+#if defined(__aarch64__)
+  #include <arm_neon.h>
+  #define IQUNPACK_NEON
+#endif
+
+#include "iqunpack.h"
+#include "message.h"
+
+//
+// The "obscure" constant 1.1920928955078125E-7 is 1/(2^23)
+//
+#define IQSCALE 1.1920928955078125E-7
+
+static inline int32_t unpack24(const unsigned char *p) {
+  return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8)) >> 8;
+}
+
+static void unpack24_double_scalar(const unsigned char *src, double *dst, int n) {
+  for (int i = 0; i < n; i++) {
+    dst[i] = (double)unpack24(src) * IQSCALE;
+    src += 3;
+  }
+}
+
+static void unpack24_float_scalar(const unsigned char *src, float *dst, int n) {
+  for (int i = 0; i < n; i++) {
+    dst[i] = (float)unpack24(src) * (float)IQSCALE;
+    src += 3;
+  }
+}
+
+#ifdef IQUNPACK_SSSE3
+//
+// Shuffle mask: the k-th 32-bit lane receives the bytes 3k+2, 3k+1, 3k
+// in its upper three bytes, the lowest byte is zeroed (index with bit 7 set)
+//
+#define SSE_SHUFFLE _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9)
+
+__attribute__((target("ssse3")))
+static void unpack24_double_ssse3(const unsigned char *src, double *dst, int n) {
+  const __m128i shuffle = SSE_SHUFFLE;
+  const __m128d scale = _mm_set1_pd(IQSCALE);
+  int i = 0;
+
+  for (; i + 6 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i *)src);
+    v = _mm_srai_epi32(_mm_shuffle_epi8(v, shuffle), 8);
+    _mm_storeu_pd(dst + i,     _mm_mul_pd(_mm_cvtepi32_pd(v), scale));
+    _mm_storeu_pd(dst + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v)), scale));
+    src += 12;
+  }
+
+  unpack24_double_scalar(src, dst + i, n - i);
+}
+
+__attribute__((target("ssse3")))
+static void unpack24_float_ssse3(const unsigned char *src, float *dst, int n) {
+  const __m128i shuffle = SSE_SHUFFLE;
+  const __m128 scale = _mm_set1_ps((float)IQSCALE);
+  int i = 0;
+
+  for (; i + 6 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i *)src);
+    v = _mm_srai_epi32(_mm_shuffle_epi8(v, shuffle), 8);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    src += 12;
+  }
+
+  unpack24_float_scalar(src, dst + i, n - i);
+}
+#endif
+
+#ifdef IQUNPACK_NEON
+//
+// Same byte shuffle as for SSSE3, out-of-range indices give zero
+//
+static const uint8_t neon_shuffle[16] = {255, 2, 1, 0, 255, 5, 4, 3, 255, 8, 7, 6, 255, 11, 10, 9};
+
+static void unpack24_double_neon(const unsigned char *src, double *dst, int n) {
+  const uint8x16_t shuffle = vld1q_u8(neon_shuffle);
+  int i = 0;
+
+  for (; i + 6 <= n; i += 4) {
+    int32x4_t v = vshrq_n_s32(vreinterpretq_s32_u8(vqtbl1q_u8(vld1q_u8(src), shuffle)), 8);
+    float32x4_t f = vmulq_n_f32(vcvtq_f32_s32(v), (float)IQSCALE);
+    vst1q_f64(dst + i,     vcvt_f64_f32(vget_low_f32(f)));
+    vst1q_f64(dst + i + 2, vcvt_high_f64_f32(f));
+    src += 12;
+  }
+
+  unpack24_double_scalar(src, dst + i, n - i);
+}
+
+static void unpack24_float_neon(const unsigned char *src, float *dst, int n) {
+  const uint8x16_t shuffle = vld1q_u8(neon_shuffle);
+  int i = 0;
+
+  for (; i + 6 <= n; i += 4) {
+    int32x4_t v = vshrq_n_s32(vreinterpretq_s32_u8(vqtbl1q_u8(vld1q_u8(src), shuffle)), 8);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(v), (float)IQSCALE));
+    src += 12;
+  }
+
+  unpack24_float_scalar(src, dst + i, n - i);
+}
+#endif
+
+//
+// The scalar kernels are the default, such that everything works
+// even if iq_unpack_init() has not been called.
+//
+static void (*unpack_double)(const unsigned char *, double *, int) = unpack24_double_scalar;
+static void (*unpack_float)(const unsigned char *, float *, int) = unpack24_float_scalar;
+
+void iq_unpack_init() {
+  const char *kernel = "scalar";
+#ifdef IQUNPACK_SSSE3
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("ssse3")) {
+    unpack_double = unpack24_double_ssse3;
+    unpack_float = unpack24_float_ssse3;
+    kernel = "SSSE3";
+  }
+
+#endif
+#ifdef IQUNPACK_NEON
+  unpack_double = unpack24_double_neon;
+  unpack_float = unpack24_float_neon;
+  kernel = "NEON";
+#endif
+  t_print("%s: using %s kernel\n", __FUNCTION__, kernel);
+}
+
+void iq_unpack24_double(const unsigned char *src, double *dst, int n) {
+  unpack_double(src, dst, n);
+}
+
+void iq_unpack24_float(const unsigned char *src, float *dst, int n) {
+  unpack_float(src, dst, n);
+}
+
+//
+// The receivers of an Ozy frame are interleaved with a small stride, so the
+// samples are converted one by one.
+//
+int ozy_unpack_frame(const unsigned char *frame, int nrx, WDSP_REAL iq[][2 * OZY_MAX_SAMPLES], short *mic) {
+  int stride = 6 * nrx + 2;
+  int iq_samples = (512 - 8) / stride;
+  const unsigned char *p = frame + 8;
+
+  for (int n = 0; n < iq_samples; n++) {
+    for (int r = 0; r < nrx; r++) {
+      iq[r][2 * n    ] = (double)unpack24(p) * IQSCALE;
+      iq[r][2 * n + 1] = (double)unpack24(p + 3) * IQSCALE;
+      p += 6;
+    }
+
+    mic[n] = (short)((p[0] << 8) | p[1]);
+    p += 2;
+  }
+
+  return iq_samples;
+}
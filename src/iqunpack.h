@@ -0,0 +1,53 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Conversion of packed 24-bit big-endian sample values (as they come
+// from the radio in new-protocol DDC packets) to doubles or floats
+// in the range [-1.0, 1.0). The kernel is chosen at run-time according
+// to the capabilities of the CPU.
+//
+
+#ifndef _IQUNPACK_H_
+#define _IQUNPACK_H_
+
+extern void iq_unpack_init(void);
+extern void iq_unpack24_double(const unsigned char *src, double *dst, int n);
+extern void iq_unpack24_float(const unsigned char *src, float *dst, int n);
+
+//
+// Unpacking of a 512-byte old-protocol (Ozy) frame. After three sync and
+// five control bytes, there are groups of (6 * nrx + 2) bytes, each containing
+// one I/Q pair (2*24 bits) per receiver followed by one 16-bit mic sample.
+// The I/Q samples of receiver #r go to iq[r] (interleaved), the mic samples
+// to mic. Returns the number of groups.
+//
+#define OZY_MAX_RX      8                       // the number of receivers is encoded in three bits
+#define OZY_MAX_SAMPLES ((512 - 8) / 8)         // groups in a frame with a single receiver
+
+extern int ozy_unpack_frame(const unsigned char *frame, int nrx, WDSP_REAL iq[][2 * OZY_MAX_SAMPLES], short *mic);
+
+//
+// Unpack directly into WDSP sample buffers (float or double, depending
+// on how WDSP has been compiled)
+//
+#ifdef WDSP_FLOAT
+  #define iq_unpack24_real iq_unpack24_float
+#else
+  #define iq_unpack24_real iq_unpack24_double
+#endif
+
+#endif
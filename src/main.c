@@ -84,15 +84,6 @@ void status_text(const char *text) {
   }
 }
 
-static pthread_t wisdom_thread_id;
-static int wisdom_running = 0;
-
-static void* wisdom_thread(void *arg) {
-  WDSPwisdom ((char *)arg);
-  wisdom_running = 0;
-  return NULL;
-}
-
 gboolean keypress_cb(GtkWidget *widget, GdkEventKey *event, gpointer data) {
   gboolean ret = TRUE;
 
@@ -248,34 +239,23 @@ static int init(void *data) {
   cursor_watch = gdk_cursor_new(GDK_WATCH);
   gdk_window_set_cursor(gtk_widget_get_window(top_window), cursor_watch);
   //
-  // Let WDSP (via FFTW) check for wisdom file in current dir
-  // If there is one, the "wisdom thread" takes no time
-  // Depending on the WDSP version, the file is wdspWisdom or wdspWisdom00.
+  // Let WDSP (via FFTW) import the wisdom file in the current dir.
+  // This does not wait for any planning: FFT sizes for which there
+  // is no wisdom yet are planned in the background (in a separate
+  // process with low priority), and the wisdom file is updated then.
+  // The file name contains a hash of the CPU model and features
+  // (wdspWisdom01-xxxxxxxx, with an "f" appended if WDSP has been compiled
+  // for single precision). If there is no such file, an old wdspWisdom00
+  // file is imported.
   //
   (void) getcwd(wisdom_directory, sizeof(wisdom_directory));
   STRLCAT(wisdom_directory, "/", 1024);
   t_print("Securing wisdom file in directory: %s\n", wisdom_directory);
   status_text("Checking FFTW Wisdom file ...");
-  wisdom_running = 1;
-  pthread_create(&wisdom_thread_id, NULL, wisdom_thread, wisdom_directory);
-
-  while (wisdom_running) {
-    // wait for the wisdom thread to complete, meanwhile
-    // handling any GTK events.
-    usleep(100000); // 100ms
-
-    while (gtk_events_pending ()) {
-      gtk_main_iteration ();
-    }
-
-    char text[1024];
-    snprintf(text, 1024, "Please do not close this window until wisdom plans are completed ...\n\n... %s",
-             wisdom_get_status());
-    status_text(text);
-  }
-
+  WDSPwisdom (wisdom_directory);
+  t_print("%s\n", wisdom_get_status());
   //
-  // When widsom plans are complete, start discovery process
+  // Start discovery process
   //
   g_timeout_add(100, delayed_discovery, NULL);
   return 0;
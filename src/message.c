@@ -27,45 +27,308 @@
  * t_perror
  *           is a perror() replacement, it puts a time stamp in font
  *           and reports via g_print
+ * t_log
+ *           is t_print() with a severity level (T_ERROR, T_WARNING, T_INFO).
+ *           t_print() is t_log(T_INFO, ...), t_perror() reports with T_ERROR.
+ *           Messages with a level above t_log_level are discarded.
  *
- * Note ALL messages of the program should go through these two functions
+ * Note ALL messages of the program should go through these functions
  * so it is easy to either silence them completely, or routing them to
  * a separate window for debugging purposes.
+ *
+ * The calling thread does not write the message. It only formats it into
+ * a ring buffer of its own, from where a background thread takes the
+ * messages of all threads (in the order of their time stamps) and writes
+ * them with g_print(). Since each ring buffer has a single writer (its
+ * thread) and a single reader (the background thread), no locks are
+ * needed, and a burst of messages from a real-time thread does not make
+ * it wait for the output.
+ *
+ * Warnings and errors are rate limited per call site (identified by the
+ * format string): at most LOG_BURST of them are printed per second, and the
+ * number of suppressed messages is reported afterwards. For these messages,
+ * the suppressed ones are not even formatted. If the ring buffer of a thread
+ * is full, warnings and errors are dropped (and counted), while for ordinary
+ * messages the calling thread writes out the pending messages itself.
  */
 
 #include <gdk/gdk.h>
 #include <stdarg.h>
 #include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
 
-void t_print(const gchar *format, ...) {
-  va_list(args);
-  va_start(args, format);
+#include "message.h"
+
+int t_log_level = T_INFO;
+
+#define LOG_SLOTS 32             // messages per ring buffer (power of two)
+#define LOG_LINE  1024           // max. length of a message
+#define LOG_SITES 256            // size of the call site table (power of two)
+#define LOG_BURST 10             // max. warnings/errors per second and call site
+
+typedef struct _log_msg {
+  double time;
+  char line[LOG_LINE];
+} LOG_MSG;
+
+typedef struct _log_ring {
+  LOG_MSG msg[LOG_SLOTS];
+  unsigned int head;             // only written by the owning thread
+  unsigned int tail;             // only written by the drain thread
+  unsigned int lost;             // messages dropped since the ring buffer was full
+  int owned;                     // ring buffer is in use by a thread
+  struct _log_ring *next;
+} LOG_RING;
+
+typedef struct _log_site {
+  const void *key;               // format string
+  int second;                    // current one-second interval
+  int count;                     // messages in this interval
+  int suppressed;                // suppressed messages not yet reported
+} LOG_SITE;
+
+static double starttime;
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+static pthread_key_t log_key;
+static pthread_mutex_t log_rings_mutex = PTHREAD_MUTEX_INITIALIZER;  // only for attaching a thread
+static pthread_mutex_t log_drain_mutex = PTHREAD_MUTEX_INITIALIZER;  // only one reader at a time
+static LOG_RING *log_rings = NULL;                                   // list of all ring buffers
+static __thread LOG_RING *log_my_ring = NULL;
+static LOG_SITE log_sites[LOG_SITES];
+
+static double log_now() {
   struct timespec ts;
-  double now;
-  static double starttime;
-  static int first = 1;
-  char line[1024];
   clock_gettime(CLOCK_MONOTONIC, &ts);
-  now = ts.tv_sec + 1E-9 * ts.tv_nsec;
+  return ts.tv_sec + 1E-9 * ts.tv_nsec;
+}
+
+//
+// Write all messages that are in the ring buffers, and report lost
+// or suppressed messages.
+//
+static void log_drain() {
+  static GString *out = NULL;
+  LOG_RING *r;
+  double now = log_now();
+  pthread_mutex_lock(&log_drain_mutex);
+
+  if (out == NULL) { out = g_string_sized_new(8192); }
+
+  for (;;) {
+    LOG_RING *first = NULL;
+
+    for (r = __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next) {
+      unsigned int tail = r->tail;
+
+      if (tail == __atomic_load_n(&r->head, __ATOMIC_ACQUIRE)) { continue; }
 
-  if (first) {
-    first = 0;
-    starttime = now;
+      if (first == NULL || r->msg[tail % LOG_SLOTS].time < first->msg[first->tail % LOG_SLOTS].time) { first = r; }
+    }
+
+    if (first == NULL) { break; }
+
+    const LOG_MSG *m = &first->msg[first->tail % LOG_SLOTS];
+    double t = m->time - starttime;
+
+    //
+    // After 11 days, the time reaches 999999.999 so we simply wrap around
+    //
+    while (t >= 999999.995) { t -= 1000000.0; }
+
+    g_string_append_printf(out, "%10.3f %s", t, m->line);
+    __atomic_store_n(&first->tail, first->tail + 1, __ATOMIC_RELEASE);
+
+    if (out->len > 4096) {
+      g_print("%s", out->str);
+      g_string_truncate(out, 0);
+    }
   }
 
-  //
-  // After 11 days, the time reaches 999999.999 so we simply wrap around
-  //
-  if (now - starttime >= 999999.995) { starttime += 1000000.0; }
+  for (r = __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next) {
+    unsigned int lost = __atomic_exchange_n(&r->lost, 0, __ATOMIC_RELAXED);
 
-  //
-  // We have to use vsnprintf to handle the varargs stuff
-  // g_print() seems to be thread-safe but call it only ONCE.
-  //
-  vsnprintf(line, 1024, format, args);
-  g_print("%10.3f %s", now - starttime, line);
+    if (lost > 0) {
+      g_string_append_printf(out, "%10.3f %s: %u messages lost\n", now - starttime, __FUNCTION__, lost);
+    }
+  }
+
+  for (int i = 0; i < LOG_SITES; i++) {
+    LOG_SITE *s = &log_sites[i];
+
+    if (__atomic_load_n(&s->suppressed, __ATOMIC_RELAXED) > 0 &&
+        __atomic_load_n(&s->second, __ATOMIC_RELAXED) != (int) now) {
+      int n = __atomic_exchange_n(&s->suppressed, 0, __ATOMIC_RELAXED);
+      const char *key = s->key;
+      g_string_append_printf(out, "%10.3f %s: %d more messages like: %.*s\n", now - starttime, __FUNCTION__, n,
+                             (int) strcspn(key, "\n"), key);
+    }
+  }
+
+  if (out->len > 0) {
+    g_print("%s", out->str);
+    g_string_truncate(out, 0);
+  }
+
+  pthread_mutex_unlock(&log_drain_mutex);
+}
+
+static gpointer log_drain_thread(gpointer data) {
+  for (;;) {
+    log_drain();
+    usleep(10000);
+  }
+
+  return NULL;
+}
+
+//
+// Called when a thread terminates: its ring buffer can be re-used
+// by another thread (the drain thread still empties it).
+//
+static void log_release(void *data) {
+  LOG_RING *r = (LOG_RING *) data;
+  __atomic_store_n(&r->owned, 0, __ATOMIC_RELEASE);
+}
+
+static void log_init() {
+  starttime = log_now();
+  pthread_key_create(&log_key, log_release);
+  atexit(log_drain);
+  g_thread_new("log drain", log_drain_thread, NULL);
+}
+
+static LOG_RING *log_ring() {
+  LOG_RING *r;
+
+  if (log_my_ring != NULL) { return log_my_ring; }
+
+  pthread_mutex_lock(&log_rings_mutex);
+
+  for (r = log_rings; r != NULL; r = r->next) {
+    if (!__atomic_load_n(&r->owned, __ATOMIC_ACQUIRE)) { break; }
+  }
+
+  if (r == NULL) {
+    r = calloc(1, sizeof(LOG_RING));
+
+    if (r != NULL) {
+      r->next = log_rings;
+      __atomic_store_n(&log_rings, r, __ATOMIC_RELEASE);
+    }
+  }
+
+  if (r != NULL) {
+    r->owned = 1;
+    pthread_setspecific(log_key, r);
+    log_my_ring = r;
+  }
+
+  pthread_mutex_unlock(&log_rings_mutex);
+  return r;
+}
+
+//
+// Returns TRUE if the message is to be suppressed
+//
+static int log_rate_limit(const void *key, double now) {
+  unsigned int h = (unsigned int)(((uintptr_t) key >> 3) * 2654435761U);
+  int second = (int) now;
+
+  for (int i = 0; i < 8; i++) {
+    LOG_SITE *s = &log_sites[(h + i) & (LOG_SITES - 1)];
+    const void *k = __atomic_load_n(&s->key, __ATOMIC_ACQUIRE);
+
+    if (k == NULL) {
+      if (!__atomic_compare_exchange_n(&s->key, &k, key, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) && k != key) {
+        continue;
+      }
+
+      k = key;
+    }
+
+    if (k != key) { continue; }
+
+    int old = __atomic_load_n(&s->second, __ATOMIC_RELAXED);
+
+    if (old != second && __atomic_compare_exchange_n(&s->second, &old, second, 0, __ATOMIC_RELAXED,
+        __ATOMIC_RELAXED)) {
+      __atomic_store_n(&s->count, 0, __ATOMIC_RELAXED);
+    }
+
+    if (__atomic_fetch_add(&s->count, 1, __ATOMIC_RELAXED) < LOG_BURST) { return 0; }
+
+    __atomic_fetch_add(&s->suppressed, 1, __ATOMIC_RELAXED);
+    return 1;
+  }
+
+  return 0; // call site table full: no rate limit
+}
+
+static void log_vwrite(int level, const void *key, const gchar *format, va_list args) {
+  if (level > t_log_level) { return; }
+
+  pthread_once(&log_once, log_init);
+  double now = log_now();
+
+  if (level <= T_WARNING && log_rate_limit(key, now)) { return; }
+
+  LOG_RING *r = log_ring();
+
+  if (r == NULL) {
+    char line[LOG_LINE];
+    vsnprintf(line, LOG_LINE, format, args);
+    g_print("%10.3f %s", now - starttime, line);
+    return;
+  }
+
+  unsigned int head = r->head;
+
+  while (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) >= LOG_SLOTS) {
+    if (level <= T_WARNING) {
+      __atomic_fetch_add(&r->lost, 1, __ATOMIC_RELAXED);
+      return;
+    }
+
+    //
+    // Write the pending messages in this thread, then we are
+    // not worse off than with synchronous output
+    //
+    log_drain();
+  }
+
+  LOG_MSG *m = &r->msg[head % LOG_SLOTS];
+  m->time = now;
+  vsnprintf(m->line, LOG_LINE, format, args);
+  __atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void t_log(int level, const gchar *format, ...) {
+  va_list(args);
+  va_start(args, format);
+  log_vwrite(level, format, format, args);
+  va_end(args);
+}
+
+void t_print(const gchar *format, ...) {
+  va_list(args);
+  va_start(args, format);
+  log_vwrite(T_INFO, format, format, args);
+  va_end(args);
+}
+
+static void log_write(int level, const void *key, const gchar *format, ...) {
+  va_list(args);
+  va_start(args, format);
+  log_vwrite(level, key, format, args);
+  va_end(args);
 }
 
 void t_perror(const gchar *string) {
-  t_print("%s: %s\n", string, strerror(errno));
+  //
+  // rate limit per caller, not for all callers of t_perror
+  //
+  log_write(T_ERROR, string, "%s: %s\n", string, strerror(errno));
 }
@@ -20,7 +20,22 @@
  * Header file to use t_print()
  */
 
+#ifndef _MESSAGE_H_
+#define _MESSAGE_H_
+
 #include <gdk/gdk.h>
 
+//
+// severity levels for t_log()
+//
+#define T_ERROR   0
+#define T_WARNING 1
+#define T_INFO    2
+
+extern int t_log_level;
+
 extern void t_print(const gchar *format, ...);
 extern void t_perror(const gchar *string);
+extern void t_log(int level, const gchar *format, ...);
+
+#endif
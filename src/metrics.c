@@ -0,0 +1,300 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#include <glib.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "metrics.h"
+#include "message.h"
+
+#define METRICS_SOCKET "pihpsdr.metrics"
+#define METRICS_SEND_TIMEOUT 500        // msec a client may take to read the output
+
+//
+// Metrics are never removed, so a pointer obtained once stays valid.
+// n_metrics is only increased after the new entry has been filled in.
+//
+static METRIC metrics[MAX_METRICS];
+static int n_metrics = 0;
+static GMutex metrics_mutex;     // only for creating metrics
+static GThread *metrics_server_thread_id = NULL;
+
+static METRIC *metric_new(int type, const char *format, va_list args) {
+  char name[48];
+  METRIC *m = NULL;
+  vsnprintf(name, sizeof(name), format, args);
+  g_mutex_lock(&metrics_mutex);
+
+  for (int i = 0; i < n_metrics; i++) {
+    if (strcmp(metrics[i].name, name) == 0) {
+      m = &metrics[i];
+      break;
+    }
+  }
+
+  if (m != NULL) {
+    if (m->type != type) {
+      t_print("%s: metric %s exists with a different type\n", __FUNCTION__, name);
+      m = NULL;
+    }
+  } else if (n_metrics < MAX_METRICS) {
+    m = &metrics[n_metrics];
+    memset(m, 0, sizeof(METRIC));
+    g_strlcpy(m->name, name, sizeof(m->name));
+    m->type = type;
+    __atomic_store_n(&n_metrics, n_metrics + 1, __ATOMIC_RELEASE);
+  } else {
+    t_print("%s: too many metrics, %s not created\n", __FUNCTION__, name);
+  }
+
+  g_mutex_unlock(&metrics_mutex);
+  return m;
+}
+
+METRIC *metric_counter(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  METRIC *m = metric_new(METRIC_COUNTER, format, args);
+  va_end(args);
+  return m;
+}
+
+METRIC *metric_gauge(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  METRIC *m = metric_new(METRIC_GAUGE, format, args);
+  va_end(args);
+  return m;
+}
+
+METRIC *metric_histogram(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  METRIC *m = metric_new(METRIC_HISTOGRAM, format, args);
+  va_end(args);
+  return m;
+}
+
+static void metric_max(METRIC *m, long v) {
+  long old = __atomic_load_n(&m->max, __ATOMIC_RELAXED);
+
+  while (v > old && !__atomic_compare_exchange_n(&m->max, &old, v, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+}
+
+void metric_add(METRIC *m, long n) {
+  if (m == NULL) { return; }
+
+  __atomic_fetch_add(&m->value, n, __ATOMIC_RELAXED);
+}
+
+void metric_set(METRIC *m, long v) {
+  if (m == NULL) { return; }
+
+  __atomic_store_n(&m->value, v, __ATOMIC_RELAXED);
+  metric_max(m, v);
+}
+
+void metric_observe(METRIC *m, long v) {
+  if (m == NULL) { return; }
+
+  if (v < 0) { v = 0; }
+
+  int i = v < 2 ? 0 : 8 * (int) sizeof(long) - 1 - __builtin_clzl((unsigned long) v);
+
+  if (i >= METRIC_BUCKETS) { i = METRIC_BUCKETS - 1; }
+
+  __atomic_fetch_add(&m->bucket[i], 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&m->sum, (unsigned long long) v, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&m->value, 1, __ATOMIC_RELAXED);
+  metric_max(m, v);
+}
+
+int metrics_count() {
+  return __atomic_load_n(&n_metrics, __ATOMIC_ACQUIRE);
+}
+
+METRIC *metric_get(int i) {
+  return (i >= 0 && i < metrics_count()) ? &metrics[i] : NULL;
+}
+
+//
+// Upper bound for the value below which a fraction p of all values are
+//
+long metric_percentile(const METRIC *m, double p) {
+  long n = 0;
+
+  for (int i = 0; i < METRIC_BUCKETS - 1; i++) {
+    n += m->bucket[i];
+
+    if (n > 0 && n >= p * m->value) { return 2L << i; }
+  }
+
+  return m->max;
+}
+
+//
+// Prometheus text exposition format
+//
+void metrics_format(GString *out) {
+  int n = metrics_count();
+
+  for (int i = 0; i < n; i++) {
+    const METRIC *m = &metrics[i];
+
+    switch (m->type) {
+    case METRIC_COUNTER:
+      g_string_append_printf(out, "# TYPE pihpsdr_%s counter\npihpsdr_%s %ld\n", m->name, m->name, m->value);
+      break;
+
+    case METRIC_GAUGE:
+      g_string_append_printf(out, "# TYPE pihpsdr_%s gauge\npihpsdr_%s %ld\n", m->name, m->name, m->value);
+      g_string_append_printf(out, "# TYPE pihpsdr_%s_max gauge\npihpsdr_%s_max %ld\n", m->name, m->name, m->max);
+      break;
+
+    case METRIC_HISTOGRAM: {
+      long count = 0;
+      g_string_append_printf(out, "# TYPE pihpsdr_%s histogram\n", m->name);
+
+      for (int b = 0; b < METRIC_BUCKETS - 1; b++) {
+        count += m->bucket[b];
+        g_string_append_printf(out, "pihpsdr_%s_bucket{le=\"%ld\"} %ld\n", m->name, (2L << b) - 1, count);
+      }
+
+      g_string_append_printf(out, "pihpsdr_%s_bucket{le=\"+Inf\"} %ld\n", m->name, m->value);
+      g_string_append_printf(out, "pihpsdr_%s_sum %llu\npihpsdr_%s_count %ld\n", m->name, m->sum, m->name, m->value);
+    }
+    break;
+    }
+  }
+}
+
+static void metrics_serve(int fd) {
+  char request[256];
+  struct pollfd pfd;
+  int http = 0;
+  //
+  // Look whether there is a HTTP request, but do not wait long
+  // for it since a plain connection sends nothing
+  //
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+
+  if (poll(&pfd, 1, 100) > 0) {
+    int n = recv(fd, request, sizeof(request) - 1, 0);
+
+    if (n > 0) {
+      request[n] = 0;
+      http = (strncmp(request, "GET ", 4) == 0);
+    }
+  }
+
+  GString *out = g_string_sized_new(16384);
+
+  if (http) {
+    g_string_append(out, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n\r\n");
+  }
+
+  metrics_format(out);
+  const char *p = out->str;
+  size_t len = out->len;
+  //
+  // All clients are served by a single thread, so the socket is written
+  // without blocking, and a client that has not taken the data after
+  // METRICS_SEND_TIMEOUT is dropped. Thus a slow scraper cannot hold up
+  // the others.
+  //
+#ifdef MSG_NOSIGNAL
+  int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+  int flags = MSG_DONTWAIT;
+#endif
+  gint64 deadline = g_get_monotonic_time() + 1000 * METRICS_SEND_TIMEOUT;
+
+  while (len > 0) {
+    ssize_t rc = send(fd, p, len, flags);
+
+    if (rc > 0) {
+      p += rc;
+      len -= rc;
+      continue;
+    }
+
+    if (rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      int wait = (int)((deadline - g_get_monotonic_time()) / 1000);
+      pfd.events = POLLOUT;
+
+      if (wait > 0 && poll(&pfd, 1, wait) >= 0) { continue; }
+    }
+
+    t_print("%s: client dropped, %ld bytes not sent\n", __FUNCTION__, (long) len);
+    break;
+  }
+
+  g_string_free(out, TRUE);
+}
+
+static gpointer metrics_server_thread(gpointer data) {
+  int server = GPOINTER_TO_INT(data);
+
+  for (;;) {
+    int fd = accept(server, NULL, NULL);
+
+    if (fd < 0) {
+      t_perror("metrics_server: accept");
+      usleep(100000);
+      continue;
+    }
+
+    metrics_serve(fd);
+    close(fd);
+  }
+
+  return NULL;
+}
+
+void metrics_server_start() {
+  struct sockaddr_un addr;
+
+  if (metrics_server_thread_id != NULL) { return; }
+
+  int server = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if (server < 0) {
+    t_perror("metrics_server: socket");
+    return;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  g_strlcpy(addr.sun_path, METRICS_SOCKET, sizeof(addr.sun_path));
+  unlink(METRICS_SOCKET);
+
+  if (bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(server, 4) < 0) {
+    t_perror("metrics_server: bind/listen");
+    close(server);
+    return;
+  }
+
+  t_print("%s: metrics available on Unix socket %s\n", __FUNCTION__, METRICS_SOCKET);
+  metrics_server_thread_id = g_thread_new("metrics server", metrics_server_thread, GINT_TO_POINTER(server));
+}
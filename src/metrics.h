@@ -0,0 +1,75 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Central registry of performance counters, gauges and histograms.
+//
+// A metric is created (or looked up, if it already exists) by name, the
+// name may contain printf-style formatting. Updating a metric is lock-free
+// and may be done from any thread, so it is cheap enough for the real-time
+// paths. All update functions accept a NULL pointer (if the registry is
+// full) and then do nothing.
+//
+// Counters only increase, gauges hold a current value (and remember the
+// largest value seen), histograms count values (e.g. latencies in usec)
+// in buckets whose limits are powers of two.
+//
+// The metrics can be read through a Unix domain socket named
+// "pihpsdr.metrics" in the working directory, which accepts either a
+// plain connection or a HTTP GET request, e.g.
+//
+//   socat - UNIX-CONNECT:pihpsdr.metrics
+//   curl --unix-socket pihpsdr.metrics http://localhost/metrics
+//
+// and returns them in the Prometheus text format.
+//
+
+#ifndef _METRICS_H_
+#define _METRICS_H_
+
+#include <glib.h>
+
+#define METRIC_COUNTER   0
+#define METRIC_GAUGE     1
+#define METRIC_HISTOGRAM 2
+
+#define METRIC_BUCKETS   24      // bucket i counts values below 2^(i+1), the last one all others
+#define MAX_METRICS      256
+
+typedef struct _metric {
+  char               name[48];
+  int                type;
+  long               value;      // counter, gauge: value; histogram: number of values
+  long               max;        // gauge, histogram: largest value seen
+  unsigned long long sum;        // histogram: sum of all values
+  long               bucket[METRIC_BUCKETS];
+} METRIC;
+
+extern METRIC *metric_counter(const char *format, ...);
+extern METRIC *metric_gauge(const char *format, ...);
+extern METRIC *metric_histogram(const char *format, ...);
+
+extern void metric_add(METRIC *m, long n);
+extern void metric_set(METRIC *m, long v);
+extern void metric_observe(METRIC *m, long v);
+
+extern int     metrics_count(void);
+extern METRIC *metric_get(int i);
+extern long    metric_percentile(const METRIC *m, double p);
+extern void    metrics_format(GString *out);
+extern void    metrics_server_start(void);
+
+#endif
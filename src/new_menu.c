@@ -24,6 +24,7 @@
 #include "audio.h"
 #include "new_menu.h"
 #include "about_menu.h"
+#include "diag_menu.h"
 #include "exit_menu.h"
 #include "radio_menu.h"
 #include "rx_menu.h"
@@ -138,6 +139,12 @@ static gboolean about_cb (GtkWidget *widget, GdkEventButton *event, gpointer dat
   return TRUE;
 }
 
+static gboolean diag_cb (GtkWidget *widget, GdkEventButton *event, gpointer data) {
+  cleanup();
+  diag_menu(top_window);
+  return TRUE;
+}
+
 static gboolean exit_cb (GtkWidget *widget, GdkEventButton *event, gpointer data) {
   cleanup();
   exit_menu(top_window);
@@ -703,11 +710,14 @@ void new_menu() {
     gtk_grid_attach(GTK_GRID(grid), BotSeparator, 0, row, 6, 1);
     row++;
     //
-    // Last row: About and Iconify Button
+    // Last row: About, Diagnostics and Iconify Button
     //
     GtkWidget *about_b = gtk_button_new_with_label("About");
     g_signal_connect (about_b, "button-press-event", G_CALLBACK(about_cb), NULL);
     gtk_grid_attach(GTK_GRID(grid), about_b, 0, row, 2, 1);
+    GtkWidget *diag_b = gtk_button_new_with_label("Diagnostics");
+    g_signal_connect (diag_b, "button-press-event", G_CALLBACK(diag_cb), NULL);
+    gtk_grid_attach(GTK_GRID(grid), diag_b, 2, row, 2, 1);
     GtkWidget *minimize_b = gtk_button_new_with_label("Iconify");
     g_signal_connect (minimize_b, "button-press-event", G_CALLBACK(minimize_cb), NULL);
     gtk_grid_attach(GTK_GRID(grid), minimize_b, 4, row, 2, 1);
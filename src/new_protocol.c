@@ -56,7 +56,10 @@
 #include "vox.h"
 #include "ext.h"
 #include "iambic.h"
+#include "iqunpack.h"
 #include "message.h"
+#include "metrics.h"
+#include "udprecv.h"
 #ifdef SATURN
   #include "saturnmain.h"
 #endif
@@ -75,6 +78,8 @@
 #define RXACTION_PS     2    // deliver 2*119 samples to PS engine
 #define RXACTION_DIV    3    // take 2*119 samples, mix them, deliver to a receiver
 
+#define IQ_MAX_SAMPLES  238  // max. number of (I/Q) samples in a DDC packet
+
 static int rxcase[MAX_DDC];
 static int rxid[MAX_DDC];
 
@@ -196,23 +201,178 @@ static pthread_mutex_t send_rxaudio_mutex   = PTHREAD_MUTEX_INITIALIZER;
 // at a very high rate, we do it the "pedestrian" way, which may
 // alleviate the system load a little.
 //
-// Therefore we allocate a pool of network buffers *once*, make
-// them a linked list, and simply maintain a "free" flag.
+// Therefore we allocate a pool of network buffers *once*. The free
+// buffers are kept in a lock-free singly-linked list (a stack), such
+// that getting and releasing a buffer is O(1).
+//
+// Buffers are released from many threads (iq_thread, mic_line_thread,
+// high_priority_thread, ...), but each pool is only used by ONE thread
+// for getting buffers (e.g. new_protocol_thread). With a single thread
+// popping from the stack, the "ABA problem" of lock-free stacks cannot
+// occur: the head can only change by a release in between.
+//
+// If the pool is exhausted, get_my_buffer() returns NULL and the
+// caller has to drop the data.
 //
-// This ONLY applies to the network buffers filled with data in
-// new_protocol_thread(), so this need not be thread-safe.
+// When the protocol is re-started, buffers still queued for processing
+// are discarded by incrementing the "epoch" of the pool: buffers obtained
+// in an earlier epoch are "stale", and simply released by the threads
+// processing them.
 //
 ////////////////////////////////////////////////////////////////////////////
 
+struct mybuffer_pool_ {
+  //
+  // These are modified by all threads releasing buffers
+  //
+  mybuffer *volatile head __attribute__((aligned(64)));
+  int               in_use;
+  //
+  // These are only modified by the thread obtaining buffers
+  //
+  int               epoch __attribute__((aligned(64)));
+  int               high_water;
+  long              exhausted;
+  int               warned;
+  int               size;
+  const char        *name;
+  mybuffer          *buffers;
+};
+
+mybuffer_pool *create_buffer_pool(const char *name, int size) {
+  mybuffer_pool *pool;
+  void *mem;
+
+  if (posix_memalign(&mem, 64, sizeof(mybuffer_pool)) != 0) {
+    t_print("%s: could not allocate pool %s\n", __FUNCTION__, name);
+    exit(-1);
+  }
+
+  pool = mem;
+  memset(pool, 0, sizeof(mybuffer_pool));
+
+  if (posix_memalign(&mem, 64, size * sizeof(mybuffer)) != 0) {
+    t_print("%s: could not allocate %d buffers for pool %s\n", __FUNCTION__, size, name);
+    exit(-1);
+  }
+
+  pool->buffers = mem;
+  pool->size = size;
+  pool->name = name;
+
+  for (int i = size - 1; i >= 0; i--) {
+    mybuffer *bp = &pool->buffers[i];
+    bp->pool = pool;
+    bp->epoch = 0;
+    bp->next = pool->head;
+    pool->head = bp;
+  }
+
+  t_print("%s: %s: %d buffers\n", __FUNCTION__, name, size);
+  return pool;
+}
+
+//
+// Obtain a free buffer. This must only be called from one thread per pool.
+//
+mybuffer *get_my_buffer(mybuffer_pool *pool) {
+  mybuffer *bp = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+
+  while (bp) {
+    mybuffer *next = bp->next;
+
+    if (__atomic_compare_exchange_n(&pool->head, &bp, next, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+      break;
+    }
+  }
+
+  if (bp == NULL) {
+    pool->exhausted++;
+
+    if (!pool->warned) {
+      t_print("%s: buffer pool %s exhausted.\n", __FUNCTION__, pool->name);
+      pool->warned = 1;
+    }
+
+    return NULL;
+  }
+
+  int used = __atomic_add_fetch(&pool->in_use, 1, __ATOMIC_RELAXED);
+
+  if (used > pool->high_water) { pool->high_water = used; }
+
+  pool->warned = 0;
+  bp->epoch = pool->epoch;
+  return bp;
+}
+
+//
+// Release a buffer. This can be called from any thread.
+//
+void release_my_buffer(mybuffer *mybuf) {
+  mybuffer_pool *pool = mybuf->pool;
+  mybuffer *head = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+
+  do {
+    mybuf->next = head;
+  } while (!__atomic_compare_exchange_n(&pool->head, &head, mybuf, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+  __atomic_sub_fetch(&pool->in_use, 1, __ATOMIC_RELAXED);
+}
+
+int is_stale_buffer(const mybuffer *mybuf) {
+  return mybuf->epoch != __atomic_load_n(&mybuf->pool->epoch, __ATOMIC_RELAXED);
+}
+
+void discard_pool_buffers(mybuffer_pool *pool) {
+  __atomic_add_fetch(&pool->epoch, 1, __ATOMIC_RELAXED);
+}
+
+void buffer_pool_statistics(const mybuffer_pool *pool, int *size, int *in_use, int *high_water,
+                            long *exhausted) {
+  *size = pool->size;
+  *in_use = __atomic_load_n(&pool->in_use, __ATOMIC_RELAXED);
+  *high_water = pool->high_water;
+  *exhausted = pool->exhausted;
+}
+
 //
-// number of buffers allocated (for statistics)
+// The pool for new_protocol_thread. This is enough for
+// about 40 msec of data with four DDCs at 1536 kHz.
 //
-static int num_buf = 0;
+#define NP_POOL_SIZE 1024
+static mybuffer_pool *np_pool = NULL;
 
 //
-// head of buffer list
+// Optionally (radio property "radio.p2_direct_sockets"), there is one
+// extra socket for each DDC, and for the HighPrio and Mic packets. These
+// are bound to the same local port as data_socket (SO_REUSEPORT) and
+// connected to the corresponding port of the radio, such that the kernel
+// delivers the packets from that radio port there instead of data_socket.
+// They are read directly by the iq_thread, high_priority_thread and
+// mic_line_thread, so these packets need not pass new_protocol_thread.
 //
-static mybuffer *buflist = NULL;
+int p2_direct_sockets = 0;
+static int ddc_socket[MAX_DDC] = { -1, -1, -1, -1 };
+static int hp_socket = -1;
+static int mic_socket = -1;
+
+//
+// The socket each of these threads is currently reading (or about to read),
+// -1 if none. This is written only by the thread itself, and tells
+// close_direct_sockets() when the thread has left a socket.
+//
+static int ddc_reading[MAX_DDC] = { -1, -1, -1, -1 };
+static int hp_reading = -1;
+static int mic_reading = -1;
+
+//
+// Batched receive in new_protocol_thread. The maximum number of
+// packets per system call can be set with the radio property
+// "radio.p2_recv_batch".
+//
+int p2_recv_batch = 16;
+static UDP_RECV np_recv;
 
 //
 // The buffers used by new_protocol_thread
@@ -231,6 +391,17 @@ static volatile int mic_inptr = 0;
 static volatile int mic_outptr = 0;
 static volatile int mic_count = 0;
 
+//
+// Performance counters, registered in new_protocol_init()
+//
+static METRIC *ddc_packets[MAX_DDC];
+static METRIC *ddc_gaps[MAX_DDC];
+static METRIC *ddc_ring[MAX_DDC];
+static METRIC *ddc_overflows[MAX_DDC];
+static METRIC *mic_ring, *mic_overflows;
+static METRIC *rxaudio_ring, *rxaudio_overflows;
+static METRIC *txiq_ring, *txiq_overflows;
+
 static unsigned char general_buffer[60];
 static unsigned char high_priority_buffer_to_radio[1444];
 static unsigned char transmit_specific_buffer[60];
@@ -268,48 +439,9 @@ static gpointer iq_thread(gpointer data);
 static void  process_iq_data(unsigned char *buffer, RECEIVER *rx);
 static void  process_ps_iq_data(unsigned char *buffer);
 static void process_div_iq_data(unsigned char *buffer);
-static void  process_high_priority(void);
+static void  process_high_priority(const unsigned char *buffer);
 static void  process_mic_data(const unsigned char *buffer);
 
-//
-// Obtain a free buffer. If no one is available allocate
-// 5 new ones. Note these buffer "live" as long as the
-// program lives. They are never released. Measurements show
-// that in typical runs, only a handful of buffers is ever
-// allocated.
-//
-static mybuffer *get_my_buffer() {
-  int i;
-  mybuffer *bp = buflist;
-
-  while (bp) {
-    if (bp->free) {
-      // found free buffer. Mark as used and return that one.
-      bp->free = 0;
-      return bp;
-    }
-
-    bp = bp->next;
-  }
-
-  //
-  // no free buffer found, allocate some extra ones
-  // and add to the head of the list
-  //
-  for (i = 0; i < 25; i++) {
-    bp = malloc(sizeof(mybuffer));
-    bp->free = 1;
-    bp->next = buflist;
-    buflist = bp;
-    num_buf++;
-  }
-
-  t_print("NewProtocol: number of buffers increased to %d\n", num_buf);
-  // Mark the first buffer in list as used and return that one.
-  buflist->free = 0;
-  return buflist;
-}
-
 void schedule_high_priority() {
   if (protocol == NEW_PROTOCOL) {
     new_protocol_high_priority();
@@ -432,6 +564,162 @@ void update_action_table() {
   }
 }
 
+//
+// Open a socket that shares the local address with data_socket
+// and only receives packets from the given port of the radio.
+//
+static int open_direct_socket(int port) {
+  struct sockaddr_in local, remote;
+  socklen_t len = sizeof(local);
+  int optval = 1;
+  int fd = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+  if (fd < 0) {
+    t_perror("open_direct_socket: socket");
+    return -1;
+  }
+
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+  setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof(optval));
+  optval = 0x40000;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &optval, sizeof(optval));
+
+  if (getsockname(data_socket, (struct sockaddr *)&local, &len) < 0) {
+    t_perror("open_direct_socket: getsockname");
+    close(fd);
+    return -1;
+  }
+
+  if (bind(fd, (struct sockaddr *)&local, len) < 0) {
+    t_perror("open_direct_socket: bind");
+    close(fd);
+    return -1;
+  }
+
+  memcpy(&remote, &radio->info.network.address, radio->info.network.address_length);
+  remote.sin_port = htons(port);
+
+  if (connect(fd, (struct sockaddr *)&remote, radio->info.network.address_length) < 0) {
+    t_perror("open_direct_socket: connect");
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+//
+// Open the direct sockets and wake up the threads waiting
+// on the semaphores, such that they switch to the sockets.
+// If a socket cannot be opened, that data goes through
+// new_protocol_thread as usual.
+//
+static void open_direct_sockets() {
+  for (int i = 0; i < MAX_DDC; i++) {
+    if (ddc_socket[i] < 0) {
+      ddc_socket[i] = open_direct_socket(RX_IQ_TO_HOST_PORT_0 + i);
+
+      if (ddc_socket[i] >= 0) {
+#ifdef __APPLE__
+        sem_post(iq_sem[i]);
+#else
+        sem_post(&iq_sem[i]);
+#endif
+      }
+    }
+  }
+
+  if (hp_socket < 0) {
+    hp_socket = open_direct_socket(HIGH_PRIORITY_TO_HOST_PORT);
+
+    if (hp_socket >= 0) {
+#ifdef __APPLE__
+      sem_post(high_priority_sem_buffer);
+#else
+      sem_post(&high_priority_sem_buffer);
+#endif
+    }
+  }
+
+  if (mic_socket < 0) {
+    mic_socket = open_direct_socket(MIC_LINE_TO_HOST_PORT);
+
+    if (mic_socket >= 0) {
+#ifdef __APPLE__
+      sem_post(mic_line_sem);
+#else
+      sem_post(&mic_line_sem);
+#endif
+    }
+  }
+
+  t_print("%s: DDC0=%d DDC1=%d DDC2=%d DDC3=%d HP=%d MIC=%d\n", __FUNCTION__,
+          ddc_socket[0], ddc_socket[1], ddc_socket[2], ddc_socket[3], hp_socket, mic_socket);
+}
+
+//
+// Called by a reader thread before each recv() on a direct socket.
+// Returns the socket to read from, or -1 if there is none (any more).
+//
+// The thread first announces the socket it is going to read, and then
+// checks that it is still there. close_direct_sockets() does it the other
+// way round: it first removes the socket, and then looks whether a thread
+// has announced it. With sequentially consistent atomics, at least one
+// side sees the write of the other, so either the thread does not use the
+// socket, or close_direct_sockets() waits until the thread has left it.
+//
+static int enter_direct_socket(int *sock, int *reading) {
+  int fd = __atomic_load_n(sock, __ATOMIC_SEQ_CST);
+  __atomic_store_n(reading, fd, __ATOMIC_SEQ_CST);
+
+  if (fd >= 0 && __atomic_load_n(sock, __ATOMIC_SEQ_CST) != fd) {
+    fd = -1;
+    __atomic_store_n(reading, fd, __ATOMIC_SEQ_CST);
+  }
+
+  return fd;
+}
+
+//
+// Close the direct sockets when the protocol is stopped. The shutdown()
+// wakes up a thread blocking in recv() (and makes further recv() calls on
+// that socket return at once). The thread then finds its socket gone and
+// acknowledges this through enter_direct_socket(). Only then is the socket
+// closed, so that no thread can call recv() on a closed (or re-used)
+// descriptor.
+//
+static void close_direct_sockets() {
+  int *sock[MAX_DDC + 2];
+  int *reading[MAX_DDC + 2];
+  int fd[MAX_DDC + 2];
+
+  for (int i = 0; i < MAX_DDC; i++) {
+    sock[i] = &ddc_socket[i];
+    reading[i] = &ddc_reading[i];
+  }
+
+  sock[MAX_DDC] = &hp_socket;
+  reading[MAX_DDC] = &hp_reading;
+  sock[MAX_DDC + 1] = &mic_socket;
+  reading[MAX_DDC + 1] = &mic_reading;
+
+  for (int i = 0; i < MAX_DDC + 2; i++) {
+    fd[i] = __atomic_exchange_n(sock[i], -1, __ATOMIC_SEQ_CST);
+
+    if (fd[i] >= 0) { shutdown(fd[i], SHUT_RDWR); }
+  }
+
+  for (int i = 0; i < MAX_DDC + 2; i++) {
+    if (fd[i] < 0) { continue; }
+
+    while (__atomic_load_n(reading[i], __ATOMIC_SEQ_CST) == fd[i]) {
+      usleep(1000);
+    }
+
+    close(fd[i]);
+  }
+}
+
 void new_protocol_init(int pixels) {
   int i;
 
@@ -450,6 +738,25 @@ void new_protocol_init(int pixels) {
   memset(rxid, 0, sizeof(rxid));
   memset(ddc_sequence, 0, sizeof(ddc_sequence));
   update_action_table();
+  iq_unpack_init();
+
+  for (i = 0; i < MAX_DDC; i++) {
+    ddc_packets[i] = metric_counter("p2_ddc%d_packets", i);
+    ddc_gaps[i] = metric_counter("p2_ddc%d_sequence_gaps", i);
+    ddc_ring[i] = metric_gauge("p2_ddc%d_ring_buffers", i);
+    ddc_overflows[i] = metric_counter("p2_ddc%d_ring_overflows", i);
+  }
+
+  mic_ring = metric_gauge("p2_mic_ring_buffers");
+  mic_overflows = metric_counter("p2_mic_ring_overflows");
+  rxaudio_ring = metric_gauge("p2_rxaudio_ring_bytes");
+  rxaudio_overflows = metric_counter("p2_rxaudio_ring_overflows");
+  txiq_ring = metric_gauge("p2_txiq_ring_bytes");
+  txiq_overflows = metric_counter("p2_txiq_ring_overflows");
+
+  if (!have_saturn_xdma && np_pool == NULL) {
+    np_pool = create_buffer_pool("P2", NP_POOL_SIZE);
+  }
 
   if (transmitter->local_microphone) {
     if (audio_open_input() != 0) {
@@ -623,6 +930,10 @@ void new_protocol_init(int pixels) {
       data_addr[i].sin_port = htons(RX_IQ_TO_HOST_PORT_0 + i);
     }
 
+    if (p2_direct_sockets) {
+      open_direct_sockets();
+    }
+
     new_protocol_thread_id = g_thread_new( "P2 main", new_protocol_thread, NULL);
   }
 
@@ -1661,7 +1972,13 @@ void new_protocol_menu_stop() {
 #endif
 
   if (!have_saturn_xdma) {
+    int size, in_use, high_water;
+    long exhausted;
     g_thread_join(new_protocol_thread_id);
+    buffer_pool_statistics(np_pool, &size, &in_use, &high_water, &exhausted);
+    t_print("%s: buffers: size=%d in use=%d high water=%d exhausted=%ld\n", __FUNCTION__,
+            size, in_use, high_water, exhausted);
+    udp_recv_print_statistics(&np_recv, "P2");
   }
 
   g_thread_join(new_protocol_timer_thread_id);
@@ -1685,6 +2002,7 @@ void new_protocol_menu_stop() {
     }
 
     free(buffer);
+    close_direct_sockets();
   }
 }
 
@@ -1708,19 +2026,14 @@ void new_protocol_menu_start() {
   update_action_table();
 
   //
-  // Mark all buffers free.
+  // Discard all buffers that are still queued
   //
   if (have_saturn_xdma) {
 #ifdef SATURN
     saturn_free_buffers();
 #endif
   } else {
-    mybuffer *mybuf = buflist;
-
-    while (mybuf) {
-      mybuf->free = 1;
-      mybuf = mybuf->next;
-    }
+    discard_pool_buffers(np_pool);
   }
 
   running = 1;
@@ -1735,6 +2048,10 @@ void new_protocol_menu_start() {
   new_protocol_txiq_thread_id = g_thread_new( "P2 TXIQ", new_protocol_txiq_thread, NULL);
 
   if (!have_saturn_xdma) {
+    if (p2_direct_sockets) {
+      open_direct_sockets();
+    }
+
     new_protocol_thread_id = g_thread_new( "P2 main", new_protocol_thread, NULL);
   }
 
@@ -1849,7 +2166,13 @@ static gpointer new_protocol_txiq_thread(gpointer data) {
 }
 
 static gpointer new_protocol_thread(gpointer data) {
+  //
+  // buffers that have been obtained from the pool but not yet filled
+  //
+  mybuffer *mybuf[UDP_RECV_MAX_BATCH];
+  int have = 0;
   t_print("new_protocol_thread\n");
+  udp_recv_init(&np_recv, data_socket, p2_recv_batch, NET_BUFFER_SIZE);
 
   //
   // This thread should do as little work as possible and avoid any blocking.
@@ -1858,15 +2181,35 @@ static gpointer new_protocol_thread(gpointer data) {
   // DDC-IQ and Microphone packets since they eventually get stuck in WDSP
   // (fexchange calls).
   //
+  // Several packets are read with a single system call (if they are
+  // already there), and then dispatched one after another.
+  //
   while (running) {
-    int ddc;
-    short sourceport;
-    int bytesread;
-    mybuffer *mybuf;
-    unsigned char *buffer;
-    mybuf = get_my_buffer();
-    buffer = mybuf->buffer;
-    bytesread = recvfrom(data_socket, buffer, NET_BUFFER_SIZE, 0, (struct sockaddr*)&addr, &length);
+    int received;
+
+    while (have < np_recv.batch) {
+      mybuffer *bp = get_my_buffer(np_pool);
+
+      if (bp == NULL) { break; }
+
+      mybuf[have++] = bp;
+    }
+
+    if (have == 0) {
+      //
+      // All buffers are queued for processing. Read a packet
+      // and drop it.
+      //
+      unsigned char dropbuf[NET_BUFFER_SIZE];
+      recvfrom(data_socket, dropbuf, NET_BUFFER_SIZE, 0, (struct sockaddr*)&addr, &length);
+      continue;
+    }
+
+    for (int i = 0; i < have; i++) {
+      np_recv.buf[i] = mybuf[i]->buffer;
+    }
+
+    received = udp_recv_batch(&np_recv, have);
 
     if (!running) {
       //
@@ -1874,64 +2217,161 @@ static gpointer new_protocol_thread(gpointer data) {
       // we were doing "recvfrom". In this case, we want to let the main
       // thread terminate gracefully, including writing the props files.
       //
-      mybuf->free = 1;
+      for (int i = 0; i < have; i++) {
+        release_my_buffer(mybuf[i]);
+      }
+
+      have = 0;
       break;
     }
 
-    if (bytesread < 0) {
+    if (received < 0) {
       t_perror("recvfrom socket failed for new_protocol_thread:");
       exit(-1);
     }
 
-    sourceport = ntohs(addr.sin_port);
-
-    //t_print("new_protocol_thread: recvd %d bytes on port %d\n",bytesread,sourceport);
+    for (int i = 0; i < received; i++) {
+      int ddc;
+      short sourceport = ntohs(np_recv.addr[i].sin_port);
+      int bytesread = np_recv.len[i];
+
+      //t_print("new_protocol_thread: recvd %d bytes on port %d\n",bytesread,sourceport);
+
+      switch (sourceport) {
+      case RX_IQ_TO_HOST_PORT_0:
+      case RX_IQ_TO_HOST_PORT_1:
+      case RX_IQ_TO_HOST_PORT_2:
+      case RX_IQ_TO_HOST_PORT_3:
+      case RX_IQ_TO_HOST_PORT_4:
+      case RX_IQ_TO_HOST_PORT_5:
+      case RX_IQ_TO_HOST_PORT_6:
+      case RX_IQ_TO_HOST_PORT_7:
+        ddc = sourceport - RX_IQ_TO_HOST_PORT_0;
+
+        //
+        // If there is a direct socket for this DDC, this packet
+        // arrived before that socket has been connected.
+        //
+        if (ddc < MAX_DDC && ddc_socket[ddc] >= 0) {
+          release_my_buffer(mybuf[i]);
+        } else {
+          saturn_post_iq_data(ddc, mybuf[i]);
+        }
 
-    switch (sourceport) {
-    case RX_IQ_TO_HOST_PORT_0:
-    case RX_IQ_TO_HOST_PORT_1:
-    case RX_IQ_TO_HOST_PORT_2:
-    case RX_IQ_TO_HOST_PORT_3:
-    case RX_IQ_TO_HOST_PORT_4:
-    case RX_IQ_TO_HOST_PORT_5:
-    case RX_IQ_TO_HOST_PORT_6:
-    case RX_IQ_TO_HOST_PORT_7:
-      ddc = sourceport - RX_IQ_TO_HOST_PORT_0;
-      saturn_post_iq_data(ddc, mybuf);
-      break;
+        break;
+
+      case COMMAND_RESPONSE_TO_HOST_PORT:
+        //
+        // Ignore these packets silently. They occur when
+        // flashing a new firmware using the new protocol
+        // programmer. But this should be done in a separate
+        // program.
+        //
+        release_my_buffer(mybuf[i]);
+        break;
+
+      case HIGH_PRIORITY_TO_HOST_PORT:
+        if (hp_socket >= 0) {
+          release_my_buffer(mybuf[i]);
+        } else {
+          saturn_post_high_priority(mybuf[i]);
+        }
 
-    case COMMAND_RESPONSE_TO_HOST_PORT:
-      //
-      // Ignore these packets silently. They occur when
-      // flashing a new firmware using the new protocol
-      // programmer. But this should be done in a separate
-      // program.
-      //
-      mybuf->free = 1;
-      break;
+        break;
 
-    case HIGH_PRIORITY_TO_HOST_PORT:
-      saturn_post_high_priority(mybuf);
-      break;
+      case MIC_LINE_TO_HOST_PORT:
+        if (mic_socket >= 0) {
+          release_my_buffer(mybuf[i]);
+        } else {
+          saturn_post_micaudio(bytesread, mybuf[i]);
+        }
 
-    case MIC_LINE_TO_HOST_PORT:
-      saturn_post_micaudio(bytesread, mybuf);
-      break;
+        break;
 
-    default:
-      t_print("new_protocol_thread: Unknown port %d\n", sourceport);
-      mybuf->free = 1;
-      break;
+      default:
+        t_print("new_protocol_thread: Unknown port %d\n", sourceport);
+        release_my_buffer(mybuf[i]);
+        break;
+      }
     }
+
+    //
+    // Keep the buffers that have not been filled for the next round
+    //
+    have -= received;
+    memmove(mybuf, mybuf + received, have * sizeof(mybuffer *));
   }
 
+  udp_recv_destroy(&np_recv);
   return NULL;
 }
 
+//
+// When a thread switches to its direct socket, new_protocol_thread does not
+// queue these packets any more (it has not been running when the socket was
+// opened). Release the buffers that are still queued, and consume the
+// semaphore counts posted for them, such that the ring is empty should the
+// thread ever return to it.
+//
+static void drain_high_priority() {
+#ifdef __APPLE__
+  while (sem_trywait(high_priority_sem_buffer) == 0) {}
+
+  while (sem_trywait(high_priority_sem_ready) == 0) {}
+#else
+  while (sem_trywait(&high_priority_sem_buffer) == 0) {}
+
+  while (sem_trywait(&high_priority_sem_ready) == 0) {}
+#endif
+}
+
+static void drain_mic_ring() {
+  while (mic_outptr != mic_inptr) {
+    int optr = mic_outptr;
+    release_my_buffer((mybuffer *) mic_line_buffer[optr]);
+    mic_outptr = (optr + 1 >= MICRINGBUFLEN) ? 0 : optr + 1;
+  }
+
+#ifdef __APPLE__
+  while (sem_trywait(mic_line_sem) == 0) {}
+#else
+  while (sem_trywait(&mic_line_sem) == 0) {}
+#endif
+}
+
+static void drain_iq_ring(int ddc) {
+  while (iq_outptr[ddc] != iq_inptr[ddc]) {
+    int optr = iq_outptr[ddc];
+    release_my_buffer((mybuffer *) iq_buffer[ddc][optr]);
+    iq_outptr[ddc] = (optr + 1 >= RXIQRINGBUFLEN) ? 0 : optr + 1;
+  }
+
+#ifdef __APPLE__
+  while (sem_trywait(iq_sem[ddc]) == 0) {}
+#else
+  while (sem_trywait(&iq_sem[ddc]) == 0) {}
+#endif
+}
+
 static gpointer high_priority_thread(gpointer data) {
   t_print("high_priority_thread\n");
 
   while (1) {
+    int fd = enter_direct_socket(&hp_socket, &hp_reading);
+
+    if (fd >= 0) {
+      //
+      // read directly from the socket
+      //
+      unsigned char buffer[NET_BUFFER_SIZE];
+
+      if (recv(fd, buffer, NET_BUFFER_SIZE, 0) > 0) {
+        process_high_priority(buffer);
+      }
+
+      continue;
+    }
+
 #ifdef __APPLE__
     sem_post(high_priority_sem_ready);
     sem_wait(high_priority_sem_buffer);
@@ -1939,8 +2379,15 @@ static gpointer high_priority_thread(gpointer data) {
     sem_post(&high_priority_sem_ready);
     sem_wait(&high_priority_sem_buffer);
 #endif
-    process_high_priority();
-    high_priority_buffer->free = 1;
+
+    // woken up to switch to the direct socket
+    if (hp_socket >= 0) {
+      drain_high_priority();
+      continue;
+    }
+
+    process_high_priority(high_priority_buffer->buffer);
+    release_my_buffer(high_priority_buffer);
   }
 
   return NULL;
@@ -1956,11 +2403,33 @@ static gpointer mic_line_thread(gpointer data) {
   // every 1333 usec, but they may come in bursts
   //
   while (1) {
+    int fd = enter_direct_socket(&mic_socket, &mic_reading);
+
+    if (fd >= 0) {
+      //
+      // read directly from the socket
+      //
+      unsigned char buffer[NET_BUFFER_SIZE];
+
+      if (recv(fd, buffer, NET_BUFFER_SIZE, 0) > 0 && running) {
+        process_mic_data(buffer);
+      }
+
+      continue;
+    }
+
 #ifdef __APPLE__
     sem_wait(mic_line_sem);
 #else
     sem_wait(&mic_line_sem);
 #endif
+
+    // woken up to switch to the direct socket
+    if (mic_socket >= 0) {
+      drain_mic_ring();
+      continue;
+    }
+
     nptr = mic_outptr + 1;
 
     if (nptr >= MICRINGBUFLEN) { nptr = 0; }
@@ -1970,10 +2439,11 @@ static gpointer mic_line_thread(gpointer data) {
     mic_outptr = nptr;
 
     // This can happen when restarting the protocol
-    if (mybuf->free) { continue; }
+    if (!is_stale_buffer(mybuf)) {
+      process_mic_data(mybuf->buffer);
+    }
 
-    process_mic_data(mybuf->buffer);
-    mybuf->free = 1;
+    release_my_buffer(mybuf);
   }
 
   return NULL;
@@ -2002,13 +2472,13 @@ void saturn_post_high_priority(mybuffer *buffer) {
 
 void saturn_post_micaudio(int bytesread, mybuffer *mybuf) {
   if (!running) {
-    mybuf->free = 1;
+    release_my_buffer(mybuf);
     return;
   }
 
   if (mic_count < 0) {
     mic_count++;
-    mybuf->free = 1;
+    release_my_buffer(mybuf);
     return;
   }
 
@@ -2016,6 +2486,8 @@ void saturn_post_micaudio(int bytesread, mybuffer *mybuf) {
 
   if (nptr >= MICRINGBUFLEN) { nptr = 0; }
 
+  metric_set(mic_ring, (mic_inptr - mic_outptr + MICRINGBUFLEN) % MICRINGBUFLEN);
+
   if (nptr != mic_outptr) {
     mic_line_buffer[mic_inptr] = mybuf;
     MEMORY_BARRIER;
@@ -2026,8 +2498,9 @@ void saturn_post_micaudio(int bytesread, mybuffer *mybuf) {
 #endif
     mic_inptr = nptr;
   } else {
-    t_print("%s: buffer overflow.\n", __FUNCTION__);
-    mybuf->free = 1;
+    t_log(T_WARNING, "%s: buffer overflow.\n", __FUNCTION__);
+    metric_add(mic_overflows, 1);
+    release_my_buffer(mybuf);
     // skip 16 mic buffers (21 msec)
     mic_count = -16;
   }
@@ -2035,19 +2508,19 @@ void saturn_post_micaudio(int bytesread, mybuffer *mybuf) {
 
 void saturn_post_iq_data(int ddc, mybuffer *mybuf) {
   if (ddc < 0 || ddc >= MAX_DDC) {
-    t_print("%s: invalid DDC(%d) seen!\n", __FUNCTION__, ddc);
-    mybuf->free = 1;
+    t_log(T_WARNING, "%s: invalid DDC(%d) seen!\n", __FUNCTION__, ddc);
+    release_my_buffer(mybuf);
     return;
   }
 
   if (!running) {
-    mybuf->free = 1;
+    release_my_buffer(mybuf);
     return;
   }
 
   if (iq_count[ddc] < 0) {
     iq_count[ddc]++;
-    mybuf->free = 1;
+    release_my_buffer(mybuf);
     return;
   }
 
@@ -2059,7 +2532,7 @@ void saturn_post_iq_data(int ddc, mybuffer *mybuf) {
                   + (buffer[3] & 0xFF);
 
   if (ddc_sequence[ddc] != sequence) {
-    t_print("%s: DDC(%d) sequence error: expected %ld got %ld\n", __FUNCTION__, ddc, ddc_sequence[ddc], sequence);
+    t_log(T_WARNING, "%s: DDC(%d) sequence error: expected %ld got %ld\n", __FUNCTION__, ddc, ddc_sequence[ddc], sequence);
     sequence_errors++;
   }
 
@@ -2069,6 +2542,8 @@ void saturn_post_iq_data(int ddc, mybuffer *mybuf) {
 
   if (nptr >= RXIQRINGBUFLEN) { nptr = 0; }
 
+  metric_set(ddc_ring[ddc], (iptr - iq_outptr[ddc] + RXIQRINGBUFLEN) % RXIQRINGBUFLEN);
+
   if (nptr != iq_outptr[ddc]) {
     iq_buffer[ddc][iptr] = mybuf;
     MEMORY_BARRIER;
@@ -2079,8 +2554,9 @@ void saturn_post_iq_data(int ddc, mybuffer *mybuf) {
     sem_post(&iq_sem[ddc]);
 #endif
   } else {
-    t_print("%s: DDC(%d) buffer overflow.\n", __FUNCTION__, ddc);
-    mybuf->free = 1;
+    t_log(T_WARNING, "%s: DDC(%d) buffer overflow.\n", __FUNCTION__, ddc);
+    metric_add(ddc_overflows[ddc], 1);
+    release_my_buffer(mybuf);
     // skip 128 incoming buffers
     iq_count[ddc] = -128;
   }
@@ -2088,13 +2564,10 @@ void saturn_post_iq_data(int ddc, mybuffer *mybuf) {
 
 static gpointer iq_thread(gpointer data) {
   int ddc = GPOINTER_TO_INT(data);
-  //
-  // TEMPORARY: additional sequence check here
-  //
   int nptr, optr;
   long sequence;
   long expected_sequence = 0;
-  volatile mybuffer *mybuf;
+  mybuffer *mybuf;
   unsigned char *buffer;
   t_print("iq_thread: ddc=%d\n", ddc);
 
@@ -2106,34 +2579,64 @@ static gpointer iq_thread(gpointer data) {
   // channel.
   //
   while (1) {
+    unsigned char direct_buffer[NET_BUFFER_SIZE];
+    int fd = enter_direct_socket(&ddc_socket[ddc], &ddc_reading[ddc]);
+
+    if (fd >= 0) {
+      //
+      // read directly from the socket
+      //
+      if (recv(fd, direct_buffer, NET_BUFFER_SIZE, 0) <= 0 || !running) { continue; }
+
+      mybuf = NULL;
+      buffer = direct_buffer;
+    } else {
 #ifdef __APPLE__
-    sem_wait(iq_sem[ddc]);
+      sem_wait(iq_sem[ddc]);
 #else
-    sem_wait(&iq_sem[ddc]);
+      sem_wait(&iq_sem[ddc]);
 #endif
-    optr = iq_outptr[ddc];
-    nptr = optr + 1;
 
-    if (nptr >= RXIQRINGBUFLEN) { nptr = 0; }
+      // woken up to switch to the direct socket
+      if (ddc_socket[ddc] >= 0) {
+        drain_iq_ring(ddc);
+        continue;
+      }
 
-    mybuf = iq_buffer[ddc][optr];
-    MEMORY_BARRIER;
-    iq_outptr[ddc] = nptr;
+      optr = iq_outptr[ddc];
+      nptr = optr + 1;
 
-    // This can happen when restarting the protocol
-    if (mybuf->free) { continue; }
+      if (nptr >= RXIQRINGBUFLEN) { nptr = 0; }
+
+      mybuf = (mybuffer *) iq_buffer[ddc][optr];
+      MEMORY_BARRIER;
+      iq_outptr[ddc] = nptr;
+
+      // This can happen when restarting the protocol
+      if (is_stale_buffer(mybuf)) {
+        release_my_buffer(mybuf);
+        continue;
+      }
+
+      buffer = (unsigned char *) mybuf->buffer;
+    }
 
-    buffer = (unsigned char *) mybuf->buffer;
     //
-    //  TEMP: perform additional sequence check
+    //  Sequence check. This thread sees every packet of the DDC, whether it
+    //  comes through the ring buffer or directly from the socket, so the
+    //  packet and gap counters are kept here. Packets dropped after a ring
+    //  buffer overflow (see ddc_overflows) are counted as gaps, too.
     //
     sequence = ((buffer[0] & 0xFF) << 24) + ((buffer[1] & 0xFF) << 16) + ((buffer[2] & 0xFF) << 8) + (buffer[3] & 0xFF);
+    metric_add(ddc_packets[ddc], 1);
 
     if (expected_sequence == 0) { expected_sequence = sequence; }
 
     if (sequence != expected_sequence) {
-      t_print("%s: DDC(%d) sequence error: expected %ld got %ld\n", __FUNCTION__, ddc, expected_sequence, sequence);
+      t_log(T_WARNING, "%s: DDC(%d) sequence error: expected %ld got %ld\n", __FUNCTION__, ddc, expected_sequence, sequence);
       sequence_errors++;
+      // number of lost packets, or one if packets arrive out of order
+      metric_add(ddc_gaps[ddc], sequence > expected_sequence ? sequence - expected_sequence : 1);
     }
 
     expected_sequence = sequence + 1;
@@ -2160,19 +2663,23 @@ static gpointer iq_thread(gpointer data) {
       break;
     }
 
-    mybuf->free = 1;
+    if (mybuf) { release_my_buffer(mybuf); }
   }
 
   return NULL;
 }
 
-static void process_iq_data(unsigned char *buffer, RECEIVER *rx) {
-  int b;
-  int leftsample;
-  int rightsample;
-  double leftsampledouble;
-  double rightsampledouble;
+static int get_samples_per_frame(const unsigned char *buffer) {
   int samplesperframe = ((buffer[14] & 0xFF) << 8) + (buffer[15] & 0xFF);
+
+  if (samplesperframe > IQ_MAX_SAMPLES) { samplesperframe = IQ_MAX_SAMPLES; }
+
+  return samplesperframe;
+}
+
+static void process_iq_data(unsigned char *buffer, RECEIVER *rx) {
+  WDSP_REAL iq[2 * IQ_MAX_SAMPLES];
+  int samplesperframe = get_samples_per_frame(buffer);
 #ifdef P2IQDEBUG
   long long timestamp =
     ((long long)(buffer[4] & 0xFF) << 56)
@@ -2186,38 +2693,20 @@ static void process_iq_data(unsigned char *buffer, RECEIVER *rx) {
   int bitspersample = ((buffer[12] & 0xFF) << 8) + (buffer[13] & 0xFF);
   t_print("%s: rx=%d bitspersample=%d samplesperframe=%d\n", __FUNCTION__, rx->id, bitspersample, samplesperframe);
 #endif
-  b = 16;
-  int i;
-
-  for (i = 0; i < samplesperframe; i++) {
-    leftsample   = (int)((signed char) buffer[b++]) << 16;
-    leftsample  |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    leftsample  |= (int)((unsigned char)buffer[b++] & 0xFF);
-    rightsample  = (int)((signed char)buffer[b++]) << 16;
-    rightsample |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    rightsample |= (int)((unsigned char)buffer[b++] & 0xFF);
-    // The "obscure" constant 1.1920928955078125E-7 is 1/(2^23)
-    leftsampledouble = (double)leftsample * 1.1920928955078125E-7;
-    rightsampledouble = (double)rightsample * 1.1920928955078125E-7;
-    add_iq_samples(rx, leftsampledouble, rightsampledouble);
-  }
+  iq_unpack24_real(buffer + 16, iq, 2 * samplesperframe);
+  add_iq_samples_block(rx, iq, samplesperframe);
 }
 
 //
-// This is the same as process_ps_iq_data except that add_div_iq_samples is called
-// at the end
+// The data contains interleaved samples from two DDCs. These are
+// separated, then both are handed to add_div_iq_samples_block,
+// and those of the second DDC also to RX2 if possible.
 //
 static void process_div_iq_data(unsigned char*buffer) {
-  int b;
-  int leftsample0;
-  int rightsample0;
-  double leftsampledouble0;
-  double rightsampledouble0;
-  int leftsample1;
-  int rightsample1;
-  double leftsampledouble1;
-  double rightsampledouble1;
-  int samplesperframe = ((buffer[14] & 0xFF) << 8) + (buffer[15] & 0xFF);
+  WDSP_REAL iq[2 * IQ_MAX_SAMPLES];
+  WDSP_REAL iq0[IQ_MAX_SAMPLES];
+  WDSP_REAL iq1[IQ_MAX_SAMPLES];
+  int samplesperframe = get_samples_per_frame(buffer);
 #ifdef P2IQDEBUG
   long long timestamp =
     ((long long)(buffer[4] & 0xFF) << 56)
@@ -2231,49 +2720,35 @@ static void process_div_iq_data(unsigned char*buffer) {
   int bitspersample = ((buffer[12] & 0xFF) << 8) + (buffer[13] & 0xFF);
   t_print("%s: rx=%d bitspersample=%d samplesperframe=%d\n", __FUNCTION__, rx->id, bitspersample, samplesperframe);
 #endif
-  b = 16;
-  int i;
+  int n = samplesperframe / 2;
+  iq_unpack24_real(buffer + 16, iq, 4 * n);
 
-  for (i = 0; i < samplesperframe; i += 2) {
-    leftsample0   = (int)((signed char) buffer[b++]) << 16;
-    leftsample0  |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    leftsample0  |= (int)((unsigned char)buffer[b++] & 0xFF);
-    rightsample0  = (int)((signed char)buffer[b++]) << 16;
-    rightsample0 |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    rightsample0 |= (int)((unsigned char)buffer[b++] & 0xFF);
-    leftsampledouble0 = (double)leftsample0 * 1.1920928955078125E-7;
-    rightsampledouble0 = (double)rightsample0 * 1.1920928955078125E-7;
-    leftsample1   = (int)((signed char) buffer[b++]) << 16;
-    leftsample1  |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    leftsample1  |= (int)((unsigned char)buffer[b++] & 0xFF);
-    rightsample1  = (int)((signed char)buffer[b++]) << 16;
-    rightsample1 |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    rightsample1 |= (int)((unsigned char)buffer[b++] & 0xFF);
-    leftsampledouble1 = (double)leftsample1 * 1.1920928955078125E-7;
-    rightsampledouble1 = (double)rightsample1 * 1.1920928955078125E-7;
-    add_div_iq_samples(receiver[0], leftsampledouble0, rightsampledouble0, leftsampledouble1, rightsampledouble1);
+  for (int i = 0; i < n; i++) {
+    iq0[2 * i]     = iq[4 * i];
+    iq0[2 * i + 1] = iq[4 * i + 1];
+    iq1[2 * i]     = iq[4 * i + 2];
+    iq1[2 * i + 1] = iq[4 * i + 3];
+  }
 
-    //
-    // if both receivers share the sample rate, we can feed data to RX2
-    //
-    if (receivers > 1 && (receiver[0]->sample_rate == receiver[1]->sample_rate)) {
-      add_iq_samples(receiver[1], leftsampledouble1, rightsampledouble1);
-    }
+  add_div_iq_samples_block(receiver[0], iq0, iq1, n);
+
+  //
+  // if both receivers share the sample rate, we can feed data to RX2
+  //
+  if (receivers > 1 && (receiver[0]->sample_rate == receiver[1]->sample_rate)) {
+    add_iq_samples_block(receiver[1], iq1, n);
   }
 }
 
+//
+// Same de-interleaving as in process_div_iq_data, the first DDC
+// carries the RX feedback and the second one the TX feedback.
+//
 static void process_ps_iq_data(unsigned char *buffer) {
-  int samplesperframe;
-  int b;
-  int leftsample0;
-  int rightsample0;
-  double leftsampledouble0;
-  double rightsampledouble0;
-  int leftsample1;
-  int rightsample1;
-  double leftsampledouble1;
-  double rightsampledouble1;
-  samplesperframe = ((buffer[14] & 0xFF) << 8) + (buffer[15] & 0xFF);
+  WDSP_REAL iq[2 * IQ_MAX_SAMPLES];
+  WDSP_REAL iq0[IQ_MAX_SAMPLES];
+  WDSP_REAL iq1[IQ_MAX_SAMPLES];
+  int samplesperframe = get_samples_per_frame(buffer);
 #ifdef P2IQDEBUG
   long long timestamp =
     ((long long)(buffer[4] & 0xFF) << 56)
@@ -2287,32 +2762,20 @@ static void process_ps_iq_data(unsigned char *buffer) {
   int bitspersample = ((buffer[12] & 0xFF) << 8) + (buffer[13] & 0xFF);
   t_print("%s: rx=%d bitspersample=%d samplesperframe=%d\n", __FUNCTION__, rx->id, bitspersample, samplesperframe);
 #endif
-  b = 16;
-  int i;
+  int n = samplesperframe / 2;
+  iq_unpack24_real(buffer + 16, iq, 4 * n);
 
-  for (i = 0; i < samplesperframe; i += 2) {
-    leftsample0   = (int)((signed char) buffer[b++]) << 16;
-    leftsample0  |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    leftsample0  |= (int)((unsigned char)buffer[b++] & 0xFF);
-    rightsample0  = (int)((signed char)buffer[b++]) << 16;
-    rightsample0 |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    rightsample0 |= (int)((unsigned char)buffer[b++] & 0xFF);
-    leftsampledouble0 = (double)leftsample0 * 1.1920928955078125E-7;
-    rightsampledouble0 = (double)rightsample0 * 1.1920928955078125E-7;
-    leftsample1   = (int)((signed char) buffer[b++]) << 16;
-    leftsample1  |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    leftsample1  |= (int)((unsigned char)buffer[b++] & 0xFF);
-    rightsample1  = (int)((signed char)buffer[b++]) << 16;
-    rightsample1 |= (int)((((unsigned char)buffer[b++]) << 8) & 0xFF00);
-    rightsample1 |= (int)((unsigned char)buffer[b++] & 0xFF);
-    leftsampledouble1 = (double)leftsample1 * 1.1920928955078125E-7;
-    rightsampledouble1 = (double)rightsample1 * 1.1920928955078125E-7;
-    add_ps_iq_samples(transmitter, leftsampledouble1, rightsampledouble1, leftsampledouble0, rightsampledouble0);
-    //t_print("%06x,%06x %06x,%06x\n",leftsample0,rightsample0,leftsample1,rightsample1);
+  for (int i = 0; i < n; i++) {
+    iq0[2 * i]     = iq[4 * i];
+    iq0[2 * i + 1] = iq[4 * i + 1];
+    iq1[2 * i]     = iq[4 * i + 2];
+    iq1[2 * i + 1] = iq[4 * i + 3];
   }
+
+  add_ps_iq_samples_block(transmitter, iq1, iq0, n);
 }
 
-static void process_high_priority() {
+static void process_high_priority(const unsigned char *buffer) {
   long sequence;
   int previous_ptt;
   int previous_dot;
@@ -2330,11 +2793,10 @@ static void process_high_priority() {
   static unsigned int ex_acc = 0;
   static unsigned int adc0_acc = 0;
   static unsigned int adc1_acc = 0;
-  const unsigned char *buffer = high_priority_buffer->buffer;
   sequence = ((buffer[0] & 0xFF) << 24) + ((buffer[1] & 0xFF) << 16) + ((buffer[2] & 0xFF) << 8) + (buffer[3] & 0xFF);
 
   if (sequence != highprio_rcvd_sequence) {
-    t_print("HighPrio SeqErr Expected=%ld Seen=%ld\n", highprio_rcvd_sequence, sequence);
+    t_log(T_WARNING, "HighPrio SeqErr Expected=%ld Seen=%ld\n", highprio_rcvd_sequence, sequence);
     highprio_rcvd_sequence = sequence;
     sequence_errors++;
   }
@@ -2456,7 +2918,7 @@ static void process_mic_data(const unsigned char *buffer) {
   sequence = ((buffer[0] & 0xFF) << 24) + ((buffer[1] & 0xFF) << 16) + ((buffer[2] & 0xFF) << 8) + (buffer[3] & 0xFF);
 
   if (sequence != micsamples_sequence) {
-    t_print("MicSample SeqErr Expected=%ld Seen=%ld\n", micsamples_sequence, sequence);
+    t_log(T_WARNING, "MicSample SeqErr Expected=%ld Seen=%ld\n", micsamples_sequence, sequence);
     sequence_errors++;
   }
 
@@ -2523,6 +2985,8 @@ void new_protocol_cw_audio_samples(short left_audio_sample, short right_audio_sa
 
       if (nptr >= RXAUDIORINGBUFLEN) { nptr = 0; }
 
+      metric_set(rxaudio_ring, (rxaudio_inptr - rxaudio_outptr + RXAUDIORINGBUFLEN) % RXAUDIORINGBUFLEN);
+
       if (nptr != rxaudio_outptr) {
         rxaudio_inptr = nptr;
 #ifdef __APPLE__
@@ -2532,7 +2996,8 @@ void new_protocol_cw_audio_samples(short left_audio_sample, short right_audio_sa
 #endif
         rxaudio_count = 0;
       } else {
-        t_print("%s: buffer overflow\n", __FUNCTION__);
+        t_log(T_WARNING, "%s: buffer overflow\n", __FUNCTION__);
+        metric_add(rxaudio_overflows, 1);
         // skip some audio samples
         rxaudio_count = -4096;
       }
@@ -2582,6 +3047,8 @@ void new_protocol_audio_samples(RECEIVER *rx, short left_audio_sample, short rig
 
     if (nptr >= RXAUDIORINGBUFLEN) { nptr = 0; }
 
+    metric_set(rxaudio_ring, (rxaudio_inptr - rxaudio_outptr + RXAUDIORINGBUFLEN) % RXAUDIORINGBUFLEN);
+
     if (nptr != rxaudio_outptr) {
       rxaudio_inptr = nptr;
 #ifdef __APPLE__
@@ -2591,7 +3058,8 @@ void new_protocol_audio_samples(RECEIVER *rx, short left_audio_sample, short rig
 #endif
       rxaudio_count = 0;
     } else {
-      t_print("%s: buffer overflow\n", __FUNCTION__);
+      t_log(T_WARNING, "%s: buffer overflow\n", __FUNCTION__);
+      metric_add(rxaudio_overflows, 1);
       // skip some audio samples
       rxaudio_count = -4096;
     }
@@ -2620,6 +3088,8 @@ void new_protocol_iq_samples(int isample, int qsample) {
 
     if (nptr >= TXIQRINGBUFLEN) { nptr = 0; }
 
+    metric_set(txiq_ring, (txiq_inptr - txiq_outptr + TXIQRINGBUFLEN) % TXIQRINGBUFLEN);
+
     if (nptr != txiq_outptr) {
       txiq_inptr = nptr;
       txiq_count = 0;
@@ -2629,7 +3099,8 @@ void new_protocol_iq_samples(int isample, int qsample) {
       sem_post(&txiq_sem);
 #endif
     } else {
-      t_print("%s: output buffer overflow\n", __FUNCTION__);
+      t_log(T_WARNING, "%s: output buffer overflow\n", __FUNCTION__);
+      metric_add(txiq_overflows, 1);
       // skip 4800 samples ( 25 msec @ 192k )
       txiq_count = -4800;
     }
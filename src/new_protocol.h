@@ -59,22 +59,38 @@
 ////////////////////////////////////////////////////////////////////////////
 //
 // One buffer. The fences can be used to detect over-writing
-// (feature currently not used).
+// (feature currently not used). Buffers are taken from a fixed-size
+// pool, and the pool is remembered such that a buffer can be released
+// from any thread without knowing where it came from.
 //
 ////////////////////////////////////////////////////////////////////////////
 
+typedef struct mybuffer_pool_ mybuffer_pool;
+
 struct mybuffer_ {
-  struct mybuffer_ *next;
-  int             free;
+  struct mybuffer_ *next;         // link in the free list of the pool
+  mybuffer_pool   *pool;          // the pool this buffer belongs to
+  int             epoch;          // pool epoch when the buffer was obtained
   long            lowfence;
   unsigned char   buffer[NET_BUFFER_SIZE];
   long            highfence;
-};
+} __attribute__((aligned(64)));
 
 typedef struct mybuffer_ mybuffer;
 
+extern mybuffer_pool *create_buffer_pool(const char *name, int size);
+extern mybuffer *get_my_buffer(mybuffer_pool *pool);
+extern void release_my_buffer(mybuffer *mybuf);
+extern int is_stale_buffer(const mybuffer *mybuf);
+extern void discard_pool_buffers(mybuffer_pool *pool);
+extern void buffer_pool_statistics(const mybuffer_pool *pool, int *size, int *in_use, int *high_water,
+                                   long *exhausted);
+
 #define MIC_SAMPLES 64
 
+extern int p2_recv_batch;
+extern int p2_direct_sockets;
+
 extern void schedule_high_priority(void);
 extern void schedule_general(void);
 extern void schedule_receive_specific(void);
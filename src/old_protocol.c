@@ -50,7 +50,9 @@
 #include "vfo.h"
 #include "ext.h"
 #include "iambic.h"
+#include "iqunpack.h"
 #include "message.h"
+#include "metrics.h"
 
 #define min(x,y) (x<y?x:y)
 
@@ -96,27 +98,6 @@
 #define LT2208_RANDOM_OFF         0x00
 #define LT2208_RANDOM_ON          0x10
 
-// state machine buffer processing
-enum {
-  SYNC_0 = 0,
-  SYNC_1,
-  SYNC_2,
-  CONTROL_0,
-  CONTROL_1,
-  CONTROL_2,
-  CONTROL_3,
-  CONTROL_4,
-  LEFT_SAMPLE_HI,
-  LEFT_SAMPLE_MID,
-  LEFT_SAMPLE_LOW,
-  RIGHT_SAMPLE_HI,
-  RIGHT_SAMPLE_MID,
-  RIGHT_SAMPLE_LOW,
-  MIC_SAMPLE_HI,
-  MIC_SAMPLE_LOW,
-  SKIP
-};
-static int state = SYNC_0;
 
 static int data_socket = -1;
 static int tcp_socket = -1;
@@ -144,6 +125,7 @@ static int command = 1;
 
 static gpointer receive_thread(gpointer arg);
 static gpointer process_ozy_input_buffer_thread(gpointer arg);
+static gpointer process_rxiq_thread(gpointer arg);
 
 static void queue_two_ozy_input_buffers(unsigned const char *buf1,
                                         unsigned const char *buf2);
@@ -191,7 +173,9 @@ static GMutex dump_mutex;
   static sem_t rxring_sem;
 #endif
 //
-// probably not needed
+// Audio samples are sent from the thread of the active receiver,
+// and each receiver has its own thread, so after changing the
+// active receiver two threads may briefly compete here.
 //
 static pthread_mutex_t send_audio_mutex   = PTHREAD_MUTEX_INITIALIZER;
 
@@ -244,6 +228,52 @@ static volatile int rxring_inptr  = 0;  // pointer updated when writing into the
 static volatile int rxring_outptr = 0;  // pointer updated when reading from the ring buffer
 static volatile int rxring_count  = 0;  // a sample counter
 
+//
+// Per-receiver sample rings.
+// process_ozy_input_buffer_thread() only de-multiplexes the data from the
+// radio, and passes the RX samples to one thread per receiver which does
+// the WDSP exchange (via add_iq_samples). So a slow WDSP channel no longer
+// stalls the other receiver, and the RX engines may run on different
+// CPU cores. The TX (mic) and PureSignal feedback samples are still
+// processed by process_ozy_input_buffer_thread().
+//
+// Each slot holds the samples of one receiver from a double-buffer
+// (1024 bytes), which is at most 126 samples (single HPSDR receiver).
+// The slots are filled by process_ozy_input_buffer_thread and
+// posted one-by-one, so the semaphore count equals the number
+// of filled slots.
+//
+#define P1_RECEIVERS 2
+#define RXIQSLOTS    256
+#define RXIQSLOTLEN  126
+
+typedef struct _rxiq_slot {
+  int samples;
+  int diversity;                // if set, aux contains the samples to be mixed in
+  WDSP_REAL iq[2 * RXIQSLOTLEN];
+  WDSP_REAL aux[2 * RXIQSLOTLEN];
+} RXIQ_SLOT;
+
+static RXIQ_SLOT *rxiq_ring[P1_RECEIVERS] = { NULL, NULL };
+static volatile int rxiq_inptr[P1_RECEIVERS]  = { 0, 0 };  // updated when a slot has been filled
+static volatile int rxiq_outptr[P1_RECEIVERS] = { 0, 0 };  // updated when a slot has been processed
+static int rxiq_fill[P1_RECEIVERS]            = { 0, 0 };  // number of samples in the slot being filled
+static int rxiq_overflow[P1_RECEIVERS]        = { 0, 0 };  // to report overflows only once per burst
+
+//
+// Performance counters, registered in old_protocol_init()
+//
+static METRIC *p1_packets, *p1_gaps;
+static METRIC *rxring_fill, *rxring_overflows;
+static METRIC *txring_fill, *txring_overflows;
+static METRIC *rxiq_fill_slots[P1_RECEIVERS], *rxiq_overflows[P1_RECEIVERS];
+
+#ifdef __APPLE__
+  static sem_t *rxiq_sem[P1_RECEIVERS];
+#else
+  static sem_t rxiq_sem[P1_RECEIVERS];
+#endif
+
 static gpointer old_protocol_txiq_thread(gpointer data) {
   int nptr;
 
@@ -361,12 +391,38 @@ void old_protocol_init(int rx, int pixels, int rate) {
     RXRINGBUF = g_new(unsigned char, RXRINGBUFLEN);
   }
 
+  for (i = 0; i < P1_RECEIVERS; i++) {
+    if (rxiq_ring[i] == NULL) {
+      rxiq_ring[i] = g_new(RXIQ_SLOT, RXIQSLOTS);
+    }
+
+    rxiq_fill_slots[i] = metric_gauge("p1_rx%d_iq_ring_slots", i);
+    rxiq_overflows[i] = metric_counter("p1_rx%d_iq_ring_overflows", i);
+  }
+
+  p1_packets = metric_counter("p1_packets");
+  p1_gaps = metric_counter("p1_sequence_gaps");
+  rxring_fill = metric_gauge("p1_rxring_bytes");
+  rxring_overflows = metric_counter("p1_rxring_overflows");
+  txring_fill = metric_gauge("p1_txring_bytes");
+  txring_overflows = metric_counter("p1_txring_overflows");
+
 #ifdef __APPLE__
   txring_sem = apple_sem(0);
   rxring_sem = apple_sem(0);
+
+  for (i = 0; i < P1_RECEIVERS; i++) {
+    rxiq_sem[i] = apple_sem(0);
+  }
+
 #else
   (void) sem_init(&txring_sem, 0, 0);
   (void) sem_init(&rxring_sem, 0, 0);
+
+  for (i = 0; i < P1_RECEIVERS; i++) {
+    (void) sem_init(&rxiq_sem[i], 0, 0);
+  }
+
 #endif
   pthread_mutex_lock(&send_ozy_mutex);
   old_protocol_set_mic_sample_rate(rate);
@@ -379,6 +435,12 @@ void old_protocol_init(int rx, int pixels, int rate) {
     }
   }
 
+  for (i = 0; i < P1_RECEIVERS; i++) {
+    char text[16];
+    snprintf(text, 16, "P1 RX%d", i + 1);
+    g_thread_new(text, process_rxiq_thread, GINT_TO_POINTER(i));
+  }
+
   g_thread_new("P1 proc", process_ozy_input_buffer_thread, NULL);
 
   //
@@ -840,9 +902,13 @@ static gpointer receive_thread(gpointer arg) {
 
           // A sequence error with a seqnum of zero usually indicates a METIS restart
           // and is no error condition
+          metric_add(p1_packets, 1);
+
           if (sequence != 0 && sequence != last_seq_num + 1) {
-            t_print("SEQ ERROR: last %ld, recvd %ld\n", (long) last_seq_num, (long) sequence);
+            t_log(T_WARNING, "SEQ ERROR: last %ld, recvd %ld\n", (long) last_seq_num, (long) sequence);
             sequence_errors++;
+            // number of lost packets, or one if packets arrive out of order
+            metric_add(p1_gaps, sequence > last_seq_num ? (long) (sequence - last_seq_num - 1) : 1);
           }
 
           last_seq_num = sequence;
@@ -1101,24 +1167,6 @@ static int how_many_receivers() {
   return ret;
 }
 
-static int nreceiver;
-static int left_sample;
-static int right_sample;
-static short mic_sample;
-static double left_sample_double;
-static double right_sample_double;
-double left_sample_double_rx;
-double right_sample_double_rx;
-double left_sample_double_tx;
-double right_sample_double_tx;
-double left_sample_double_main;
-double right_sample_double_main;
-double left_sample_double_aux;
-double right_sample_double_aux;
-
-static int nsamples;
-static int iq_samples;
-
 static void process_control_bytes() {
   int previous_ptt;
   int previous_dot;
@@ -1306,162 +1354,185 @@ static void process_control_bytes() {
   }
 }
 
+static void post_rx_iq_samples(int id);
+
 //
-// These static variables are set at the beginning
-// of process_ozy_input_buffer() and "do" the communication
-// with process_ozy_byte()
+// Return the slot currently being filled for receiver #id. If it already
+// contains samples of the other kind (with/without diversity), hand it over
+// to the receiver thread and start with a fresh one.
 //
-static int st_num_hpsdr_receivers;
-static int st_rxfdbk;
-static int st_txfdbk;
+static RXIQ_SLOT *get_rx_iq_slot(int id, int diversity) {
+  RXIQ_SLOT *slot = &rxiq_ring[id][rxiq_inptr[id]];
 
-static void process_ozy_byte(int b) {
-  switch (state) {
-  case SYNC_0:
-    if (b == SYNC) {
-      state++;
-    }
+  if (rxiq_fill[id] > 0 && slot->diversity != diversity) {
+    post_rx_iq_samples(id);
+    slot = &rxiq_ring[id][rxiq_inptr[id]];
+  }
 
-    break;
+  slot->diversity = diversity;
+  return slot;
+}
 
-  case SYNC_1:
-    if (b == SYNC) {
-      state++;
-    }
+//
+// Append n RX samples (interleaved I/Q) to the slot currently being filled
+// for receiver #id
+//
+static void queue_rx_iq_samples(int id, const WDSP_REAL *iq, int n) {
+  RXIQ_SLOT *slot = get_rx_iq_slot(id, 0);
+  int fill = rxiq_fill[id];
 
-    break;
+  if (fill + n > RXIQSLOTLEN) { n = RXIQSLOTLEN - fill; }
 
-  case SYNC_2:
-    if (b == SYNC) {
-      state++;
-    }
+  memcpy(&slot->iq[2 * fill], iq, 2 * n * sizeof(WDSP_REAL));
+  rxiq_fill[id] = fill + n;
+}
 
-    break;
+//
+// Append n pairs of DIVERSITY samples, these are mixed in the receiver thread
+//
+static void queue_rx_div_iq_samples(int id, const WDSP_REAL *iq0, const WDSP_REAL *iq1, int n) {
+  RXIQ_SLOT *slot = get_rx_iq_slot(id, 1);
+  int fill = rxiq_fill[id];
 
-  case CONTROL_0:
-    control_in[0] = b;
-    state++;
-    break;
+  if (fill + n > RXIQSLOTLEN) { n = RXIQSLOTLEN - fill; }
 
-  case CONTROL_1:
-    control_in[1] = b;
-    state++;
-    break;
+  memcpy(&slot->iq [2 * fill], iq0, 2 * n * sizeof(WDSP_REAL));
+  memcpy(&slot->aux[2 * fill], iq1, 2 * n * sizeof(WDSP_REAL));
+  rxiq_fill[id] = fill + n;
+}
 
-  case CONTROL_2:
-    control_in[2] = b;
-    state++;
-    break;
+//
+// Hand over the slot currently being filled to the thread of receiver #id
+//
+static void post_rx_iq_samples(int id) {
+  if (rxiq_fill[id] == 0) { return; }
 
-  case CONTROL_3:
-    control_in[3] = b;
-    state++;
-    break;
+  int nptr = rxiq_inptr[id] + 1;
 
-  case CONTROL_4:
-    control_in[4] = b;
-    process_control_bytes();
-    nreceiver = 0;
-    iq_samples = (512 - 8) / ((st_num_hpsdr_receivers * 6) + 2);
-    nsamples = 0;
-    state++;
-    break;
+  if (nptr >= RXIQSLOTS) { nptr = 0; }
 
-  case LEFT_SAMPLE_HI:
-    left_sample = (int)((signed char)b << 16);
-    state++;
-    break;
+  metric_set(rxiq_fill_slots[id], (rxiq_inptr[id] - rxiq_outptr[id] + RXIQSLOTS) % RXIQSLOTS);
 
-  case LEFT_SAMPLE_MID:
-    left_sample |= (int)((((unsigned char)b) << 8) & 0xFF00);
-    state++;
-    break;
+  if (nptr == rxiq_outptr[id]) {
+    //
+    // The receiver thread does not keep pace. Drop these samples
+    // and re-use the slot.
+    //
+    if (!rxiq_overflow[id]) {
+      t_log(T_WARNING, "%s: RX%d sample ring overflow.\n", __FUNCTION__, id + 1);
+      rxiq_overflow[id] = 1;
+    }
 
-  case LEFT_SAMPLE_LOW:
-    left_sample |= (int)((unsigned char)b & 0xFF);
-    left_sample_double = (double)left_sample * 1.1920928955078125E-7;
-    state++;
-    break;
+    metric_add(rxiq_overflows[id], 1);
+  } else {
+    rxiq_ring[id][rxiq_inptr[id]].samples = rxiq_fill[id];
+    MEMORY_BARRIER;
+    rxiq_inptr[id] = nptr;
+    rxiq_overflow[id] = 0;
+#ifdef __APPLE__
+    sem_post(rxiq_sem[id]);
+#else
+    sem_post(&rxiq_sem[id]);
+#endif
+  }
 
-  case RIGHT_SAMPLE_HI:
-    right_sample = (int)((signed char)b << 16);
-    state++;
-    break;
+  rxiq_fill[id] = 0;
+}
 
-  case RIGHT_SAMPLE_MID:
-    right_sample |= (int)((((unsigned char)b) << 8) & 0xFF00);
-    state++;
-    break;
+static gpointer process_rxiq_thread(gpointer arg) {
+  int id = GPOINTER_TO_INT(arg);
 
-  case RIGHT_SAMPLE_LOW:
-    right_sample |= (int)((unsigned char)b & 0xFF);
-    right_sample_double = (double)right_sample * 1.1920928955078125E-7;
+  //
+  // This thread does the fexchange() with WDSP for one receiver.
+  // Each semaphore count corresponds to one filled slot.
+  //
+  for (;;) {
+#ifdef __APPLE__
+    sem_wait(rxiq_sem[id]);
+#else
+    sem_wait(&rxiq_sem[id]);
+#endif
+    const RXIQ_SLOT *slot = &rxiq_ring[id][rxiq_outptr[id]];
+    RECEIVER *rx = receiver[id];
+    int nptr = rxiq_outptr[id] + 1;
 
-    if (isTransmitting() && transmitter->puresignal) {
-      //
-      // transmitting with PureSignal. Get sample pairs and feed to pscc
-      //
-      if (nreceiver == st_rxfdbk) {
-        left_sample_double_rx = left_sample_double;
-        right_sample_double_rx = right_sample_double;
-      } else if (nreceiver == st_txfdbk) {
-        left_sample_double_tx = left_sample_double;
-        right_sample_double_tx = right_sample_double;
-      }
+    if (nptr >= RXIQSLOTS) { nptr = 0; }
 
-      // this is pure paranoia, it allows for st_txfdbk < st_rxfdbk
-      if (nreceiver + 1 == st_num_hpsdr_receivers) {
-        add_ps_iq_samples(transmitter, left_sample_double_tx, right_sample_double_tx, left_sample_double_rx,
-                          right_sample_double_rx);
-      }
+    if (slot->diversity) {
+      add_div_iq_samples_block(rx, slot->iq, slot->aux, slot->samples);
+    } else {
+      add_iq_samples_block(rx, slot->iq, slot->samples);
     }
 
-    if (!isTransmitting() && diversity_enabled) {
-      //
-      // receiving with DIVERSITY. Get sample pairs and feed to diversity mixer.
-      // If the second RX is running, feed aux samples to that receiver.
-      //
-      if (nreceiver == 0) {
-        left_sample_double_main = left_sample_double;
-        right_sample_double_main = right_sample_double;
-      } else if (nreceiver == 1) {
-        left_sample_double_aux = left_sample_double;
-        right_sample_double_aux = right_sample_double;
-        add_div_iq_samples(receiver[0], left_sample_double_main, right_sample_double_main, left_sample_double_aux,
-                           right_sample_double_aux);
-
-        if (receivers > 1) { add_iq_samples(receiver[1], left_sample_double_aux, right_sample_double_aux); }
-      }
-    }
+    MEMORY_BARRIER;
+    rxiq_outptr[id] = nptr;
+  }
 
-    if ((!isTransmitting() || duplex) && !diversity_enabled) {
-      //
-      // RX without DIVERSITY. Feed samples to RX1 and RX2
-      //
-      if (nreceiver == 0) {
-        add_iq_samples(receiver[0], left_sample_double, right_sample_double);
-      } else if (nreceiver == 1 && receivers > 1) {
-        add_iq_samples(receiver[1], left_sample_double, right_sample_double);
-      }
-    }
+  return NULL;
+}
 
-    nreceiver++;
+//
+// These static variables are set at the beginning
+// of process_ozy_input_buffer() and "do" the communication
+// with process_ozy_frame()
+//
+static int st_num_hpsdr_receivers;
+static int st_rxfdbk;
+static int st_txfdbk;
 
-    if (nreceiver == st_num_hpsdr_receivers) {
-      state++;
-    } else {
-      state = LEFT_SAMPLE_HI;
-    }
+//
+// Process a complete 512-byte Ozy frame.
+// The layout of the frame is fixed for a given number of receivers (see
+// ozy_unpack_frame). First all I/Q samples are unpacked into a separate
+// vector for each receiver, then these vectors are passed on as a whole.
+//
+static void process_ozy_frame(const unsigned char *buffer) {
+  WDSP_REAL iq[OZY_MAX_RX][2 * OZY_MAX_SAMPLES];
+  short mic[OZY_MAX_SAMPLES];
+  int nrx = st_num_hpsdr_receivers;
 
-    break;
+  if (buffer[SYNC0] != SYNC || buffer[SYNC1] != SYNC || buffer[SYNC2] != SYNC) {
+    t_log(T_WARNING, "%s: sync error %02X %02X %02X\n", __FUNCTION__, buffer[SYNC0], buffer[SYNC1], buffer[SYNC2]);
+    return;
+  }
 
-  case MIC_SAMPLE_HI:
-    mic_sample = (short)(b << 8);
-    state++;
-    break;
+  if (nrx < 1 || nrx > OZY_MAX_RX) { return; }
+
+  control_in[0] = buffer[C0];
+  control_in[1] = buffer[C1];
+  control_in[2] = buffer[C2];
+  control_in[3] = buffer[C3];
+  control_in[4] = buffer[C4];
+  process_control_bytes();
+  int iq_samples = ozy_unpack_frame(buffer, nrx, iq, mic);
+
+  if (isTransmitting() && transmitter->puresignal && st_rxfdbk < nrx && st_txfdbk < nrx) {
+    //
+    // transmitting with PureSignal. Feed sample pairs to pscc
+    //
+    add_ps_iq_samples_block(transmitter, iq[st_txfdbk], iq[st_rxfdbk], iq_samples);
+  }
+
+  if (!isTransmitting() && diversity_enabled && nrx > 1) {
+    //
+    // receiving with DIVERSITY. Feed sample pairs to the diversity mixer.
+    // If the second RX is running, feed aux samples to that receiver.
+    //
+    queue_rx_div_iq_samples(0, iq[0], iq[1], iq_samples);
+
+    if (receivers > 1) { queue_rx_iq_samples(1, iq[1], iq_samples); }
+  }
 
-  case MIC_SAMPLE_LOW:
-    mic_sample |= (short)(b & 0xFF);
+  if ((!isTransmitting() || duplex) && !diversity_enabled) {
+    //
+    // RX without DIVERSITY. Feed samples to RX1 and RX2
+    //
+    queue_rx_iq_samples(0, iq[0], iq_samples);
+
+    if (receivers > 1 && nrx > 1) { queue_rx_iq_samples(1, iq[1], iq_samples); }
+  }
+
+  for (int n = 0; n < iq_samples; n++) {
     mic_samples++;
 
     if (mic_samples >= mic_sample_divisor) { // reduce to 48000
@@ -1475,27 +1546,16 @@ static void process_ozy_byte(int b) {
       float fsample;
 
       if (radio_ptt) {
-        fsample = (float) mic_sample * 0.00003051;
+        fsample = (float) mic[n] * 0.00003051;
 
         if (transmitter->local_microphone) { fsample += audio_get_next_mic_sample(); }
       } else {
-        fsample = transmitter->local_microphone ? audio_get_next_mic_sample() : (float) mic_sample * 0.00003051;
+        fsample = transmitter->local_microphone ? audio_get_next_mic_sample() : (float) mic[n] * 0.00003051;
       }
 
       add_mic_sample(transmitter, fsample);
       mic_samples = 0;
     }
-
-    nsamples++;
-
-    if (nsamples == iq_samples) {
-      state = SYNC_0;
-    } else {
-      nreceiver = 0;
-      state = LEFT_SAMPLE_HI;
-    }
-
-    break;
   }
 }
 
@@ -1516,6 +1576,8 @@ static void queue_two_ozy_input_buffers(unsigned const char *buf1,
 
   if (nptr >= RXRINGBUFLEN) { nptr = 0; }
 
+  metric_set(rxring_fill, (rxring_inptr - rxring_outptr + RXRINGBUFLEN) % RXRINGBUFLEN);
+
   if (nptr != rxring_outptr) {
     memcpy((void *)(&RXRINGBUF[rxring_inptr    ]), buf1, 512);
     memcpy((void *)(&RXRINGBUF[rxring_inptr + 512]), buf2, 512);
@@ -1527,7 +1589,8 @@ static void queue_two_ozy_input_buffers(unsigned const char *buf1,
     sem_post(&rxring_sem);
 #endif
   } else {
-    t_print("%s: input buffer overflow.\n", __FUNCTION__);
+    t_log(T_WARNING, "%s: input buffer overflow.\n", __FUNCTION__);
+    metric_add(rxring_overflows, 1);
     // if an overflow is encountered, skip the next 256 input buffers
     // to allow a "fresh start"
     rxring_count = -256;
@@ -1538,11 +1601,14 @@ static gpointer process_ozy_input_buffer_thread(gpointer arg) {
   //
   // This thread constantly monitors the input ring buffer and
   // processes the data whenever a bunch is available. Note this
-  // thread does all the fexchange() with WDSP, since it calls
-  // (via process_ozy_byte)
+  // thread does the fexchange() with WDSP for the TX engine,
+  // since it calls (via process_ozy_frame)
   //
-  // add_iq_samples   ==> RX engine(s)
-  // add_mic_sample   ==> TX engine
+  // add_mic_sample     ==> TX engine
+  // add_ps_iq_samples_block  ==> PureSignal
+  //
+  // while the RX samples are handed over to the receiver threads
+  // (see process_rxiq_thread) in one bunch per double-buffer.
   //
   for (;;) {
 #ifdef __APPLE__
@@ -1561,8 +1627,11 @@ static gpointer process_ozy_input_buffer_thread(gpointer arg) {
     st_rxfdbk = rx_feedback_channel();
     st_txfdbk = tx_feedback_channel();
 
-    for (int i = 0; i < 1024; i++) {
-      process_ozy_byte(RXRINGBUF[rxring_outptr + i] & 0xFF);
+    process_ozy_frame(&RXRINGBUF[rxring_outptr      ]);
+    process_ozy_frame(&RXRINGBUF[rxring_outptr + 512]);
+
+    for (int i = 0; i < P1_RECEIVERS; i++) {
+      post_rx_iq_samples(i);
     }
 
     MEMORY_BARRIER;
@@ -1625,6 +1694,8 @@ void old_protocol_audio_samples(RECEIVER *rx, short left_audio_sample, short rig
 
       if (nptr >= TXRINGBUFLEN) { nptr = 0; }
 
+      metric_set(txring_fill, (txring_inptr - txring_outptr + TXRINGBUFLEN) % TXRINGBUFLEN);
+
       if (nptr != txring_outptr) {
 #ifdef __APPLE__
         sem_post(txring_sem);
@@ -1634,7 +1705,8 @@ void old_protocol_audio_samples(RECEIVER *rx, short left_audio_sample, short rig
         txring_inptr = nptr;
         txring_count = 0;
       } else {
-        t_print("%s: output buffer overflow.\n", __FUNCTION__);
+        t_log(T_WARNING, "%s: output buffer overflow.\n", __FUNCTION__);
+        metric_add(txring_overflows, 1);
         txring_count = -1260;
       }
     }
@@ -1713,6 +1785,8 @@ void old_protocol_iq_samples(int isample, int qsample, int side) {
 
       if (nptr >= TXRINGBUFLEN) { nptr = 0; }
 
+      metric_set(txring_fill, (txring_inptr - txring_outptr + TXRINGBUFLEN) % TXRINGBUFLEN);
+
       if (nptr != txring_outptr) {
 #ifdef __APPLE__
         sem_post(txring_sem);
@@ -1722,7 +1796,8 @@ void old_protocol_iq_samples(int isample, int qsample, int side) {
         txring_inptr = nptr;
         txring_count = 0;
       } else {
-        t_print("%s: output buffer overflow.\n", __FUNCTION__);
+        t_log(T_WARNING, "%s: output buffer overflow.\n", __FUNCTION__);
+        metric_add(txring_overflows, 1);
         txring_count = -1260;
       }
     }
@@ -0,0 +1,403 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Micro-benchmark of the old-protocol (P1) input path, "make ozybench".
+//
+// A canned 1032-byte Metis packet (two 512-byte Ozy frames) is decoded over
+// and over, the way process_ozy_input_buffer_thread() does it, by
+//
+//   old: the byte-by-byte state machine (process_ozy_byte) that was
+//        replaced by process_ozy_frame(), storing every sample separately
+//   new: process_ozy_frame(), which unpacks a frame as a whole with
+//        ozy_unpack_frame() from iqunpack.c and queues one vector per receiver
+//
+// Both are copies of the code in old_protocol.c, reduced to receiving without
+// diversity (the common case), except ozy_unpack_frame() which is linked in.
+// Control bytes, mic samples and the RX sample slots are handled as in
+// old_protocol.c, but the slots are "posted" without waking up a thread.
+// The program checks that both produce the same samples and prints the time
+// per packet for 1, 2 and 4 HPSDR receivers.
+//
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "iqunpack.h"
+
+#define SYNC          0x7F
+#define RXIQSLOTS     256
+#define RXIQSLOTLEN   126
+#define P1_RECEIVERS  2
+#define MIN_TIME      0.5             // seconds per measurement
+
+//
+// iqunpack.c reports its kernel through t_print(), which lives in message.c
+// with the GTK dependencies. Provide a plain one here.
+//
+void t_print(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+}
+
+typedef struct _rxiq_slot {
+  int samples;
+  int diversity;
+  WDSP_REAL iq[2 * RXIQSLOTLEN];
+  WDSP_REAL aux[2 * RXIQSLOTLEN];
+} RXIQ_SLOT;
+
+static RXIQ_SLOT rxiq_ring[P1_RECEIVERS][RXIQSLOTS];
+static int rxiq_inptr[P1_RECEIVERS];
+static int rxiq_fill[P1_RECEIVERS];
+
+static unsigned char control_in[5];
+static int st_num_hpsdr_receivers;
+static int receivers;
+static int mic_samples;
+static int mic_sample_divisor = 4;          // 192 kHz
+static volatile double mic_sink;
+static volatile int control_sink;
+
+static void process_control_bytes() {
+  control_sink += control_in[0] + control_in[1] + control_in[2] + control_in[3] + control_in[4];
+}
+
+static void add_mic_sample(float sample) {
+  mic_sink += sample;
+}
+
+static void post_rx_iq_samples(int id) {
+  if (rxiq_fill[id] == 0) { return; }
+
+  rxiq_ring[id][rxiq_inptr[id]].samples = rxiq_fill[id];
+  rxiq_inptr[id] = (rxiq_inptr[id] + 1) % RXIQSLOTS;
+  rxiq_fill[id] = 0;
+}
+
+static RXIQ_SLOT *get_rx_iq_slot(int id, int diversity) {
+  RXIQ_SLOT *slot = &rxiq_ring[id][rxiq_inptr[id]];
+
+  if (rxiq_fill[id] > 0 && slot->diversity != diversity) {
+    post_rx_iq_samples(id);
+    slot = &rxiq_ring[id][rxiq_inptr[id]];
+  }
+
+  slot->diversity = diversity;
+  return slot;
+}
+
+//
+// old: one sample at a time
+//
+enum {
+  SYNC_0 = 0,
+  SYNC_1,
+  SYNC_2,
+  CONTROL_0,
+  CONTROL_1,
+  CONTROL_2,
+  CONTROL_3,
+  CONTROL_4,
+  LEFT_SAMPLE_HI,
+  LEFT_SAMPLE_MID,
+  LEFT_SAMPLE_LOW,
+  RIGHT_SAMPLE_HI,
+  RIGHT_SAMPLE_MID,
+  RIGHT_SAMPLE_LOW,
+  MIC_SAMPLE_HI,
+  MIC_SAMPLE_LOW,
+  SKIP
+};
+static int state = SYNC_0;
+static int nreceiver;
+static int left_sample;
+static int right_sample;
+static short mic_sample;
+static double left_sample_double;
+static double right_sample_double;
+static int nsamples;
+static int iq_samples;
+
+static void queue_rx_iq_sample(int id, double i_sample, double q_sample) {
+  RXIQ_SLOT *slot = get_rx_iq_slot(id, 0);
+  int n = rxiq_fill[id];
+
+  if (n < RXIQSLOTLEN) {
+    slot->iq[2 * n    ] = i_sample;
+    slot->iq[2 * n + 1] = q_sample;
+    rxiq_fill[id] = n + 1;
+  }
+}
+
+static void process_ozy_byte(int b) {
+  switch (state) {
+  case SYNC_0:
+  case SYNC_1:
+  case SYNC_2:
+    if (b == SYNC) {
+      state++;
+    }
+
+    break;
+
+  case CONTROL_0:
+  case CONTROL_1:
+  case CONTROL_2:
+  case CONTROL_3:
+    control_in[state - CONTROL_0] = b;
+    state++;
+    break;
+
+  case CONTROL_4:
+    control_in[4] = b;
+    process_control_bytes();
+    nreceiver = 0;
+    iq_samples = (512 - 8) / ((st_num_hpsdr_receivers * 6) + 2);
+    nsamples = 0;
+    state++;
+    break;
+
+  case LEFT_SAMPLE_HI:
+    left_sample = (int)((signed char)b << 16);
+    state++;
+    break;
+
+  case LEFT_SAMPLE_MID:
+    left_sample |= (int)((((unsigned char)b) << 8) & 0xFF00);
+    state++;
+    break;
+
+  case LEFT_SAMPLE_LOW:
+    left_sample |= (int)((unsigned char)b & 0xFF);
+    left_sample_double = (double)left_sample * 1.1920928955078125E-7;
+    state++;
+    break;
+
+  case RIGHT_SAMPLE_HI:
+    right_sample = (int)((signed char)b << 16);
+    state++;
+    break;
+
+  case RIGHT_SAMPLE_MID:
+    right_sample |= (int)((((unsigned char)b) << 8) & 0xFF00);
+    state++;
+    break;
+
+  case RIGHT_SAMPLE_LOW:
+    right_sample |= (int)((unsigned char)b & 0xFF);
+    right_sample_double = (double)right_sample * 1.1920928955078125E-7;
+
+    if (nreceiver == 0) {
+      queue_rx_iq_sample(0, left_sample_double, right_sample_double);
+    } else if (nreceiver == 1 && receivers > 1) {
+      queue_rx_iq_sample(1, left_sample_double, right_sample_double);
+    }
+
+    nreceiver++;
+
+    if (nreceiver == st_num_hpsdr_receivers) {
+      state++;
+    } else {
+      state = LEFT_SAMPLE_HI;
+    }
+
+    break;
+
+  case MIC_SAMPLE_HI:
+    mic_sample = (short)(b << 8);
+    state++;
+    break;
+
+  case MIC_SAMPLE_LOW:
+    mic_sample |= (short)(b & 0xFF);
+    mic_samples++;
+
+    if (mic_samples >= mic_sample_divisor) {
+      add_mic_sample((float) mic_sample * 0.00003051);
+      mic_samples = 0;
+    }
+
+    nsamples++;
+
+    if (nsamples == iq_samples) {
+      state = SYNC_0;
+    } else {
+      nreceiver = 0;
+      state = LEFT_SAMPLE_HI;
+    }
+
+    break;
+  }
+}
+
+static void old_packet(const unsigned char *packet) {
+  for (int i = 8; i < 1032; i++) {
+    process_ozy_byte(packet[i]);
+  }
+
+  for (int i = 0; i < P1_RECEIVERS; i++) {
+    post_rx_iq_samples(i);
+  }
+}
+
+//
+// new: a frame at a time
+//
+static void queue_rx_iq_samples(int id, const WDSP_REAL *iq, int n) {
+  RXIQ_SLOT *slot = get_rx_iq_slot(id, 0);
+  int fill = rxiq_fill[id];
+
+  if (fill + n > RXIQSLOTLEN) { n = RXIQSLOTLEN - fill; }
+
+  memcpy(&slot->iq[2 * fill], iq, 2 * n * sizeof(WDSP_REAL));
+  rxiq_fill[id] = fill + n;
+}
+
+static void process_ozy_frame(const unsigned char *buffer) {
+  WDSP_REAL iq[OZY_MAX_RX][2 * OZY_MAX_SAMPLES];
+  short mic[OZY_MAX_SAMPLES];
+  int nrx = st_num_hpsdr_receivers;
+
+  if (buffer[0] != SYNC || buffer[1] != SYNC || buffer[2] != SYNC) { return; }
+
+  if (nrx < 1 || nrx > OZY_MAX_RX) { return; }
+
+  memcpy(control_in, buffer + 3, 5);
+  process_control_bytes();
+  int n_iq = ozy_unpack_frame(buffer, nrx, iq, mic);
+  queue_rx_iq_samples(0, iq[0], n_iq);
+
+  if (receivers > 1 && nrx > 1) { queue_rx_iq_samples(1, iq[1], n_iq); }
+
+  for (int n = 0; n < n_iq; n++) {
+    mic_samples++;
+
+    if (mic_samples >= mic_sample_divisor) {
+      add_mic_sample((float) mic[n] * 0.00003051);
+      mic_samples = 0;
+    }
+  }
+}
+
+static void new_packet(const unsigned char *packet) {
+  process_ozy_frame(packet + 8);
+  process_ozy_frame(packet + 520);
+
+  for (int i = 0; i < P1_RECEIVERS; i++) {
+    post_rx_iq_samples(i);
+  }
+}
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1.0E-9 * (double)ts.tv_nsec;
+}
+
+static void reset() {
+  memset(rxiq_ring, 0, sizeof(rxiq_ring));
+  memset(rxiq_inptr, 0, sizeof(rxiq_inptr));
+  memset(rxiq_fill, 0, sizeof(rxiq_fill));
+  mic_samples = 0;
+  mic_sink = 0.0;
+  state = SYNC_0;
+}
+
+//
+// nanoseconds per packet
+//
+static double run(void (*decode)(const unsigned char *), const unsigned char *packet) {
+  long n = 0;
+  double t0 = now(), t;
+
+  do {
+    for (int i = 0; i < 1000; i++) {
+      decode(packet);
+    }
+
+    n += 1000;
+  } while ((t = now() - t0) < MIN_TIME);
+
+  return 1.0E9 * t / (double) n;
+}
+
+int main() {
+  static RXIQ_SLOT ref[P1_RECEIVERS];
+  unsigned char packet[1032];
+  unsigned int seed = 4711;
+  int fail = 0;
+
+  //
+  // Metis header, then two Ozy frames with sync, control bytes and random samples
+  //
+  for (int i = 0; i < 1032; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    packet[i] = seed >> 24;
+  }
+
+  packet[0] = 0xEF;
+  packet[1] = 0xFE;
+  packet[2] = 0x01;
+  packet[3] = 0x06;
+
+  for (int f = 8; f < 1032; f += 512) {
+    packet[f] = packet[f + 1] = packet[f + 2] = SYNC;
+  }
+
+  printf("%s, ns per 1032-byte packet\n", sizeof(WDSP_REAL) == sizeof(float) ? "float" : "double");
+  printf("  receivers      old      new  speed-up\n");
+
+  for (int nrx = 1; nrx <= 4; nrx *= 2) {
+    st_num_hpsdr_receivers = nrx;
+    receivers = nrx > 1 ? 2 : 1;
+
+    //
+    // the bytes after the last group of a frame are zero
+    //
+    for (int f = 8; f < 1032; f += 512) {
+      int used = 8 + ((512 - 8) / (6 * nrx + 2)) * (6 * nrx + 2);
+      memset(packet + f + used, 0, 512 - used);
+    }
+
+    reset();
+    old_packet(packet);
+    double old_mic = mic_sink;
+    memcpy(ref, &rxiq_ring[0][0], sizeof(RXIQ_SLOT));
+    memcpy(ref + 1, &rxiq_ring[1][0], sizeof(RXIQ_SLOT));
+    reset();
+    new_packet(packet);
+
+    for (int id = 0; id < P1_RECEIVERS; id++) {
+      if (memcmp(&ref[id], &rxiq_ring[id][0], sizeof(RXIQ_SLOT)) != 0) { fail = 1; }
+    }
+
+    if (mic_sink != old_mic) { fail = 1; }
+
+    reset();
+    double t_old = run(old_packet, packet);
+    reset();
+    double t_new = run(new_packet, packet);
+    printf("  %9d  %7.0f  %7.0f  %7.2fx%s\n", nrx, t_old, t_new, t_old / t_new, fail ? "  MISMATCH" : "");
+  }
+
+  return fail;
+}
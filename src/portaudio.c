@@ -72,7 +72,7 @@ int n_output_devices = 0;
 // the ring buffer is cleared and only 256 (stereo) samples of silence
 // are put into it. During the TX phase, the buffer filling remains low
 // which we need for small CW sidetone latencies. If we then go to RX again
-// a "low water mark" condition is detected in the first call to audio_write()
+// a "low water mark" condition is detected in the first call to audio_write_block()
 // and half a buffer length of silence is inserted again.
 //
 // Experiments indicate that we can indeed keep the ring buffer about half full
@@ -557,20 +557,21 @@ void audio_close_output(RECEIVER *rx) {
 }
 
 //
-// AUDIO_WRITE
+// AUDIO_WRITE_BLOCK
 //
-// send RX audio data to a PA output stream
+// send n stereo samples (lr[0...2n-1], left and right interleaved) of
+// RX audio data to a PA output stream
 // we have to store the data such that the PA callback function
 // can access it.
 //
 // Note that the check on isTransmitting() takes care that "blocking"
 // by the mutex can only occur in the moment of a RX/TX transition if
-// both audio_write() and cw_audio_write() get a "go".
+// both audio_write_block() and cw_audio_write() get a "go".
 //
 // So mutex locking/unlocking should only cost few CPU cycles in
-// normal operation.
+// normal operation, and it is done once per block.
 //
-int audio_write (RECEIVER *rx, float left, float right) {
+int audio_write_block (RECEIVER *rx, const float *lr, int n) {
   int txmode = get_tx_mode();
   float *buffer = rx->local_audio_buffer;
 
@@ -616,6 +617,7 @@ int audio_write (RECEIVER *rx, float left, float right) {
 
       MEMORY_BARRIER;
       rx->local_audio_buffer_inpt = oldpt;
+      avail = MY_RING_BUFFER_SIZE / 2;
       //t_print("%s: buffer was nearly empty, inserted silence.\n", __FUNCTION__);
     }
 
@@ -633,27 +635,32 @@ int audio_write (RECEIVER *rx, float left, float right) {
       if (oldpt < 0) { oldpt += MY_RING_BUFFER_SIZE; }
 
       rx->local_audio_buffer_inpt = oldpt;
-      t_print("%s: buffer was nearly full, deleted audio\n", __FUNCTION__);
+      avail = MY_RING_BUFFER_SIZE / 2;
+      t_log(T_WARNING, "%s: buffer was nearly full, deleted audio\n", __FUNCTION__);
     }
 
     //
-    // put sample into ring buffer
+    // put samples into ring buffer, as many as there is space for,
+    // in (at most) two contiguous pieces
     //
+    int space = MY_RING_BUFFER_SIZE - 1 - avail;
+
+    if (n > space) { n = space; }
+
     int oldpt = rx->local_audio_buffer_inpt;
-    int newpt = oldpt + 1;
+    int first = MY_RING_BUFFER_SIZE - oldpt;
 
-    if (newpt == MY_RING_BUFFER_SIZE) { newpt = 0; }
+    if (first > n) { first = n; }
 
-    if (newpt != rx->local_audio_buffer_outpt) {
-      //
-      // buffer space available
-      //
-      MEMORY_BARRIER;
-      buffer[2 * oldpt] = left;
-      buffer[2 * oldpt + 1] = right;
-      MEMORY_BARRIER;
-      rx->local_audio_buffer_inpt = newpt;
-    }
+    MEMORY_BARRIER;
+    memcpy(&buffer[2 * oldpt], lr, 2 * first * sizeof(float));
+    memcpy(buffer, &lr[2 * first], 2 * (n - first) * sizeof(float));
+    MEMORY_BARRIER;
+    oldpt += n;
+
+    if (oldpt >= MY_RING_BUFFER_SIZE) { oldpt -= MY_RING_BUFFER_SIZE; }
+
+    rx->local_audio_buffer_inpt = oldpt;
   }
 
   g_mutex_unlock(&rx->local_audio_mutex);
@@ -24,25 +24,100 @@
 #include "property.h"
 #include "message.h"
 
+//
+// The properties are kept in a linked list (which defines the order in
+// which they are written to the props file) and, for the look-up by name,
+// in a hash table whose keys are the property names stored in the list
+// elements.
+//
+// Integer properties (set with setPropertyInt, which is what the SetPropI
+// macros use) are stored as numbers and only converted to a string when
+// the string is needed, that is, when the props file is written. A value
+// read with getPropertyInt is converted from the string only once.
+//
+#define PROP_STR 1                       // value string is valid
+#define PROP_INT 2                       // ival is valid
+#define PROP_DBL 4                       // dval is valid
+
 PROPERTY* properties = NULL;
+static GHashTable *property_index = NULL;
 
 static double version = 0.0;
 
 void clearProperties() {
   t_print("clearProperties\n");
 
+  if (property_index != NULL) {
+    g_hash_table_remove_all(property_index);
+  }
+
   if (properties != NULL) {
     // free all the properties
     PROPERTY *next;
 
     while (properties != NULL) {
       next = properties->next_property;
+      g_free(properties->name);
+      g_free(properties->value);
       free(properties);
       properties = next;
     }
   }
 }
 
+static PROPERTY *findProperty(const char *name) {
+  if (property_index == NULL) { return NULL; }
+
+  return g_hash_table_lookup(property_index, name);
+}
+
+static PROPERTY *newProperty(const char *name) {
+  PROPERTY *property = malloc(sizeof(PROPERTY));
+
+  if (property_index == NULL) {
+    property_index = g_hash_table_new(g_str_hash, g_str_equal);
+  }
+
+  property->name = g_strdup(name);
+  property->value = NULL;
+  property->value_size = 0;
+  property->valid = 0;
+  property->next_property = properties;
+  properties = property;
+  g_hash_table_insert(property_index, property->name, property);
+  return property;
+}
+
+//
+// Store a string value, re-using the value buffer if possible
+//
+static void storeValue(PROPERTY *property, const char *value) {
+  int len = strlen(value) + 1;
+
+  if (len > property->value_size) {
+    g_free(property->value);
+    property->value_size = len < 16 ? 16 : len;
+    property->value = g_malloc(property->value_size);
+  }
+
+  memcpy(property->value, value, len);
+  property->valid = PROP_STR;
+}
+
+//
+// Make sure the string value is valid
+//
+static const char *propertyString(PROPERTY *property) {
+  if (!(property->valid & PROP_STR)) {
+    char value[32];
+    snprintf(value, sizeof(value), "%lld", property->ival);
+    storeValue(property, value);
+    property->valid |= PROP_INT;
+  }
+
+  return property->value;
+}
+
 /* --------------------------------------------------------------------------*/
 /**
 * @brief Load Properties
@@ -51,9 +126,9 @@ void clearProperties() {
 */
 void loadProperties(const char* filename) {
   FILE* f = fopen(filename, "r");
-  PROPERTY* property;
   t_print("loadProperties: %s\n", filename);
   clearProperties();
+  version = 0.0;
 
   if (f) {
     const char* value;
@@ -67,11 +142,7 @@ void loadProperties(const char* filename) {
 
         // Beware of "illegal" lines in corrupted files
         if (name != NULL && value != NULL) {
-          property = malloc(sizeof(PROPERTY));
-          property->name = g_strdup(name);
-          property->value = g_strdup(value);
-          property->next_property = properties;
-          properties = property;
+          setProperty(name, value);
 
           if (strcmp(name, "property_version") == 0) {
             version = atof(value);
@@ -84,7 +155,7 @@ void loadProperties(const char* filename) {
   }
 
   if (version != PROPERTY_VERSION) {
-    properties = NULL;
+    clearProperties();
     t_print("loadProperties: version=%f expected version=%f ignoring\n", version, PROPERTY_VERSION);
   }
 }
@@ -93,6 +164,8 @@ void loadProperties(const char* filename) {
 /**
 * @brief Save Properties
 *
+* The file contents are assembled in memory and written with a single call.
+*
 * @param filename
 */
 void saveProperties(const char* filename) {
@@ -108,14 +181,22 @@ void saveProperties(const char* filename) {
 
   snprintf(line, 512, "%0.2f", PROPERTY_VERSION);
   setProperty("property_version", line);
+  GString *contents = g_string_sized_new(65536);
   property = properties;
 
   while (property) {
-    snprintf(line, 512, "%s=%s\n", property->name, property->value);
-    fwrite(line, 1, strlen(line), f);
+    g_string_append(contents, property->name);
+    g_string_append_c(contents, '=');
+    g_string_append(contents, propertyString(property));
+    g_string_append_c(contents, '\n');
     property = property->next_property;
   }
 
+  if (fwrite(contents->str, 1, contents->len, f) != contents->len) {
+    t_print("saveProperties: write error on %s\n", filename);
+  }
+
+  g_string_free(contents, TRUE);
   fclose(f);
 }
 
@@ -128,19 +209,44 @@ void saveProperties(const char* filename) {
 * @return
 */
 char* getProperty(const char* name) {
-  char* value = NULL;
-  PROPERTY* property = properties;
+  PROPERTY* property = findProperty(name);
 
-  while (property) {
-    if (strcmp(name, property->name) == 0) {
-      value = property->value;
-      break;
-    }
+  if (property == NULL) { return NULL; }
 
-    property = property->next_property;
+  return (char *) propertyString(property);
+}
+
+//
+// Typed read access. Return value is TRUE if the property exists
+// (then *value has been set), and FALSE otherwise.
+// The results are the same as applying atoll() and atof() to the string value.
+//
+int getPropertyInt(const char* name, long long *value) {
+  PROPERTY* property = findProperty(name);
+
+  if (property == NULL) { return FALSE; }
+
+  if (!(property->valid & PROP_INT)) {
+    property->ival = atoll(property->value);
+    property->valid |= PROP_INT;
+  }
+
+  *value = property->ival;
+  return TRUE;
+}
+
+int getPropertyDouble(const char* name, double *value) {
+  PROPERTY* property = findProperty(name);
+
+  if (property == NULL) { return FALSE; }
+
+  if (!(property->valid & PROP_DBL)) {
+    property->dval = atof(propertyString(property));
+    property->valid |= PROP_DBL;
   }
 
-  return value;
+  *value = property->dval;
+  return TRUE;
 }
 
 /* --------------------------------------------------------------------------*/
@@ -151,27 +257,23 @@ char* getProperty(const char* name) {
 * @param value
 */
 void setProperty(const char* name, const char* value) {
-  PROPERTY* property = properties;
-
-  while (property) {
-    if (strcmp(name, property->name) == 0) {
-      break;
-    }
+  PROPERTY* property = findProperty(name);
 
-    property = property->next_property;
+  if (property == NULL) {
+    property = newProperty(name);
   }
 
-  if (property) {
-    // just update
-    free(property->value);
-    property->value = g_strdup(value);
-  } else {
-    // new property
-    property = malloc(sizeof(PROPERTY));
-    property->name = g_strdup(name);
-    property->value = g_strdup(value);
-    property->next_property = properties;
-    properties = property;
+  storeValue(property, value);
+}
+
+void setPropertyInt(const char* name, long long value) {
+  PROPERTY* property = findProperty(name);
+
+  if (property == NULL) {
+    property = newProperty(name);
   }
+
+  property->ival = value;
+  property->valid = PROP_INT;
 }
 
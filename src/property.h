@@ -26,13 +26,20 @@ typedef struct _PROPERTY PROPERTY;
 struct _PROPERTY {
   char* name;
   char* value;
+  int value_size;                        // size of the value buffer
+  int valid;                             // which of value, ival, dval are valid
+  long long ival;
+  double dval;
   PROPERTY* next_property;
 };
 
 extern void clearProperties(void);
 extern void loadProperties(const char* filename);
 extern char* getProperty(const char* name);
+extern int getPropertyInt(const char* name, long long *value);
+extern int getPropertyDouble(const char* name, double *value);
 extern void setProperty(const char* name, const char* value);
+extern void setPropertyInt(const char* name, long long value);
 extern void saveProperties(const char* filename);
 
 //
@@ -52,13 +59,13 @@ extern void saveProperties(const char* filename);
 #include "mystring.h"
 
 #define GetPropI0(a,b)  { \
-  const char *value=getProperty(a); \
-  if (value) { b = atoll(value); } \
+  long long value; \
+  if (getPropertyInt(a, &value)) { b = value; } \
 }
 
 #define GetPropF0(a,b)  { \
-  const char *value=getProperty(a); \
-  if (value) { b = atof(value); } \
+  double value; \
+  if (getPropertyDouble(a, &value)) { b = value; } \
 }
 
 #define GetPropS0(a,b)  { \
@@ -74,15 +81,15 @@ extern void saveProperties(const char* filename);
 #define GetPropI1(a,b,c) { \
   char name[128]; \
   snprintf(name, sizeof(name), a, b); \
-  const char *value=getProperty(name); \
-  if (value) { c = atoll(value); } \
+  long long value; \
+  if (getPropertyInt(name, &value)) { c = value; } \
 }
 
 #define GetPropF1(a,b,c) { \
   char name[128]; \
   snprintf(name, sizeof(name), a, b); \
-  const char *value=getProperty(name); \
-  if (value) { c = atof(value); } \
+  double value; \
+  if (getPropertyDouble(name, &value)) { c = value; } \
 }
 
 #define GetPropS1(a,b,c) { \
@@ -102,8 +109,8 @@ extern void saveProperties(const char* filename);
 #define GetPropI2(a,b,c,d) { \
   char name[128]; \
   snprintf(name, sizeof(name), a, b, c); \
-  const char *value=getProperty(name); \
-  if (value) { d = atoll(value); } \
+  long long value; \
+  if (getPropertyInt(name, &value)) { d = value; } \
 }
 
 #define GetPropS2(a,b,c,d) { \
@@ -123,8 +130,8 @@ extern void saveProperties(const char* filename);
 #define GetPropI3(a,b,c,d, e) { \
   char name[128]; \
   snprintf(name, sizeof(name), a, b, c, d); \
-  const char *value=getProperty(name); \
-  if (value) { e = atoll(value); } \
+  long long value; \
+  if (getPropertyInt(name, &value)) { e = value; } \
 }
 
 #define GetPropS3(a,b,c,d, e) { \
@@ -142,9 +149,7 @@ extern void saveProperties(const char* filename);
 }
 
 #define SetPropI0(a,b) { \
-  char value[128]; \
-  snprintf(value, sizeof(value), "%lld", (long long)(b)); \
-  setProperty(a, value); \
+  setPropertyInt(a, (long long)(b)); \
 }
 
 #define SetPropF0(a,b) { \
@@ -159,10 +164,8 @@ extern void saveProperties(const char* filename);
 
 #define SetPropI1(a,b,c) { \
   char name[128]; \
-  char value[128]; \
   snprintf(name, sizeof(name), a, b); \
-  snprintf(value, sizeof(value), "%lld", (long long) (c)); \
-  setProperty(name, value); \
+  setPropertyInt(name, (long long) (c)); \
 }
 
 #define SetPropF1(a,b,c) { \
@@ -189,10 +192,8 @@ extern void saveProperties(const char* filename);
 
 #define SetPropI2(a,b,c,d) { \
   char name[128]; \
-  char value[128]; \
   snprintf(name, sizeof(name), a, b, c); \
-  snprintf(value, sizeof(value), "%lld", (long long) (d)); \
-  setProperty(name, value); \
+  setPropertyInt(name, (long long) (d)); \
 }
 
 #define SetPropS2(a,b,c,d) { \
@@ -211,10 +212,8 @@ extern void saveProperties(const char* filename);
 
 #define SetPropI3(a,b,c,d, e) { \
   char name[128]; \
-  char value[128]; \
   snprintf(name, sizeof(name), a, b, c, d); \
-  snprintf(value, sizeof(value), "%lld", (long long) (e)); \
-  setProperty(name, value); \
+  setPropertyInt(name, (long long) (e)); \
 }
 
 #define SetPropS3(a,b,c,d, e) { \
@@ -17,6 +17,7 @@
 */
 
 #include <gtk/gtk.h>
+#include <string.h>
 #include <pulse/pulseaudio.h>
 #include <pulse/glib-mainloop.h>
 #include <pulse/simple.h>
@@ -383,7 +384,7 @@ int cw_audio_write(RECEIVER *rx, float sample) {
                                &err);
 
       if (rc != 0) {
-        t_print("%s: simple_write failed err=%d\n", __FUNCTION__, err);
+        t_log(T_WARNING, "%s: simple_write failed err=%d\n", __FUNCTION__, err);
       }
 
       rx->local_audio_buffer_offset = 0;
@@ -394,7 +395,11 @@ int cw_audio_write(RECEIVER *rx, float sample) {
   return result;
 }
 
-int audio_write(RECEIVER *rx, float left_sample, float right_sample) {
+//
+// Put n stereo samples (lr[0...2n-1], left and right interleaved)
+// into the output buffer, which is sent whenever it is full.
+//
+int audio_write_block(RECEIVER *rx, const float *lr, int n) {
   int result = 0;
   int err;
   int txmode = get_tx_mode();
@@ -411,21 +416,29 @@ int audio_write(RECEIVER *rx, float left_sample, float right_sample) {
     // Since this is mutex-protected, we know that both rx->playstream
     // and rx->local_audio_buffer will not be destroyes until we
     // are finished here.
-    rx->local_audio_buffer[rx->local_audio_buffer_offset * 2] = left_sample;
-    rx->local_audio_buffer[(rx->local_audio_buffer_offset * 2) + 1] = right_sample;
-    rx->local_audio_buffer_offset++;
+    //
+    while (n > 0) {
+      int chunk = out_buffer_size - rx->local_audio_buffer_offset;
 
-    if (rx->local_audio_buffer_offset >= out_buffer_size) {
-      int rc = pa_simple_write(rx->playstream,
-                               rx->local_audio_buffer,
-                               out_buffer_size * sizeof(float) * 2,
-                               &err);
+      if (chunk > n) { chunk = n; }
 
-      if (rc != 0) {
-        t_print("%s: simple_write failed err=%d\n", __FUNCTION__, err);
-      }
+      memcpy(&rx->local_audio_buffer[rx->local_audio_buffer_offset * 2], lr, 2 * chunk * sizeof(float));
+      rx->local_audio_buffer_offset += chunk;
+      lr += 2 * chunk;
+      n -= chunk;
 
-      rx->local_audio_buffer_offset = 0;
+      if (rx->local_audio_buffer_offset >= out_buffer_size) {
+        int rc = pa_simple_write(rx->playstream,
+                                 rx->local_audio_buffer,
+                                 out_buffer_size * sizeof(float) * 2,
+                                 &err);
+
+        if (rc != 0) {
+          t_log(T_WARNING, "%s: simple_write failed err=%d\n", __FUNCTION__, err);
+        }
+
+        rx->local_audio_buffer_offset = 0;
+      }
     }
   }
 
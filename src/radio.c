@@ -80,6 +80,7 @@
   #include "client_server.h"
 #endif
 #include "message.h"
+#include "metrics.h"
 #ifdef SATURN
   #include "saturnmain.h"
   #include "saturnserver.h"
@@ -1440,6 +1441,7 @@ void start_radio() {
 
   // save every 30 seconds
   // save_timer_id=gdk_threads_add_timeout(30000, save_cb, NULL);
+  metrics_server_start();
 
   if (rigctl_enable) {
     launch_rigctl();
@@ -2408,6 +2410,8 @@ void radioRestoreState() {
   GetPropF0("diversity_cos",                                 div_cos);
   GetPropF0("diversity_sin",                                 div_sin);
   GetPropI0("new_pa_board",                                  new_pa_board);
+  GetPropI0("radio.p2_recv_batch",                           p2_recv_batch);
+  GetPropI0("radio.p2_direct_sockets",                       p2_direct_sockets);
   GetPropI0("region",                                        region);
   GetPropI0("atlas_penelope",                                atlas_penelope);
   GetPropI0("atlas_clock_source_10mhz",                      atlas_clock_source_10mhz);
@@ -2621,6 +2625,8 @@ void radioSaveState() {
   SetPropF0("diversity_cos",                                 div_cos);
   SetPropF0("diversity_sin",                                 div_sin);
   SetPropI0("new_pa_board",                                  new_pa_board);
+  SetPropI0("radio.p2_recv_batch",                           p2_recv_batch);
+  SetPropI0("radio.p2_direct_sockets",                       p2_direct_sockets);
   SetPropI0("region",                                        region);
   SetPropI0("atlas_penelope",                                atlas_penelope);
   SetPropI0("atlas_clock_source_10mhz",                      atlas_clock_source_10mhz);
@@ -466,6 +466,8 @@ static int update_display(gpointer data) {
       GetPixels(rx->id, 0, rx->pixel_samples, &rc);
 
       if (rc) {
+        metric_observe(rx->analyzer_usec, g_get_monotonic_time() - rx->spectrum_time);
+
         if (rx->display_panadapter) {
           rx_panadapter_update(rx);
         }
@@ -801,7 +803,7 @@ RECEIVER *create_pure_signal_receiver(int id, int sample_rate, int width) {
   //
   rx->id = id;
   rx->buffer_size = 1024;
-  rx->iq_input_buffer = g_new(double, 2 * rx->buffer_size);
+  rx->iq_input_buffer = g_new(WDSP_REAL, 2 * rx->buffer_size);
 
   if (id == PS_RX_FEEDBACK) {
     int result;
@@ -841,6 +843,12 @@ RECEIVER *create_receiver(int id, int pixels, int width, int height) {
   rx->id = id;
   g_mutex_init(&rx->mutex);
   g_mutex_init(&rx->display_mutex);
+  rx->fexchange_usec = metric_histogram("rx%d_fexchange_usec", id);
+  rx->analyzer_usec = metric_histogram("rx%d_analyzer_latency_usec", id);
+  rx->spectrum_time = 0;
+  rx->audio_delay = NULL;
+  rx->audio_underruns = NULL;
+  rx->audio_overruns = NULL;
 
   switch (id) {
   case 0:
@@ -956,6 +964,11 @@ RECEIVER *create_receiver(int id, int pixels, int width, int height) {
   rx->local_audio = 0;
   g_mutex_init(&rx->local_audio_mutex);
   rx->local_audio_buffer = NULL;
+#ifdef ALSA
+  rx->local_audio_ring = NULL;
+  g_mutex_init(&rx->local_audio_ring_mutex);
+  rx->local_audio_thread = NULL;
+#endif
   STRLCPY(rx->audio_name, "NO AUDIO", sizeof(rx->audio_name));
   rx->mute_when_not_active = 0;
   rx->audio_channel = STEREO;
@@ -980,13 +993,13 @@ RECEIVER *create_receiver(int id, int pixels, int width, int height) {
   }
 
   // allocate buffers
-  rx->iq_input_buffer = g_new(double, 2 * rx->buffer_size);
+  rx->iq_input_buffer = g_new(WDSP_REAL, 2 * rx->buffer_size);
   rx->pixels = pixels * rx->zoom;
   rx->pixel_samples = g_new(float, rx->pixels);
   t_print("%s (after restore): id=%d local_audio=%d\n", __FUNCTION__, rx->id, rx->local_audio);
   int scale = rx->sample_rate / 48000;
   rx->output_samples = rx->buffer_size / scale;
-  rx->audio_output_buffer = g_new(double, 2 * rx->output_samples);
+  rx->audio_output_buffer = g_new(WDSP_REAL, 2 * rx->output_samples);
   t_print("%s: RXid=%d output_samples=%d audio_output_buffer=%p\n", __FUNCTION__, rx->id, rx->output_samples,
           rx->audio_output_buffer);
   rx->hz_per_pixel = (double)rx->sample_rate / (double)rx->pixels;
@@ -1169,7 +1182,7 @@ void receiver_change_sample_rate(RECEIVER *rx, int sample_rate) {
     g_free(rx->audio_output_buffer);
   }
 
-  rx->audio_output_buffer = g_new(double, 2 * rx->output_samples);
+  rx->audio_output_buffer = g_new(WDSP_REAL, 2 * rx->output_samples);
   SetChannelState(rx->id, 0, 1);
   init_analyzer(rx);
   SetInputSamplerate(rx->id, sample_rate);
@@ -1325,10 +1338,17 @@ void receiver_vfo_changed(RECEIVER *rx) {
   receiver_mode_changed(rx);
 }
 
+//
+// local audio is collected and passed to audio_write_block() in chunks
+//
+#define LOCAL_AUDIO_CHUNK 512
+
 static void process_rx_buffer(RECEIVER *rx) {
   double left_sample, right_sample;
   short left_audio_sample, right_audio_sample;
   int i;
+  float local_audio[2 * LOCAL_AUDIO_CHUNK];
+  int local_samples = 0;
 
   //t_print("%s: rx=%p id=%d output_samples=%d audio_output_buffer=%p\n",__FUNCTION__,rx,rx->id,rx->output_samples,rx->audio_output_buffer);
 
@@ -1364,7 +1384,13 @@ static void process_rx_buffer(RECEIVER *rx) {
         }
       }
 
-      audio_write(rx, (float)left_sample, (float)right_sample);
+      local_audio[2 * local_samples] = (float)left_sample;
+      local_audio[2 * local_samples + 1] = (float)right_sample;
+
+      if (++local_samples == LOCAL_AUDIO_CHUNK) {
+        audio_write_block(rx, local_audio, local_samples);
+        local_samples = 0;
+      }
     }
 
 #ifdef CLIENT_SERVER
@@ -1405,6 +1431,10 @@ static void process_rx_buffer(RECEIVER *rx) {
       }
     }
   }
+
+  if (local_samples > 0) {
+    audio_write_block(rx, local_audio, local_samples);
+  }
 }
 
 void full_rx_buffer(RECEIVER *rx) {
@@ -1433,15 +1463,18 @@ void full_rx_buffer(RECEIVER *rx) {
       break;
     }
 
+    gint64 start = g_get_monotonic_time();
     fexchange0(rx->id, rx->iq_input_buffer, rx->audio_output_buffer, &error);
+    metric_observe(rx->fexchange_usec, g_get_monotonic_time() - start);
 
     if (error != 0) {
-      t_print("%s: id=%d fexchange0: error=%d\n", __FUNCTION__, rx->id, error);
+      t_log(T_WARNING, "%s: id=%d fexchange0: error=%d\n", __FUNCTION__, rx->id, error);
     }
 
     if (rx->displaying) {
       g_mutex_lock(&rx->display_mutex);
       Spectrum0(1, rx->id, 0, 0, rx->iq_input_buffer);
+      rx->spectrum_time = g_get_monotonic_time();
       g_mutex_unlock(&rx->display_mutex);
     }
 
@@ -1488,6 +1521,80 @@ void add_div_iq_samples(RECEIVER *rx, double i0, double q0, double i1, double q1
   add_iq_samples(rx, i_sample, q_sample);
 }
 
+//
+// Called by the block versions below after chunk samples have been
+// stored at the current position of the input buffer. This does the
+// "silencing" after a TX/RX transition (see add_iq_samples) and
+// processes the buffer when it is full.
+//
+static void commit_iq_block(RECEIVER *rx, int chunk) {
+  if (rx->txrxcount < rx->txrxmax) {
+    guint mute = rx->txrxmax - rx->txrxcount;
+
+    if (mute > (guint) chunk) { mute = chunk; }
+
+    memset(&rx->iq_input_buffer[rx->samples * 2], 0, 2 * mute * sizeof(WDSP_REAL));
+    rx->txrxcount += mute;
+  }
+
+  rx->samples += chunk;
+
+  if (rx->samples >= rx->buffer_size) {
+    full_rx_buffer(rx);
+    rx->samples = 0;
+  }
+}
+
+//
+// Block version of add_iq_samples: n I/Q sample pairs (interleaved)
+// are copied into the input buffer. The data is only split where the
+// input buffer becomes full.
+//
+void add_iq_samples_block(RECEIVER *rx, const WDSP_REAL *iq, int n) {
+  while (n > 0) {
+    int chunk = rx->buffer_size - rx->samples;
+
+    if (chunk > n) { chunk = n; }
+
+    memcpy(&rx->iq_input_buffer[rx->samples * 2], iq, 2 * chunk * sizeof(WDSP_REAL));
+    commit_iq_block(rx, chunk);
+    iq += 2 * chunk;
+    n -= chunk;
+  }
+}
+
+//
+// Block version of add_div_iq_samples: the (rotated) samples from the
+// second channel (iq1) are added to those of the first one (iq0)
+// while storing them into the input buffer.
+//
+void add_div_iq_samples_block(RECEIVER *rx, const WDSP_REAL *iq0, const WDSP_REAL *iq1, int n) {
+  //
+  // local copies of the rotation, such that the compiler knows they
+  // do not change within the loop
+  //
+  const double c = div_cos;
+  const double s = div_sin;
+
+  while (n > 0) {
+    int chunk = rx->buffer_size - rx->samples;
+
+    if (chunk > n) { chunk = n; }
+
+    WDSP_REAL *dst = &rx->iq_input_buffer[rx->samples * 2];
+
+    for (int i = 0; i < chunk; i++) {
+      dst[2 * i    ] = iq0[2 * i    ] + (c * iq1[2 * i] - s * iq1[2 * i + 1]);
+      dst[2 * i + 1] = iq0[2 * i + 1] + (s * iq1[2 * i] + c * iq1[2 * i + 1]);
+    }
+
+    commit_iq_block(rx, chunk);
+    iq0 += 2 * chunk;
+    iq1 += 2 * chunk;
+    n -= chunk;
+  }
+}
+
 void receiver_update_zoom(RECEIVER *rx) {
   //
   // This is called whenever rx->zoom or rx->width changes,
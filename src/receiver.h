@@ -19,11 +19,13 @@
 #define _RECEIVER_H
 
 #include <gtk/gtk.h>
+#include "metrics.h"
 #ifdef PORTAUDIO
   #include <portaudio.h>
 #endif
 #ifdef ALSA
   #include <alsa/asoundlib.h>
+  #include <semaphore.h>
 #endif
 #ifdef PULSEAUDIO
   #include <pulse/pulseaudio.h>
@@ -64,8 +66,8 @@ typedef struct _receiver {
   int pixels;
   int samples;
   int output_samples;
-  double *iq_input_buffer;
-  double *audio_output_buffer;
+  WDSP_REAL *iq_input_buffer;
+  WDSP_REAL *audio_output_buffer;
   int audio_index;
   float *pixel_samples;
   int display_panadapter;
@@ -175,7 +177,8 @@ typedef struct _receiver {
   int waterfall_high;
   int waterfall_automatic;
   cairo_surface_t *panadapter_surface;
-  GdkPixbuf *pixbuf;
+  cairo_surface_t *waterfall_surface;
+  int waterfall_head;                   // row of waterfall_surface with the newest line
   int local_audio;
   int mute_when_not_active;
   int audio_device;
@@ -190,6 +193,13 @@ typedef struct _receiver {
   snd_pcm_t *playback_handle;
   snd_pcm_format_t local_audio_format;
   void *local_audio_buffer;        // different formats possible, so void*
+  float *local_audio_ring;         // RX audio (stereo) for the writer thread
+  GMutex local_audio_ring_mutex;   // protects local_audio_ring against being freed
+  int local_audio_ring_inpt;       // written by audio_write_block
+  int local_audio_ring_outpt;      // written by the writer thread
+  sem_t local_audio_sem;
+  GThread *local_audio_thread;
+  volatile int local_audio_running;
 #endif
 #ifdef PULSEAUDIO
   pa_simple *playstream;
@@ -213,9 +223,9 @@ typedef struct _receiver {
 
   int mute_radio;
 
-  double *buffer;
+  WDSP_REAL *buffer;
   void *resampler;
-  double *resample_buffer;
+  WDSP_REAL *resample_buffer;
   int resample_buffer_size;
 
   int zoom;
@@ -238,6 +248,17 @@ typedef struct _receiver {
   int display_average_mode;
   double display_average_time;
 
+  //
+  // performance counters: time spent in fexchange0, and the
+  // age of the spectrum data when the pixels are fetched
+  //
+  METRIC *fexchange_usec;
+  METRIC *analyzer_usec;
+  gint64 spectrum_time;
+  METRIC *audio_delay;        // frames queued in the local audio device
+  METRIC *audio_underruns;
+  METRIC *audio_overruns;     // buffers dropped since the audio device was full
+
 } RECEIVER;
 
 extern RECEIVER *create_pure_signal_receiver(int id, int sample_rate, int pixels);
@@ -258,6 +279,8 @@ extern void set_offset(RECEIVER *rx, long long offset);
 
 extern void add_iq_samples(RECEIVER *rx, double i_sample, double q_sample);
 extern void add_div_iq_samples(RECEIVER *rx, double i0, double q0, double i1, double q1);
+extern void add_iq_samples_block(RECEIVER *rx, const WDSP_REAL *iq, int n);
+extern void add_div_iq_samples_block(RECEIVER *rx, const WDSP_REAL *iq0, const WDSP_REAL *iq1, int n);
 
 extern void reconfigure_receiver(RECEIVER *rx, int height);
 
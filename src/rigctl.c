@@ -26,6 +26,10 @@
 #include <gdk/gdk.h>
 #include <fcntl.h>
 #include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <errno.h>
+#include <poll.h>
 #include <termios.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -61,6 +65,7 @@
 #include "zoompan.h"
 #include "exit_menu.h"
 #include "message.h"
+#include "metrics.h"
 #include "mystring.h"
 
 #include <math.h>
@@ -85,40 +90,69 @@ int cat_control;
 typedef struct {GMutex m; } GT_MUTEX;
 
 GT_MUTEX * mutex_a;
-GT_MUTEX * mutex_busy;
 
-#define MAX_CLIENTS 3
-static GThread *rigctl_server_thread_id = NULL;
+#define MAX_CLIENTS 16
 static GThread *rigctl_cw_thread_id = NULL;
 static int server_running;
 
 static int server_socket = -1;
 static struct sockaddr_in server_address;
 
+//
+// All TCP clients and serial ports are served by a single I/O thread,
+// see rigctl_io_thread(). Replies that cannot be written at once
+// are kept in a per-client output buffer.
+//
+#define RIGCTL_OUT_MAX 16384
+
 typedef struct _client {
   int fd;
   int fifo;    // only needed for serial clients to
   // indicate this is a FIFO and not a
   // true serial line
-  int busy;    // only needed for serial clients over FIFOs
-  int done;    // only needed for serial clients over FIFOs
+  int serial;  // serial line (or FIFO) rather than TCP connection
   int running; // set this to zero to terminate client
   socklen_t address_length;
   struct sockaddr_in address;
-  GThread *thread_id;
   guint andromeda_timer;  // for periodic andromeda_tasks
+  int pending; // number of commands of this client queued for the GTK thread
+  gint64 hold; // do not read from this client before this time (monotonic, usec)
+  //
+  // input: characters collected up to the next semicolon
+  //
+  char command[MAXDATASIZE];
+  int command_index;
+  //
+  // output: replies not yet written (protected by io_mutex)
+  //
+  char *out_buf;
+  int out_len;
+  int broken;  // TCP connection to be closed by the I/O thread
 } CLIENT;
 
 typedef struct _command {
   CLIENT *client;
   char *command;
+  gint64 received; // time stamp (monotonic, usec) when the command came in
 } COMMAND;
 
 static CLIENT tcp_client[MAX_CLIENTS];     // TCP clients
 static CLIENT serial_client[MAX_SERIAL];   // serial clienta
 SERIALPORT SerialPorts[MAX_SERIAL];
 
-static gpointer rigctl_client (gpointer data);
+static GMutex io_mutex;                    // protects fd and output buffer of all clients
+static GThread *rigctl_io_thread_id = NULL;
+static int io_running = 0;
+static int io_wake[2] = { -1, -1 };        // pipe to wake up the I/O thread
+
+static void rigctl_io_start(void);
+static void rigctl_io_stop(void);
+static void rigctl_io_wakeup(void);
+static void rigctl_close_client(CLIENT *client);
+static gboolean rigctl_dispatch(CLIENT *client, const char *command);
+static void cat_state_refresh(void);
+static void cat_state_start(void);
+static void cat_hist_print(void);
 
 void close_rigctl_ports() {
   int i;
@@ -126,26 +160,12 @@ void close_rigctl_ports() {
   linger.l_onoff = 1;
   linger.l_linger = 0;
   t_print("%s: server_socket=%d\n", __FUNCTION__, server_socket);
+  rigctl_io_stop();
   server_running = 0;
 
   for (i = 0; i < MAX_CLIENTS; i++) {
-    tcp_client[i].running = 0;
-
-    if (tcp_client[i].fd != -1) {
-      t_print("%s: setting SO_LINGER to 0 for client_socket: %d\n", __FUNCTION__, tcp_client[i].fd);
-
-      if (setsockopt(tcp_client[i].fd, SOL_SOCKET, SO_LINGER, (const char *)&linger, sizeof(linger)) == -1) {
-        t_perror("setsockopt(...,SO_LINGER,...) failed for client");
-      }
-
-      t_print("%s: closing client socket: %d\n", __FUNCTION__, tcp_client[i].fd);
-      close(tcp_client[i].fd);
-      tcp_client[i].fd = -1;
-    }
-
-    if (tcp_client[i].thread_id) {
-      g_thread_join(tcp_client[i].thread_id);
-      tcp_client[i].thread_id = NULL;
+    if (tcp_client[i].running) {
+      rigctl_close_client(&tcp_client[i]);
     }
   }
 
@@ -156,10 +176,16 @@ void close_rigctl_ports() {
       t_perror("setsockopt(...,SO_LINGER,...) failed for server");
     }
 
-    t_print("s: closing server_socket: %d\n", __FUNCTION__, server_socket);
+    t_print("%s: closing server_socket: %d\n", __FUNCTION__, server_socket);
     close(server_socket);
     server_socket = -1;
   }
+
+  cat_hist_print();
+  //
+  // serial ports may still be active
+  //
+  rigctl_io_start();
 }
 
 //
@@ -708,6 +734,66 @@ static gpointer rigctl_cw_thread(gpointer data) {
   return NULL;
 }
 
+static void rigctl_init_mutex() {
+  if (mutex_a == NULL) {
+    cat_control = 0;
+    mutex_a = g_new(GT_MUTEX, 1);
+    g_mutex_init(&mutex_a->m);
+  }
+}
+
+static void rigctl_cat_control(int delta) {
+  g_mutex_lock(&mutex_a->m);
+  cat_control += delta;
+
+  if (rigctl_debug) { t_print("RIGCTL: cat_control=%d\n", cat_control); }
+
+  g_mutex_unlock(&mutex_a->m);
+  g_idle_add(ext_vfo_update, NULL);
+}
+
+//
+// Write as much of the output buffer as possible without blocking.
+// Must be called with io_mutex locked. Returns -1 if writing failed.
+//
+static int rigctl_flush(CLIENT *client) {
+  while (client->out_len > 0) {
+    int rc = write(client->fd, client->out_buf, client->out_len);
+
+    if (rc < 0) {
+      if (errno == EINTR) { continue; }
+
+      return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+
+    if (rc == 0) { return 0; }
+
+    client->out_len -= rc;
+    memmove(client->out_buf, client->out_buf + rc, client->out_len);
+  }
+
+  return 0;
+}
+
+static CLIENT *rigctl_find_client(int fd) {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (tcp_client[i].running && tcp_client[i].fd == fd) { return &tcp_client[i]; }
+  }
+
+  for (int i = 0; i < MAX_SERIAL; i++) {
+    if (serial_client[i].running && serial_client[i].fd == fd) { return &serial_client[i]; }
+  }
+
+  return NULL;
+}
+
+//
+// This may be called from the GTK thread or from the I/O thread, and
+// never blocks. If the reply cannot be written at once, it is appended to
+// the output buffer of the client and written by the I/O thread.
+// If the output buffer is full, the client does not read its replies.
+// A TCP connection is then closed, for a serial line the reply is dropped.
+//
 void send_resp (int fd, char * msg) {
   if (fd == -1) {
     //
@@ -721,200 +807,327 @@ void send_resp (int fd, char * msg) {
   if (rigctl_debug) { t_print("RIGCTL: RESP=%s\n", msg); }
 
   int length = strlen(msg);
-  int count = 0;
+  int wakeup = 0;
+  g_mutex_lock(&io_mutex);
+  CLIENT *client = rigctl_find_client(fd);
+
+  if (client != NULL && !client->broken) {
+    if (client->out_len + length > RIGCTL_OUT_MAX) {
+      if (client->serial) {
+        if (rigctl_debug) { t_print("RIGCTL: output buffer full, reply dropped\n"); }
+      } else {
+        t_print("%s: output buffer full for fd=%d, closing connection\n", __FUNCTION__, fd);
+        client->broken = 1;
+      }
+    } else {
+      memcpy(client->out_buf + client->out_len, msg, length);
+      client->out_len += length;
 
-  //
-  // Possibly, the channel is already closed. In this case
-  // give up (rc < 0) or at most try a few times (rc == 0)
-  // since we are in the GTK idle loop
-  //
-  while (length > 0) {
-    int rc = write(fd, msg, length);
+      if (rigctl_flush(client) < 0) {
+        if (client->serial) {
+          client->out_len = 0;
+        } else {
+          client->broken = 1;
+        }
+      }
+    }
+
+    wakeup = client->out_len > 0 || client->broken;
+  }
 
-    if (rc < 0) { return; }
+  g_mutex_unlock(&io_mutex);
 
-    if (rc == 0) {
-      count++;
+  if (wakeup) { rigctl_io_wakeup(); }
+}
 
-      if (count > 10) { return; }
-    }
+//
+// 2-25-17 - K5JAE - removed duplicate rigctl
+//
 
-    length -= rc;
-    msg += rc;
+static void rigctl_io_wakeup() {
+  if (io_wake[1] >= 0) {
+    char c = 0;
+    (void) write(io_wake[1], &c, 1);
   }
 }
 
 //
-// 2-25-17 - K5JAE - removed duplicate rigctl
+// Close a TCP connection. Only called from the I/O thread, or while
+// the I/O thread is not running.
 //
+static void rigctl_close_client(CLIENT *client) {
+  struct linger linger = { 0 };
+  linger.l_onoff = 1;
+  linger.l_linger = 0;
+  t_print("%s: setting SO_LINGER to 0 for client_socket: %d\n", __FUNCTION__, client->fd);
 
-static gpointer rigctl_server(gpointer data) {
-  int port = GPOINTER_TO_INT(data);
-  int on = 1;
-  int i;
-  t_print("%s: starting TCP server on port %d\n", __FUNCTION__, port);
-  server_socket = socket(AF_INET, SOCK_STREAM, 0);
+  if (setsockopt(client->fd, SOL_SOCKET, SO_LINGER, (const char *)&linger, sizeof(linger)) == -1) {
+    t_perror("setsockopt(...,SO_LINGER,...) failed for client");
+  }
 
-  if (server_socket < 0) {
-    t_perror("rigctl_server: listen socket failed");
-    return NULL;
+  g_mutex_lock(&io_mutex);
+  close(client->fd);
+  client->fd = -1;
+  client->running = 0;
+  client->out_len = 0;
+  client->broken = 0;
+  g_mutex_unlock(&io_mutex);
+  rigctl_cat_control(-1);
+}
+
+//
+// A slot can be re-used if the previous client has gone and
+// none of its commands is still pending in the GTK thread.
+//
+static int rigctl_spare_slot() {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (!tcp_client[i].running && g_atomic_int_get(&tcp_client[i].pending) <= 0) { return i; }
   }
 
-  setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
-  setsockopt(server_socket, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
-  // bind to listening port
-  memset(&server_address, 0, sizeof(server_address));
-  server_address.sin_family = AF_INET;
-  server_address.sin_addr.s_addr = INADDR_ANY;
-  server_address.sin_port = htons(port);
+  return -1;
+}
 
-  if (bind(server_socket, (struct sockaddr * )&server_address, sizeof(server_address)) < 0) {
-    t_perror("rigctl_server: listen socket bind failed");
-    close(server_socket);
-    return NULL;
+static void rigctl_accept() {
+  int on = 1;
+  int spare = rigctl_spare_slot();
+
+  if (spare < 0) { return; }
+
+  CLIENT *client = &tcp_client[spare];
+  client->address_length = sizeof(client->address);
+  int fd = accept(server_socket, (struct sockaddr*)&client->address, &client->address_length);
+
+  if (fd < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) { t_perror("rigctl_server: client accept failed"); }
+
+    return;
   }
 
-  for (i = 0; i < MAX_CLIENTS; i++) {
-    tcp_client[i].fd = -1;
+  t_print("%s: slot= %d connected with fd=%d\n", __FUNCTION__, spare, fd);
+  //
+  // Setting TCP_NODELAY may (or may not) improve responsiveness
+  // by *disabling* Nagle's algorithm for clustering small packets
+  //
+#ifdef __APPLE__
+
+  if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (void *)&on, sizeof(on)) < 0) {
+#else
+
+  if (setsockopt(fd, SOL_TCP, TCP_NODELAY, (void *)&on, sizeof(on)) < 0) {
+#endif
+    t_perror("TCP_NODELAY");
   }
 
-  // listen with a max queue of 3
-  if (listen(server_socket, 3) < 0) {
-    t_perror("rigctl_server: listen failed");
-    close(server_socket);
-    return NULL;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+  if (client->out_buf == NULL) { client->out_buf = g_new(char, RIGCTL_OUT_MAX); }
+
+  client->fifo = 0;
+  client->serial = 0;
+  client->hold = 0;
+  client->command_index = 0;
+  client->andromeda_timer = 0;
+  g_mutex_lock(&io_mutex);
+  client->fd = fd;
+  client->out_len = 0;
+  client->broken = 0;
+  client->running = 1;
+  g_mutex_unlock(&io_mutex);
+  rigctl_cat_control(1);
+}
+
+//
+// Read what is available and process all complete commands
+//
+static void rigctl_read(CLIENT *client) {
+  char cmd_input[MAXDATASIZE];
+  int numbytes = read(client->fd, cmd_input, sizeof(cmd_input));
+
+  if (numbytes <= 0) {
+    if (client->serial) {
+      //
+      // On my MacOS using a FIFO, I have seen that numbytes can be -1
+      // (with errno = EAGAIN) although poll() indicated that data
+      // is available, and a FIFO without a writer reports end-of-file.
+      // Therefore a serial port is not shut down if the read() failed,
+      // but we wait a little before trying again.
+      //
+      __atomic_store_n(&client->hold, g_get_monotonic_time() + 250000, __ATOMIC_RELAXED);
+    } else if (numbytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      t_print("%s: client fd=%d has gone\n", __FUNCTION__, client->fd);
+      client->broken = 1;
+    }
+
+    return;
   }
 
-  // must start the thread here in order NOT to inherit a lock
-  cw_buf_in = 0;
-  cw_buf_out = 0;
+  for (int i = 0; i < numbytes; i++) {
+    client->command[client->command_index++] = cmd_input[i];
 
-  if (!rigctl_cw_thread_id) { rigctl_cw_thread_id = g_thread_new("RIGCTL cw", rigctl_cw_thread, NULL); }
+    if (cmd_input[i] == ';') {
+      client->command[client->command_index] = '\0';
+      client->command_index = 0;
 
-  while (server_running) {
-    int spare;
-    //
-    // find a spare slot
-    //
-    spare = -1;
+      if (rigctl_debug) { t_print("RIGCTL: command=%s\n", client->command); }
 
-    for (i = 0; i < MAX_CLIENTS; i++) {
-      if (tcp_client[i].fd == -1) {
-        spare = i;
-        break;
+      gboolean done = rigctl_dispatch(client, client->command);
+
+      if (client->fifo) {
+        //
+        // If the "serial line" is a FIFO, we must not drain it
+        // by reading our own responses (they must go to the other
+        // side). Therefore, wait until 50msec after the last
+        // CAT command of this client has been processed (see the
+        // end of parse_cmd). If for some reason this does not happen,
+        // resume after waiting for 500 msec.
+        //
+        __atomic_store_n(&client->hold, g_get_monotonic_time() + (done ? 50000 : 500000), __ATOMIC_RELAXED);
       }
+    } else if (client->command_index >= MAXDATASIZE - 1) {
+      // no terminating semicolon: discard
+      client->command_index = 0;
     }
+  }
+}
 
-    // if all slots are in use, wait and continue
-    if (spare < 0) {
-      usleep(100000L);
-      continue;
+//
+// The I/O thread multiplexes the listening socket, all TCP connections and
+// all serial ports with poll(). It is woken up through a pipe if replies
+// are queued in an output buffer or if it has to terminate.
+//
+static gpointer rigctl_io_thread(gpointer data) {
+  struct pollfd pfd[2 + MAX_CLIENTS + MAX_SERIAL];
+  CLIENT *pcl[2 + MAX_CLIENTS + MAX_SERIAL];
+  t_print("%s: starting\n", __FUNCTION__);
+
+  while (io_running) {
+    int n = 0;
+    int timeout = 250;
+    gint64 now = g_get_monotonic_time();
+
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+      if (tcp_client[i].running && tcp_client[i].broken) { rigctl_close_client(&tcp_client[i]); }
     }
 
-    //
-    // A slot is available, try to get connection via accept()
-    //
-    t_print("%s: slot= %d waiting for connection\n", __FUNCTION__, spare);
-    tcp_client[spare].fd = accept(server_socket, (struct sockaddr*)&tcp_client[spare].address,
-                                  &tcp_client[spare].address_length);
+    if (io_wake[0] >= 0) {
+      pfd[n].fd = io_wake[0];
+      pfd[n].events = POLLIN;
+      pcl[n++] = NULL;
+    }
 
-    if (tcp_client[spare].fd < 0) {
-      t_perror("rigctl_server: client accept failed");
-      tcp_client[spare].fd = -1;
-      continue;
+    // if all slots are in use, do not accept new connections
+    if (server_socket >= 0 && rigctl_spare_slot() >= 0) {
+      pfd[n].fd = server_socket;
+      pfd[n].events = POLLIN;
+      pcl[n++] = NULL;
     }
 
-    t_print("%s: slot= %d connected with fd=%d\n", __FUNCTION__, spare, tcp_client[spare].fd);
-    //
-    // Setting TCP_NODELAY may (or may not) improve responsiveness
-    // by *disabling* Nagle's algorithm for clustering small packets
-    //
-#ifdef __APPLE__
+    g_mutex_lock(&io_mutex);
 
-    if (setsockopt(tcp_client[spare].fd, IPPROTO_TCP, TCP_NODELAY, (void *)&on, sizeof(on)) < 0) {
-#else
+    for (int i = 0; i < MAX_CLIENTS + MAX_SERIAL; i++) {
+      CLIENT *client = i < MAX_CLIENTS ? &tcp_client[i] : &serial_client[i - MAX_CLIENTS];
+      short events = 0;
 
-    if (setsockopt(tcp_client[spare].fd, SOL_TCP, TCP_NODELAY, (void *)&on, sizeof(on)) < 0) {
-#endif
-      t_perror("TCP_NODELAY");
+      if (!client->running || client->fd < 0) { continue; }
+
+      gint64 hold = __atomic_load_n(&client->hold, __ATOMIC_RELAXED);
+
+      if (hold > now) {
+        int ms = (hold - now) / 1000 + 1;
+
+        if (ms < timeout) { timeout = ms; }
+      } else {
+        events |= POLLIN;
+      }
+
+      if (client->out_len > 0) { events |= POLLOUT; }
+
+      if (events == 0) { continue; }
+
+      pfd[n].fd = client->fd;
+      pfd[n].events = events;
+      pcl[n++] = client;
     }
 
-    //
-    // Spawn off a thread for handling this new connection
-    //
-    tcp_client[spare].running = 1;
-    tcp_client[spare].thread_id = g_thread_new("rigctl client", rigctl_client, (gpointer)&tcp_client[spare]);
-  }
+    g_mutex_unlock(&io_mutex);
 
-  close(server_socket);
-  return NULL;
-}
+    if (poll(pfd, n, timeout) <= 0) { continue; }
 
-static gpointer rigctl_client (gpointer data) {
-  CLIENT *client = (CLIENT *)data;
-  t_print("%s: starting rigctl_client: socket=%d\n", __FUNCTION__, client->fd);
-  g_mutex_lock(&mutex_a->m);
-  cat_control++;
+    for (int i = 0; i < n; i++) {
+      CLIENT *client = pcl[i];
 
-  if (rigctl_debug) { t_print("RIGCTL: CTLA INC cat_control=%d\n", cat_control); }
+      if (pfd[i].revents == 0) { continue; }
 
-  g_mutex_unlock(&mutex_a->m);
-  g_idle_add(ext_vfo_update, NULL);
-  int i;
-  int numbytes;
-  char  cmd_input[MAXDATASIZE] ;
-  char *command = g_new(char, MAXDATASIZE);
-  int command_index = 0;
+      if (client == NULL) {
+        if (pfd[i].fd == server_socket) {
+          rigctl_accept();
+        } else {
+          char buf[64];
+
+          while (read(io_wake[0], buf, sizeof(buf)) > 0) {}
+        }
+
+        continue;
+      }
 
-  while (client->running && (numbytes = recv(client->fd, cmd_input, MAXDATASIZE - 2, 0)) > 0 ) {
-    for (i = 0; i < numbytes; i++) {
-      command[command_index] = cmd_input[i];
-      command_index++;
+      if (pfd[i].revents & POLLOUT) {
+        g_mutex_lock(&io_mutex);
 
-      if (cmd_input[i] == ';') {
-        command[command_index] = '\0';
+        if (rigctl_flush(client) < 0) {
+          if (client->serial) {
+            client->out_len = 0;
+          } else {
+            client->broken = 1;
+          }
+        }
 
-        if (rigctl_debug) { t_print("RIGCTL: command=%s\n", command); }
+        g_mutex_unlock(&io_mutex);
+      }
 
-        COMMAND *info = g_new(COMMAND, 1);
-        info->client = client;
-        info->command = command;
-        g_idle_add(parse_cmd, info);
-        command = g_new(char, MAXDATASIZE);
-        command_index = 0;
+      if ((pfd[i].revents & (POLLIN | POLLHUP | POLLERR)) && !client->broken) {
+        rigctl_read(client);
       }
     }
   }
 
-  t_print("%s: Leaving rigctl_client thread\n", __FUNCTION__);
+  t_print("%s: terminating\n", __FUNCTION__);
+  return NULL;
+}
 
-  //
-  // If rigctl is disabled via the GUI, the connections are closed by close_rigctl_ports()
-  // but even the we should decrement cat_control
-  //
-  if (client->fd != -1) {
-    t_print("%s: setting SO_LINGER to 0 for client_socket: %d\n", __FUNCTION__, client->fd);
-    struct linger linger = { 0 };
-    linger.l_onoff = 1;
-    linger.l_linger = 0;
-
-    if (setsockopt(client->fd, SOL_SOCKET, SO_LINGER, (const char *)&linger, sizeof(linger)) == -1) {
-      t_perror("setsockopt(...,SO_LINGER,...) failed for client");
-    }
+//
+// The I/O thread is stopped while clients or serial ports are added or
+// removed, and then started again if there is anything to serve.
+//
+static void rigctl_io_start() {
+  int active = server_socket >= 0;
 
-    close(client->fd);
-    client->fd = -1;
+  for (int id = 0; id < MAX_SERIAL; id++) {
+    if (serial_client[id].running) { active = 1; }
   }
 
-  // Decrement CAT_CONTROL
-  g_mutex_lock(&mutex_a->m);
-  cat_control--;
+  if (rigctl_io_thread_id != NULL || !active) { return; }
 
-  if (rigctl_debug) { t_print("RIGCTL: CTLA DEC - cat_control=%d\n", cat_control); }
+  if (io_wake[0] < 0) {
+    if (pipe(io_wake) < 0) {
+      t_perror("RIGCTL (wake-up pipe):");
+      io_wake[0] = io_wake[1] = -1;
+    } else {
+      fcntl(io_wake[0], F_SETFL, O_NONBLOCK);
+      fcntl(io_wake[1], F_SETFL, O_NONBLOCK);
+    }
+  }
 
-  g_mutex_unlock(&mutex_a->m);
-  g_idle_add(ext_vfo_update, NULL);
-  return NULL;
+  io_running = 1;
+  rigctl_io_thread_id = g_thread_new("rigctl io", rigctl_io_thread, NULL);
+}
+
+static void rigctl_io_stop() {
+  if (rigctl_io_thread_id != NULL) {
+    io_running = 0;
+    rigctl_io_wakeup();
+    g_thread_join(rigctl_io_thread_id);
+    rigctl_io_thread_id = NULL;
+  }
 }
 
 static int ts2000_mode(int m) {
@@ -961,6 +1174,317 @@ static int ts2000_mode(int m) {
   return mode;
 }
 
+//
+// CAT queries that only read the radio state (frequency, mode, S-meter,
+// TX state) are answered directly in the client thread from a snapshot
+// of the radio state, so they need not wait for the GTK main loop, which
+// may be busy e.g. re-drawing the waterfall. All other commands are
+// queued for the GTK thread as before. A query is also queued if there
+// are commands from the same client still pending in the GTK thread, such
+// that replies come out in order and a query following a "set" command
+// sees the new value.
+//
+// The snapshot is refreshed in the GTK thread, periodically and after each
+// command processed there. It is protected by a sequence counter that is odd
+// while the snapshot is being written: a reader retries if it sees an odd
+// value, or if the counter has changed while copying the snapshot.
+//
+#define CAT_MAX_RX 2
+
+typedef struct _cat_state {
+  int valid;
+  int receivers;
+  int active;                   // id of the active receiver
+  long long frequency[2];       // VFO-A/B frequency (CTUN frequency if CTUN is active)
+  int mode[2];                  // VFO-A/B mode
+  int step;                     // VFO-A step size
+  long long rit;                // VFO-A RIT
+  int rit_enabled;
+  int xit_enabled;              // XIT of the TX VFO
+  int ctcss_enabled;
+  int ctcss;
+  int split;
+  int mox;
+  int transmitting;
+  double meter[CAT_MAX_RX];
+} CAT_STATE;
+
+static CAT_STATE cat_state;
+static unsigned int cat_state_seq = 0;
+static guint cat_state_timer = 0;
+
+//
+// Must be called from the GTK thread
+//
+static void cat_state_refresh() {
+  CAT_STATE s;
+
+  if (active_receiver == NULL) { return; }
+
+  memset(&s, 0, sizeof(CAT_STATE));
+  s.receivers = receivers < CAT_MAX_RX ? receivers : CAT_MAX_RX;
+  s.active = active_receiver->id;
+
+  for (int v = 0; v < 2; v++) {
+    s.frequency[v] = vfo[v].ctun ? vfo[v].ctun_frequency : vfo[v].frequency;
+    s.mode[v] = vfo[v].mode;
+  }
+
+  s.step = vfo[VFO_A].step;
+  s.rit = vfo[VFO_A].rit;
+  s.rit_enabled = vfo[VFO_A].rit_enabled;
+
+  if (can_transmit) {
+    s.xit_enabled   = vfo[get_tx_vfo()].xit_enabled;
+    s.ctcss         = transmitter->ctcss;
+    s.ctcss_enabled = transmitter->ctcss_enabled;
+  }
+
+  s.split = split;
+  s.mox = mox;
+  s.transmitting = isTransmitting();
+
+  for (int id = 0; id < s.receivers; id++) {
+    s.meter[id] = receiver[id]->meter;
+  }
+
+  s.valid = 1;
+  __atomic_store_n(&cat_state_seq, cat_state_seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  cat_state = s;
+  __atomic_store_n(&cat_state_seq, cat_state_seq + 1, __ATOMIC_RELEASE);
+}
+
+//
+// Get a consistent copy of the snapshot, return FALSE if this fails
+// or if there is no valid snapshot yet.
+//
+static int cat_state_read(CAT_STATE *s) {
+  for (int tries = 0; tries < 100; tries++) {
+    unsigned int seq = __atomic_load_n(&cat_state_seq, __ATOMIC_ACQUIRE);
+
+    if (seq & 1) { continue; }
+
+    *s = cat_state;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    if (__atomic_load_n(&cat_state_seq, __ATOMIC_RELAXED) == seq) { return s->valid; }
+  }
+
+  return 0;
+}
+
+static gboolean cat_state_timer_cb(gpointer data) {
+  if (cat_control > 0) { cat_state_refresh(); }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void cat_state_start() {
+  if (cat_state_timer == 0) {
+    cat_state_timer = g_timeout_add(50, cat_state_timer_cb, NULL);
+  }
+}
+
+//
+// Latency histograms, one for each TS-2000 command XY and each extended
+// command ZZXY. The latency is measured from the arrival of the command
+// until it has been processed (and the reply has been sent).
+// Bucket i counts latencies below 2^(i+1) usec, the last one everything else.
+//
+#define CAT_HIST_BUCKETS 20
+#define CAT_HIST_OTHER   (2 * 26 * 26)
+
+typedef struct _cat_hist {
+  unsigned int count;
+  unsigned int fast;            // number of commands answered from the snapshot
+  unsigned int max;             // max. latency in usec
+  unsigned long long sum;       // sum of latencies in usec
+  unsigned int bucket[CAT_HIST_BUCKETS];
+} CAT_HIST;
+
+static CAT_HIST cat_hist[CAT_HIST_OTHER + 1];
+
+static int cat_hist_slot(const char *command) {
+  if (command[0] == 'Z' && command[1] == 'Z' && isupper(command[2]) && isupper(command[3])) {
+    return 26 * 26 + 26 * (command[2] - 'A') + (command[3] - 'A');
+  }
+
+  if (isupper(command[0]) && isupper(command[1])) {
+    return 26 * (command[0] - 'A') + (command[1] - 'A');
+  }
+
+  return CAT_HIST_OTHER;
+}
+
+static void cat_hist_add(const char *command, gint64 usec, int fast) {
+  static METRIC *latency = NULL;
+  static METRIC *fast_queries = NULL;
+  CAT_HIST *h = &cat_hist[cat_hist_slot(command)];
+  unsigned int us = usec < 0 ? 0 : usec > UINT_MAX ? UINT_MAX : (unsigned int) usec;
+  int i = us < 2 ? 0 : 31 - __builtin_clz(us);
+
+  if (i >= CAT_HIST_BUCKETS) { i = CAT_HIST_BUCKETS - 1; }
+
+  __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+
+  if (fast) { __atomic_fetch_add(&h->fast, 1, __ATOMIC_RELAXED); }
+
+  __atomic_fetch_add(&h->sum, us, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&h->bucket[i], 1, __ATOMIC_RELAXED);
+  unsigned int old = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+
+  while (us > old && !__atomic_compare_exchange_n(&h->max, &old, us, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+
+  //
+  // Registering twice (if two threads race here) returns the same metric
+  //
+  if (latency == NULL) {
+    latency = metric_histogram("cat_latency_usec");
+    fast_queries = metric_counter("cat_fast_queries");
+  }
+
+  metric_observe(latency, us);
+
+  if (fast) { metric_add(fast_queries, 1); }
+}
+
+//
+// upper bound (in usec) for the latency of a given fraction of commands
+//
+static unsigned int cat_hist_percentile(const CAT_HIST *h, double p) {
+  unsigned int n = 0;
+
+  for (int i = 0; i < CAT_HIST_BUCKETS - 1; i++) {
+    n += h->bucket[i];
+
+    if (n >= p * h->count) { return 2U << i; }
+  }
+
+  return h->max;
+}
+
+static void cat_hist_print() {
+  for (int slot = 0; slot <= CAT_HIST_OTHER; slot++) {
+    const CAT_HIST *h = &cat_hist[slot];
+    char name[8];
+
+    if (h->count == 0) { continue; }
+
+    if (slot < 26 * 26) {
+      snprintf(name, sizeof(name), "%c%c", 'A' + slot / 26, 'A' + slot % 26);
+    } else if (slot < CAT_HIST_OTHER) {
+      snprintf(name, sizeof(name), "ZZ%c%c", 'A' + (slot - 26 * 26) / 26, 'A' + slot % 26);
+    } else {
+      STRLCPY(name, "other", sizeof(name));
+    }
+
+    t_print("%s: %-5s count=%u fast=%u avg=%llu p50<%u p99<%u max=%u usec\n", __FUNCTION__, name,
+            h->count, h->fast, h->sum / h->count, cat_hist_percentile(h, 0.5), cat_hist_percentile(h, 0.99), h->max);
+  }
+}
+
+//
+// Answer a read-only query from the snapshot. Return FALSE if the
+// command has to be processed in the GTK thread.
+//
+static gboolean cat_fast_query(CLIENT *client, const char *command) {
+  CAT_STATE s;
+  char reply[256];
+  size_t len = strlen(command);
+
+  if (g_atomic_int_get(&client->pending) > 0 || !cat_state_read(&s)) { return FALSE; }
+
+  if (len == 3) {
+    if (!strcmp(command, "FA;")) {
+      snprintf(reply, 256, "FA%011lld;", s.frequency[VFO_A]);
+    } else if (!strcmp(command, "FB;")) {
+      snprintf(reply, 256, "FB%011lld;", s.frequency[VFO_B]);
+    } else if (!strcmp(command, "FR;")) {
+      snprintf(reply, 256, "FR%d;", s.active);
+    } else if (!strcmp(command, "FT;")) {
+      snprintf(reply, 256, "FT%d;", s.split);
+    } else if (!strcmp(command, "ID;")) {
+      STRLCPY(reply, "ID019;", 256); // TS-2000
+    } else if (!strcmp(command, "IF;")) {
+      snprintf(reply, 256, "IF%011lld%04d%+06lld%d%d%d%02d%d%d%d%d%d%d%02d%d;",
+               s.frequency[VFO_A], s.step, s.rit, s.rit_enabled, s.xit_enabled,
+               0, 0, s.transmitting, ts2000_mode(s.mode[VFO_A]), 0, 0, s.split,
+               s.ctcss_enabled ? 2 : 0, s.ctcss, 0);
+    } else if (!strcmp(command, "MD;")) {
+      snprintf(reply, 256, "MD%d;", ts2000_mode(s.mode[VFO_A]));
+    } else if (!strcmp(command, "PS;")) {
+      STRLCPY(reply, "PS1;", 256);
+    } else {
+      return FALSE;
+    }
+  } else if (len == 4 && command[0] == 'S' && command[1] == 'M' && isdigit(command[2])) {
+    int id = command[2] - '0';
+
+    if (id >= s.receivers) { return FALSE; }
+
+    int val = (int)((s.meter[id] + 127.0) * 0.277778);
+
+    if (val > 30) { val = 30; }
+
+    if (val < 0 ) { val = 0; }
+
+    snprintf(reply, 256, "SM%d%04d;", id, val);
+  } else if (len == 5) {
+    if (!strcmp(command, "ZZFA;")) {
+      snprintf(reply, 256, "ZZFA%011lld;", s.frequency[VFO_A]);
+    } else if (!strcmp(command, "ZZFB;")) {
+      snprintf(reply, 256, "ZZFB%011lld;", s.frequency[VFO_B]);
+    } else if (!strcmp(command, "ZZMD;")) {
+      snprintf(reply, 256, "ZZMD%02d;", s.mode[VFO_A]);
+    } else if (!strcmp(command, "ZZME;")) {
+      snprintf(reply, 256, "ZZMD%02d;", s.mode[VFO_B]);
+    } else if (!strcmp(command, "ZZSP;")) {
+      snprintf(reply, 256, "ZZSP%d;", s.split);
+    } else if (!strcmp(command, "ZZTX;")) {
+      snprintf(reply, 256, "ZZTX%d;", s.mox);
+    } else {
+      return FALSE;
+    }
+  } else if (len == 6 && !strncmp(command, "ZZSM", 4) && isdigit(command[4])) {
+    int id = command[4] - '0';
+
+    if (id >= s.receivers) { return FALSE; }
+
+    double m = s.meter[id];
+    m = fmax(-140.0, m);
+    m = fmin(-10.0, m);
+    snprintf(reply, 256, "ZZSM%d%03d;", id, (int)((m + 140.0) * 2));
+  } else {
+    return FALSE;
+  }
+
+  send_resp(client->fd, reply);
+  return TRUE;
+}
+
+//
+// Process a complete CAT command received by a client thread. Returns TRUE
+// if the command has been answered at once, and FALSE if it has been
+// queued for the GTK thread.
+//
+static gboolean rigctl_dispatch(CLIENT *client, const char *command) {
+  gint64 received = g_get_monotonic_time();
+
+  if (cat_fast_query(client, command)) {
+    cat_hist_add(command, g_get_monotonic_time() - received, 1);
+    return TRUE;
+  }
+
+  COMMAND *info = g_new(COMMAND, 1);
+  info->client = client;
+  info->command = g_strdup(command);
+  info->received = received;
+  g_atomic_int_inc(&client->pending);
+  g_idle_add(parse_cmd, info);
+  return FALSE;
+}
+
 gboolean parse_extended_cmd (const char *command, const CLIENT *client) {
   gboolean implemented = TRUE;
   char reply[256];
@@ -5515,7 +6039,18 @@ int parse_cmd(void *data) {
     send_resp(client->fd, "?;");
   }
 
-  client->done = 1; // possibly inform server that command is finished
+  //
+  // Update the snapshot before this command is marked done, such that
+  // the next query from this client already sees the changes
+  //
+  cat_state_refresh();
+  cat_hist_add(info->command, g_get_monotonic_time() - info->received, 0);
+  if (g_atomic_int_dec_and_test(&client->pending) && client->fifo) {
+    // last pending command of a FIFO client: resume reading soon
+    __atomic_store_n(&client->hold, g_get_monotonic_time() + 50000, __ATOMIC_RELAXED);
+    rigctl_io_wakeup();
+  }
+
   g_free(info->command);
   g_free(info);
   return 0;
@@ -5585,112 +6120,6 @@ void set_blocking (int fd, int should_block) {
   }
 }
 
-static gpointer serial_server(gpointer data) {
-  // We're going to Read the Serial port and
-  // when we get data we'll send it to parse_cmd
-  CLIENT *client = (CLIENT *)data;
-  char cmd_input[MAXDATASIZE];
-  char *command = g_new(char, MAXDATASIZE);
-  int command_index = 0;
-  int i;
-  fd_set fds;
-  struct timeval tv;
-  t_print("%s: Entering Thread\n", __FUNCTION__);
-  g_mutex_lock(&mutex_a->m);
-  cat_control++;
-
-  if (rigctl_debug) { t_print("RIGCTL: SER INC cat_control=%d\n", cat_control); }
-
-  g_mutex_unlock(&mutex_a->m);
-  g_idle_add(ext_vfo_update, NULL);
-  client->running = TRUE;
-
-  while (client->running) {
-    //
-    // If the "serial line" is a FIFO, we must not drain it
-    // by reading our own responses (they must go to the other
-    // side). Therefore, wait until 50msec after the last
-    // CAT command of this client has been processed.
-    // If for some reason this does not happen, resume after
-    // waiting for about 500 msec.
-    // Check client->running after the "pause" and after returning
-    // from "read".
-    //
-    while (client->fifo && client->busy > 0) {
-      if (client->done) {
-        // command done, possibly response sent:
-        // wait 50 msec then resume listening
-        usleep(50000L);
-        break;
-      }
-
-      usleep(50000L);
-      client->busy--;
-    }
-
-    client->busy = 0;
-    client->done = 0;
-
-    if (!client->running) { break; }
-
-    //
-    // Blocking I/O with a time-out
-    //
-    FD_ZERO(&fds);
-    FD_SET(client->fd, &fds);
-    tv.tv_usec = 250000; // 250 msec
-    tv.tv_sec = 0;
-
-    if (select(client->fd + 1, &fds, NULL, NULL, &tv) <= 0) {
-      continue;
-    }
-
-    int numbytes = read (client->fd, cmd_input, sizeof cmd_input);
-
-    //
-    // On my MacOS using a FIFO, I have seen that numbytes can be -1
-    // (with errno = EAGAIN) although the select() inidcated that data
-    // is available. Therefore the serial thread is not shut down if
-    // the read() failed -- it will try again and again until it is
-    // shut down by the rigctl menu.
-
-    if (!client->running) { break; }
-
-    if (numbytes > 0) {
-      for (i = 0; i < numbytes; i++) {
-        command[command_index] = cmd_input[i];
-        command_index++;
-
-        if (cmd_input[i] == ';') {
-          command[command_index] = '\0';
-
-          if (rigctl_debug) { t_print("RIGCTL: serial command=%s\n", command); }
-
-          COMMAND *info = g_new(COMMAND, 1);
-          info->client = client;
-          info->command = command;
-          g_mutex_lock(&mutex_busy->m);
-          client->busy = 10;
-          g_idle_add(parse_cmd, info);
-          g_mutex_unlock(&mutex_busy->m);
-          command = g_new(char, MAXDATASIZE);
-          command_index = 0;
-        }
-      }
-    }
-  }
-
-  g_mutex_lock(&mutex_a->m);
-  cat_control--;
-
-  if (rigctl_debug) { t_print("RIGCTL: SER DEC - cat_control=%d\n", cat_control); }
-
-  g_mutex_unlock(&mutex_a->m);
-  g_idle_add(ext_vfo_update, NULL);
-  t_print("%s: Exiting Thread, running=%d\n", __FUNCTION__, client->running);
-  return NULL;
-}
-
 static int last_mox;
 static int last_tune;
 static int last_ps;
@@ -5794,15 +6223,12 @@ int launch_serial (int id) {
   int fd;
   int baud;
   t_print("%s: Open Serial Port %s\n", __FUNCTION__, SerialPorts[id].port);
-
-  if (mutex_busy == NULL) {
-    mutex_busy = g_new(GT_MUTEX, 1);
-    g_mutex_init(&mutex_busy->m);
-  }
+  rigctl_init_mutex();
+  cat_state_start();
 
   //
-  // Use O_NONBLOCK to prevent "hanging" upon open(), set blocking mode
-  // later.
+  // Use O_NONBLOCK to prevent "hanging" upon open(). The I/O thread
+  // uses non-blocking I/O anyway.
   //
   fd = open (SerialPorts[id].port, O_RDWR | O_NOCTTY | O_SYNC | O_NONBLOCK);
 
@@ -5812,8 +6238,7 @@ int launch_serial (int id) {
   }
 
   t_print("%s: serial port fd=%d\n", __FUNCTION__, fd);
-  serial_client[id].fd = fd;
-  serial_client[id].busy = 0;
+  rigctl_io_stop();
   serial_client[id].fifo = 0;
   // hard-wired parity = NONE
   // if ANDROMEDA, hard-wired baud = 9600
@@ -5822,7 +6247,7 @@ int launch_serial (int id) {
   if (SerialPorts[id].andromeda) { baud = B9600; }
 
   if (set_interface_attribs (fd, baud, 0) == 0) {
-    set_blocking (fd, 1);                   // set blocking
+    set_blocking (fd, 0);                   // set non-blocking
   } else {
     //
     // This tells the server that fd is something else
@@ -5833,9 +6258,20 @@ int launch_serial (int id) {
     serial_client[id].fifo = 1;
   }
 
-  serial_client[id].running = 1;
+  if (serial_client[id].out_buf == NULL) { serial_client[id].out_buf = g_new(char, RIGCTL_OUT_MAX); }
+
+  serial_client[id].serial = 1;
+  serial_client[id].hold = 0;
+  serial_client[id].command_index = 0;
   serial_client[id].andromeda_timer = 0;
-  serial_client[id].thread_id = g_thread_new( "Serial server", serial_server, &serial_client[id]);
+  g_mutex_lock(&io_mutex);
+  serial_client[id].fd = fd;
+  serial_client[id].out_len = 0;
+  serial_client[id].broken = 0;
+  serial_client[id].running = 1;
+  g_mutex_unlock(&io_mutex);
+  rigctl_cat_control(1);
+  rigctl_io_start();
   //
   // If this is a serial line to an ANDROMEDA controller, initialize it and start a periodic GTK task
   //
@@ -5859,28 +6295,20 @@ void launch_andromeda (int id) {
 void disable_serial (int id) {
   t_print("%s: Close Serial Port %s\n", __FUNCTION__, SerialPorts[id].port);
   disable_andromeda(id);
-  serial_client[id].running = FALSE;
-
-  if (serial_client[id].fifo) {
-    //
-    // If the "serial port" is a fifo then the serial thread
-    // may hang in a blocking read().
-    // Fortunately, we can set the thread free
-    // by sending something to the FIFO
-    //
-    write (serial_client[id].fd, "ID;", 3);
-  }
+  rigctl_io_stop();
 
-  // wait for the serial server actually terminating
-  if (serial_client[id].thread_id) {
-    g_thread_join(serial_client[id].thread_id);
-    serial_client[id].thread_id = NULL;
-  }
-
-  if (serial_client[id].fd >= 0) {
+  if (serial_client[id].running) {
+    g_mutex_lock(&io_mutex);
     close(serial_client[id].fd);
     serial_client[id].fd = -1;
+    serial_client[id].running = FALSE;
+    serial_client[id].out_len = 0;
+    g_mutex_unlock(&io_mutex);
+    rigctl_cat_control(-1);
   }
+
+  cat_hist_print();
+  rigctl_io_start();
 }
 
 void disable_andromeda (int id) {
@@ -5895,10 +6323,56 @@ void disable_andromeda (int id) {
 //                   (Port numbers now const ints instead of defines..)
 //
 void launch_rigctl () {
+  int on = 1;
+  int port = rigctl_port_base;
   t_print( "---- LAUNCHING RIGCTL ----\n");
-  cat_control = 0;
-  mutex_a = g_new(GT_MUTEX, 1); // memory leak
-  g_mutex_init(&mutex_a->m);
+  rigctl_init_mutex();
+  cat_state_start();
+
+  if (server_socket >= 0) { return; }
+
+  t_print("%s: starting TCP server on port %d\n", __FUNCTION__, port);
+  server_socket = socket(AF_INET, SOCK_STREAM, 0);
+
+  if (server_socket < 0) {
+    t_perror("rigctl_server: listen socket failed");
+    return;
+  }
+
+  setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  setsockopt(server_socket, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+  // bind to listening port
+  memset(&server_address, 0, sizeof(server_address));
+  server_address.sin_family = AF_INET;
+  server_address.sin_addr.s_addr = INADDR_ANY;
+  server_address.sin_port = htons(port);
+
+  if (bind(server_socket, (struct sockaddr * )&server_address, sizeof(server_address)) < 0) {
+    t_perror("rigctl_server: listen socket bind failed");
+    close(server_socket);
+    server_socket = -1;
+    return;
+  }
+
+  // listen with a max queue of 3
+  if (listen(server_socket, 3) < 0) {
+    t_perror("rigctl_server: listen failed");
+    close(server_socket);
+    server_socket = -1;
+    return;
+  }
+
+  fcntl(server_socket, F_SETFL, fcntl(server_socket, F_GETFL, 0) | O_NONBLOCK);
   server_running = 1;
-  rigctl_server_thread_id = g_thread_new( "rigctl server", rigctl_server, GINT_TO_POINTER(rigctl_port_base));
+  // must start the thread here in order NOT to inherit a lock
+  cw_buf_in = 0;
+  cw_buf_out = 0;
+
+  if (!rigctl_cw_thread_id) { rigctl_cw_thread_id = g_thread_new("RIGCTL cw", rigctl_cw_thread, NULL); }
+
+  //
+  // (re-)start the I/O thread such that it serves the listening socket
+  //
+  rigctl_io_stop();
+  rigctl_io_start();
 }
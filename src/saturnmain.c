@@ -129,98 +129,27 @@ IQHeadPtr[VNUMDDC];                                                      // ptr
 unsigned char*
 IQBasePtr[VNUMDDC];                                                      // ptr to DMA location in I/Q memory
 
-// Memory buffers to be exchanged with PiHPSDR APIs
-#define MAXMYBUF 3
-#define DDCMYBUF 0
-#define MICMYBUF 1
-#define HPMYBUF  2
+// Memory buffers to be exchanged with PiHPSDR APIs.
+// Note we need very few HighPrio buffers, a limited
+// amount of MicSample buffers, and a possibly large
+// amount of DDC IQ buffers. Each pool is only used by
+// one thread to obtain buffers.
 //
-// number of buffers allocated (for statistics)
-//
-static int num_buf[MAXMYBUF];
+#define DDC_POOL_SIZE 1024
+#define MIC_POOL_SIZE 32
+#define HP_POOL_SIZE  4
 
-//
-// head of buffer list
-//
-static mybuffer *buflist[MAXMYBUF];
+static mybuffer_pool *ddc_pool = NULL;
+static mybuffer_pool *mic_pool = NULL;
+static mybuffer_pool *hp_pool = NULL;
 
 //
-// Obtain a free buffer. If no one is available allocate
-// new ones. Note these buffer "live" as long as the
-// program lives. They are never released.
+// Discard all buffers that are still queued for processing
 //
-static mybuffer *get_my_buffer(int numlist) {
-  int i, j, first;
-  const char *desc;
-  mybuffer *bp = buflist[numlist];
-
-  while (bp) {
-    if (bp->free) {
-      // found free buffer. Mark as used and return that one.
-      bp->free = 0;
-      return bp;
-    }
-
-    bp = bp->next;
-  }
-
-  //
-  // No buffer free, or the first time we request a buffer:
-  // allocate (a) new one(s). Note we need very few
-  // HighPrio buffers, a limited amount of MicSample buffers,
-  // and a possibly large amount of DDC IQ buffers.
-  //
-  first = (bp == NULL);
-
-  switch (numlist) {
-  case HPMYBUF:
-    j = 1;
-    desc = "HP";
-    break;
-
-  case MICMYBUF:
-    j = 5;
-    desc = "MIC";
-    break;
-
-  case DDCMYBUF:
-    j = 25;
-    desc = "DDC";
-    break;
-
-  default:
-    // NOTREACHED
-    j = 5;
-    desc = "UNKNOWN";
-    break;
-  }
-
-  for (i = 0; i < j; i++) {
-    bp = malloc(sizeof(mybuffer));
-    bp->free = 1;
-    bp->next = buflist[numlist];
-    buflist[numlist] = bp;
-    num_buf[numlist]++;
-  }
-
-  t_print("%s: number of buffer[%s] %s to %d\n", __FUNCTION__, desc,
-          first ? "set" : "increased", num_buf[numlist]);
-  // Mark the first buffer in list as used and return that one.
-  buflist[numlist]->free = 0;
-  return buflist[numlist];
-}
-
 void saturn_free_buffers() {
-  mybuffer *mybuf;
-
-  for (int i = 0; i < MAXMYBUF; i++) {
-    mybuf = buflist[i];
-
-    while (mybuf) {
-      mybuf->free = 1;
-      mybuf = mybuf->next;
-    }
-  }
+  discard_pool_buffers(ddc_pool);
+  discard_pool_buffers(mic_pool);
+  discard_pool_buffers(hp_pool);
 }
 
 bool CreateDynamicMemory(void) {                            // return true if error
@@ -476,11 +405,11 @@ void saturn_handle_duc_iq(bool FromNetwork, uint8_t *UDPInBuffer) {
 #ifdef DISPLAY_OVER_UNDER_FLOWS
 
   if (FIFODUCOverThreshold) {
-    t_print("TX DUC FIFO Overthreshold, depth now = %d\n", Current);
+    t_log(T_WARNING, "TX DUC FIFO Overthreshold, depth now = %d\n", Current);
   }
 
   if (FIFODUCUnderflow) {
-    t_print("TX DUC FIFO Underflowed, depth now = %d\n", Current);
+    t_log(T_WARNING, "TX DUC FIFO Underflowed, depth now = %d\n", Current);
   }
 
 #endif
@@ -492,11 +421,11 @@ void saturn_handle_duc_iq(bool FromNetwork, uint8_t *UDPInBuffer) {
 #ifdef DISPLAY_OVER_UNDER_FLOWS
 
     if (FIFODUCOverThreshold) {
-      t_print("TX DUC FIFO Overthreshold, depth now = %d\n", Current);
+      t_log(T_WARNING, "TX DUC FIFO Overthreshold, depth now = %d\n", Current);
     }
 
     if (FIFODUCUnderflow) {
-      t_print("TX DUC FIFO Underflowed, depth now = %d\n", Current);
+      t_log(T_WARNING, "TX DUC FIFO Underflowed, depth now = %d\n", Current);
     }
 
 #endif
@@ -573,11 +502,11 @@ void saturn_handle_speaker_audio(uint8_t *UDPInBuffer) {
 #ifdef DISPLAY_OVER_UNDER_FLOWS
 
   if (FIFOSpkOverThreshold) {
-    t_print("Codec speaker FIFO Overthreshold, depth now = %d\n", Current);
+    t_log(T_WARNING, "Codec speaker FIFO Overthreshold, depth now = %d\n", Current);
   }
 
   if (FIFOSpkUnderflow) {
-    t_print("Codec Speaker FIFO Underflowed, depth now = %d\n", Current);
+    t_log(T_WARNING, "Codec Speaker FIFO Underflowed, depth now = %d\n", Current);
   }
 
 #endif
@@ -590,11 +519,11 @@ void saturn_handle_speaker_audio(uint8_t *UDPInBuffer) {
 #ifdef DISPLAY_OVER_UNDER_FLOWS
 
     if (FIFOSpkOverThreshold) {
-      t_print("Codec speaker FIFO Overthreshold, depth now = %d\n", Current);
+      t_log(T_WARNING, "Codec speaker FIFO Overthreshold, depth now = %d\n", Current);
     }
 
     if (FIFOSpkUnderflow) {
-      t_print("Codec Speaker FIFO Underflowed, depth now = %d\n", Current);
+      t_log(T_WARNING, "Codec Speaker FIFO Underflowed, depth now = %d\n", Current);
     }
 
 #endif
@@ -681,32 +610,34 @@ static gpointer saturn_high_priority_thread(gpointer arg) {
     while (SDRActive) {                            // main loop
       uint16_t SleepCount;                                      // counter for sending next message
       uint8_t PTTBits;                                          // PTT bits - and change means a new message needed
-      mybuffer *mybuf = get_my_buffer(HPMYBUF);
       ReadStatusRegister();
       PTTBits = (uint8_t)GetP2PTTKeyInputs();
-      *(uint8_t *)(UDPBuffer + 4) = *(uint8_t *)(mybuf->buffer + 4) = PTTBits;
+      *(uint8_t *)(UDPBuffer + 4) = PTTBits;
       Byte = (uint8_t)GetADCOverflow();
-      *(uint8_t *)(UDPBuffer + 5) = *(uint8_t *)(mybuf->buffer + 5) = Byte;
+      *(uint8_t *)(UDPBuffer + 5) = Byte;
       Byte = (uint8_t)GetUserIOBits();                                              // user I/O bits
-      *(uint8_t *)(UDPBuffer + 59) = *(uint8_t *)(mybuf->buffer + 59) = Byte;
+      *(uint8_t *)(UDPBuffer + 59) = Byte;
       Word = (uint16_t)GetAnalogueIn(4);
-      *(uint16_t *)(UDPBuffer + 6) = *(uint16_t *)(mybuf->buffer + 6) = htons(Word); // exciter power
+      *(uint16_t *)(UDPBuffer + 6) = htons(Word); // exciter power
       Word = (uint16_t)GetAnalogueIn(0);
-      *(uint16_t *)(UDPBuffer + 14) = *(uint16_t *)(mybuf->buffer + 14) = htons(Word); // forward power
+      *(uint16_t *)(UDPBuffer + 14) = htons(Word); // forward power
       Word = (uint16_t)GetAnalogueIn(1);
-      *(uint16_t *)(UDPBuffer + 22) = *(uint16_t *)(mybuf->buffer + 22) = htons(Word); // reverse power
+      *(uint16_t *)(UDPBuffer + 22) = htons(Word); // reverse power
       Word = (uint16_t)GetAnalogueIn(5);
-      *(uint16_t *)(UDPBuffer + 49) = *(uint16_t *)(mybuf->buffer + 49) = htons(Word); // supply voltage
+      *(uint16_t *)(UDPBuffer + 49) = htons(Word); // supply voltage
       Word = (uint16_t)GetAnalogueIn(2);
-      *(uint16_t *)(UDPBuffer + 57) = *(uint16_t *)(mybuf->buffer + 57) = htons(Word); // AIN3 user_analog1
+      *(uint16_t *)(UDPBuffer + 57) = htons(Word); // AIN3 user_analog1
       Word = (uint16_t)GetAnalogueIn(3);
-      *(uint16_t *)(UDPBuffer + 55) = *(uint16_t *)(mybuf->buffer + 55) = htons(Word); // AIN4 user_analog2
+      *(uint16_t *)(UDPBuffer + 55) = htons(Word); // AIN4 user_analog2
 
       if (TXActive != 2) {
-        *(uint32_t *)mybuf->buffer = htonl(SequenceCounter++);       // add sequence count
-        saturn_post_high_priority(mybuf);
-      } else {
-        mybuf->free = 1;
+        mybuffer *mybuf = get_my_buffer(hp_pool);
+
+        if (mybuf != NULL) {
+          memcpy(mybuf->buffer, UDPBuffer, VHIGHPRIOTIYFROMSDRSIZE);
+          *(uint32_t *)mybuf->buffer = htonl(SequenceCounter++);       // add sequence count
+          saturn_post_high_priority(mybuf);
+        }
       }
 
       if (ServerActive) {
@@ -875,16 +806,21 @@ static gpointer saturn_micaudio_thread(gpointer arg) {
 
       DMAReadFromFPGA(DMAReadfile_fd, MicBasePtr, VDMAMICTRANSFERSIZE, VADDRMICSTREAMREAD);
       // create the packet
-      mybuffer *mybuf = get_my_buffer(MICMYBUF);
-      *(uint32_t*)mybuf->buffer = htonl(SequenceCounter++);        // add sequence count
+      mybuffer *mybuf = get_my_buffer(mic_pool);
 
-      if (TXActive == 2) {
-        memset(mybuf->buffer + 4, 0, VDMAMICTRANSFERSIZE);  // copy in mic samples
-      } else {
-        memcpy(mybuf->buffer + 4, MicBasePtr, VDMAMICTRANSFERSIZE);  // copy in mic samples
+      if (mybuf != NULL) {
+        *(uint32_t*)mybuf->buffer = htonl(SequenceCounter);        // add sequence count
+
+        if (TXActive == 2) {
+          memset(mybuf->buffer + 4, 0, VDMAMICTRANSFERSIZE);  // copy in mic samples
+        } else {
+          memcpy(mybuf->buffer + 4, MicBasePtr, VDMAMICTRANSFERSIZE);  // copy in mic samples
+        }
+
+        saturn_post_micaudio(VMICPACKETSIZE, mybuf);
       }
 
-      saturn_post_micaudio(VMICPACKETSIZE, mybuf);
+      SequenceCounter++;
 
       if (ServerActive) {
         iovecinst.iov_base = UDPBuffer;
@@ -1040,7 +976,15 @@ static gpointer saturn_rx_thread(gpointer arg) {
       for (DDC = 0; DDC < VNUMDDC; DDC++) {
         while ((IQHeadPtr[DDC] - IQReadPtr[DDC]) > VIQBYTESPERFRAME) {
           //                    t_print("enough data for packet: DDC= %d\n", DDC);
-          mybuffer *mybuf = get_my_buffer(DDCMYBUF);
+          mybuffer *mybuf = get_my_buffer(ddc_pool);
+
+          if (mybuf == NULL) {
+            // no buffer available: drop this packet
+            IQReadPtr[DDC] += VIQBYTESPERFRAME;
+            SequenceCounter[DDC]++;
+            continue;
+          }
+
           *(uint32_t*)mybuf->buffer = htonl(SequenceCounter[DDC]++);     // add sequence count
           memset(mybuf->buffer + 4, 0, 8);                               // clear the timestamp data
           *(uint16_t*)(mybuf->buffer + 12) = htons(24);                  // bits per sample
@@ -1067,7 +1011,7 @@ static gpointer saturn_rx_thread(gpointer arg) {
               SequenceCounter[DDC] = 0;
             }
 
-            mybuf->free = 1;
+            release_my_buffer(mybuf);
           } else {
             saturn_post_iq_data(DDC - 6, mybuf);
           }
@@ -1252,6 +1196,15 @@ static gpointer saturn_rx_thread(gpointer arg) {
 }
 
 void saturn_init() {
+  //
+  // The buffer pools are allocated once and forever
+  //
+  if (ddc_pool == NULL) {
+    ddc_pool = create_buffer_pool("SATURN DDC", DDC_POOL_SIZE);
+    mic_pool = create_buffer_pool("SATURN MIC", MIC_POOL_SIZE);
+    hp_pool = create_buffer_pool("SATURN HP", HP_POOL_SIZE);
+  }
+
   saturn_init_speaker_audio();
   saturn_init_duc_iq();
   start_saturn_receive_thread();
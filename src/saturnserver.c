@@ -57,6 +57,7 @@
 #include "saturndrivers.h"
 #include "saturnmain.h"
 #include "message.h"
+#include "udprecv.h"
 
 struct sockaddr_in reply_addr;              // destination address for outgoing data
 
@@ -72,6 +73,7 @@ bool client_enable_tx = false;
 bool HW_Timer_Enable = true;
 
 #define VDISCOVERYSIZE 60                   // discovery packet
+#define VUDPBATCH 8                         // max. number of streaming packets read per system call
 #define VDISCOVERYREPLYSIZE 60              // reply packet
 #define VWIDEBANDSIZE 1028                  // wideband scalar samples
 #define VCONSTTXAMPLSCALEFACTOR 0x0001FFFF  // 18 bit scale value - set to 1/2 of full scale
@@ -660,10 +662,8 @@ void *IncomingDUCSpecific(void *arg) {                  // listener thread
 //
 void *IncomingSpkrAudio(void *arg) {                    // listener thread
   struct ThreadSocketData *ThreadData;                  // socket etc data for this thread
-  struct sockaddr_in addr_from;                         // holds MAC address of source of incoming messages
-  uint8_t UDPInBuffer[VSPEAKERAUDIOSIZE];               // incoming buffer
-  struct iovec iovecinst;                               // iovcnt buffer - 1 for each outgoing buffer
-  struct msghdr datagram;                               // multiple incoming message header
+  uint8_t UDPInBuffer[VUDPBATCH][VSPEAKERAUDIOSIZE];    // incoming buffers
+  UDP_RECV udprecv;                                     // batched receive
   //
   // variables for DMA buffer
   //
@@ -705,23 +705,25 @@ void *IncomingSpkrAudio(void *arg) {                    // listener thread
   //
   // main processing loop
   //
+  udp_recv_init(&udprecv, ThreadData->Socketid, VUDPBATCH, VSPEAKERAUDIOSIZE);
+
+  for (int i = 0; i < VUDPBATCH; i++) {
+    udprecv.buf[i] = UDPInBuffer[i];
+  }
+
   while (!ExitRequested) {
-    memset(&iovecinst, 0, sizeof(struct iovec));            // clear buffers
-    memset(&datagram, 0, sizeof(datagram));
-    iovecinst.iov_base = &UDPInBuffer;                      // set buffer for incoming message number i
-    iovecinst.iov_len = VSPEAKERAUDIOSIZE;
-    datagram.msg_iov = &iovecinst;
-    datagram.msg_iovlen = 1;
-    datagram.msg_name = &addr_from;
-    datagram.msg_namelen = sizeof(addr_from);
-    int size = recvmsg(ThreadData->Socketid, &datagram, 0);     // get one message. If it times out, sets size=-1
+    int count = udp_recv_batch(&udprecv, VUDPBATCH);        // get messages. If it times out, sets count=-1
 
-    if (size < 0 && errno != EAGAIN) {
+    if (count < 0 && errno != EAGAIN) {
       t_perror("recvfrom fail, Speaker data");
+      udp_recv_destroy(&udprecv);
       return NULL;
     }
 
-    if (size == VSPEAKERAUDIOSIZE) {                        // we have received a packet!
+    for (int i = 0; i < count; i++) {
+      if (udprecv.len[i] != VSPEAKERAUDIOSIZE) { continue; }
+
+      // we have received a packet!
       NewMessageReceived = true;
       //RegVal += 1;            //debug
       int Depth = ReadFIFOMonitorChannel(eSpkCodecDMA, &FIFOOverflow, &FIFOOverThreshold, &FIFOUnderflow,
@@ -739,7 +741,7 @@ void *IncomingSpkrAudio(void *arg) {                    // listener thread
       }
 
       // copy data from UDP Buffer & DMA write it
-      memcpy(SpkBasePtr, UDPInBuffer + 4, VDMATRANSFERSIZE);              // copy out spk samples
+      memcpy(SpkBasePtr, UDPInBuffer[i] + 4, VDMATRANSFERSIZE);           // copy out spk samples
       //            if(RegVal == 100)
       //                DumpMemoryBuffer(SpkBasePtr, VDMATRANSFERSIZE);
       DMAWriteToFPGA(DMAWritefile_fd, SpkBasePtr, VDMATRANSFERSIZE, VADDRSPKRSTREAMWRITE);
@@ -749,6 +751,8 @@ void *IncomingSpkrAudio(void *arg) {                    // listener thread
   //
   // close down thread
   //
+  udp_recv_print_statistics(&udprecv, "Speaker");
+  udp_recv_destroy(&udprecv);
   close(ThreadData->Socketid);                  // close incoming data socket
   ThreadData->Socketid = 0;
   ThreadData->Active = false;                   // indicate it is closed
@@ -768,43 +772,43 @@ void *IncomingSpkrAudio(void *arg) {                    // listener thread
 //
 void *IncomingDUCIQ(void *arg) {                        // listener thread
   struct ThreadSocketData *ThreadData;                  // socket etc data for this thread
-  struct sockaddr_in addr_from;                         // holds MAC address of source of incoming messages
-  uint8_t UDPInBuffer[VDUCIQSIZE];                      // incoming buffer
-  struct iovec iovecinst;                               // iovcnt buffer - 1 for each outgoing buffer
-  struct msghdr datagram;                               // multiple incoming message header
+  uint8_t UDPInBuffer[VUDPBATCH][VDUCIQSIZE];           // incoming buffers
+  UDP_RECV udprecv;                                     // batched receive
   ThreadData = (struct ThreadSocketData *)arg;
   ThreadData->Active = true;
   t_print("spinning up incoming DUC I/Q thread with port %d\n", ThreadData->Portid);
+  udp_recv_init(&udprecv, ThreadData->Socketid, VUDPBATCH, VDUCIQSIZE);
+
+  for (int i = 0; i < VUDPBATCH; i++) {
+    udprecv.buf[i] = UDPInBuffer[i];
+  }
 
   //
   //
   // main processing loop
   //
   while (!ExitRequested) {
-    memset(&iovecinst, 0, sizeof(struct iovec));
-    memset(&datagram, 0, sizeof(datagram));
-    iovecinst.iov_base = &UDPInBuffer;                  // set buffer for incoming message number i
-    iovecinst.iov_len = VDUCIQSIZE;
-    datagram.msg_iov = &iovecinst;
-    datagram.msg_iovlen = 1;
-    datagram.msg_name = &addr_from;
-    datagram.msg_namelen = sizeof(addr_from);
-    int size = recvmsg(ThreadData->Socketid, &datagram, 0);         // get one message. If it times out, ges size=-1
+    int count = udp_recv_batch(&udprecv, VUDPBATCH);    // get messages. If it times out, gets count=-1
 
-    if (size < 0 && errno != EAGAIN) {
+    if (count < 0 && errno != EAGAIN) {
       t_perror("recvfrom fail, TX I/Q data");
+      udp_recv_destroy(&udprecv);
       return NULL;
     }
 
-    if (size == VDUCIQSIZE) {
-      NewMessageReceived = true;
-      saturn_handle_duc_iq(true, UDPInBuffer);
+    for (int i = 0; i < count; i++) {
+      if (udprecv.len[i] == VDUCIQSIZE) {
+        NewMessageReceived = true;
+        saturn_handle_duc_iq(true, UDPInBuffer[i]);
+      }
     }
   }
 
   //
   // close down thread
   //
+  udp_recv_print_statistics(&udprecv, "DUC I/Q");
+  udp_recv_destroy(&udprecv);
   close(ThreadData->Socketid);                  // close incoming data socket
   ThreadData->Socketid = 0;
   ThreadData->Active = false;                   // indicate it is closed
@@ -127,7 +127,7 @@ void soapy_protocol_change_sample_rate(RECEIVER *rx) {
     }
 
     rx->resample_buffer_size = 2 * max_samples / (radio_sample_rate / rx->sample_rate);
-    rx->resample_buffer = g_new(double, rx->resample_buffer_size);
+    rx->resample_buffer = g_new(WDSP_REAL, rx->resample_buffer_size);
     rx->resampler = create_resample (1, max_samples, rx->buffer, rx->resample_buffer, radio_sample_rate, rx->sample_rate,
                                      0.0, 0, 1.0);
   }
@@ -180,7 +180,7 @@ void soapy_protocol_create_receiver(RECEIVER *rx) {
     max_samples = 2 * rx->fft_size;
   }
 
-  rx->buffer = g_new(double, max_samples * 2);
+  rx->buffer = g_new(WDSP_REAL, max_samples * 2);
 
   if (rx->sample_rate == radio_sample_rate) {
     rx->resample_buffer = NULL;
@@ -188,7 +188,7 @@ void soapy_protocol_create_receiver(RECEIVER *rx) {
     rx->resample_buffer_size = 0;
   } else {
     rx->resample_buffer_size = 2 * max_samples / (radio_sample_rate / rx->sample_rate);
-    rx->resample_buffer = g_new(double, rx->resample_buffer_size);
+    rx->resample_buffer = g_new(WDSP_REAL, rx->resample_buffer_size);
     rx->resampler = create_resample (1, max_samples, rx->buffer, rx->resample_buffer, radio_sample_rate, rx->sample_rate,
                                      0.0, 0, 1.0);
   }
@@ -333,8 +333,6 @@ void soapy_protocol_init(gboolean hf) {
 }
 
 static void *receive_thread(void *arg) {
-  double isample;
-  double qsample;
   int flags = 0;
   long long timeNs = 0;
   long timeoutUs = 100000L;
@@ -357,62 +355,44 @@ static void *receive_thread(void *arg) {
     }
 
     for (i = 0; i < elements; i++) {
-      rx->buffer[i * 2] = (double)buffer[i * 2];
-      rx->buffer[(i * 2) + 1] = (double)buffer[(i * 2) + 1];
+      rx->buffer[i * 2] = (WDSP_REAL)buffer[i * 2];
+      rx->buffer[(i * 2) + 1] = (WDSP_REAL)buffer[(i * 2) + 1];
     }
 
+    WDSP_REAL *iq;
+    int samples;
+
     if (rx->resampler != NULL) {
-      int samples = xresample(rx->resampler);
+      samples = xresample(rx->resampler);
+      iq = rx->resample_buffer;
+    } else {
+      samples = elements;
+      iq = rx->buffer;
+    }
 
+    if (iqswap) {
       for (i = 0; i < samples; i++) {
-        isample = rx->resample_buffer[i * 2];
-        qsample = rx->resample_buffer[(i * 2) + 1];
-
-        if (iqswap) {
-          add_iq_samples(rx, qsample, isample);
-        } else {
-          add_iq_samples(rx, isample, qsample);
-        }
-
-        if (can_transmit) {
-          mic_samples++;
-
-          if (mic_samples >= mic_sample_divisor) { // reduce to 48000
-            if (transmitter != NULL) {
-              fsample = transmitter->local_microphone ? audio_get_next_mic_sample() : 0.0F;
-            } else {
-              fsample = 0.0F;
-            }
-
-            add_mic_sample(transmitter, fsample);
-            mic_samples = 0;
-          }
-        }
+        WDSP_REAL tmp = iq[i * 2];
+        iq[i * 2] = iq[(i * 2) + 1];
+        iq[(i * 2) + 1] = tmp;
       }
-    } else {
-      for (i = 0; i < elements; i++) {
-        isample = rx->buffer[i * 2];
-        qsample = rx->buffer[(i * 2) + 1];
-
-        if (iqswap) {
-          add_iq_samples(rx, qsample, isample);
-        } else {
-          add_iq_samples(rx, isample, qsample);
-        }
+    }
 
-        if (can_transmit) {
-          mic_samples++;
+    add_iq_samples_block(rx, iq, samples);
 
-          if (mic_samples >= mic_sample_divisor) { // reduce to 48000
-            if (transmitter != NULL) {
-              fsample = transmitter->local_microphone ? audio_get_next_mic_sample() : 0.0F;
-            } else {
-              fsample = 0.0F;
-            }
+    if (can_transmit) {
+      for (i = 0; i < samples; i++) {
+        mic_samples++;
 
-            add_mic_sample(transmitter, fsample);
-            mic_samples = 0;
+        if (mic_samples >= mic_sample_divisor) { // reduce to 48000
+          if (transmitter != NULL) {
+            fsample = transmitter->local_microphone ? audio_get_next_mic_sample() : 0.0F;
+          } else {
+            fsample = 0.0F;
           }
+
+          add_mic_sample(transmitter, fsample);
+          mic_samples = 0;
         }
       }
     }
@@ -681,6 +681,7 @@ TRANSMITTER *create_transmitter(int id, int width, int height) {
   tx->id = id;
   tx->dac = 0;
   tx->fps = 10;
+  tx->fexchange_usec = metric_histogram("tx%d_fexchange_usec", id);
   tx->display_filled = 0;
   tx->dsp_size = 2048;
   tx->low_latency = 0;
@@ -790,8 +791,8 @@ TRANSMITTER *create_transmitter(int id, int width, int height) {
   // allocate buffers
   t_print("transmitter: allocate buffers: mic_input_buffer=%d iq_output_buffer=%d pixels=%d\n", tx->buffer_size,
           tx->output_samples, tx->pixels);
-  tx->mic_input_buffer = g_new(double, 2 * tx->buffer_size);
-  tx->iq_output_buffer = g_new(double, 2 * tx->output_samples);
+  tx->mic_input_buffer = g_new(WDSP_REAL, 2 * tx->buffer_size);
+  tx->iq_output_buffer = g_new(WDSP_REAL, 2 * tx->output_samples);
   tx->samples = 0;
   tx->pixel_samples = g_new(float, tx->pixels);
 
@@ -1013,7 +1014,7 @@ static void full_tx_buffer(TRANSMITTER *tx) {
   long isample;
   long qsample;
   double gain, sidevol, ramp;
-  double *dp;
+  WDSP_REAL *dp;
   int j;
   int error;
   int cwmode;
@@ -1055,7 +1056,9 @@ static void full_tx_buffer(TRANSMITTER *tx) {
     // signal to generate the RF pulse is that we do not want MicGain
     // and equalizer settings to interfere.
     //
+    gint64 start = g_get_monotonic_time();
     fexchange0(tx->id, tx->mic_input_buffer, tx->iq_output_buffer, &error);
+    metric_observe(tx->fexchange_usec, g_get_monotonic_time() - start);
     //
     // Construct our CW TX signal in tx->iq_output_buffer for the sole
     // purpose of displaying them in the TX panadapter
@@ -1112,10 +1115,12 @@ static void full_tx_buffer(TRANSMITTER *tx) {
       }
     }
 
+    gint64 start = g_get_monotonic_time();
     fexchange0(tx->id, tx->mic_input_buffer, tx->iq_output_buffer, &error);
+    metric_observe(tx->fexchange_usec, g_get_monotonic_time() - start);
 
     if (error != 0) {
-      t_print("full_tx_buffer: id=%d fexchange0: error=%d\n", tx->id, error);
+      t_log(T_WARNING, "full_tx_buffer: id=%d fexchange0: error=%d\n", tx->id, error);
     }
   }
 
@@ -1491,6 +1496,53 @@ void add_mic_sample(TRANSMITTER *tx, float mic_sample) {
   }
 }
 
+//
+// Called when the PureSignal feedback buffers are full
+//
+static void full_ps_buffer(TRANSMITTER *tx) {
+  RECEIVER *tx_feedback = receiver[PS_TX_FEEDBACK];
+  RECEIVER *rx_feedback = receiver[PS_RX_FEEDBACK];
+
+  if (isTransmitting()) {
+    int txmode = get_tx_mode();
+    int cwmode = (txmode == modeCWL || txmode == modeCWU) && !tune && !tx->twotone;
+#if 0
+    //
+    // Special code to document the amplitude of the TX IQ samples.
+    // This can be used to determine the "PK" value for an unknown
+    // radio.
+    //
+    double pkmax = 0.0, pkval;
+
+    for (int i = 0; i < rx_feedback->buffer_size; i++) {
+      pkval = tx_feedback->iq_input_buffer[2 * i] * tx_feedback->iq_input_buffer[2 * i] +
+              tx_feedback->iq_input_buffer[2 * i + 1] * tx_feedback->iq_input_buffer[2 * i + 1];
+
+      if (pkval > pkmax) { pkmax = pkval; }
+    }
+
+    t_print("PK MEASURED: %f\n", sqrt(pkmax));
+#endif
+
+    if (!cwmode) {
+      //
+      // Since we are not using WDSP in CW transmit, it also makes little sense to
+      // deliver feedback samples
+      //
+      pscc(tx->id, rx_feedback->buffer_size, tx_feedback->iq_input_buffer, rx_feedback->iq_input_buffer);
+    }
+
+    if (tx->displaying && tx->feedback) {
+      g_mutex_lock(&rx_feedback->display_mutex);
+      Spectrum0(1, rx_feedback->id, 0, 0, rx_feedback->iq_input_buffer);
+      g_mutex_unlock(&rx_feedback->display_mutex);
+    }
+  }
+
+  rx_feedback->samples = 0;
+  tx_feedback->samples = 0;
+}
+
 void add_ps_iq_samples(TRANSMITTER *tx, double i_sample_tx, double q_sample_tx, double i_sample_rx,
                        double q_sample_rx) {
   RECEIVER *tx_feedback = receiver[PS_TX_FEEDBACK];
@@ -1512,44 +1564,45 @@ void add_ps_iq_samples(TRANSMITTER *tx, double i_sample_tx, double q_sample_tx,
   rx_feedback->samples = rx_feedback->samples + 1;
 
   if (rx_feedback->samples >= rx_feedback->buffer_size) {
-    if (isTransmitting()) {
-      int txmode = get_tx_mode();
-      int cwmode = (txmode == modeCWL || txmode == modeCWU) && !tune && !tx->twotone;
-#if 0
-      //
-      // Special code to document the amplitude of the TX IQ samples.
-      // This can be used to determine the "PK" value for an unknown
-      // radio.
-      //
-      double pkmax = 0.0, pkval;
+    full_ps_buffer(tx);
+  }
+}
+
+//
+// Block version of add_ps_iq_samples: n pairs of TX and RX feedback samples
+// (interleaved I/Q), which are only split where the feedback buffers become full.
+//
+void add_ps_iq_samples_block(TRANSMITTER *tx, const WDSP_REAL *iq_tx, const WDSP_REAL *iq_rx, int n) {
+  RECEIVER *tx_feedback = receiver[PS_TX_FEEDBACK];
+  RECEIVER *rx_feedback = receiver[PS_RX_FEEDBACK];
 
-      for (int i = 0; i < rx_feedback->buffer_size; i++) {
-        pkval = tx_feedback->iq_input_buffer[2 * i] * tx_feedback->iq_input_buffer[2 * i] +
-                tx_feedback->iq_input_buffer[2 * i + 1] * tx_feedback->iq_input_buffer[2 * i + 1];
+  while (n > 0) {
+    int chunk = rx_feedback->buffer_size - rx_feedback->samples;
 
-        if (pkval > pkmax) { pkmax = pkval; }
-      }
+    if (chunk > n) { chunk = n; }
 
-      t_print("PK MEASURED: %f\n", sqrt(pkmax));
-#endif
+    WDSP_REAL *dst = &tx_feedback->iq_input_buffer[tx_feedback->samples * 2];
 
-      if (!cwmode) {
-        //
-        // Since we are not using WDSP in CW transmit, it also makes little sense to
-        // deliver feedback samples
-        //
-        pscc(tx->id, rx_feedback->buffer_size, tx_feedback->iq_input_buffer, rx_feedback->iq_input_buffer);
-      }
+    if (tx->do_scale) {
+      const double scale = tx->drive_iscal;
 
-      if (tx->displaying && tx->feedback) {
-        g_mutex_lock(&rx_feedback->display_mutex);
-        Spectrum0(1, rx_feedback->id, 0, 0, rx_feedback->iq_input_buffer);
-        g_mutex_unlock(&rx_feedback->display_mutex);
+      for (int i = 0; i < 2 * chunk; i++) {
+        dst[i] = iq_tx[i] * scale;
       }
+    } else {
+      memcpy(dst, iq_tx, 2 * chunk * sizeof(WDSP_REAL));
     }
 
-    rx_feedback->samples = 0;
-    tx_feedback->samples = 0;
+    memcpy(&rx_feedback->iq_input_buffer[rx_feedback->samples * 2], iq_rx, 2 * chunk * sizeof(WDSP_REAL));
+    tx_feedback->samples += chunk;
+    rx_feedback->samples += chunk;
+    iq_tx += 2 * chunk;
+    iq_rx += 2 * chunk;
+    n -= chunk;
+
+    if (rx_feedback->samples >= rx_feedback->buffer_size) {
+      full_ps_buffer(tx);
+    }
   }
 }
 
@@ -20,6 +20,7 @@
 #define _TRANSMITTER_H
 
 #include <gtk/gtk.h>
+#include "metrics.h"
 
 #define CTCSS_FREQUENCIES 38
 extern double ctcss_frequencies[CTCSS_FREQUENCIES];
@@ -39,8 +40,8 @@ typedef struct _transmitter {
   int pixels;
   int samples;
   int output_samples;
-  double *mic_input_buffer;
-  double *iq_output_buffer;
+  WDSP_REAL *mic_input_buffer;
+  WDSP_REAL *iq_output_buffer;
 
   float *pixel_samples;
   int display_panadapter;
@@ -125,6 +126,8 @@ typedef struct _transmitter {
 
   int display_filled;
 
+  METRIC *fexchange_usec;     // performance counter: time spent in fexchange0
+
 } TRANSMITTER;
 
 extern TRANSMITTER *create_transmitter(int id, int width, int height);
@@ -161,6 +164,7 @@ extern void transmitter_set_compressor(TRANSMITTER *tx, int state);
 extern void tx_set_ps_sample_rate(TRANSMITTER *tx, int rate);
 extern void add_ps_iq_samples(TRANSMITTER *tx, double i_sample_0, double q_sample_0, double i_sample_1,
                               double q_sample_1);
+extern void add_ps_iq_samples_block(TRANSMITTER *tx, const WDSP_REAL *iq_tx, const WDSP_REAL *iq_rx, int n);
 
 extern void cw_hold_key(int state);
 
@@ -0,0 +1,116 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// On Linux, recvmmsg() is used with MSG_WAITFORONE: it blocks (or times
+// out, if a receive timeout is set on the socket) until the first datagram
+// arrives, and then takes whatever else is already queued in the socket, up to
+// the batch size. On other systems (MacOS), one datagram is received per call.
+//
+
+#if defined(__linux__)
+  #define _GNU_SOURCE    // for recvmmsg
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "udprecv.h"
+#include "message.h"
+
+void udp_recv_init(UDP_RECV *ur, int fd, int batch, int buflen) {
+  memset(ur, 0, sizeof(UDP_RECV));
+
+  if (batch < 1) { batch = 1; }
+
+  if (batch > UDP_RECV_MAX_BATCH) { batch = UDP_RECV_MAX_BATCH; }
+
+#if !defined(__linux__)
+  batch = 1;
+#endif
+  ur->fd = fd;
+  ur->batch = batch;
+  ur->buflen = buflen;
+#if defined(__linux__)
+  ur->msg = calloc(batch, sizeof(struct mmsghdr));
+  ur->iov = calloc(batch, sizeof(struct iovec));
+#endif
+}
+
+void udp_recv_destroy(UDP_RECV *ur) {
+  free(ur->msg);
+  free(ur->iov);
+  ur->msg = NULL;
+  ur->iov = NULL;
+}
+
+//
+// Receive up to n (but not more than the batch size) datagrams into
+// buf[0...n-1]. Returns the number of datagrams received, or -1
+// (with errno set) if the call failed or timed out.
+//
+int udp_recv_batch(UDP_RECV *ur, int n) {
+  int rc;
+
+  if (n > ur->batch) { n = ur->batch; }
+
+  if (n < 1) { n = 1; }
+
+#if defined(__linux__)
+
+  for (int i = 0; i < n; i++) {
+    ur->iov[i].iov_base = ur->buf[i];
+    ur->iov[i].iov_len = ur->buflen;
+    memset(&ur->msg[i].msg_hdr, 0, sizeof(struct msghdr));
+    ur->msg[i].msg_hdr.msg_iov = &ur->iov[i];
+    ur->msg[i].msg_hdr.msg_iovlen = 1;
+    ur->msg[i].msg_hdr.msg_name = &ur->addr[i];
+    ur->msg[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+  }
+
+  rc = recvmmsg(ur->fd, ur->msg, n, MSG_WAITFORONE, NULL);
+
+  for (int i = 0; i < rc; i++) {
+    ur->len[i] = ur->msg[i].msg_len;
+  }
+
+#else
+  socklen_t length = sizeof(struct sockaddr_in);
+  ur->len[0] = recvfrom(ur->fd, ur->buf[0], ur->buflen, 0, (struct sockaddr *)&ur->addr[0], &length);
+  rc = (ur->len[0] < 0) ? -1 : 1;
+#endif
+
+  if (rc > 0) {
+    ur->syscalls++;
+    ur->packets += rc;
+    ur->hist[rc]++;
+  }
+
+  return rc;
+}
+
+void udp_recv_print_statistics(const UDP_RECV *ur, const char *name) {
+  int max = 0;
+
+  for (int i = 1; i <= UDP_RECV_MAX_BATCH; i++) {
+    if (ur->hist[i] > 0) { max = i; }
+  }
+
+  t_print("%s: %s: batch=%d calls=%ld packets=%ld avg=%.2f max=%d packets/call\n", __FUNCTION__, name,
+          ur->batch, ur->syscalls, ur->packets,
+          ur->syscalls > 0 ? (double) ur->packets / (double) ur->syscalls : 0.0, max);
+}
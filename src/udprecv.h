@@ -0,0 +1,60 @@
+/*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Receiving a batch of UDP datagrams with a single system call.
+//
+// The caller fills buf[0...n-1] with the buffers to receive into
+// (they may change from call to call), and udp_recv_batch() then
+// returns the number of datagrams received. For each datagram, the
+// length is in len[] and the source address in addr[].
+//
+
+#ifndef _UDPRECV_H_
+#define _UDPRECV_H_
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#define UDP_RECV_MAX_BATCH 64
+
+typedef struct _udp_recv {
+  int                fd;
+  int                batch;                         // max. number of datagrams per call
+  int                buflen;                        // size of each buffer
+  unsigned char      *buf[UDP_RECV_MAX_BATCH];
+  int                len[UDP_RECV_MAX_BATCH];
+  struct sockaddr_in addr[UDP_RECV_MAX_BATCH];
+  //
+  // statistics
+  //
+  long               syscalls;                      // number of successful calls
+  long               packets;                       // number of datagrams received
+  long               hist[UDP_RECV_MAX_BATCH + 1];  // hist[i]: number of calls that returned i datagrams
+  //
+  // used internally
+  //
+  struct mmsghdr     *msg;
+  struct iovec       *iov;
+} UDP_RECV;
+
+extern void udp_recv_init(UDP_RECV *ur, int fd, int batch, int buflen);
+extern void udp_recv_destroy(UDP_RECV *ur);
+extern int  udp_recv_batch(UDP_RECV *ur, int n);
+extern void udp_recv_print_statistics(const UDP_RECV *ur, const char *name);
+
+#endif
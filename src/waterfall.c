@@ -22,6 +22,7 @@
 #include <unistd.h>
 #include <semaphore.h>
 #include <string.h>
+#include <stdint.h>
 #include "radio.h"
 #include "vfo.h"
 #include "band.h"
@@ -40,6 +41,70 @@ static int colorHighB = 0;
 
 static double hz_per_pixel;
 
+//
+// colour map, indexed by (int)(255 * percent) where percent is the
+// relative position of the sample value between wf_low and wf_high.
+// The entries are pixel values in the CAIRO_FORMAT_RGB24 format.
+//
+static uint32_t colormap[256];
+static uint32_t colorLow;
+static uint32_t colorHigh;
+
+static uint32_t rgb24(int r, int g, int b) {
+  return ((uint32_t) r << 16) | ((uint32_t) g << 8) | (uint32_t) b;
+}
+
+static void waterfall_colormap_init() {
+  colorLow = rgb24(colorLowR, colorLowG, colorLowB);
+  colorHigh = rgb24(colorHighR, colorHighG, colorHighB);
+
+  for (int i = 0; i < 256; i++) {
+    float percent = (float) i / 255.0F;
+
+    if (percent < 0.222222f) {
+      float local_percent = percent * 4.5f;
+      colormap[i] = rgb24((int)((1.0f - local_percent) * colorLowR),
+                          (int)((1.0f - local_percent) * colorLowG),
+                          (int)(colorLowB + local_percent * (255 - colorLowB)));
+    } else if (percent < 0.333333f) {
+      float local_percent = (percent - 0.222222f) * 9.0f;
+      colormap[i] = rgb24(0, (int)(local_percent * 255), 255);
+    } else if (percent < 0.444444f) {
+      float local_percent = (percent - 0.333333) * 9.0f;
+      colormap[i] = rgb24(0, 255, (int)((1.0f - local_percent) * 255));
+    } else if (percent < 0.555555f) {
+      float local_percent = (percent - 0.444444f) * 9.0f;
+      colormap[i] = rgb24((int)(local_percent * 255), 255, 0);
+    } else if (percent < 0.777777f) {
+      float local_percent = (percent - 0.555555f) * 4.5f;
+      colormap[i] = rgb24(255, (int)((1.0f - local_percent) * 255), 0);
+    } else if (percent < 0.888888f) {
+      float local_percent = (percent - 0.777777f) * 9.0f;
+      colormap[i] = rgb24(255, 0, (int)(local_percent * 255));
+    } else {
+      float local_percent = (percent - 0.888888f) * 9.0f;
+      colormap[i] = rgb24((int)((0.75f + 0.25f * (1.0f - local_percent)) * 255.0f),
+                          (int)(local_percent * 255.0f * 0.5f), 255);
+    }
+  }
+}
+
+//
+// The waterfall image is a ring buffer of rows: rx->waterfall_head is the
+// row that holds the newest line, which is drawn at the top, followed by
+// the rows head+1, head+2, ... (wrapping around). So adding a new line
+// only touches that line, and the image is drawn in two pieces.
+// A cairo image surface (rather than a GdkPixbuf) is used such that
+// drawing needs no conversion of the image.
+//
+static void waterfall_clear(RECEIVER *rx) {
+  cairo_surface_flush(rx->waterfall_surface);
+  memset(cairo_image_surface_get_data(rx->waterfall_surface), 0,
+         cairo_image_surface_get_stride(rx->waterfall_surface) * cairo_image_surface_get_height(rx->waterfall_surface));
+  cairo_surface_mark_dirty(rx->waterfall_surface);
+  rx->waterfall_head = 0;
+}
+
 static int my_width;
 static int my_heigt;
 
@@ -51,9 +116,13 @@ waterfall_configure_event_cb (GtkWidget         *widget,
   RECEIVER *rx = (RECEIVER *)data;
   my_width = gtk_widget_get_allocated_width (widget);
   my_heigt = gtk_widget_get_allocated_height (widget);
-  rx->pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, my_width, my_heigt);
-  unsigned char *pixels = gdk_pixbuf_get_pixels (rx->pixbuf);
-  memset(pixels, 0, my_width * my_heigt * 3);
+
+  if (rx->waterfall_surface) {
+    cairo_surface_destroy (rx->waterfall_surface);
+  }
+
+  rx->waterfall_surface = cairo_image_surface_create(CAIRO_FORMAT_RGB24, my_width, my_heigt);
+  waterfall_clear(rx);
   return TRUE;
 }
 
@@ -66,8 +135,25 @@ waterfall_draw_cb (GtkWidget *widget,
                    cairo_t   *cr,
                    gpointer   data) {
   const RECEIVER *rx = (RECEIVER *)data;
-  gdk_cairo_set_source_pixbuf (cr, rx->pixbuf, 0, 0);
-  cairo_paint (cr);
+
+  if (rx->waterfall_surface) {
+    int width = cairo_image_surface_get_width(rx->waterfall_surface);
+    int height = cairo_image_surface_get_height(rx->waterfall_surface);
+    int head = rx->waterfall_head;
+    //
+    // rows head ... height-1 at the top, rows 0 ... head-1 below
+    //
+    cairo_set_source_surface (cr, rx->waterfall_surface, 0, -head);
+    cairo_rectangle (cr, 0, 0, width, height - head);
+    cairo_fill (cr);
+
+    if (head > 0) {
+      cairo_set_source_surface (cr, rx->waterfall_surface, 0, height - head);
+      cairo_rectangle (cr, 0, height - head, width, head);
+      cairo_fill (cr);
+    }
+  }
+
   return FALSE;
 }
 
@@ -114,11 +200,12 @@ void waterfall_update(RECEIVER *rx) {
 
 #endif
 
-  if (rx->pixbuf) {
-    unsigned char *pixels = gdk_pixbuf_get_pixels (rx->pixbuf);
-    int width = gdk_pixbuf_get_width(rx->pixbuf);
-    int height = gdk_pixbuf_get_height(rx->pixbuf);
-    int rowstride = gdk_pixbuf_get_rowstride(rx->pixbuf);
+  if (rx->waterfall_surface) {
+    cairo_surface_flush(rx->waterfall_surface);
+    unsigned char *pixels = cairo_image_surface_get_data(rx->waterfall_surface);
+    int width = cairo_image_surface_get_width(rx->waterfall_surface);
+    int height = cairo_image_surface_get_height(rx->waterfall_surface);
+    int rowstride = cairo_image_surface_get_stride(rx->waterfall_surface);
     hz_per_pixel = (double)rx->sample_rate / ((double)my_width * rx->zoom);
 
     //
@@ -145,7 +232,7 @@ void waterfall_update(RECEIVER *rx) {
           //
           // If horizontal shift is too large, re-init waterfall
           //
-          memset(pixels, 0, my_width * my_heigt * 3);
+          waterfall_clear(rx);
           rx->waterfall_frequency = vfofreq;
           rx->waterfall_pan = pan;
         } else {
@@ -156,20 +243,22 @@ void waterfall_update(RECEIVER *rx) {
           //
           if (rotate_pixels < 0) {
             // shift left, and clear the right-most part
-            memmove(pixels, &pixels[-rotate_pixels * 3], ((my_width * my_heigt) + rotate_pixels) * 3);
-
-            for (i = 0; i < my_heigt; i++) {
-              memset(&pixels[((i * my_width) + (width + rotate_pixels)) * 3], 0, -rotate_pixels * 3);
+            for (i = 0; i < height; i++) {
+              uint32_t *row = (uint32_t *) &pixels[i * rowstride];
+              memmove(row, &row[-rotate_pixels], (width + rotate_pixels) * sizeof(uint32_t));
+              memset(&row[width + rotate_pixels], 0, -rotate_pixels * sizeof(uint32_t));
             }
           } else if (rotate_pixels > 0) {
             // shift right, and clear left-most part
-            memmove(&pixels[rotate_pixels * 3], pixels, ((my_width * my_heigt) - rotate_pixels) * 3);
-
-            for (i = 0; i < my_heigt; i++) {
-              memset(&pixels[(i * my_width) * 3], 0, rotate_pixels * 3);
+            for (i = 0; i < height; i++) {
+              uint32_t *row = (uint32_t *) &pixels[i * rowstride];
+              memmove(&row[rotate_pixels], row, (width - rotate_pixels) * sizeof(uint32_t));
+              memset(row, 0, rotate_pixels * sizeof(uint32_t));
             }
           }
 
+          cairo_surface_mark_dirty(rx->waterfall_surface);
+
           if (rotfreq != 0) {
             freq_changed = 1;
             rx->waterfall_frequency -= lround(rotfreq * hz_per_pixel); // this is not necessarily vfofreq!
@@ -183,7 +272,7 @@ void waterfall_update(RECEIVER *rx) {
       // waterfall frequency not (yet) set, sample rate changed, or zoom value changed:
       // (re-) init waterfall
       //
-      memset(pixels, 0, my_width * my_heigt * 3);
+      waterfall_clear(rx);
       rx->waterfall_frequency = vfofreq;
       rx->waterfall_pan = pan;
       rx->waterfall_zoom = zoom;
@@ -201,11 +290,14 @@ void waterfall_update(RECEIVER *rx) {
     // improvement.
     //
     if (!freq_changed) {
-      memmove(&pixels[rowstride], pixels, (height - 1)*rowstride);
       float soffset;
       float average;
-      unsigned char *p;
-      p = pixels;
+      uint32_t *p;
+      //
+      // The new line goes into the row preceding the current head
+      //
+      rx->waterfall_head = (rx->waterfall_head == 0) ? height - 1 : rx->waterfall_head - 1;
+      p = (uint32_t *) &pixels[rx->waterfall_head * rowstride];
       samples = rx->pixel_samples;
       float wf_low, wf_high, rangei;
       int id = rx->id;
@@ -245,54 +337,15 @@ void waterfall_update(RECEIVER *rx) {
         float sample = samples[i + pan] + soffset;
 
         if (sample < wf_low) {
-          *p++ = colorLowR;
-          *p++ = colorLowG;
-          *p++ = colorLowB;
+          *p++ = colorLow;
         } else if (sample > wf_high) {
-          *p++ = colorHighR;
-          *p++ = colorHighG;
-          *p++ = colorHighB;
+          *p++ = colorHigh;
         } else {
-          float percent = (sample - wf_low) * rangei;
-
-          if (percent < 0.222222f) {
-            float local_percent = percent * 4.5f;
-            *p++ = (int)((1.0f - local_percent) * colorLowR);
-            *p++ = (int)((1.0f - local_percent) * colorLowG);
-            *p++ = (int)(colorLowB + local_percent * (255 - colorLowB));
-          } else if (percent < 0.333333f) {
-            float local_percent = (percent - 0.222222f) * 9.0f;
-            *p++ = 0;
-            *p++ = (int)(local_percent * 255);
-            *p++ = 255;
-          } else if (percent < 0.444444f) {
-            float local_percent = (percent - 0.333333) * 9.0f;
-            *p++ = 0;
-            *p++ = 255;
-            *p++ = (int)((1.0f - local_percent) * 255);
-          } else if (percent < 0.555555f) {
-            float local_percent = (percent - 0.444444f) * 9.0f;
-            *p++ = (int)(local_percent * 255);
-            *p++ = 255;
-            *p++ = 0;
-          } else if (percent < 0.777777f) {
-            float local_percent = (percent - 0.555555f) * 4.5f;
-            *p++ = 255;
-            *p++ = (int)((1.0f - local_percent) * 255);
-            *p++ = 0;
-          } else if (percent < 0.888888f) {
-            float local_percent = (percent - 0.777777f) * 9.0f;
-            *p++ = 255;
-            *p++ = 0;
-            *p++ = (int)(local_percent * 255);
-          } else {
-            float local_percent = (percent - 0.888888f) * 9.0f;
-            *p++ = (int)((0.75f + 0.25f * (1.0f - local_percent)) * 255.0f);
-            *p++ = (int)(local_percent * 255.0f * 0.5f);
-            *p++ = 255;
-          }
+          *p++ = colormap[(int)((sample - wf_low) * rangei * 255.0F)];
         }
       }
+
+      cairo_surface_mark_dirty_rectangle(rx->waterfall_surface, 0, rx->waterfall_head, width, 1);
     }
 
     gtk_widget_queue_draw (rx->waterfall);
@@ -302,7 +355,9 @@ void waterfall_update(RECEIVER *rx) {
 void waterfall_init(RECEIVER *rx, int width, int height) {
   my_width = width;
   my_heigt = height;
-  rx->pixbuf = NULL;
+  rx->waterfall_surface = NULL;
+  rx->waterfall_head = 0;
+  waterfall_colormap_init();
   rx->waterfall_frequency = 0;
   rx->waterfall_sample_rate = 0;
   rx->waterfall = gtk_drawing_area_new ();
@@ -32,14 +32,14 @@ typedef struct _ammod
     int run;
     int mode;
     int size;
-    double* in;
-    double* out;
-    double c_level;
-    double a_level;
-    double mult;
+    real* in;
+    real* out;
+    real c_level;
+    real a_level;
+    real mult;
 }ammod, *AMMOD;
 
-extern AMMOD create_ammod (int run, int mode, int size, double* in, double* out, double c_level);
+extern AMMOD create_ammod (int run, int mode, int size, real* in, real* out, real c_level);
 
 extern void destroy_ammod (AMMOD a);
 
@@ -47,7 +47,7 @@ extern void flush_ammod (AMMOD a);
 
 extern void xammod (AMMOD a);
 
-extern void setBuffers_ammod (AMMOD a, double* in, double* out);
+extern void setBuffers_ammod (AMMOD a, real* in, real* out);
 
 extern void setSamplerate_ammod (AMMOD a, int rate);
 
@@ -30,31 +30,31 @@ typedef struct _amsq
 {
     int run;                            // 0 if squelch system is OFF; 1 if it's ON
     int size;                           // size of input/output buffers
-    double* in;                         // squelch input signal buffer
-    double* out;                        // squelch output signal buffer
-    double* trigger;                    // pointer to trigger data source
-    double* trigsig;                    // buffer containing trigger signal
-    double rate;                        // sample rate
-    double avtau;                       // time constant for averaging noise
-    double avm;
-    double onem_avm;
-    double avsig;
+    real* in;                           // squelch input signal buffer
+    real* out;                          // squelch output signal buffer
+    real* trigger;                      // pointer to trigger data source
+    real* trigsig;                      // buffer containing trigger signal
+    real rate;                          // sample rate
+    real avtau;                         // time constant for averaging noise
+    real avm;
+    real onem_avm;
+    real avsig;
     int state;                          // state machine control
     int count;
-    double tup;
-    double tdown;
+    real tup;
+    real tdown;
     int ntup;
     int ntdown;
-    double* cup;
-    double* cdown;
-    double tail_thresh;
-    double unmute_thresh;
-    double min_tail;
-    double max_tail;
-    double muted_gain;
+    real* cup;
+    real* cdown;
+    real tail_thresh;
+    real unmute_thresh;
+    real min_tail;
+    real max_tail;
+    real muted_gain;
 } amsq, *AMSQ;
 
-extern AMSQ create_amsq (int run, int size, double* in, double* out, double* trigger, int rate, double avtau, double tup, double tdown, double tail_thresh, double unmute_thresh, double min_tail, double max_tail, double muted_gain);
+extern AMSQ create_amsq (int run, int size, real* in, real* out, real* trigger, int rate, real avtau, real tup, real tdown, real tail_thresh, real unmute_thresh, real min_tail, real max_tail, real muted_gain);
 
 extern void destroy_amsq (AMSQ a);
 
@@ -64,7 +64,7 @@ extern void xamsq (AMSQ a);
 
 extern void xamsqcap (AMSQ a);
 
-extern void setBuffers_amsq (AMSQ a, double* in, double* out, double* trigger);
+extern void setBuffers_amsq (AMSQ a, real* in, real* out, real* trigger);
 
 extern void setSamplerate_amsq (AMSQ a, int rate);
 
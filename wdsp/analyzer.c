@@ -30,10 +30,10 @@ warren@wpratt.com
 
 DP pdisp[dMAX_DISPLAYS];
 
-double bessi0(double x)
+real bessi0(real x)
 {
-    double ax,ans;
-    double y;
+    real ax,ans;
+    real y;
 
     if ((ax=fabs(x)) < 3.75) {
         y = x / 3.75,  y = y * y;
@@ -49,111 +49,111 @@ double bessi0(double x)
     return ans;
 }
 
-void new_window(int disp, int type, int size, double PiAlpha)
+void new_window(int disp, int type, int size, real PiAlpha)
 {
     DP a = pdisp[disp];
     int i;
-    double arg0, arg1, cgsum, igsum;
+    real arg0, arg1, cgsum, igsum;
     switch (type)
     {
     case 0:                 // rectangular window
         {
             a->inv_coherent_gain = 1.0;
-            igsum = (double)size;
+            igsum = (real)size;
             for (i = 0; i < size; i++)
                 a->window[i] = a->inv_coherent_gain * 1.0;
             break;
         }
     case 1:                 // blackman-harris window (4 term)
         {
-            arg0 = 2.0 * PI / ((double)size - 1.0);
+            arg0 = 2.0 * PI / ((real)size - 1.0);
             cgsum = 0.0;
             igsum = 0.0;
             for (i = 0; i < size; i++)
             {
-                arg1 = arg0 * (double)i;
+                arg1 = arg0 * (real)i;
                 a->window[i] = 0.35875 - 0.48829 * cos(arg1) + 0.14128 * cos(2.0 * arg1) - 0.01168 * cos(3.0 * arg1);
                 cgsum += a->window[i];
                 igsum += a->window[i] * a->window[i];
             }
-            a->inv_coherent_gain = (double)size / cgsum;
+            a->inv_coherent_gain = (real)size / cgsum;
             for (i = 0; i < size; i++)
                 a->window[i] *= a->inv_coherent_gain;
             break;
         }
     case 2:                 // hann window
         {
-            arg0 = 2.0 * PI / ((double)size - 1.0);
+            arg0 = 2.0 * PI / ((real)size - 1.0);
             cgsum = 0.0;
             igsum = 0.0;
             for (i = 0; i < size; i++)
             {
-                a->window[i] = 0.5 * (1.0 - cos((double)i * arg0));
+                a->window[i] = 0.5 * (1.0 - cos((real)i * arg0));
                 cgsum += a->window[i];
                 igsum += a->window[i] * a->window[i];
             }
-            a->inv_coherent_gain = (double)size / cgsum;
+            a->inv_coherent_gain = (real)size / cgsum;
             for (i = 0; i < size; i++)
                 a->window[i] *= a->inv_coherent_gain;
             break;
         }
     case 3:                 // flat-top window
         {
-            arg0 = 2.0 * PI / ((double)size - 1.0);
+            arg0 = 2.0 * PI / ((real)size - 1.0);
             cgsum = 0.0;
             igsum = 0.0;
             for (i = 0; i < size; i++)
             {
-                arg1 = arg0 * (double)i;
+                arg1 = arg0 * (real)i;
                 a->window[i] = 0.21557895 - 0.41663158 * cos(arg1) + 0.277263158 * cos(2.0 * arg1) - 0.083578947 * cos(3.0 * arg1) + 0.006947368 * cos (4.0 * arg1);
                 cgsum += a->window[i];
                 igsum += a->window[i] * a->window[i];
             }
-            a->inv_coherent_gain = (double)size / cgsum;
+            a->inv_coherent_gain = (real)size / cgsum;
             for (i = 0; i < size; i++)
                 a->window[i] *= a->inv_coherent_gain;
             break;
         }
     case 4:                 // hamming window
         {
-            arg0 = 2.0 * PI / ((double)size - 1.0);
+            arg0 = 2.0 * PI / ((real)size - 1.0);
             cgsum = 0.0;
             igsum = 0.0;
             for (i = 0; i < size; i++)
             {
-                a->window[i] = (0.54 - 0.46 * cos((double)i * arg0));
+                a->window[i] = (0.54 - 0.46 * cos((real)i * arg0));
                 cgsum += a->window[i];
                 igsum += a->window[i] * a->window[i];
             }
-            a->inv_coherent_gain = (double)size / cgsum;
+            a->inv_coherent_gain = (real)size / cgsum;
             for (i = 0; i < size; i++)
                 a->window[i] *= a->inv_coherent_gain;
             break;
         }
     case 5:                 // Kaiser window
         {   arg0 = bessi0(PiAlpha);
-            arg1 = (double)(size - 1);
+            arg1 = (real)(size - 1);
             cgsum = 0.0;
             igsum = 0.0;
             for (i = 0; i < size; ++i)
             {
-                a->window[i] = bessi0(PiAlpha * sqrt(1.0 - pow(2.0 * (double)i / arg1 - 1.0, 2))) / arg0;
+                a->window[i] = bessi0(PiAlpha * sqrt(1.0 - pow(2.0 * (real)i / arg1 - 1.0, 2))) / arg0;
                 cgsum += a->window[i];
                 igsum += a->window[i] * a->window[i];
             }
-            a->inv_coherent_gain = (double)size / cgsum;
+            a->inv_coherent_gain = (real)size / cgsum;
             for (i = 0; i < size; i++)
                 a->window[i] *= a->inv_coherent_gain;
             break;
         }
     case 6:                 // Blackman-Harris window (7-term)
         {
-            arg0 = 2.0 * PI / ((double)size - 1.0);
+            arg0 = 2.0 * PI / ((real)size - 1.0);
             cgsum = 0.0;
             igsum = 0.0;
             for (i = 0; i < size; ++i)
             {
-                arg1 = cos (arg0 * (double)i);
+                arg1 = cos (arg0 * (real)i);
                 a->window[i]   =    + 6.3964424114390378e-02
                         + arg1 *  ( - 2.3993864599352804e-01
                         + arg1 *  ( + 3.5015956323820469e-01
@@ -164,13 +164,13 @@ void new_window(int disp, int type, int size, double PiAlpha)
                 cgsum += a->window[i];
                 igsum += a->window[i] * a->window[i];
             }
-            a->inv_coherent_gain = (double)size / cgsum;
+            a->inv_coherent_gain = (real)size / cgsum;
             for (i = 0; i < size; i++)
                 a->window[i] *= a->inv_coherent_gain;
             break;
         }
     }
-    a->inherent_power_gain = igsum / (double)size;
+    a->inherent_power_gain = igsum / (real)size;
     a->inv_enb = 1.0 / (a->inherent_power_gain * a->inv_coherent_gain * a->inv_coherent_gain);
     // print_window_gain ("windows.txt", type, a->inv_coherent_gain, a->inherent_power_gain);
 }
@@ -180,7 +180,7 @@ void eliminate(int disp, int ss, int LO)
 {
     DP a = pdisp[disp];
     int i, k, begin, end, ilim;
-    double mag;
+    real mag;
 
     if (ss == a->begin_ss)
         begin = a->fscL + a->clip;
@@ -215,7 +215,7 @@ void Celiminate(int disp, int ss, int LO)
 {
     DP a = pdisp[disp];
     int i, k, begin0, end0, begin1, end1, ilim;
-    double mag;
+    real mag;
 
     if (ss == a->begin_ss)
     {
@@ -282,20 +282,20 @@ void Celiminate(int disp, int ss, int LO)
 void detector ( int det_type,           // detector type
                 int m,                  // number of bins
                 int num_pixels,         // number of output pixels
-                double pix_per_bin,     // pixels per bin
-                double bin_per_pix,     // bins per pixel
-                double* bins,           // input buffer
-                double* pixels,         // output buffer
-                double inv_enb,         // inverse equivalent noise bandwidth
-                double fsclipL,
-                double fsclipH,
-                double det_offset
+                real pix_per_bin,       // pixels per bin
+                real bin_per_pix,       // bins per pixel
+                real* bins,             // input buffer
+                real* pixels,           // output buffer
+                real inv_enb,           // inverse equivalent noise bandwidth
+                real fsclipL,
+                real fsclipH,
+                real det_offset
                 )
 {
     int i, imin, ilim;
     int pix_count = 0;
     int rose, fell, next_pix_count, bcount, last_pix_count;
-    double prev_maxi, mini, maxi, psum;
+    real prev_maxi, mini, maxi, psum;
     if (pix_per_bin <= 1.0)
     {
         if (fsclipL == floor(fsclipL)) imin = 0;
@@ -311,7 +311,7 @@ void detector ( int det_type,           // detector type
 
             for (i = imin; i < ilim; i++)
             {
-                pix_count = (int)(det_offset + (double)i * pix_per_bin);
+                pix_count = (int)(det_offset + (real)i * pix_per_bin);
                 if (pix_count >= num_pixels) pix_count = num_pixels - 1;
                 if (bins[i] > pixels[pix_count])
                     pixels[pix_count] = bins[i];
@@ -328,10 +328,10 @@ void detector ( int det_type,           // detector type
             for (i = imin; i < ilim; i++)       // for each FFT bin
             {
                 // determine the pixel number that this FFT bin goes into
-                pix_count = (int)(det_offset + (double)i * pix_per_bin);
+                pix_count = (int)(det_offset + (real)i * pix_per_bin);
                 if (pix_count >= num_pixels) pix_count = num_pixels - 1;
                 // determine the pixel number for the NEXT FFT bin
-                next_pix_count = (int)((double)(i + 1) * pix_per_bin);
+                next_pix_count = (int)((real)(i + 1) * pix_per_bin);
                 // update the minimum and maximum of the set of bins within the pixel
                 if (bins[i] <   mini)     mini = bins[i];
                 if (bins[i] >   maxi)     maxi = bins[i];
@@ -370,7 +370,7 @@ void detector ( int det_type,           // detector type
             for (i = imin; i < ilim; i++)
             {
                 last_pix_count = pix_count;
-                pix_count = (int)(det_offset + (double)i * pix_per_bin);
+                pix_count = (int)(det_offset + (real)i * pix_per_bin);
                 if (pix_count >= num_pixels) pix_count = num_pixels - 1;
                 if (pix_count == last_pix_count)
                 {
@@ -379,13 +379,13 @@ void detector ( int det_type,           // detector type
                 }
                 else
                 {
-                    pixels[last_pix_count] = psum / (double)bcount * inv_enb;
+                    pixels[last_pix_count] = psum / (real)bcount * inv_enb;
                     psum = bins[i];
                     bcount = 1;
                 }
                 if (i == ilim - 1)
                 {
-                    pixels[pix_count] = psum / (double)bcount * inv_enb;
+                    pixels[pix_count] = psum / (real)bcount * inv_enb;
                 }
             }
             break;
@@ -395,7 +395,7 @@ void detector ( int det_type,           // detector type
             for (i = imin; i < ilim; i++)
             {
                 last_pix_count = pix_count;
-                pix_count = (int)(det_offset + (double)i * pix_per_bin);
+                pix_count = (int)(det_offset + (real)i * pix_per_bin);
                 if (pix_count >= num_pixels) pix_count = num_pixels - 1;
                 if (pix_count == last_pix_count)
                 {
@@ -419,7 +419,7 @@ void detector ( int det_type,           // detector type
             for (i = imin; i < ilim; i++)
             {
                 last_pix_count = pix_count;
-                pix_count = (int)(det_offset + (double)i * pix_per_bin);
+                pix_count = (int)(det_offset + (real)i * pix_per_bin);
                 if (pix_count >= num_pixels) pix_count = num_pixels - 1;
                 if (pix_count == last_pix_count)
                 {
@@ -428,13 +428,13 @@ void detector ( int det_type,           // detector type
                 }
                 else
                 {
-                    pixels[last_pix_count] = sqrt (psum / (double)bcount) * inv_enb;
+                    pixels[last_pix_count] = sqrt (psum / (real)bcount) * inv_enb;
                     psum = bins[i] * bins[i];
                     bcount = 1;
                 }
                 if (i == ilim - 1)
                 {
-                    pixels[pix_count] = sqrt (psum / (double)bcount) * inv_enb;
+                    pixels[pix_count] = sqrt (psum / (real)bcount) * inv_enb;
                 }
             }
             break;
@@ -442,14 +442,14 @@ void detector ( int det_type,           // detector type
     }
     else
     {
-        double frac;
-        double pix_pos = fsclipL - floor(fsclipL);
+        real frac;
+        real pix_pos = fsclipL - floor(fsclipL);
         int ampl_comp = (det_type == 2) || (det_type == 3) || (det_type == 4);
         for (i = 1; i < m; i++)
         {
-            while (pix_pos < ((double)i + 1.0e-06) && pix_count < num_pixels)
+            while (pix_pos < ((real)i + 1.0e-06) && pix_count < num_pixels)
             {
-                frac = pix_pos - (double)(i - 1);
+                frac = pix_pos - (real)(i - 1);
                 pixels[pix_count]   = bins[i - 1] * (1.0 - frac) + bins[i] * frac;
                 if (ampl_comp) pixels[pix_count] *= inv_enb;
                 pix_count++;
@@ -466,19 +466,19 @@ void avenger (  int av_mode,                // averaging mode
                 int num_average,            // number of frames to average within a window
                 int* av_in_idx,             // in index for av_buff
                 int* av_out_idx,            // out index for av_buff
-                double av_backmult,         // multiplier for recursive averaging
-                double scale,               // scale factor
-                double* t_pixels,           // input buffer
-                double* av_sum,             // history buffer for averaging
-                double** av_buff,           // frame buffer for window averaging
-                double* cd,                 // correction factor buffer
+                real av_backmult,           // multiplier for recursive averaging
+                real scale,                 // scale factor
+                real* t_pixels,             // input buffer
+                real* av_sum,               // history buffer for averaging
+                real** av_buff,             // frame buffer for window averaging
+                real* cd,                   // correction factor buffer
                 int norm,                   // if TRUE, normalize to one Hz bandwidth
-                double norm_oneHz,          // normalization factor to add
+                real norm_oneHz,            // normalization factor to add
                 dOUTREAL* pixels            // output buffer
     )
 {
     int i;
-    double factor;
+    real factor;
     switch (av_mode)
     {
     case -1:    // peak-hold
@@ -500,7 +500,7 @@ void avenger (  int av_mode,                // averaging mode
         }
     case 1:     // weighted averaging of linear data
         {
-            double onem_avb = 1.0 - av_backmult;
+            real onem_avb = 1.0 - av_backmult;
             for (i = 0; i < num_pixels; i++)
             {
                 av_sum[i] = av_backmult * av_sum[i] + onem_avb * t_pixels[i];
@@ -512,7 +512,7 @@ void avenger (  int av_mode,                // averaging mode
         {
             if (*avail_frames < num_average)
             {
-                factor = scale / (double)++(*avail_frames);
+                factor = scale / (real)++(*avail_frames);
                 for (i = 0; i < num_pixels; i++)
                 {
                     av_sum[i] += t_pixels[i];
@@ -522,7 +522,7 @@ void avenger (  int av_mode,                // averaging mode
             }
             else
             {
-                factor = scale / (double)(*avail_frames);
+                factor = scale / (real)(*avail_frames);
                 for (i = 0; i < num_pixels; i++)
                 {
                     av_sum[i] += t_pixels[i] - (av_buff[*av_out_idx])[i];
@@ -538,7 +538,7 @@ void avenger (  int av_mode,                // averaging mode
         }
     case 3:     // weighted averaging of log data - looks nice, not accurate for time-varying signals
         {
-            double onem_avb = 1.0 - av_backmult;
+            real onem_avb = 1.0 - av_backmult;
             for (i = 0; i < num_pixels; i++)
             {
                 av_sum[i] = av_backmult * av_sum[i] + onem_avb * (10.0 * mlog10(scale * cd[i] * t_pixels[i] + 1e-60));
@@ -556,14 +556,14 @@ void stitch(int disp)
 {
     DP a = pdisp[disp];
     int i, j, k, n, m;
-    double* ptr;
+    real* ptr;
 
     // stitch
     m = 0;
     ptr = a->pre_av_out;
     for (n = a->begin_ss; n <= a->end_ss; n++)
     {
-        memcpy(ptr, a->result[n], a->ss_bins[n] * sizeof(double));
+        memcpy(ptr, a->result[n], a->ss_bins[n] * sizeof(real));
         ptr += a->ss_bins[n];
         m += a->ss_bins[n];
     }
@@ -584,7 +584,7 @@ void stitch(int disp)
             detector (a->det_type[i], m, a->num_pixels, a->pix_per_bin, a->bin_per_pix, a->pre_av_out,
                 a->t_pixels[i], a->inv_enb, a->fsclipL, a->fsclipH, a->det_offset);
         else
-            memcpy (a->t_pixels[i], a->t_pixels[k], a->num_pixels * sizeof (double));
+            memcpy (a->t_pixels[i], a->t_pixels[k], a->num_pixels * sizeof (real));
         // average & convert to dBm
         avenger (a->av_mode[i], a->num_pixels, &a->avail_frames[i], a->num_average[i], &a->av_in_idx[i], &a->av_out_idx[i],
             a->av_backmult[i], a->scale, a->t_pixels[i], a->av_sum[i], a->av_buff[i], a->cd, a->normalize[i], a->norm_oneHz,
@@ -599,6 +599,13 @@ void stitch(int disp)
     }
 }
 
+static void wake_dispatcher (DP a)
+{
+    // coalesce wake-ups: only signal if the dispatcher has not yet been signalled
+    if (!InterlockedBitTestAndSet(&a->dispatch_pending, 0))
+        SetEvent(a->hDispatchEvent);
+}
+
 DWORD WINAPI spectra (void *pargs)
 {
     int i, j;
@@ -617,7 +624,7 @@ DWORD WINAPI spectra (void *pargs)
     {
         for (i = 0; i < a->size; i++)
         {
-            (a->fft_in[ss][LO])[i] = a->window[i] * (double)((a->I_samples[ss][LO])[a->IQO_idx[ss][LO]]);
+            (a->fft_in[ss][LO])[i] = a->window[i] * (real)((a->I_samples[ss][LO])[a->IQO_idx[ss][LO]]);
             if(++a->IQO_idx[ss][LO] >= a->bsize)
                  a->IQO_idx[ss][LO] -= a->bsize;
         }
@@ -655,6 +662,7 @@ DWORD WINAPI spectra (void *pargs)
             for (j = 0; j < dMAX_STITCH; j++)
                 for (i = 0; i < dMAX_NUM_FFT; i++)
                     InterlockedBitTestAndReset(&(a->input_busy[j][i]), 0);
+            wake_dispatcher(a);
             stitch(disp);
         }
         else
@@ -674,7 +682,7 @@ DWORD WINAPI Cspectra (void *pargs)
     int ss = (((int)(uintptr_t)pargs) >> 4) & 255;
     int LO = ((int)(uintptr_t)pargs) & 15;
     DP a = pdisp[disp];
-    int trans_size = a->size * sizeof(double);
+    int trans_size = a->size * sizeof(real);
 
     if (a->stop)
     {
@@ -686,8 +694,8 @@ DWORD WINAPI Cspectra (void *pargs)
     {
         for (i = 0; i < a->size; i++)
         {
-            (a->Cfft_in[ss][LO])[i][0] = a->window[i] * (double)((a->I_samples[ss][LO])[a->IQO_idx[ss][LO]]);
-            (a->Cfft_in[ss][LO])[i][1] = a->window[i] * (double)((a->Q_samples[ss][LO])[a->IQO_idx[ss][LO]]);
+            (a->Cfft_in[ss][LO])[i][0] = a->window[i] * (real)((a->I_samples[ss][LO])[a->IQO_idx[ss][LO]]);
+            (a->Cfft_in[ss][LO])[i][1] = a->window[i] * (real)((a->Q_samples[ss][LO])[a->IQO_idx[ss][LO]]);
             if(++a->IQO_idx[ss][LO] >= a->bsize)
                  a->IQO_idx[ss][LO] -= a->bsize;
         }
@@ -732,6 +740,7 @@ DWORD WINAPI Cspectra (void *pargs)
             for (j = 0; j < dMAX_STITCH; j++)
                 for (i = 0; i < dMAX_NUM_FFT; i++)
                     InterlockedBitTestAndReset(&(a->input_busy[j][i]), 0);
+            wake_dispatcher(a);
             stitch(disp);
         }
         else
@@ -744,22 +753,22 @@ DWORD WINAPI Cspectra (void *pargs)
     return 1;
 }
 
-void interpolate(int disp, int set, double fmin, double fmax, int num_pixels)
+void interpolate(int disp, int set, real fmin, real fmax, int num_pixels)
 {
     DP a = pdisp[disp];
     int i;
-    double f;
+    real f;
     int n = a->n_freqs[set];
     int k;
     int kmin = 0;
     int kmax = n - 1;
     int kdelta;
-    double dx;
-    double mag;
+    real dx;
+    real mag;
 
     for (i = 0; i < num_pixels; i++)
     {
-        f = fmin + (double)i * (fmax - fmin) / (double)(num_pixels - 1);
+        f = fmin + (real)i * (fmax - fmin) / (real)(num_pixels - 1);
 
         if (f < (a->freqs[set])[0])
             k = 0;
@@ -797,19 +806,19 @@ void interpolate(int disp, int set, double fmin, double fmax, int num_pixels)
     }
 }
 
-int build_interpolants(int disp, int set, int n, int m, double *x, double (*y)[dMAX_M])
+int build_interpolants(int disp, int set, int n, int m, real *x, real (*y)[dMAX_M])
 {
     DP a = pdisp[disp];
-    double dx[dMAX_N];
-    double idx[dMAX_N];
-    double dmain[dMAX_N];
-    double dsub[dMAX_N];
-    double dsup[dMAX_N];
-    double d[dMAX_N][dMAX_M];
-    double S[dMAX_N][dMAX_M];
-    double b[dMAX_N];
-    double v[dMAX_N][dMAX_M];
-    double tmp;
+    real dx[dMAX_N];
+    real idx[dMAX_N];
+    real dmain[dMAX_N];
+    real dsub[dMAX_N];
+    real dsup[dMAX_N];
+    real d[dMAX_N][dMAX_M];
+    real S[dMAX_N][dMAX_M];
+    real b[dMAX_N];
+    real v[dMAX_N][dMAX_M];
+    real tmp;
     int i, j;
 
     for (i = 0; i < n - 1; i++)
@@ -884,33 +893,43 @@ int build_interpolants(int disp, int set, int n, int m, double *x, double (*y)[d
 void __cdecl sendbuf(void *arg)
 {
     DP a = pdisp[(int)(uintptr_t)arg];
+    int dispatched;
     while(!a->end_dispatcher)
     {
-        for (a->ss = 0; a->ss < a->num_stitch; a->ss++)
-            for (a->LO = 0; a->LO < a->num_fft; a->LO++)
-            {
-                if (!_InterlockedAnd(&(a->input_busy[a->ss][a->LO]), 1) && _InterlockedAnd(&(a->buff_ready[a->ss][a->LO]), 1))
+        // sleep until new samples arrive, an fft completes, or we are told to terminate
+        WaitForSingleObject(a->hDispatchEvent, INFINITE);
+        InterlockedBitTestAndReset(&a->dispatch_pending, 0);
+        do
+        {
+            dispatched = 0;
+            for (a->ss = 0; a->ss < a->num_stitch; a->ss++)
+                for (a->LO = 0; a->LO < a->num_fft; a->LO++)
                 {
-                    InterlockedBitTestAndSet(&(a->input_busy[a->ss][a->LO]), 0);
-
-                    a->IQO_idx[a->ss][a->LO] = a->IQout_index[a->ss][a->LO];
-
-                    InterlockedIncrement(a->pnum_threads);
-                    if (a->type == 0)
-                        QueueUserWorkItem(spectra, (void *)(((uintptr_t)arg << 12) + (a->ss << 4) + a->LO), 0);
-                    else
-                        QueueUserWorkItem(Cspectra, (void *)(((uintptr_t)arg << 12) + (a->ss << 4) + a->LO), 0);
-
-                    if((a->IQout_index[a->ss][a->LO] += a->incr) >= a->bsize)
-                        a->IQout_index[a->ss][a->LO] -= a->bsize;
-
-                    EnterCriticalSection(&(a->BufferControlSection[a->ss][a->LO]));
-                    if ((a->have_samples[a->ss][a->LO] -= a->incr) < a->size)
-                        InterlockedBitTestAndReset(&(a->buff_ready[a->ss][a->LO]), 0);
-                    LeaveCriticalSection(&(a->BufferControlSection[a->ss][a->LO]));
+                    if (a->end_dispatcher)
+                        break;
+                    if (!_InterlockedAnd(&(a->input_busy[a->ss][a->LO]), 1) && _InterlockedAnd(&(a->buff_ready[a->ss][a->LO]), 1))
+                    {
+                        InterlockedBitTestAndSet(&(a->input_busy[a->ss][a->LO]), 0);
+
+                        a->IQO_idx[a->ss][a->LO] = a->IQout_index[a->ss][a->LO];
+
+                        InterlockedIncrement(a->pnum_threads);
+                        if (a->type == 0)
+                            QueueUserWorkItem(spectra, (void *)(((uintptr_t)arg << 12) + (a->ss << 4) + a->LO), 0);
+                        else
+                            QueueUserWorkItem(Cspectra, (void *)(((uintptr_t)arg << 12) + (a->ss << 4) + a->LO), 0);
+
+                        if((a->IQout_index[a->ss][a->LO] += a->incr) >= a->bsize)
+                            a->IQout_index[a->ss][a->LO] -= a->bsize;
+
+                        EnterCriticalSection(&(a->BufferControlSection[a->ss][a->LO]));
+                        if ((a->have_samples[a->ss][a->LO] -= a->incr) < a->size)
+                            InterlockedBitTestAndReset(&(a->buff_ready[a->ss][a->LO]), 0);
+                        LeaveCriticalSection(&(a->BufferControlSection[a->ss][a->LO]));
+                        dispatched = 1;
+                    }
                 }
-            }
-        Sleep(1);
+        } while (dispatched && !a->end_dispatcher);
     }
     InterlockedBitTestAndReset(&a->dispatcher, 0);
     _endthread();
@@ -918,8 +937,8 @@ void __cdecl sendbuf(void *arg)
 
 void CalcBandwidthNormalization (DP a)
 {
-    double bin_width;
-    bin_width = (double)a->sample_rate / (double)a->size;
+    real bin_width;
+    bin_width = (real)a->sample_rate / (real)a->size;
     a->norm_oneHz = 10.0 * mlog10 (1.0 / bin_width);
 }
 
@@ -956,7 +975,7 @@ void ResetPixelBuffers(int disp)
                 a->av_sum[i][j] = -160.0;
             break;
         default:
-            memset((void*)a->av_sum[i], 0, sizeof(double) * dMAX_PIXELS);
+            memset((void*)a->av_sum[i], 0, sizeof(real) * dMAX_PIXELS);
             break;
         }
         a->avail_frames[i] = 0;
@@ -970,7 +989,7 @@ void ResetPixelBuffers(int disp)
             a->pb_ready[i][j] = 0;
         LeaveCriticalSection(&a->PB_ControlsSection[i]);
     }
-    memset((void*)a->pre_av_out, 0, sizeof(double) * a->max_size * a->max_stitch);
+    memset((void*)a->pre_av_out, 0, sizeof(real) * a->max_size * a->max_stitch);
     LeaveCriticalSection(&a->ResampleSection);
     EnterCriticalSection(&a->StitchSection);
     for (i = 0; i < dMAX_STITCH; i++)
@@ -1022,6 +1041,7 @@ void SetAnalyzer (  int disp,           // display identifier
 
     EnterCriticalSection(&a->SetAnalyzerSection);
     a->end_dispatcher = 1;
+    SetEvent(a->hDispatchEvent);
     while (InterlockedAnd(&a->dispatcher, 1))
         Sleep(1);
     a->stop = 1;
@@ -1044,10 +1064,10 @@ void SetAnalyzer (  int disp,           // display identifier
         for (i = 0; i < a->max_stitch; i++)
             for (j = 0; j < a->max_num_fft; j++)
             {
-                if (a->plan[i][j])      fftw_destroy_plan (a->plan[i][j]);
-                if (a->Cplan[i][j])     fftw_destroy_plan (a->Cplan[i][j]);
-                a->plan[i][j] = fftw_plan_dft_r2c_1d(sz, a->fft_in[i][j], a->fft_out[i][j], FFTW_PATIENT);
-                a->Cplan[i][j] = fftw_plan_dft_1d(sz, a->Cfft_in[i][j], a->fft_out[i][j], FFTW_FORWARD, FFTW_PATIENT);
+                if (a->plan[i][j])      wisdom_destroy_plan (a->plan[i][j]);
+                if (a->Cplan[i][j])     wisdom_destroy_plan (a->Cplan[i][j]);
+                a->plan[i][j] = wisdom_plan_dft_r2c_1d(sz, a->fft_in[i][j], a->fft_out[i][j]);
+                a->Cplan[i][j] = wisdom_plan_dft_1d(sz, a->Cfft_in[i][j], a->fft_out[i][j], FFTW_FORWARD);
             }
     }
 
@@ -1076,12 +1096,12 @@ void SetAnalyzer (  int disp,           // display identifier
     if (a->type == 0)
     {
         a->out_size = a->size / 2 + 1;
-        a->scale = 4.0 / ((double)a->size * (double)a->size);
+        a->scale = 4.0 / ((real)a->size * (real)a->size);
     }
     else
     {
         a->out_size = a->size;
-        a->scale = 1.0 / ((double)a->size * (double)a->size);
+        a->scale = 1.0 / ((real)a->size * (real)a->size);
     }
 
     a->begin_ss = 0;
@@ -1101,9 +1121,9 @@ void SetAnalyzer (  int disp,           // display identifier
         a->end_ss--;
     }
 
-    a->pix_per_bin = (double)a->num_pixels / ((double)(a->num_stitch * (a->out_size - 1 - 2 * a->clip)) - a->fsclipL - a->fsclipH - 1.0);
+    a->pix_per_bin = (real)a->num_pixels / ((real)(a->num_stitch * (a->out_size - 1 - 2 * a->clip)) - a->fsclipL - a->fsclipH - 1.0);
     a->det_offset = -a->pix_per_bin * (a->fsclipL - floor(a->fsclipL));
-    a->bin_per_pix = ((double)(a->num_stitch * (a->out_size - 1 - 2 * a->clip)) - 1.0 - a->fsclipL - a->fsclipH) / ((double)a->num_pixels - 1.0);
+    a->bin_per_pix = ((real)(a->num_stitch * (a->out_size - 1 - 2 * a->clip)) - 1.0 - a->fsclipL - a->fsclipH) / ((real)a->num_pixels - 1.0);
 
     for (i = 0; i < dMAX_STITCH; i++)
         for (j = 0; j < dMAX_NUM_FFT; j++)
@@ -1155,6 +1175,8 @@ void XCreateAnalyzer(   int disp,
     a->max_stitch = m_stitch;
 
     a->pnum_threads = (LONG*) malloc0 (sizeof (LONG));
+    a->hDispatchEvent = CreateEvent(NULL, FALSE, FALSE, TEXT("dispatch"));
+    a->dispatch_pending = 0;
 
     for (i = 0; i < a->max_stitch; i++)
         for (j = 0; j < a->max_num_fft; j++)
@@ -1174,11 +1196,11 @@ void XCreateAnalyzer(   int disp,
             InitializeCriticalSectionAndSpinCount(&(a->BufferControlSection[i][j]), 0);
     }
 
-    a->window = (double*) malloc0 (sizeof(double) * a->max_size);
+    a->window = (real*) malloc0 (sizeof(real) * a->max_size);
 
     for (i = 0; i < a->max_stitch; i++)
     {
-        a->result[i] = (double*) malloc0 (sizeof(double) * a->max_size);
+        a->result[i] = (real*) malloc0 (sizeof(real) * a->max_size);
 
     }
     for (i = 0; i < a->max_stitch; i++)
@@ -1186,35 +1208,35 @@ void XCreateAnalyzer(   int disp,
         {
             a->plan[i][j] = 0;
             a->Cplan[i][j] = 0;
-            a->fft_in[i][j]   = (double*) malloc0 (sizeof(double) * a->max_size);
+            a->fft_in[i][j]   = (real*) malloc0 (sizeof(real) * a->max_size);
             a->Cfft_in[i][j]  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * a->max_size);
             a->fft_out[i][j]  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * a->max_size);
         }
-    a->pre_av_out = (double*) malloc0 (sizeof(double) * a->max_size * a->max_stitch);
+    a->pre_av_out = (real*) malloc0 (sizeof(real) * a->max_size * a->max_stitch);
     for (i = 0; i < dMAX_PIXOUTS; i++)
     {
         a->det_type[i] = 0;
         a->av_mode[i] = 0;
-        a->av_sum[i] = (double*) malloc0 (sizeof(double) * dMAX_PIXELS);
+        a->av_sum[i] = (real*) malloc0 (sizeof(real) * dMAX_PIXELS);
         for (j = 0; j < dMAX_AVERAGE; j++)
-            a->av_buff[i][j] = (double*) malloc0 (sizeof(double) * dMAX_PIXELS);
-        a->t_pixels[i] = (double*) malloc0 (sizeof(double) * dMAX_PIXELS);
+            a->av_buff[i][j] = (real*) malloc0 (sizeof(real) * dMAX_PIXELS);
+        a->t_pixels[i] = (real*) malloc0 (sizeof(real) * dMAX_PIXELS);
         for (j = 0; j < dNUM_PIXEL_BUFFS; j++)
             a->pixels[i][j] = (dOUTREAL*) malloc0 (sizeof(dOUTREAL) * dMAX_PIXELS);
     }
 
-    a->cd = (double*) malloc0 (sizeof(double) * dMAX_PIXELS);
+    a->cd = (real*) malloc0 (sizeof(real) * dMAX_PIXELS);
     for (j = 0; j < dMAX_PIXELS; j++)
         a->cd[j] = 1.0;
     for (i = 0; i < dMAX_CAL_SETS; i++)
     {
-        a->freqs[i] = (double*) malloc0 (sizeof(double) * dMAX_N);
+        a->freqs[i] = (real*) malloc0 (sizeof(real) * dMAX_N);
         for (j = 0; j < dMAX_M; j++)
         {
-            a->ac3[i][j] = (double*) malloc0 (sizeof(double) * dMAX_N);
-            a->ac2[i][j] = (double*) malloc0 (sizeof(double) * dMAX_N);
-            a->ac1[i][j] = (double*) malloc0 (sizeof(double) * dMAX_N);
-            a->ac0[i][j] = (double*) malloc0 (sizeof(double) * dMAX_N);
+            a->ac3[i][j] = (real*) malloc0 (sizeof(real) * dMAX_N);
+            a->ac2[i][j] = (real*) malloc0 (sizeof(real) * dMAX_N);
+            a->ac1[i][j] = (real*) malloc0 (sizeof(real) * dMAX_N);
+            a->ac0[i][j] = (real*) malloc0 (sizeof(real) * dMAX_N);
         }
     }
 
@@ -1242,8 +1264,13 @@ void DestroyAnalyzer(int disp)
     int i, j;
 
     a->end_dispatcher = 1;
+    SetEvent(a->hDispatchEvent);
     while (InterlockedAnd(&a->dispatcher, 1))
         Sleep(1);
+    // FFT work items run asynchronously in the worker pool, wait for them
+    a->stop = 1;
+    while (_InterlockedAnd(a->pnum_threads, 1023))
+        Sleep(1);
 
     for (i = 0; i < a->max_stitch; i++)
         for (j = 0; j < a->max_num_fft; j++)
@@ -1279,8 +1306,8 @@ void DestroyAnalyzer(int disp)
     for (i = 0; i < a->max_stitch; i++)
         for (j = 0; j < a->max_num_fft; j++)
         {
-            fftw_destroy_plan (a->plan[i][j]);
-            fftw_destroy_plan (a->Cplan[i][j]);
+            wisdom_destroy_plan (a->plan[i][j]);
+            wisdom_destroy_plan (a->Cplan[i][j]);
             fftw_free (a->Cfft_in[i][j]);
             _aligned_free (a->fft_in[i][j]);
             fftw_free (a->fft_out[i][j]);
@@ -1305,6 +1332,7 @@ void DestroyAnalyzer(int disp)
     for (i = 0; i < a->max_stitch; i++)
         for (j = 0; j < a->max_num_fft; j++)
             CloseHandle(a->hSnapEvent[i][j]);
+    CloseHandle(a->hDispatchEvent);
 
     _aligned_free ((void *) a->pnum_threads);
 
@@ -1337,7 +1365,7 @@ PORT
 void SnapSpectrum(  int disp,
                     int ss,
                     int LO,
-                    double *snap_buff)
+                    real *snap_buff)
 {
     DP a = pdisp[disp];
     a->snap_buff[ss][LO] = snap_buff;
@@ -1349,7 +1377,7 @@ PORT
 void SnapSpectrumTimeout(   int disp,
                             int ss,
                             int LO,
-                            double* snap_buff,
+                            real* snap_buff,
                             DWORD timeout,
                             int* flag)
 {
@@ -1368,9 +1396,9 @@ void SnapSpectrumTimeout(   int disp,
 
 int calcompare (const void * a, const void * b)
 {
-    if (*(double*)a < *(double*)b)
+    if (*(real*)a < *(real*)b)
         return -1;
-    else if (*(double*)a == *(double*)b)
+    else if (*(real*)a == *(real*)b)
         return 0;
     else
         return 1;
@@ -1380,16 +1408,16 @@ PORT
 void SetCalibration (   int disp,
                         int set_num,                //identifier for this calibration data set
                         int n_points,               //number of calibration points in the set
-                        double (*cal)[dMAX_M+1]     //pointer to the calibration table, first
+                        real (*cal)[dMAX_M+1]       //pointer to the calibration table, first
                     )                               //   column is frequency, add'l columns are
                                                     //   data for variables being calibrated
 {
     DP a = pdisp[disp];
     int i, j;
     int k = 0;
-    double y [dMAX_N][dMAX_M];
+    real y [dMAX_N][dMAX_M];
 
-    qsort (cal, n_points, (dMAX_M+1) * sizeof(double), calcompare);
+    qsort (cal, n_points, (dMAX_M+1) * sizeof(real), calcompare);
 
     for (i = 0; i < n_points; i++)
     {
@@ -1445,6 +1473,7 @@ void CloseBuffer(int disp, int ss, int LO)
     }
     else
         LeaveCriticalSection(&a->SetAnalyzerSection);
+    wake_dispatcher(a);
 }
 
 PORT
@@ -1484,6 +1513,7 @@ void Spectrum(int disp, int ss, int LO, dINREAL* pI, dINREAL* pQ)
     }
     else
         LeaveCriticalSection(&a->SetAnalyzerSection);
+    wake_dispatcher(a);
 }
 
 PORT
@@ -1529,11 +1559,12 @@ void Spectrum2(int run, int disp, int ss, int LO, dINREAL* pbuff)
         }
         else
             LeaveCriticalSection(&a->SetAnalyzerSection);
+        wake_dispatcher(a);
     }
 }
 
 PORT
-void Spectrum0(int run, int disp, int ss, int LO, double* pbuff)
+void Spectrum0(int run, int disp, int ss, int LO, real* pbuff)
 {
     if (run)
     {
@@ -1575,6 +1606,7 @@ void Spectrum0(int run, int disp, int ss, int LO, double* pbuff)
         }
         else
             LeaveCriticalSection(&a->SetAnalyzerSection);
+        wake_dispatcher(a);
     }
 }
 
@@ -1615,7 +1647,7 @@ void SetDisplayAverageMode (int disp, int pixout, int mode)
                 a->av_sum[pixout][i] = -160.0;
             break;
         default:
-            memset ((void *)a->av_sum[pixout], 0, sizeof(double) * dMAX_PIXELS);
+            memset ((void *)a->av_sum[pixout], 0, sizeof(real) * dMAX_PIXELS);
             break;
         }
         LeaveCriticalSection (&a->ResampleSection);
@@ -1678,7 +1710,7 @@ PORT
 double GetDisplayENB (int disp)
 {
     DP a = pdisp[disp];
-    double enb;
+    real enb;
     EnterCriticalSection(&a->SetAnalyzerSection);
     enb = 1.0 / a->inv_enb;
     LeaveCriticalSection(&a->SetAnalyzerSection);
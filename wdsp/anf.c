@@ -26,25 +26,35 @@ warren@wpratt.com
 
 #include "comm.h"
 
+static void clamp_anf (ANF a)
+{
+    // xanf() reads the mirrored delay line up to d[in_idx + delay + n_taps]:
+    // delay + n_taps must not exceed dline_size
+    if (a->n_taps < 0) a->n_taps = 0;
+    if (a->n_taps > a->dline_size) a->n_taps = a->dline_size;
+    if (a->delay < 0) a->delay = 0;
+    if (a->delay > a->dline_size - a->n_taps) a->delay = a->dline_size - a->n_taps;
+}
+
 ANF create_anf  (
                 int run,
                 int position,
                 int buff_size,
-                double *in_buff,
-                double *out_buff,
+                real *in_buff,
+                real *out_buff,
                 int dline_size,
                 int n_taps,
                 int delay,
-                double two_mu,
-                double gamma,
-
-                double lidx,
-                double lidx_min,
-                double lidx_max,
-                double ngamma,
-                double den_mult,
-                double lincr,
-                double ldecr
+                real two_mu,
+                real gamma,
+
+                real lidx,
+                real lidx_min,
+                real lidx_max,
+                real ngamma,
+                real den_mult,
+                real lincr,
+                real ldecr
             )
 {
     ANF a = (ANF) malloc0 (sizeof(anf));
@@ -57,6 +67,7 @@ ANF create_anf  (
     a->mask = dline_size - 1;
     a->n_taps = n_taps;
     a->delay = delay;
+    clamp_anf (a);
     a->two_mu = two_mu;
     a->gamma = gamma;
     a->in_idx = 0;
@@ -68,8 +79,8 @@ ANF create_anf  (
     a->lincr = lincr;
     a->ldecr = ldecr;
 
-    memset (a->d, 0, sizeof(double) * ANF_DLINE_SIZE);
-    memset (a->w, 0, sizeof(double) * ANF_DLINE_SIZE);
+    memset (a->d, 0, sizeof(a->d));
+    memset (a->w, 0, sizeof(a->w));
 
     return a;
 }
@@ -81,25 +92,28 @@ void destroy_anf (ANF a)
 
 void xanf(ANF a, int position)
 {
-    int i, j, idx;
-    double c0, c1;
-    double y, error, sigma, inv_sigp;
-    double nel, nev;
+    int i;
+    real c0, c1;
+    real y, error, sigma, inv_sigp;
+    real nel, nev;
+    real* x;
     if (a->run && (a->position == position))
     {
+        // The delay line is mirrored (each sample is also stored at in_idx + dline_size),
+        // so the taps are always a contiguous section x[0...n_taps-1] of it. The energy
+        // of the taps (sigma) is updated for the sample entering and the one leaving
+        // them, and computed from scratch once per buffer so rounding errors cannot
+        // accumulate.
+        sigma = lms_energy (&a->d[a->in_idx + 1 + a->delay], a->n_taps);
         for (i = 0; i < a->buff_size; i++)
         {
-            a->d[a->in_idx] = a->in_buff[2 * i + 0];
-
-            y = 0;
-            sigma = 0;
+            x = &a->d[a->in_idx + a->delay];
+            sigma -= x[a->n_taps] * x[a->n_taps];
+            a->d[a->in_idx] = a->d[a->in_idx + a->dline_size] = a->in_buff[2 * i + 0];
+            sigma += x[0] * x[0];
+            if (sigma < 0.0) sigma = 0.0;
 
-            for (j = 0; j < a->n_taps; j++)
-            {
-                idx = (a->in_idx + j + a->delay) & a->mask;
-                y += a->w[j] * a->d[idx];
-                sigma += a->d[idx] * a->d[idx];
-            }
+            y = lms_dot (a->w, x, a->n_taps);
             inv_sigp = 1.0 / (sigma + 1e-10);
             error = a->d[a->in_idx] - y;
 
@@ -121,11 +135,7 @@ void xanf(ANF a, int position)
             c0 = 1.0 - a->two_mu * a->ngamma;
             c1 = a->two_mu * error * inv_sigp;
 
-            for (j = 0; j < a->n_taps; j++)
-            {
-                idx = (a->in_idx + j + a->delay) & a->mask;
-                a->w[j] = c0 * a->w[j] + c1 * a->d[idx];
-            }
+            lms_update (a->w, x, a->n_taps, c0, c1);
             a->in_idx = (a->in_idx + a->mask) & a->mask;
         }
     }
@@ -135,12 +145,12 @@ void xanf(ANF a, int position)
 
 void flush_anf (ANF a)
 {
-    memset (a->d, 0, sizeof(double) * ANF_DLINE_SIZE);
-    memset (a->w, 0, sizeof(double) * ANF_DLINE_SIZE);
+    memset (a->d, 0, sizeof(a->d));
+    memset (a->w, 0, sizeof(a->w));
     a->in_idx = 0;
 }
 
-void setBuffers_anf (ANF a, double* in, double* out)
+void setBuffers_anf (ANF a, real* in, real* out)
 {
     a->in_buff = in;
     a->out_buff = out;
@@ -188,6 +198,7 @@ SetRXAANFVals (int channel, int taps, int delay, double gain, double leakage)
     rxa[channel].anf.p->delay = delay;
     rxa[channel].anf.p->two_mu = gain;          //try two_mu = 1e-4
     rxa[channel].anf.p->gamma = leakage;        //try gamma = 0.10
+    clamp_anf (rxa[channel].anf.p);
     flush_anf (rxa[channel].anf.p);
     LeaveCriticalSection (&ch[channel].csDSP);
 }
@@ -197,6 +208,7 @@ SetRXAANFTaps (int channel, int taps)
 {
     EnterCriticalSection (&ch[channel].csDSP);
     rxa[channel].anf.p->n_taps = taps;
+    clamp_anf (rxa[channel].anf.p);
     flush_anf (rxa[channel].anf.p);
     LeaveCriticalSection (&ch[channel].csDSP);
 }
@@ -206,6 +218,7 @@ SetRXAANFDelay (int channel, int delay)
 {
     EnterCriticalSection (&ch[channel].csDSP);
     rxa[channel].anf.p->delay = delay;
+    clamp_anf (rxa[channel].anf.p);
     flush_anf (rxa[channel].anf.p);
     LeaveCriticalSection (&ch[channel].csDSP);
 }
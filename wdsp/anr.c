@@ -26,25 +26,35 @@ warren@wpratt.com
 
 #include "comm.h"
 
+static void clamp_anr (ANR a)
+{
+    // xanr() reads the mirrored delay line up to d[in_idx + delay + n_taps]:
+    // delay + n_taps must not exceed dline_size
+    if (a->n_taps < 0) a->n_taps = 0;
+    if (a->n_taps > a->dline_size) a->n_taps = a->dline_size;
+    if (a->delay < 0) a->delay = 0;
+    if (a->delay > a->dline_size - a->n_taps) a->delay = a->dline_size - a->n_taps;
+}
+
 ANR create_anr  (
                 int run,
                 int position,
                 int buff_size,
-                double *in_buff,
-                double *out_buff,
+                real *in_buff,
+                real *out_buff,
                 int dline_size,
                 int n_taps,
                 int delay,
-                double two_mu,
-                double gamma,
-
-                double lidx,
-                double lidx_min,
-                double lidx_max,
-                double ngamma,
-                double den_mult,
-                double lincr,
-                double ldecr
+                real two_mu,
+                real gamma,
+
+                real lidx,
+                real lidx_min,
+                real lidx_max,
+                real ngamma,
+                real den_mult,
+                real lincr,
+                real ldecr
             )
 {
     ANR a = (ANR) malloc0 (sizeof(anr));
@@ -57,6 +67,7 @@ ANR create_anr  (
     a->mask = dline_size - 1;
     a->n_taps = n_taps;
     a->delay = delay;
+    clamp_anr (a);
     a->two_mu = two_mu;
     a->gamma = gamma;
     a->in_idx = 0;
@@ -68,8 +79,8 @@ ANR create_anr  (
     a->lincr = lincr;
     a->ldecr = ldecr;
 
-    memset (a->d, 0, sizeof(double) * ANR_DLINE_SIZE);
-    memset (a->w, 0, sizeof(double) * ANR_DLINE_SIZE);
+    memset (a->d, 0, sizeof(a->d));
+    memset (a->w, 0, sizeof(a->w));
 
     return a;
 }
@@ -81,25 +92,28 @@ void destroy_anr (ANR a)
 
 void xanr (ANR a, int position)
 {
-    int i, j, idx;
-    double c0, c1;
-    double y, error, sigma, inv_sigp;
-    double nel, nev;
+    int i;
+    real c0, c1;
+    real y, error, sigma, inv_sigp;
+    real nel, nev;
+    real* x;
     if (a->run && (a->position == position))
     {
+        // The delay line is mirrored (each sample is also stored at in_idx + dline_size),
+        // so the taps are always a contiguous section x[0...n_taps-1] of it. The energy
+        // of the taps (sigma) is updated for the sample entering and the one leaving
+        // them, and computed from scratch once per buffer so rounding errors cannot
+        // accumulate.
+        sigma = lms_energy (&a->d[a->in_idx + 1 + a->delay], a->n_taps);
         for (i = 0; i < a->buff_size; i++)
         {
-            a->d[a->in_idx] = a->in_buff[2 * i + 0];
-
-            y = 0;
-            sigma = 0;
+            x = &a->d[a->in_idx + a->delay];
+            sigma -= x[a->n_taps] * x[a->n_taps];
+            a->d[a->in_idx] = a->d[a->in_idx + a->dline_size] = a->in_buff[2 * i + 0];
+            sigma += x[0] * x[0];
+            if (sigma < 0.0) sigma = 0.0;
 
-            for (j = 0; j < a->n_taps; j++)
-            {
-                idx = (a->in_idx + j + a->delay) & a->mask;
-                y += a->w[j] * a->d[idx];
-                sigma += a->d[idx] * a->d[idx];
-            }
+            y = lms_dot (a->w, x, a->n_taps);
             inv_sigp = 1.0 / (sigma + 1e-10);
             error = a->d[a->in_idx] - y;
 
@@ -121,11 +135,7 @@ void xanr (ANR a, int position)
             c0 = 1.0 - a->two_mu * a->ngamma;
             c1 = a->two_mu * error * inv_sigp;
 
-            for (j = 0; j < a->n_taps; j++)
-            {
-                idx = (a->in_idx + j + a->delay) & a->mask;
-                a->w[j] = c0 * a->w[j] + c1 * a->d[idx];
-            }
+            lms_update (a->w, x, a->n_taps, c0, c1);
             a->in_idx = (a->in_idx + a->mask) & a->mask;
         }
     }
@@ -135,12 +145,12 @@ void xanr (ANR a, int position)
 
 void flush_anr (ANR a)
 {
-    memset (a->d, 0, sizeof(double) * ANR_DLINE_SIZE);
-    memset (a->w, 0, sizeof(double) * ANR_DLINE_SIZE);
+    memset (a->d, 0, sizeof(a->d));
+    memset (a->w, 0, sizeof(a->w));
     a->in_idx = 0;
 }
 
-void setBuffers_anr (ANR a, double* in, double* out)
+void setBuffers_anr (ANR a, real* in, real* out)
 {
     a->in_buff = in;
     a->out_buff = out;
@@ -187,6 +197,7 @@ SetRXAANRVals (int channel, int taps, int delay, double gain, double leakage)
     rxa[channel].anr.p->delay = delay;
     rxa[channel].anr.p->two_mu = gain;
     rxa[channel].anr.p->gamma = leakage;
+    clamp_anr (rxa[channel].anr.p);
     flush_anr (rxa[channel].anr.p);
     LeaveCriticalSection (&ch[channel].csDSP);
 }
@@ -196,6 +207,7 @@ SetRXAANRTaps (int channel, int taps)
 {
     EnterCriticalSection (&ch[channel].csDSP);
     rxa[channel].anr.p->n_taps = taps;
+    clamp_anr (rxa[channel].anr.p);
     flush_anr (rxa[channel].anr.p);
     LeaveCriticalSection (&ch[channel].csDSP);
 }
@@ -205,6 +217,7 @@ SetRXAANRDelay (int channel, int delay)
 {
     EnterCriticalSection (&ch[channel].csDSP);
     rxa[channel].anr.p->delay = delay;
+    clamp_anr (rxa[channel].anr.p);
     flush_anr (rxa[channel].anr.p);
     LeaveCriticalSection (&ch[channel].csDSP);
 }
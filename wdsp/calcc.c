@@ -33,26 +33,26 @@ void size_calcc (CALCC a)
     a->nsamps = a->ints * a->spi;
 
     a->tsamps = a->nsamps + a->npsamps;
-    a->env_TX = (double*)malloc0(a->nsamps * sizeof(double));
-    a->env_RX = (double*)malloc0(a->nsamps * sizeof(double));
-    a->x = (double*)malloc0(a->tsamps * sizeof(double));
-    a->ym = (double*)malloc0(a->tsamps * sizeof(double));
-    a->yc = (double*)malloc0(a->tsamps * sizeof(double));
-    a->ys = (double*)malloc0(a->tsamps * sizeof(double));
-    a->cat = (double*)malloc0(4 * a->nsamps * sizeof(double));
-
-    a->t    = (double *) malloc0 ((a->ints + 1) * sizeof(double));
-    a->tmap = (double *) malloc0 ((a->ints + 1) * sizeof(double));
+    a->env_TX = (real*)malloc0(a->nsamps * sizeof(real));
+    a->env_RX = (real*)malloc0(a->nsamps * sizeof(real));
+    a->x = (real*)malloc0(a->tsamps * sizeof(real));
+    a->ym = (real*)malloc0(a->tsamps * sizeof(real));
+    a->yc = (real*)malloc0(a->tsamps * sizeof(real));
+    a->ys = (real*)malloc0(a->tsamps * sizeof(real));
+    a->cat = (real*)malloc0(4 * a->nsamps * sizeof(real));
+
+    a->t    = (real *) malloc0 ((a->ints + 1) * sizeof(real));
+    a->tmap = (real *) malloc0 ((a->ints + 1) * sizeof(real));
     for (i = 0; i < a->ints + 1; i++)
-        a->t[i] = (double)i / (double)a->ints;
+        a->t[i] = (real)i / (real)a->ints;
 
-    a->cm = (double *) malloc0 (a->ints * 4 * sizeof(double));
-    a->cc = (double *) malloc0 (a->ints * 4 * sizeof(double));
-    a->cs = (double *) malloc0 (a->ints * 4 * sizeof(double));
-    a->cm_old = (double *) malloc0 (a->ints * 4 * sizeof (double));
+    a->cm = (real *) malloc0 (a->ints * 4 * sizeof(real));
+    a->cc = (real *) malloc0 (a->ints * 4 * sizeof(real));
+    a->cs = (real *) malloc0 (a->ints * 4 * sizeof(real));
+    a->cm_old = (real *) malloc0 (a->ints * 4 * sizeof (real));
 
-    a->rxs = (double *) malloc0 (a->nsamps * sizeof (complex));
-    a->txs = (double *) malloc0 (a->nsamps * sizeof (complex));
+    a->rxs = (real *) malloc0 (a->nsamps * sizeof (complex));
+    a->txs = (real *) malloc0 (a->nsamps * sizeof (complex));
 
     a->ccbld = create_builder(a->nsamps + a->npsamps, a->ints);
 
@@ -67,17 +67,17 @@ void size_calcc (CALCC a)
         a->ctrl.sbase[i] = i * a->spi;
     }
 
-    a->disp.x  = (double *) malloc0 (a->nsamps * sizeof (double));
-    a->disp.ym = (double *) malloc0 (a->nsamps * sizeof (double));
-    a->disp.yc = (double *) malloc0 (a->nsamps * sizeof (double));
-    a->disp.ys = (double *) malloc0 (a->nsamps * sizeof (double));
-    a->disp.cm = (double *) malloc0 (a->ints * 4 * sizeof(double));
-    a->disp.cc = (double *) malloc0 (a->ints * 4 * sizeof(double));
-    a->disp.cs = (double *) malloc0 (a->ints * 4 * sizeof(double));
-
-    a->util.pm = (double *) malloc0 (4 * a->util.ints * sizeof(double));
-    a->util.pc = (double *) malloc0 (4 * a->util.ints * sizeof(double));
-    a->util.ps = (double *) malloc0 (4 * a->util.ints * sizeof(double));
+    a->disp.x  = (real *) malloc0 (a->nsamps * sizeof (real));
+    a->disp.ym = (real *) malloc0 (a->nsamps * sizeof (real));
+    a->disp.yc = (real *) malloc0 (a->nsamps * sizeof (real));
+    a->disp.ys = (real *) malloc0 (a->nsamps * sizeof (real));
+    a->disp.cm = (real *) malloc0 (a->ints * 4 * sizeof(real));
+    a->disp.cc = (real *) malloc0 (a->ints * 4 * sizeof(real));
+    a->disp.cs = (real *) malloc0 (a->ints * 4 * sizeof(real));
+
+    a->util.pm = (real *) malloc0 (4 * a->util.ints * sizeof(real));
+    a->util.pc = (real *) malloc0 (4 * a->util.ints * sizeof(real));
+    a->util.ps = (real *) malloc0 (4 * a->util.ints * sizeof(real));
 }
 
 void desize_calcc (CALCC a)
@@ -116,9 +116,9 @@ void desize_calcc (CALCC a)
     _aligned_free(a->env_RX);
 }
 
-CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int spi, double hw_scale,
-    double moxdelay, double loopdelay, double ptol, int mox, int solidmox, int pin, int map, int stbl,
-    int npsamps, double alpha)
+CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int spi, real hw_scale,
+    real moxdelay, real loopdelay, real ptol, int mox, int solidmox, int pin, int map, int stbl,
+    int npsamps, real alpha)
 {
     CALCC a = (CALCC) malloc0 (sizeof (calcc));
     a->channel = channel;
@@ -182,8 +182,8 @@ CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int s
 
     size_calcc (a);
 
-    a->temprx = (double*)malloc0(2048 * sizeof(complex));                                                       // remove later
-    a->temptx = (double*)malloc0(2048 * sizeof(complex));                                                       // remove later
+    a->temprx = (real*)malloc0(2048 * sizeof(complex));                                                         // remove later
+    a->temptx = (real*)malloc0(2048 * sizeof(complex));                                                         // remove later
 
     // correction save and restore threads
     InterlockedBitTestAndReset(&a->savecorr_bypass, 0);
@@ -247,9 +247,9 @@ void flush_calcc (CALCC a)
 void scheck(CALCC a)
 {
     int i, j, k;
-    double v, dx, out, x, xold;
+    real v, dx, out, x, xold;
     int intm1 = a->ints - 1;
-    const double diff_thresh = 0.05;
+    const real diff_thresh = 0.05;
     a->binfo[6] = 0x0000;
 
     for (i = 0; i < 4 * a->ints; i++)
@@ -268,8 +268,8 @@ void scheck(CALCC a)
         for (j = 0; j < 4; j++)
         {
             k = 4 * i + j;
-            v = (double)k / (4.0 * (double)a->ints);
-            dx = (a->t[i + 1] - a->t[i]) * (double)j / 4.0;
+            v = (real)k / (4.0 * (real)a->ints);
+            dx = (a->t[i + 1] - a->t[i]) * (real)j / 4.0;
             out = v * (a->cm[4 * i + 0] + dx * (a->cm[4 * i + 1] + dx * (a->cm[4 * i + 2] + dx * a->cm[4 * i + 3])));
             if (out > 1.0)
                 a->binfo[6] |= 0x0004;
@@ -288,14 +288,14 @@ void scheck(CALCC a)
         if (fabs (a->cm[4 * i + 0] - a->cm_old[4 * i + 0]) > diff_thresh) a->binfo[6] |= 0x0040;
     xold = a->cm_old[4 * intm1 + 0] + dx * (a->cm_old[4 * intm1 + 1] + dx * (a->cm_old[4 * intm1 + 2] + dx * a->cm_old[4 * intm1 + 3]));
     if (fabs (x - xold) > diff_thresh) a->binfo[6] |= 0x0040;
-    memcpy (a->cm_old, a->cm, a->ints * 4 * sizeof(double));
+    memcpy (a->cm_old, a->cm, a->ints * 4 * sizeof(real));
 }
 
-void rxscheck (int rints, double* tvec, double* coef, int* info)
+void rxscheck (int rints, real* tvec, real* coef, int* info)
 {
     int i, j, k;
     int rintsm1 = rints - 1;
-    double v, dx, out;
+    real v, dx, out;
     *info = 0x0000;
     for (i = 0; i < 4 * rints; i++)
         if (isnan (coef[i])) *info |= 0x0001;
@@ -307,8 +307,8 @@ void rxscheck (int rints, double* tvec, double* coef, int* info)
         for (j = 0; j < 4; j++)
         {
             k = 4 * i + j;
-            v = (double)k / (4.0 * (double)rints);
-            dx = (tvec[i + 1] - tvec[i]) * (double)j / 4.0;
+            v = (real)k / (4.0 * (real)rints);
+            dx = (tvec[i + 1] - tvec[i]) * (real)j / 4.0;
             out = v * (coef[4 * i + 0] + dx * (coef[4 * i + 1] + dx * (coef[4 * i + 2] + dx * coef[4 * i + 3])));
             if (out > 1.0)  // potentially use hw_scale here
                 *info |= 0x0004;
@@ -324,7 +324,7 @@ void rxscheck (int rints, double* tvec, double* coef, int* info)
 void calc (CALCC a)
 {
     int i;
-    double norm;
+    real norm;
     for (i = 0; i < a->nsamps; i++)
     {
         a->env_TX[i] = sqrt (a->txs[2 * i + 0] * a->txs[2 * i + 0] + a->txs[2 * i + 1] * a->txs[2 * i + 1]);
@@ -332,15 +332,15 @@ void calc (CALCC a)
     }
     {
         int rints, ix;
-        double dx;
-        double tvec[3];
-        double txrxcoefs[4 * 2];
-        double rx_scale;
+        real dx;
+        real tvec[3];
+        real txrxcoefs[4 * 2];
+        real rx_scale;
         if (a->ints < 16) rints = 1;
         else              rints = 2;
         ix = rints - 1;
         for (i = 0; i <= rints; i++)
-            tvec[i] = (double)i / (double)rints / a->hw_scale;
+            tvec[i] = (real)i / (real)rints / a->hw_scale;
         dx = tvec[rints] - tvec[rints - 1];
         xbuilder(a->ccbld, a->nsamps, a->env_TX, a->env_RX, rints, tvec, &(a->binfo[0]), txrxcoefs, a->ptol);
         rxscheck (rints, tvec, txrxcoefs, &a->binfo[7]);
@@ -362,8 +362,8 @@ void calc (CALCC a)
 
     if (a->pin) // regress
     {
-        const double slope = 0.001;
-        double max_rx;
+        const real slope = 0.001;
+        real max_rx;
         for (i = 0; i < a->nsamps; i++)
         {
             max_rx = (1.0 - slope + slope * a->hw_scale * a->env_TX[i]) / a->rx_scale;
@@ -382,7 +382,7 @@ void calc (CALCC a)
         if (a->stbl && _InterlockedAnd (&a->ctrl.running, 1) && a->scOK)
         {
             int k;
-            double dx, ymo, yco, yso;
+            real dx, ymo, yco, yso;
             if ((k = (int)(a->x[i] * a->ints)) > a->ints - 1) k = a->ints - 1;
             dx = a->x[i] - a->t[k];
             ymo = a->cm[4 * k + 0] + dx * (a->cm[4 * k + 1] + dx * (a->cm[4 * k + 2] + dx * a->cm[4 * k + 3]));
@@ -396,8 +396,8 @@ void calc (CALCC a)
 
     if (a->pin) // pin
     {
-        const double mval = 1.0e+00 - 1.0e-10;
-        double cval, sval;
+        const real mval = 1.0e+00 - 1.0e-10;
+        real cval, sval;
         for (i = 0; i < a->nsamps; i++)
         {
             a->cat[4 * i + 0] = a->x[i];
@@ -405,7 +405,7 @@ void calc (CALCC a)
             a->cat[4 * i + 2] = a->yc[i];
             a->cat[4 * i + 3] = a->ys[i];
         }
-        qsort(a->cat, a->nsamps, 4 * sizeof(double), fcompare);
+        qsort(a->cat, a->nsamps, 4 * sizeof(real), fcompare);
         for (i = 0; i < a->nsamps; i++)
         {
             a->x[i]  = a->cat[4 * i + 0];
@@ -443,8 +443,8 @@ void calc (CALCC a)
     if (a->pin) // tune
     {
         int k = a->ints - 1;
-        double dx = a->t[a->ints] - a->t[a->ints - 1];
-        double sf = 1.0 / (a->cm[4 * k + 0] + dx * (a->cm[4 * k + 1] + dx * (a->cm[4 * k + 2] + dx * a->cm[4 * k + 3])));
+        real dx = a->t[a->ints] - a->t[a->ints - 1];
+        real sf = 1.0 / (a->cm[4 * k + 0] + dx * (a->cm[4 * k + 1] + dx * (a->cm[4 * k + 2] + dx * a->cm[4 * k + 3])));
         for (i = 0; i < 4 * a->ints; i++)
             a->cm[i] *= sf;
     }
@@ -461,21 +461,21 @@ void calc (CALCC a)
     }
 
     EnterCriticalSection (&a->disp.cs_disp);
-    memcpy(a->disp.x, a->x,  a->nsamps * sizeof (double));
-    memcpy(a->disp.ym, a->ym, a->nsamps * sizeof (double));
-    memcpy(a->disp.yc, a->yc, a->nsamps * sizeof (double));
-    memcpy(a->disp.ys, a->ys, a->nsamps * sizeof (double));
+    memcpy(a->disp.x, a->x,  a->nsamps * sizeof (real));
+    memcpy(a->disp.ym, a->ym, a->nsamps * sizeof (real));
+    memcpy(a->disp.yc, a->yc, a->nsamps * sizeof (real));
+    memcpy(a->disp.ys, a->ys, a->nsamps * sizeof (real));
     if (a->scOK)
     {
-        memcpy(a->disp.cm, a->cm, a->ints * 4 * sizeof (double));
-        memcpy(a->disp.cc, a->cc, a->ints * 4 * sizeof (double));
-        memcpy(a->disp.cs, a->cs, a->ints * 4 * sizeof (double));
+        memcpy(a->disp.cm, a->cm, a->ints * 4 * sizeof (real));
+        memcpy(a->disp.cc, a->cc, a->ints * 4 * sizeof (real));
+        memcpy(a->disp.cs, a->cs, a->ints * 4 * sizeof (real));
     }
     else
     {
-        memset(a->disp.cm, 0, a->ints * 4 * sizeof (double));
-        memset(a->disp.cc, 0, a->ints * 4 * sizeof (double));
-        memset(a->disp.cs, 0, a->ints * 4 * sizeof (double));
+        memset(a->disp.cm, 0, a->ints * 4 * sizeof (real));
+        memset(a->disp.cc, 0, a->ints * 4 * sizeof (real));
+        memset(a->disp.cs, 0, a->ints * 4 * sizeof (real));
     }
     LeaveCriticalSection (&a->disp.cs_disp);
 cleanup:
@@ -579,11 +579,11 @@ void __cdecl PSRestoreCorrection(void *pargs)
             for (i = 0; i < a->util.ints; i++)
             {
                 for (k = 0; k < 4; k++)
-                    fscanf(file, "%le", &(a->util.pm[4 * i + k]));
+                    fscanf(file, SCNreal, &(a->util.pm[4 * i + k]));
                 for (k = 0; k < 4; k++)
-                    fscanf(file, "%le", &(a->util.pc[4 * i + k]));
+                    fscanf(file, SCNreal, &(a->util.pc[4 * i + k]));
                 for (k = 0; k < 4; k++)
-                    fscanf(file, "%le", &(a->util.ps[4 * i + k]));
+                    fscanf(file, SCNreal, &(a->util.ps[4 * i + k]));
             }
             fclose(file);
             if (!InterlockedBitTestAndSet(&a->ctrl.running, 0))
@@ -603,10 +603,10 @@ void __cdecl PSRestoreCorrection(void *pargs)
 ********************************************************************************************************/
 
 PORT
-void pscc (int channel, int size, double* tx, double* rx)
+void pscc (int channel, int size, real* tx, real* rx)
 {
     int i, n, m;
-    double env;
+    real env;
     CALCC a;
     EnterCriticalSection (&txa[channel].calcc.cs_update);
     a = txa[channel].calcc.p;
@@ -714,7 +714,7 @@ void pscc (int channel, int size, double* tx, double* rx)
                             if (env < a->tmap[n]) n--;
                         }
                         else
-                            n = (int)(env * (double)a->ints);
+                            n = (int)(env * (real)a->ints);
                         m = a->ctrl.sbase[n] + a->ctrl.sindex[n];
                         a->txs[2 * m + 0] = tx[2 * i + 0];
                         a->txs[2 * m + 1] = tx[2 * i + 1];
@@ -837,10 +837,10 @@ void psccF (int channel, int size, float *Itxbuff, float *Qtxbuff, float *Irxbuf
     LeaveCriticalSection (&txa[channel].calcc.cs_update);
     for (i = 0; i < size; i++)
     {
-        a->temptx[2 * i + 0] = (double)Itxbuff[i];
-        a->temptx[2 * i + 1] = (double)Qtxbuff[i];
-        a->temprx[2 * i + 0] = (double)Irxbuff[i];
-        a->temprx[2 * i + 1] = (double)Qrxbuff[i];
+        a->temptx[2 * i + 0] = (real)Itxbuff[i];
+        a->temptx[2 * i + 1] = (real)Qtxbuff[i];
+        a->temprx[2 * i + 0] = (real)Irxbuff[i];
+        a->temprx[2 * i + 1] = (real)Qrxbuff[i];
     }
     pscc (channel, size, a->temptx, a->temprx);
 }
@@ -982,7 +982,7 @@ PORT
 double SetPSTXDelay (int channel, double delay)
 {
     CALCC a;
-    double adelay;
+    real adelay;
     EnterCriticalSection (&txa[channel].calcc.cs_update);
     a = txa[channel].calcc.p;
     a->txdel = delay;
@@ -1036,17 +1036,17 @@ void SetPSPtol (int channel, double ptol)
 }
 
 PORT
-void GetPSDisp (int channel, double* x, double* ym, double* yc, double* ys, double* cm, double* cc, double* cs)
+void GetPSDisp (int channel, real* x, real* ym, real* yc, real* ys, real* cm, real* cc, real* cs)
 {
     CALCC a = txa[channel].calcc.p;
     EnterCriticalSection (&a->disp.cs_disp);
-    memcpy (x,  a->disp.x,  a->nsamps * sizeof (double));
-    memcpy (ym, a->disp.ym, a->nsamps * sizeof (double));
-    memcpy (yc, a->disp.yc, a->nsamps * sizeof (double));
-    memcpy (ys, a->disp.ys, a->nsamps * sizeof (double));
-    memcpy (cm, a->disp.cm, a->ints * 4 * sizeof (double));
-    memcpy (cc, a->disp.cc, a->ints * 4 * sizeof (double));
-    memcpy (cs, a->disp.cs, a->ints * 4 * sizeof (double));
+    memcpy (x,  a->disp.x,  a->nsamps * sizeof (real));
+    memcpy (ym, a->disp.ym, a->nsamps * sizeof (real));
+    memcpy (yc, a->disp.yc, a->nsamps * sizeof (real));
+    memcpy (ys, a->disp.ys, a->nsamps * sizeof (real));
+    memcpy (cm, a->disp.cm, a->ints * 4 * sizeof (real));
+    memcpy (cc, a->disp.cc, a->ints * 4 * sizeof (real));
+    memcpy (cs, a->disp.cs, a->ints * 4 * sizeof (real));
     LeaveCriticalSection (&a->disp.cs_disp);
 }
 
@@ -45,31 +45,31 @@ typedef struct _calcc
     int convex;
     int stbl;
     int scOK;
-    double hw_scale;
-    double rx_scale;
-    double alpha;
+    real hw_scale;
+    real rx_scale;
+    real alpha;
 
     int tsamps;
-    double* env_TX;
-    double* env_RX;
-    double* x;
-    double* ym;
-    double* yc;
-    double* ys;
-    double* cat;
-
-    double* t;
-    double* tmap;
-    double* cm;
-    double* cc;
-    double* cs;
-    double* cm_old;
-    double* rxs;
-    double* txs;
-    double ptol;
+    real* env_TX;
+    real* env_RX;
+    real* x;
+    real* ym;
+    real* yc;
+    real* ys;
+    real* cat;
+
+    real* t;
+    real* tmap;
+    real* cm;
+    real* cc;
+    real* cs;
+    real* cm_old;
+    real* rxs;
+    real* txs;
+    real ptol;
     int* info;
     int* binfo;
-    double txdel;
+    real txdel;
     BLDR ccbld;
     volatile long savecorr_bypass;
     HANDLE Sem_SaveCorr;
@@ -81,8 +81,8 @@ typedef struct _calcc
     HANDLE Sem_TurnOff;
     struct _ctrl
     {
-        double moxdelay;
-        double loopdelay;
+        real moxdelay;
+        real loopdelay;
         int state;
         int reset;
         int automode;
@@ -99,7 +99,7 @@ typedef struct _calcc
         volatile LONG calcdone;
         int waitsamps;
         int waitcount;
-        double env_maxtx;
+        real env_maxtx;
         volatile long running;
         int bs_count;
         volatile long current_state;
@@ -107,13 +107,13 @@ typedef struct _calcc
     } ctrl;
     struct _disp
     {
-        double* x;
-        double* ym;
-        double* yc;
-        double* ys;
-        double* cm;
-        double* cc;
-        double* cs;
+        real* x;
+        real* ym;
+        real* yc;
+        real* ys;
+        real* cm;
+        real* cc;
+        real* cs;
         CRITICAL_SECTION cs_disp;
     } disp;
     DELAY rxdelay;
@@ -124,23 +124,23 @@ typedef struct _calcc
         char restfile[256];
         int ints;
         int channel;
-        double* pm;
-        double* pc;
-        double* ps;
+        real* pm;
+        real* pc;
+        real* ps;
     } util;
-    double* temptx;             //////////////////////////////////////////////////// temporary tx complex buffer - remove with new callback3port()
-    double* temprx;             //////////////////////////////////////////////////// temporary rx complex buffer - remove with new callback3port()
+    real* temptx;               //////////////////////////////////////////////////// temporary tx complex buffer - remove with new callback3port()
+    real* temprx;               //////////////////////////////////////////////////// temporary rx complex buffer - remove with new callback3port()
 } calcc, *CALCC;
 
-extern CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int spi, double hw_scale,
-    double moxdelay, double loopdelay, double ptol, int mox, int solidmox, int pin, int map, int stbl,
-    int npsamps, double alpha);
+extern CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int spi, real hw_scale,
+    real moxdelay, real loopdelay, real ptol, int mox, int solidmox, int pin, int map, int stbl,
+    int npsamps, real alpha);
 
 extern void destroy_calcc (CALCC a);
 
 extern void flush_calcc (CALCC a);
 
-extern __declspec(dllexport) void pscc (int channel, int size, double* tx, double* rx);
+extern __declspec(dllexport) void pscc (int channel, int size, real* tx, real* rx);
 
 extern void __cdecl PSSaveCorrection(void* pargs);
 
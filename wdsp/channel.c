@@ -76,6 +76,7 @@ PORT
 void OpenChannel (int channel, int in_size, int dsp_size, int input_samplerate, int dsp_rate, int output_samplerate,
     int type, int state, double tdelayup, double tslewup, double tdelaydown, double tslewdown, int bfo)
 {
+    init_simd ();
     ch[channel].in_size = in_size;
     ch[channel].dsp_size = dsp_size;
     ch[channel].in_rate = input_samplerate;
@@ -44,7 +44,7 @@ struct _ch
     CRITICAL_SECTION csDSP;     // used to block dsp while parameters are updated or buffers flushed
     CRITICAL_SECTION csEXCH;    // used to block fexchange() while parameters are updated or buffers flushed
     int state;                  // 0 for channel OFF; 1 for channel ON
-    double tdelayup;
+    double tdelayup;            // the slew times are double in all builds: (int)(0.010f * 192000) is 1919
     double tslewup;
     double tdelaydown;
     double tslewdown;
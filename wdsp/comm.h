@@ -54,6 +54,30 @@ warren@wpratt.com
 #endif
 #include "fftw3.h"
 
+// sample data type: double, or float if compiled with -DWDSP_FLOAT
+// (then the single-precision FFTW library libfftw3f is used)
+#ifdef WDSP_FLOAT
+#define WDSP_REAL                       float
+#define SCNreal                         "%e"                // scanf format for real
+#define fftw_complex                    fftwf_complex
+#define fftw_plan                       fftwf_plan
+#define fftw_plan_dft_1d                fftwf_plan_dft_1d
+#define fftw_plan_dft_r2c_1d            fftwf_plan_dft_r2c_1d
+#define fftw_plan_dft_c2r_1d            fftwf_plan_dft_c2r_1d
+#define fftw_execute                    fftwf_execute
+#define fftw_execute_dft_r2c            fftwf_execute_dft_r2c
+#define fftw_execute_dft_c2r            fftwf_execute_dft_c2r
+#define fftw_destroy_plan               fftwf_destroy_plan
+#define fftw_malloc                     fftwf_malloc
+#define fftw_free                       fftwf_free
+#define fftw_import_wisdom_from_filename fftwf_import_wisdom_from_filename
+#define fftw_export_wisdom_to_filename  fftwf_export_wisdom_to_filename
+#else
+#define WDSP_REAL                       double
+#define SCNreal                         "%le"
+#endif
+typedef WDSP_REAL real;
+
 #include "amd.h"
 #include "ammod.h"
 #include "amsq.h"
@@ -101,6 +125,7 @@ warren@wpratt.com
 #include "sender.h"
 #include "shift.h"
 #include "siphon.h"
+#include "simd.h"
 #include "slew.h"
 #include "snb.h"
 #include "ssql.h"
@@ -109,6 +134,7 @@ warren@wpratt.com
 #include "utilities.h"
 #include "varsamp.h"
 #include "wcpAGC.h"
+#include "wisdom.h"
 
 // manage differences among consoles
 #define _Thetis
@@ -126,7 +152,7 @@ warren@wpratt.com
 #define dMAX_PIXELS                     16384               // maximum number of pixels that can be requested
 #define dMAX_AVERAGE                    60                  // maximum number of pixel frames that will be window-averaged
 #ifdef _Thetis
-#define dINREAL                         double
+#define dINREAL                         real
 #else
 #define dINREAL                         float
 #endif
@@ -147,5 +173,5 @@ warren@wpratt.com
 #define TWOPI                           6.2831853071795864
 
 // miscellaneous
-typedef double complex[2];
+typedef real complex[2];
 #define PORT                            __declspec( dllexport )
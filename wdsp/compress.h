@@ -31,9 +31,9 @@ typedef struct _compressor
 {
     int run;
     int buffsize;
-    double *inbuff;
-    double *outbuff;
-    double gain;
+    real *inbuff;
+    real *outbuff;
+    real gain;
 } compressor, *COMPRESSOR;
 
 extern void xcompressor (COMPRESSOR a);
@@ -41,15 +41,15 @@ extern void xcompressor (COMPRESSOR a);
 extern COMPRESSOR create_compressor (
                 int run,
                 int buffsize,
-                double* inbuff,
-                double* outbuff,
-                double gain );
+                real* inbuff,
+                real* outbuff,
+                real gain );
 
 extern void destroy_compressor (COMPRESSOR a);
 
 extern void flush_compressor (COMPRESSOR a);
 
-extern void setBuffers_compressor (COMPRESSOR a, double* in, double* out);
+extern void setBuffers_compressor (COMPRESSOR a, real* in, real* out);
 
 extern void setSamplerate_compressor (COMPRESSOR a, int rate);
 
@@ -33,32 +33,32 @@ typedef struct _delay
 {
     int run;            // run
     int size;           // number of input samples per buffer
-    double* in;         // input buffer
-    double* out;        // output buffer
+    real* in;           // input buffer
+    real* out;          // output buffer
     int rate;           // samplerate
-    double tdelta;      // delay increment required (seconds)
-    double tdelay;      // delay requested (seconds)
+    real tdelta;        // delay increment required (seconds)
+    real tdelay;        // delay requested (seconds)
 
     int L;              // interpolation factor
     int ncoef;          // number of coefficients
     int cpp;            // coefficients per phase
-    double ft;          // normalized cutoff frequency
-    double* h;          // coefficients
+    real ft;            // normalized cutoff frequency
+    real* h;            // coefficients
     int snum;           // starting sample number (0 for sub-sample delay)
     int phnum;          // phase number
 
     int idx_in;         // index for input into ring
     int rsize;          // ring size in complex samples
-    double* ring;       // ring buffer
+    real* ring;         // ring buffer
 
-    double adelta;      // actual delay increment
-    double adelay;      // actual delay
+    real adelta;        // actual delay increment
+    real adelay;        // actual delay
 
     CRITICAL_SECTION cs_update;
 
 } delay, *DELAY;
 
-extern DELAY create_delay (int run, int size, double* in, double* out, int rate, double tdelta, double tdelay);
+extern DELAY create_delay (int run, int size, real* in, real* out, int rate, real tdelta, real tdelay);
 
 extern void destroy_delay (DELAY a);
 
@@ -70,8 +70,8 @@ extern void xdelay (DELAY a);
 
 extern void SetDelayRun (DELAY a, int run);
 
-extern double SetDelayValue (DELAY a, double delay);        // returns actual delay in seconds
+extern real SetDelayValue (DELAY a, real delay);            // returns actual delay in seconds
 
-extern void SetDelayBuffs (DELAY a, int size, double* in, double* out);
+extern void SetDelayBuffs (DELAY a, int size, real* in, real* out);
 
 #endif
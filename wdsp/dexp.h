@@ -30,13 +30,13 @@ warren@wpratt.com
 typedef struct _delring
 {
     int rsize;                          // ringsize (measured in complex samples)
-    double* ring;                       // ring buffer
+    real* ring;                         // ring buffer
     int inptr;                          // ring input pointer (counts in complex samples)
     int outptr;                         // ring output pointer (counts in complex samples)
     int rdelay;                         // ring delay (measured in complex samples)
     int size;                           // input/output size in complex samples
-    double* in;                         // source buffer
-    double* out;                        // destination buffer
+    real* in;                           // source buffer
+    real* out;                          // destination buffer
 } delring, *DELRING;
 
 typedef struct _dexp
@@ -44,43 +44,43 @@ typedef struct _dexp
     int id;                             // 'id' for this dexp
     int run_dexp;                       // 0 if dexp is OFF; 1 if it's ON
     int size;                           // size of input/output buffers
-    double* in;                         // audio input buffer
-    double* out;                        // audio output buffer; can be same as 'in'
-    double rate;                        // sample rate
-    double dettau;                      // detection averaging time constant
-    double avm;                         // averaging multiplier
-    double onem_avm;                    // one minus averaging multiplier
-    double avsig;                       // averaged detection signal
+    real* in;                           // audio input buffer
+    real* out;                          // audio output buffer; can be same as 'in'
+    real rate;                          // sample rate
+    real dettau;                        // detection averaging time constant
+    real avm;                           // averaging multiplier
+    real onem_avm;                      // one minus averaging multiplier
+    real avsig;                         // averaged detection signal
     int state;                          // state machine control
     int count;                          // count variable used within a state
-    double tattack;                     // attack time
-    double tdecay;                      // decay time
+    real tattack;                       // attack time
+    real tdecay;                        // decay time
     int nattack;                        // one less than total number of attack multipliers
     int ndecay;                         // one less than total number of decay multipliers
-    double* cattack;                    // attack curve multipliers
-    double* cdecay;                     // decay curve multipliers
-    double attack_thresh;               // attack threshold
-    double hold_thresh;                 // hold & decay threshold
-    double thold;                       // hold time
+    real* cattack;                      // attack curve multipliers
+    real* cdecay;                       // decay curve multipliers
+    real attack_thresh;                 // attack threshold
+    real hold_thresh;                   // hold & decay threshold
+    real thold;                         // hold time
     int nhold;                          // hold count
-    double exp_ratio;                   // expander ratio (high-gain to low-gain)
-    double hysteresis_ratio;            // ratio hold_thresh/attack_thresh.  0.0 < ratio < 1.0
-    double low_gain;                    // gain when gate is closed
-    double* trigsig;                    // buffer for trigger signal (signal after side-channel filter)
-    double* delsig;                     // buffer for signal delayed to match trigger signal
-    double peak;                        // peak signal value to return to console
+    real exp_ratio;                     // expander ratio (high-gain to low-gain)
+    real hysteresis_ratio;              // ratio hold_thresh/attack_thresh.  0.0 < ratio < 1.0
+    real low_gain;                      // gain when gate is closed
+    real* trigsig;                      // buffer for trigger signal (signal after side-channel filter)
+    real* delsig;                       // buffer for signal delayed to match trigger signal
+    real peak;                          // peak signal value to return to console
     // side-channel bandpass filter & and buffer for compensating delay
     int run_filt;                       // 1 = side-channel filter and compensating delay are ON, 0 = OFF
     int nc;                             // number of coefficients
     int wintype;                        // window type
-    double low_cut;                     // low cutoff frequency
-    double high_cut;                    // high cutoff frequency
+    real low_cut;                       // low cutoff frequency
+    real high_cut;                      // high cutoff frequency
     FIRCORE p;                          // filter structure
     DELRING scdring;                    // delay ring for side channel
     // output audio delay to cover RF_Delay + Xmtr_delay_and_upslew
-    double* audbuffer;                  // buffer to serve as input to audring
+    real* audbuffer;                    // buffer to serve as input to audring
     int run_audelay;                    // 'run' variable for audio delay ring
-    double audelay;                     // audio output delay in seconds
+    real audelay;                       // audio output delay in seconds
     DELRING audring;                    // audio delay ring
     // vox
     int run_vox;
@@ -92,18 +92,18 @@ typedef struct _dexp
     int antivox_run;                    // 'run' for anti-vox
     int antivox_new;                    // internal variable indicating new anti-vox data is available
     int antivox_size;                   // size of anti-vox data buffer
-    double antivox_rate;                // sample-rate of anti-vox data
-    double antivox_tau;                 // time-constant of anti-vox smoothing
-    double antivox_gain;                // anti-vox gain factor
-    double antivox_mult;                // multiplier for anti-vox smoothing
-    double antivox_onemmult;            // one minus antivox_mult
-    double antivox_level;               // current anti-vox smoothed signal level
-    double* antivox_data;               // buffer to hold new anti-vox data
+    real antivox_rate;                  // sample-rate of anti-vox data
+    real antivox_tau;                   // time-constant of anti-vox smoothing
+    real antivox_gain;                  // anti-vox gain factor
+    real antivox_mult;                  // multiplier for anti-vox smoothing
+    real antivox_onemmult;              // one minus antivox_mult
+    real antivox_level;                 // current anti-vox smoothed signal level
+    real* antivox_data;                 // buffer to hold new anti-vox data
 } dexp, *DEXP;
 
 extern DEXP pdexp[];
 
-__declspec (dllexport) void create_dexp (int id, int run_dexp, int size, double* in, double* out, int rate, double dettau, double tattack, double tdecay,
+__declspec (dllexport) void create_dexp (int id, int run_dexp, int size, real* in, real* out, int rate, double dettau, double tattack, double tdecay,
     double thold, double exp_ratio, double hyst_ratio, double attack_thresh, int nc, int wtype, double lowcut, double highcut,
     int run_filt, int run_vox, int run_audelay, double audelay, void (__stdcall *pushvox)(int id, int active),
     int antivox_run, int antivox_size, int antivox_rate, double antivox_gain, double antivox_tau);
@@ -118,6 +118,6 @@ __declspec (dllexport) void SetDEXPSize (int id, int size);
 
 __declspec (dllexport) void SetDEXPRate (int id, double rate);
 
-__declspec (dllexport) void SendAntiVOXData (int id, int nsamples, double* data);
+__declspec (dllexport) void SendAntiVOXData (int id, int nsamples, real* data);
 
 #endif
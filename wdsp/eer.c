@@ -27,7 +27,7 @@ warren@wpratt.com
 #include "comm.h"
 
 PORT
-EER create_eer (int run, int size, double* in, double* out, double* outM, int rate, double mgain, double pgain, int rundelays, double mdelay, double pdelay, int amiq)
+EER create_eer (int run, int size, real* in, real* out, real* outM, int rate, double mgain, double pgain, int rundelays, double mdelay, double pdelay, int amiq)
 {
     EER a = (EER) malloc0 (sizeof (eer));
     a->run = run;
@@ -60,8 +60,8 @@ EER create_eer (int run, int size, double* in, double* out, double* outM, int ra
         a->pdelay);                                 // delay
     InitializeCriticalSectionAndSpinCount(&a->cs_update, 2500);
 
-    a->legacy  = (double *) malloc0 (2048 * sizeof (complex));                                                      /////////////// legacy interface - remove
-    a->legacyM = (double *) malloc0 (2048 * sizeof (complex));                                                      /////////////// legacy interface - remove
+    a->legacy  = (real *) malloc0 (2048 * sizeof (complex));                                                        /////////////// legacy interface - remove
+    a->legacyM = (real *) malloc0 (2048 * sizeof (complex));                                                        /////////////// legacy interface - remove
 
     return a;
 }
@@ -89,7 +89,7 @@ void xeer (EER a)
     if (a->run)
     {
         int i;
-        double I, Q, mag;
+        real I, Q, mag;
         for (i = 0; i < a->size; i++)
         {
             I = a->in[2 * i + 0];
@@ -378,8 +378,8 @@ void xeerEXTF (int id, float* inI, float* inQ, float* outI, float* outQ, float*
         SetDelayBuffs (a->pdel, a->size, a->out, a->out);
         for (i = 0; i < a->size; i++)
         {
-            a->legacy[2 * i + 0] = (double)inI[i];
-            a->legacy[2 * i + 1] = (double)inQ[i];
+            a->legacy[2 * i + 0] = (real)inI[i];
+            a->legacy[2 * i + 1] = (real)inQ[i];
         }
         xeer (a);
         for (i = 0; i < a->size; i++)
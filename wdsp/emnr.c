@@ -166,25 +166,25 @@ double e1xb (double x)
 void calc_window (EMNR a)
 {
     int i;
-    double arg, sum, inv_coherent_gain;
+    real arg, sum, inv_coherent_gain;
     switch (a->wintype)
     {
     case 0:
-        arg = 2.0 * PI / (double)a->fsize;
+        arg = 2.0 * PI / (real)a->fsize;
         sum = 0.0;
         for (i = 0; i < a->fsize; i++)
         {
-            a->window[i] = sqrt (0.54 - 0.46 * cos((double)i * arg));
+            a->window[i] = sqrt (0.54 - 0.46 * cos((real)i * arg));
             sum += a->window[i];
         }
-        inv_coherent_gain = (double)a->fsize / sum;
+        inv_coherent_gain = (real)a->fsize / sum;
         for (i = 0; i < a->fsize; i++)
             a->window[i] *= inv_coherent_gain;
         break;
     }
 }
 
-void interpM (double* res, double x, int nvals, double* xvals, double* yvals)
+void interpM (real* res, real x, int nvals, real* xvals, real* yvals)
 {
     if (x <= xvals[0])
         *res = yvals[0];
@@ -193,7 +193,7 @@ void interpM (double* res, double x, int nvals, double* xvals, double* yvals)
     else
     {
         int idx = 0;
-        double xllow, xlhigh, frac;
+        real xllow, xlhigh, frac;
         while (x >= xvals[idx])  idx++;
         xllow = log10 (xvals[idx - 1]);
         xlhigh = log10(xvals[idx]);
@@ -202,17 +202,93 @@ void interpM (double* res, double x, int nvals, double* xvals, double* yvals)
     }
 }
 
+// The FFT plans only depend on the FFT size, so they are shared among all
+// EMNR instances with the same fsize (typically, one per receiver). They are
+// made with scratch buffers and executed with the new-array interface on the
+// buffers of each instance; all buffers come from malloc0() and therefore
+// have the same alignment. If the table is full, an instance gets its own plans.
+
+#define EMNR_MAX_PLANS 8
+
+static struct _emnr_plans
+{
+    int fsize;
+    int refcount;
+    real* in;
+    real* out;
+    fftw_plan Rfor;
+    fftw_plan Rrev;
+} emnr_plans[EMNR_MAX_PLANS];
+
+static CRITICAL_SECTION emnr_plans_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void get_emnr_plans (EMNR a)
+{
+    int i, slot = -1;
+    EnterCriticalSection (&emnr_plans_lock);
+    for (i = 0; i < EMNR_MAX_PLANS; i++)
+    {
+        if (emnr_plans[i].refcount > 0 && emnr_plans[i].fsize == a->fsize)
+        {
+            slot = i;
+            break;
+        }
+        if (emnr_plans[i].refcount == 0 && slot < 0)
+            slot = i;
+    }
+    if (slot >= 0)
+    {
+        if (emnr_plans[slot].refcount == 0)
+        {
+            emnr_plans[slot].fsize = a->fsize;
+            emnr_plans[slot].in  = (real *)malloc0(a->fsize * sizeof(real));
+            emnr_plans[slot].out = (real *)malloc0(a->msize * sizeof(complex));
+            emnr_plans[slot].Rfor = wisdom_plan_dft_r2c_1d(a->fsize, emnr_plans[slot].in, (fftw_complex *)emnr_plans[slot].out);
+            emnr_plans[slot].Rrev = wisdom_plan_dft_c2r_1d(a->fsize, (fftw_complex *)emnr_plans[slot].out, emnr_plans[slot].in);
+        }
+        emnr_plans[slot].refcount++;
+        a->Rfor = emnr_plans[slot].Rfor;
+        a->Rrev = emnr_plans[slot].Rrev;
+    }
+    else
+    {
+        a->Rfor = wisdom_plan_dft_r2c_1d(a->fsize, a->forfftin, (fftw_complex *)a->forfftout);
+        a->Rrev = wisdom_plan_dft_c2r_1d(a->fsize, (fftw_complex *)a->revfftin, a->revfftout);
+    }
+    a->plan_slot = slot;
+    LeaveCriticalSection (&emnr_plans_lock);
+}
+
+static void release_emnr_plans (EMNR a)
+{
+    int slot = a->plan_slot;
+    EnterCriticalSection (&emnr_plans_lock);
+    if (slot < 0)
+    {
+        wisdom_destroy_plan(a->Rrev);
+        wisdom_destroy_plan(a->Rfor);
+    }
+    else if (--emnr_plans[slot].refcount == 0)
+    {
+        wisdom_destroy_plan(emnr_plans[slot].Rrev);
+        wisdom_destroy_plan(emnr_plans[slot].Rfor);
+        _aligned_free(emnr_plans[slot].out);
+        _aligned_free(emnr_plans[slot].in);
+    }
+    LeaveCriticalSection (&emnr_plans_lock);
+}
+
 void calc_emnr(EMNR a)
 {
     int i;
-    double Dvals[18] = { 1.0, 2.0, 5.0, 8.0, 10.0, 15.0, 20.0, 30.0, 40.0,
+    real Dvals[18] = { 1.0, 2.0, 5.0, 8.0, 10.0, 15.0, 20.0, 30.0, 40.0,
         60.0, 80.0, 120.0, 140.0, 160.0, 180.0, 220.0, 260.0, 300.0 };
-    double Mvals[18] = { 0.000, 0.260, 0.480, 0.580, 0.610, 0.668, 0.705, 0.762, 0.800,
+    real Mvals[18] = { 0.000, 0.260, 0.480, 0.580, 0.610, 0.668, 0.705, 0.762, 0.800,
         0.841, 0.865, 0.890, 0.900, 0.910, 0.920, 0.930, 0.935, 0.940 };
-    double Hvals[18] = { 0.000, 0.150, 0.480, 0.780, 0.980, 1.550, 2.000, 2.300, 2.520,
+    real Hvals[18] = { 0.000, 0.150, 0.480, 0.780, 0.980, 1.550, 2.000, 2.300, 2.520,
         3.100, 3.380, 4.150, 4.350, 4.250, 3.900, 4.100, 4.700, 5.000 };
     a->incr = a->fsize / a->ovrlp;
-    a->gain = a->ogain / a->fsize / (double)a->ovrlp;
+    a->gain = a->ogain / a->fsize / (real)a->ovrlp;
     if (a->fsize > a->bsize)
         a->iasize = a->fsize;
     else
@@ -233,34 +309,34 @@ void calc_emnr(EMNR a)
     a->init_oainidx = a->oainidx;
     a->oaoutidx = 0;
     a->msize = a->fsize / 2 + 1;
-    a->window = (double *)malloc0(a->fsize * sizeof(double));
-    a->inaccum = (double *)malloc0(a->iasize * sizeof(double));
-    a->forfftin = (double *)malloc0(a->fsize * sizeof(double));
-    a->forfftout = (double *)malloc0(a->msize * sizeof(complex));
-    a->mask = (double *)malloc0(a->msize * sizeof(double));
-    a->revfftin = (double *)malloc0(a->msize * sizeof(complex));
-    a->revfftout = (double *)malloc0(a->fsize * sizeof(double));
-    a->save = (double **)malloc0(a->ovrlp * sizeof(double *));
+    a->window = (real *)malloc0(a->fsize * sizeof(real));
+    a->inaccum = (real *)malloc0(2 * a->iasize * sizeof(real));     // mirrored
+    a->forfftin = (real *)malloc0(a->fsize * sizeof(real));
+    a->forfftout = (real *)malloc0(a->msize * sizeof(complex));
+    a->mask = (real *)malloc0(a->msize * sizeof(real));
+    a->revfftin = (real *)malloc0(a->msize * sizeof(complex));
+    a->revfftout = (real *)malloc0(a->fsize * sizeof(real));
+    a->save = (real **)malloc0(a->ovrlp * sizeof(real *));
     for (i = 0; i < a->ovrlp; i++)
-        a->save[i] = (double *)malloc0(a->fsize * sizeof(double));
-    a->outaccum = (double *)malloc0(a->oasize * sizeof(double));
+        a->save[i] = (real *)malloc0(a->fsize * sizeof(real));
+    a->outaccum = (real *)malloc0(a->oasize * sizeof(real));
+    a->olabuff = (real *)malloc0(a->incr * sizeof(real));
     a->nsamps = 0;
     a->saveidx = 0;
-    a->Rfor = fftw_plan_dft_r2c_1d(a->fsize, a->forfftin, (fftw_complex *)a->forfftout, FFTW_ESTIMATE);
-    a->Rrev = fftw_plan_dft_c2r_1d(a->fsize, (fftw_complex *)a->revfftin, a->revfftout, FFTW_ESTIMATE);
+    get_emnr_plans(a);
     calc_window(a);
 
     a->g.msize = a->msize;
     a->g.mask = a->mask;
     a->g.y = a->forfftout;
-    a->g.lambda_y = (double *)malloc0(a->msize * sizeof(double));
-    a->g.lambda_d = (double *)malloc0(a->msize * sizeof(double));
-    a->g.prev_gamma = (double *)malloc0(a->msize * sizeof(double));
-    a->g.prev_mask = (double *)malloc0(a->msize * sizeof(double));
+    a->g.lambda_y = (real *)malloc0(a->msize * sizeof(real));
+    a->g.lambda_d = (real *)malloc0(a->msize * sizeof(real));
+    a->g.prev_gamma = (real *)malloc0(a->msize * sizeof(real));
+    a->g.prev_mask = (real *)malloc0(a->msize * sizeof(real));
 
     a->g.gf1p5 = sqrt(PI) / 2.0;
     {
-        double tau = -128.0 / 8000.0 / log(0.98);
+        real tau = -128.0 / 8000.0 / log(0.98);
         a->g.alpha = exp(-a->incr / a->rate / tau);
     }
     a->g.eps_floor = 1.0e-300;
@@ -273,18 +349,27 @@ void calc_emnr(EMNR a)
     }
     a->g.gmax = 10000.0;
     //
-    a->g.GG = (double *)malloc0(241 * 241 * sizeof(double));
-    a->g.GGS = (double *)malloc0(241 * 241 * sizeof(double));
-    if ((a->g.fileb = fopen("calculus", "rb")))
+    a->g.GG = (real *)malloc0(241 * 241 * sizeof(real));
+    a->g.GGS = (real *)malloc0(241 * 241 * sizeof(real));
     {
-        fread(a->g.GG, sizeof(double), 241 * 241, a->g.fileb);
-        fread(a->g.GGS, sizeof(double), 241 * 241, a->g.fileb);
-        fclose(a->g.fileb);
-    }
-    else
-    {
-        memcpy (a->g.GG,  GG,  241 * 241 * sizeof(double));
-        memcpy (a->g.GGS, GGS, 241 * 241 * sizeof(double));
+        // the tables (file or built-in) are always double
+        double* tab = (double *)malloc0(2 * 241 * 241 * sizeof(double));
+        if ((a->g.fileb = fopen("calculus", "rb")))
+        {
+            fread(tab, sizeof(double), 2 * 241 * 241, a->g.fileb);
+            fclose(a->g.fileb);
+        }
+        else
+        {
+            memcpy (tab,             GG,  241 * 241 * sizeof(double));
+            memcpy (tab + 241 * 241, GGS, 241 * 241 * sizeof(double));
+        }
+        for (i = 0; i < 241 * 241; i++)
+        {
+            a->g.GG[i]  = (real)tab[i];
+            a->g.GGS[i] = (real)tab[241 * 241 + i];
+        }
+        _aligned_free(tab);
     }
     //
 
@@ -295,24 +380,24 @@ void calc_emnr(EMNR a)
     a->np.lambda_d = a->g.lambda_d;
 
     {
-        double tau = -128.0 / 8000.0 / log(0.7);
+        real tau = -128.0 / 8000.0 / log(0.7);
         a->np.alphaCsmooth = exp(-a->np.incr / a->np.rate / tau);
     }
     {
-        double tau = -128.0 / 8000.0 / log(0.96);
+        real tau = -128.0 / 8000.0 / log(0.96);
         a->np.alphaMax = exp(-a->np.incr / a->np.rate / tau);
     }
     {
-        double tau = -128.0 / 8000.0 / log(0.7);
+        real tau = -128.0 / 8000.0 / log(0.7);
         a->np.alphaCmin = exp(-a->np.incr / a->np.rate / tau);
     }
     {
-        double tau = -128.0 / 8000.0 / log(0.3);
+        real tau = -128.0 / 8000.0 / log(0.3);
         a->np.alphaMin_max_value = exp(-a->np.incr / a->np.rate / tau);
     }
     a->np.snrq = -a->np.incr / (0.064 * a->np.rate);
     {
-        double tau = -128.0 / 8000.0 / log(0.8);
+        real tau = -128.0 / 8000.0 / log(0.8);
         a->np.betamax = exp(-a->np.incr / a->np.rate / tau);
     }
     a->np.invQeqMax = 0.5;
@@ -330,7 +415,7 @@ void calc_emnr(EMNR a)
     a->np.invQbar_points[2] = 0.06;
     a->np.invQbar_points[3] = 1.0e300;
     {
-        double db;
+        real db;
         db = 10.0 * log10(8.0) / (12.0 * 128 / 8000);
         a->np.nsmax[0] = pow(10.0, db / 10.0 * a->np.V * a->np.incr / a->np.rate);
         db = 10.0 * log10(4.0) / (12.0 * 128 / 8000);
@@ -341,23 +426,23 @@ void calc_emnr(EMNR a)
         a->np.nsmax[3] = pow(10.0, db / 10.0 * a->np.V * a->np.incr / a->np.rate);
     }
 
-    a->np.p = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.alphaOptHat = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.alphaHat = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.sigma2N = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.pbar = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.p2bar = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.Qeq = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.bmin = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.bmin_sub = (double *)malloc0(a->np.msize * sizeof(double));
+    a->np.p = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.alphaOptHat = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.alphaHat = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.sigma2N = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.pbar = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.p2bar = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.Qeq = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.bmin = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.bmin_sub = (real *)malloc0(a->np.msize * sizeof(real));
     a->np.k_mod = (int *)malloc0(a->np.msize * sizeof(int));
-    a->np.actmin = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.actmin_sub = (double *)malloc0(a->np.msize * sizeof(double));
+    a->np.actmin = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.actmin_sub = (real *)malloc0(a->np.msize * sizeof(real));
     a->np.lmin_flag = (int *)malloc0(a->np.msize * sizeof(int));
-    a->np.pmin_u = (double *)malloc0(a->np.msize * sizeof(double));
-    a->np.actminbuff = (double**)malloc0(a->np.U     * sizeof(double*));
+    a->np.pmin_u = (real *)malloc0(a->np.msize * sizeof(real));
+    a->np.actminbuff = (real**)malloc0(a->np.U     * sizeof(real*));
     for (i = 0; i < a->np.U; i++)
-        a->np.actminbuff[i] = (double *)malloc0(a->np.msize * sizeof(double));
+        a->np.actminbuff[i] = (real *)malloc0(a->np.msize * sizeof(real));
 
     {
         int k, ku;
@@ -365,10 +450,10 @@ void calc_emnr(EMNR a)
         a->np.subwc = a->np.V;
         a->np.amb_idx = 0;
         for (k = 0; k < a->np.msize; k++) a->np.lambda_y[k] = 0.5;
-        memcpy(a->np.p, a->np.lambda_y, a->np.msize * sizeof(double));
-        memcpy(a->np.sigma2N, a->np.lambda_y, a->np.msize * sizeof(double));
-        memcpy(a->np.pbar, a->np.lambda_y, a->np.msize * sizeof(double));
-        memcpy(a->np.pmin_u, a->np.lambda_y, a->np.msize * sizeof(double));
+        memcpy(a->np.p, a->np.lambda_y, a->np.msize * sizeof(real));
+        memcpy(a->np.sigma2N, a->np.lambda_y, a->np.msize * sizeof(real));
+        memcpy(a->np.pbar, a->np.lambda_y, a->np.msize * sizeof(real));
+        memcpy(a->np.pmin_u, a->np.lambda_y, a->np.msize * sizeof(real));
         for (k = 0; k < a->np.msize; k++)
         {
             a->np.p2bar[k] = a->np.lambda_y[k] * a->np.lambda_y[k];
@@ -387,20 +472,20 @@ void calc_emnr(EMNR a)
     a->nps.lambda_d = a->g.lambda_d;
 
     {
-        double tau = -128.0 / 8000.0 / log(0.8);
+        real tau = -128.0 / 8000.0 / log(0.8);
         a->nps.alpha_pow = exp(-a->nps.incr / a->nps.rate / tau);
     }
     {
-        double tau = -128.0 / 8000.0 / log(0.9);
+        real tau = -128.0 / 8000.0 / log(0.9);
         a->nps.alpha_Pbar = exp(-a->nps.incr / a->nps.rate / tau);
     }
     a->nps.epsH1 = pow(10.0, 15.0 / 10.0);
     a->nps.epsH1r = a->nps.epsH1 / (1.0 + a->nps.epsH1);
 
-    a->nps.sigma2N = (double *)malloc0(a->nps.msize * sizeof(double));
-    a->nps.PH1y = (double *)malloc0(a->nps.msize * sizeof(double));
-    a->nps.Pbar = (double *)malloc0(a->nps.msize * sizeof(double));
-    a->nps.EN2y = (double *)malloc0(a->nps.msize * sizeof(double));
+    a->nps.sigma2N = (real *)malloc0(a->nps.msize * sizeof(real));
+    a->nps.PH1y = (real *)malloc0(a->nps.msize * sizeof(real));
+    a->nps.Pbar = (real *)malloc0(a->nps.msize * sizeof(real));
+    a->nps.EN2y = (real *)malloc0(a->nps.msize * sizeof(real));
 
     for (i = 0; i < a->nps.msize; i++)
     {
@@ -414,7 +499,7 @@ void calc_emnr(EMNR a)
     a->ae.zetaThresh = 0.75;
     a->ae.psi = 10.0;
 
-    a->ae.nmask = (double *)malloc0(a->ae.msize * sizeof(double));
+    a->ae.nmask = (real *)malloc0(a->ae.msize * sizeof(real));
 }
 
 void decalc_emnr(EMNR a)
@@ -452,8 +537,8 @@ void decalc_emnr(EMNR a)
     _aligned_free(a->g.lambda_d);
     _aligned_free(a->g.lambda_y);
 
-    fftw_destroy_plan(a->Rrev);
-    fftw_destroy_plan(a->Rfor);
+    release_emnr_plans(a);
+    _aligned_free(a->olabuff);
     _aligned_free(a->outaccum);
     for (i = 0; i < a->ovrlp; i++)
         _aligned_free(a->save[i]);
@@ -467,8 +552,8 @@ void decalc_emnr(EMNR a)
     _aligned_free(a->window);
 }
 
-EMNR create_emnr (int run, int position, int size, double* in, double* out, int fsize, int ovrlp,
-    int rate, int wintype, double gain, int gain_method, int npe_method, int ae_run)
+EMNR create_emnr (int run, int position, int size, real* in, real* out, int fsize, int ovrlp,
+    int rate, int wintype, real gain, int gain_method, int npe_method, int ae_run)
 {
     EMNR a = (EMNR) malloc0 (sizeof (emnr));
 
@@ -492,10 +577,10 @@ EMNR create_emnr (int run, int position, int size, double* in, double* out, int
 void flush_emnr (EMNR a)
 {
     int i;
-    memset (a->inaccum, 0, a->iasize * sizeof (double));
+    memset (a->inaccum, 0, 2 * a->iasize * sizeof (real));
     for (i = 0; i < a->ovrlp; i++)
-        memset (a->save[i], 0, a->fsize * sizeof (double));
-    memset (a->outaccum, 0, a->oasize * sizeof (double));
+        memset (a->save[i], 0, a->fsize * sizeof (real));
+    memset (a->outaccum, 0, a->oasize * sizeof (real));
     a->nsamps   = 0;
     a->iainidx  = 0;
     a->iaoutidx = 0;
@@ -513,17 +598,17 @@ void destroy_emnr (EMNR a)
 void LambdaD(EMNR a)
 {
     int k;
-    double f0, f1, f2, f3;
-    double sum_prev_p;
-    double sum_lambda_y;
-    double alphaCtilda;
-    double sum_prev_sigma2N;
-    double alphaMin, SNR;
-    double beta, varHat, invQeq;
-    double invQbar;
-    double bc;
-    double QeqTilda, QeqTildaSub;
-    double noise_slope_max;
+    real f0, f1, f2, f3;
+    real sum_prev_p;
+    real sum_lambda_y;
+    real alphaCtilda;
+    real sum_prev_sigma2N;
+    real alphaMin, SNR;
+    real beta, varHat, invQeq;
+    real invQbar;
+    real bc;
+    real QeqTilda, QeqTildaSub;
+    real noise_slope_max;
 
     sum_prev_p = 0.0;
     sum_lambda_y = 0.0;
@@ -563,7 +648,7 @@ void LambdaD(EMNR a)
         a->np.Qeq[k] = 1.0 / invQeq;
         invQbar += invQeq;
     }
-    invQbar /= (double)a->np.msize;
+    invQbar /= (real)a->np.msize;
     bc = 1.0 + a->np.av * sqrt (invQbar);
     for (k = 0; k < a->np.msize; k++)
     {
@@ -593,7 +678,7 @@ void LambdaD(EMNR a)
         for (k = 0; k < a->np.msize; k++)
         {
             int ku;
-            double min;
+            real min;
             if (a->np.k_mod[k])
                 a->np.lmin_flag[k] = 0;
             a->np.actminbuff[a->np.amb_idx][k] = a->np.actmin[k];
@@ -632,7 +717,7 @@ void LambdaD(EMNR a)
         }
         ++a->np.subwc;
     }
-    memcpy (a->np.lambda_d, a->np.sigma2N, a->np.msize * sizeof (double));
+    memcpy (a->np.lambda_d, a->np.sigma2N, a->np.msize * sizeof (real));
 }
 
 void LambdaDs (EMNR a)
@@ -647,14 +732,14 @@ void LambdaDs (EMNR a)
         a->nps.EN2y[k] = (1.0 - a->nps.PH1y[k]) * a->nps.lambda_y[k] + a->nps.PH1y[k] * a->nps.sigma2N[k];
         a->nps.sigma2N[k] = a->nps.alpha_pow * a->nps.sigma2N[k] + (1.0 - a->nps.alpha_pow) * a->nps.EN2y[k];
     }
-    memcpy (a->nps.lambda_d, a->nps.sigma2N, a->nps.msize * sizeof (double));
+    memcpy (a->nps.lambda_d, a->nps.sigma2N, a->nps.msize * sizeof (real));
 }
 
 void aepf(EMNR a)
 {
     int k, m;
     int N, n;
-    double sumPre, sumPost, zeta, zetaT;
+    real sumPre, sumPost, zeta, zetaT;
     sumPre = 0.0;
     sumPost = 0.0;
     for (k = 0; k < a->ae.msize; k++)
@@ -677,17 +762,17 @@ void aepf(EMNR a)
         a->ae.nmask[k] = 0.0;
         for (m = k - n; m <= (k + n); m++)
             a->ae.nmask[k] += a->mask[m];
-        a->ae.nmask[k] /= (double)N;
+        a->ae.nmask[k] /= (real)N;
     }
-    memcpy (a->mask + n, a->ae.nmask, (a->ae.msize - 2 * n) * sizeof (double));
+    memcpy (a->mask + n, a->ae.nmask, (a->ae.msize - 2 * n) * sizeof (real));
 }
 
-double getKey(double* type, double gamma, double xi)
+real getKey(real* type, real gamma, real xi)
 {
     int ngamma1, ngamma2, nxi1, nxi2;
-    double tg, tx, dg, dx;
-    const double dmin = 0.001;
-    const double dmax = 1000.0;
+    real tg, tx, dg, dx;
+    const real dmin = 0.001;
+    const real dmax = 1000.0;
     if (gamma <= dmin)
     {
         ngamma1 = ngamma2 = 0;
@@ -748,7 +833,7 @@ void calc_gain (EMNR a)
     {
     case 0:
         {
-            double gamma, eps_hat, v;
+            real gamma, eps_hat, v;
             for (k = 0; k < a->msize; k++)
             {
                 gamma = min (a->g.lambda_y[k] / a->g.lambda_d[k], a->g.gamma_max);
@@ -758,10 +843,10 @@ void calc_gain (EMNR a)
                 a->g.mask[k] = a->g.gf1p5 * sqrt (v) / gamma * exp (- 0.5 * v)
                     * ((1.0 + v) * bessI0 (0.5 * v) + v * bessI1 (0.5 * v));
                 {
-                    double v2 = min (v, 700.0);
-                    double eta = a->g.mask[k] * a->g.mask[k] * a->g.lambda_y[k] / a->g.lambda_d[k];
-                    double eps = eta / (1.0 - a->g.q);
-                    double witchHat = (1.0 - a->g.q) / a->g.q * exp (v2) / (1.0 + eps);
+                    real v2 = min (v, 700.0);
+                    real eta = a->g.mask[k] * a->g.mask[k] * a->g.lambda_y[k] / a->g.lambda_d[k];
+                    real eps = eta / (1.0 - a->g.q);
+                    real witchHat = (1.0 - a->g.q) / a->g.q * exp (v2) / (1.0 + eps);
                     a->g.mask[k] *= witchHat / (1.0 + witchHat);
                 }
                 if (a->g.mask[k] > a->g.gmax) a->g.mask[k] = a->g.gmax;
@@ -773,7 +858,7 @@ void calc_gain (EMNR a)
         }
     case 1:
         {
-            double gamma, eps_hat, v, ehr;
+            real gamma, eps_hat, v, ehr;
             for (k = 0; k < a->g.msize; k++)
             {
                 gamma = min (a->g.lambda_y[k] / a->g.lambda_d[k], a->g.gamma_max);
@@ -790,7 +875,7 @@ void calc_gain (EMNR a)
         }
     case 2:
         {
-            double gamma, eps_hat, eps_p;
+            real gamma, eps_hat, eps_p;
             for (k = 0; k < a->msize; k++)
             {
                 gamma = min(a->g.lambda_y[k] / a->g.lambda_d[k], a->g.gamma_max);
@@ -811,21 +896,27 @@ void xemnr (EMNR a, int pos)
 {
     if (a->run && pos == a->position)
     {
-        int i, j, k, sbuff, sbegin;
-        double g1;
-        for (i = 0; i < 2 * a->bsize; i += 2)
+        int i, j, n, sbuff;
+        real g1;
+        real* x;
+        // The input accumulator is mirrored (each sample is also stored at
+        // iainidx + iasize), so the fsize samples of a frame are contiguous.
+        // All loops over frame and segment samples are on contiguous data,
+        // without index wrapping, so the compiler can vectorize them.
+        for (i = 0; i < a->bsize; i++)
         {
-            a->inaccum[a->iainidx] = a->in[i];
-            a->iainidx = (a->iainidx + 1) % a->iasize;
+            a->inaccum[a->iainidx] = a->inaccum[a->iainidx + a->iasize] = a->in[2 * i + 0];
+            if (++a->iainidx == a->iasize) a->iainidx = 0;
         }
         a->nsamps += a->bsize;
         while (a->nsamps >= a->fsize)
         {
-            for (i = 0, j = a->iaoutidx; i < a->fsize; i++, j = (j + 1) % a->iasize)
-                a->forfftin[i] = a->window[i] * a->inaccum[j];
-            a->iaoutidx = (a->iaoutidx + a->incr) % a->iasize;
+            x = &a->inaccum[a->iaoutidx];
+            for (i = 0; i < a->fsize; i++)
+                a->forfftin[i] = a->window[i] * x[i];
+            if ((a->iaoutidx += a->incr) >= a->iasize) a->iaoutidx -= a->iasize;
             a->nsamps -= a->incr;
-            fftw_execute (a->Rfor);
+            fftw_execute_dft_r2c (a->Rfor, a->forfftin, (fftw_complex *)a->forfftout);
             calc_gain(a);
             for (i = 0; i < a->msize; i++)
             {
@@ -833,36 +924,43 @@ void xemnr (EMNR a, int pos)
                 a->revfftin[2 * i + 0] = g1 * a->forfftout[2 * i + 0];
                 a->revfftin[2 * i + 1] = g1 * a->forfftout[2 * i + 1];
             }
-            fftw_execute (a->Rrev);
+            fftw_execute_dft_c2r (a->Rrev, (fftw_complex *)a->revfftin, a->revfftout);
             for (i = 0; i < a->fsize; i++)
                 a->save[a->saveidx][i] = a->window[i] * a->revfftout[i];
-            for (i = a->ovrlp; i > 0; i--)
+            // overlap-add the segments of the last ovrlp frames that make up
+            // the next incr output samples, then copy them to the output accumulator
+            memcpy (a->olabuff, a->save[a->saveidx], a->incr * sizeof (real));
+            for (i = a->ovrlp - 1; i > 0; i--)
             {
-                sbuff = (a->saveidx + i) % a->ovrlp;
-                sbegin = a->incr * (a->ovrlp - i);
-                for (j = sbegin, k = a->oainidx; j < a->incr + sbegin; j++, k = (k + 1) % a->oasize)
-                {
-                    if ( i == a->ovrlp)
-                        a->outaccum[k]  = a->save[sbuff][j];
-                    else
-                        a->outaccum[k] += a->save[sbuff][j];
-                }
+                if ((sbuff = a->saveidx + i) >= a->ovrlp) sbuff -= a->ovrlp;
+                x = &a->save[sbuff][a->incr * (a->ovrlp - i)];
+                for (j = 0; j < a->incr; j++)
+                    a->olabuff[j] += x[j];
             }
-            a->saveidx = (a->saveidx + 1) % a->ovrlp;
-            a->oainidx = (a->oainidx + a->incr) % a->oasize;
+            n = a->oasize - a->oainidx;
+            if (n > a->incr) n = a->incr;
+            memcpy (&a->outaccum[a->oainidx], a->olabuff, n * sizeof (real));
+            memcpy (a->outaccum, &a->olabuff[n], (a->incr - n) * sizeof (real));
+            if (++a->saveidx == a->ovrlp) a->saveidx = 0;
+            if ((a->oainidx += a->incr) >= a->oasize) a->oainidx -= a->oasize;
         }
-        for (i = 0; i < a->bsize; i++)
+        for (i = 0; i < a->bsize; i += n)
         {
-            a->out[2 * i + 0] = a->outaccum[a->oaoutidx];
-            a->out[2 * i + 1] = 0.0;
-            a->oaoutidx = (a->oaoutidx + 1) % a->oasize;
+            n = a->oasize - a->oaoutidx;
+            if (n > a->bsize - i) n = a->bsize - i;
+            for (j = 0; j < n; j++)
+            {
+                a->out[2 * (i + j) + 0] = a->outaccum[a->oaoutidx + j];
+                a->out[2 * (i + j) + 1] = 0.0;
+            }
+            if ((a->oaoutidx += n) == a->oasize) a->oaoutidx = 0;
         }
     }
     else if (a->out != a->in)
         memcpy (a->out, a->in, a->bsize * sizeof (complex));
 }
 
-void setBuffers_emnr (EMNR a, double* in, double* out)
+void setBuffers_emnr (EMNR a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -32,27 +32,28 @@ typedef struct _emnr
     int run;
     int position;
     int bsize;
-    double* in;
-    double* out;
+    real* in;
+    real* out;
     int fsize;
     int ovrlp;
     int incr;
-    double* window;
+    real* window;
     int iasize;
-    double* inaccum;
-    double* forfftin;
-    double* forfftout;
+    real* inaccum;
+    real* forfftin;
+    real* forfftout;
     int msize;
-    double* mask;
-    double* revfftin;
-    double* revfftout;
-    double** save;
+    real* mask;
+    real* revfftin;
+    real* revfftout;
+    real** save;
     int oasize;
-    double* outaccum;
-    double rate;
+    real* outaccum;
+    real* olabuff;      // overlap-add result for one output segment (incr samples)
+    real rate;
     int wintype;
-    double ogain;
-    double gain;
+    real ogain;
+    real gain;
     int nsamps;
     int iainidx;
     int iaoutidx;
@@ -62,101 +63,102 @@ typedef struct _emnr
     int saveidx;
     fftw_plan Rfor;
     fftw_plan Rrev;
+    int plan_slot;      // index into the table of shared plans, -1 if own plans
     struct _g
     {
         int gain_method;
         int npe_method;
         int ae_run;
-        double msize;
-        double* mask;
-        double* y;
-        double* lambda_y;
-        double* lambda_d;
-        double* prev_mask;
-        double* prev_gamma;
-        double gf1p5;
-        double alpha;
-        double eps_floor;
-        double gamma_max;
-        double q;
-        double gmax;
+        real msize;
+        real* mask;
+        real* y;
+        real* lambda_y;
+        real* lambda_d;
+        real* prev_mask;
+        real* prev_gamma;
+        real gf1p5;
+        real alpha;
+        real eps_floor;
+        real gamma_max;
+        real q;
+        real gmax;
         //
-        double* GG;
-        double* GGS;
+        real* GG;
+        real* GGS;
         FILE* fileb;
     } g;
     struct _npest
     {
         int incr;
-        double rate;
+        real rate;
         int msize;
-        double* lambda_y;
-        double* lambda_d;
-        double* p;
-        double* alphaOptHat;
-        double alphaC;
-        double alphaCsmooth;
-        double alphaCmin;
-        double* alphaHat;
-        double alphaMax;
-        double* sigma2N;
-        double alphaMin_max_value;
-        double snrq;
-        double betamax;
-        double* pbar;
-        double* p2bar;
-        double invQeqMax;
-        double av;
-        double* Qeq;
+        real* lambda_y;
+        real* lambda_d;
+        real* p;
+        real* alphaOptHat;
+        real alphaC;
+        real alphaCsmooth;
+        real alphaCmin;
+        real* alphaHat;
+        real alphaMax;
+        real* sigma2N;
+        real alphaMin_max_value;
+        real snrq;
+        real betamax;
+        real* pbar;
+        real* p2bar;
+        real invQeqMax;
+        real av;
+        real* Qeq;
         int U;
-        double Dtime;
+        real Dtime;
         int V;
         int D;
-        double MofD;
-        double MofV;
-        double* bmin;
-        double* bmin_sub;
+        real MofD;
+        real MofV;
+        real* bmin;
+        real* bmin_sub;
         int* k_mod;
-        double* actmin;
-        double* actmin_sub;
+        real* actmin;
+        real* actmin_sub;
         int subwc;
         int* lmin_flag;
-        double* pmin_u;
-        double invQbar_points[4];
-        double nsmax[4];
-        double** actminbuff;
+        real* pmin_u;
+        real invQbar_points[4];
+        real nsmax[4];
+        real** actminbuff;
         int amb_idx;
     } np;
     struct _npests
     {
         int incr;
-        double rate;
+        real rate;
         int msize;
-        double* lambda_y;
-        double* lambda_d;
-
-        double alpha_pow;
-        double alpha_Pbar;
-        double epsH1;
-        double epsH1r;
-
-        double* sigma2N;
-        double* PH1y;
-        double* Pbar;
-        double* EN2y;
+        real* lambda_y;
+        real* lambda_d;
+
+        real alpha_pow;
+        real alpha_Pbar;
+        real epsH1;
+        real epsH1r;
+
+        real* sigma2N;
+        real* PH1y;
+        real* Pbar;
+        real* EN2y;
     } nps;
     struct _ae
     {
         int msize;
-        double* lambda_y;
-        double zetaThresh;
-        double psi;
-        double* nmask;
+        real* lambda_y;
+        real zetaThresh;
+        real psi;
+        real* nmask;
     } ae;
 }emnr, *EMNR;
 
-extern EMNR create_emnr (int run, int position, int size, double* in, double* out, int fsize, int ovrlp,
-    int rate, int wintype, double gain, int gain_method, int npe_method, int ae_run);
+extern EMNR create_emnr (int run, int position, int size, real* in, real* out, int fsize, int ovrlp,
+    int rate, int wintype, real gain, int gain_method, int npe_method, int ae_run);
 
 extern void destroy_emnr (EMNR a);
 
@@ -164,7 +166,7 @@ extern void flush_emnr (EMNR a);
 
 extern void xemnr (EMNR a, int pos);
 
-extern void setBuffers_emnr (EMNR a, double* in, double* out);
+extern void setBuffers_emnr (EMNR a, real* in, real* out);
 
 extern void setSamplerate_emnr (EMNR a, int rate);
 
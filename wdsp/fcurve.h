@@ -27,8 +27,8 @@ warren@wpratt.com
 #ifndef _fcurve_h
 #define _fcurve_h
 
-extern double* fc_impulse (int nc, double f0, double f1, double g0, double g1, int curve, double samplerate, double scale, int ctfmode, int wintype);
+extern real* fc_impulse (int nc, real f0, real f1, real g0, real g1, int curve, real samplerate, real scale, int ctfmode, int wintype);
 
-extern double* fc_mults (int size, double f0, double f1, double g0, double g1, int curve, double samplerate, double scale, int ctfmode, int wintype);
+extern real* fc_mults (int size, real f0, real f1, real g0, real g1, int curve, real samplerate, real scale, int ctfmode, int wintype);
 
 #endif
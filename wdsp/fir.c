@@ -26,33 +26,33 @@ warren@pratt.one
 #define _CRT_SECURE_NO_WARNINGS
 #include "comm.h"
 
-double* fftcv_mults (int NM, double* c_impulse)
+real* fftcv_mults (int NM, real* c_impulse)
 {
-    double* mults        = (double *) malloc0 (NM * sizeof (complex));
-    double* cfft_impulse = (double *) malloc0 (NM * sizeof (complex));
-    fftw_plan ptmp = fftw_plan_dft_1d(NM, (fftw_complex *) cfft_impulse,
-            (fftw_complex *) mults, FFTW_FORWARD, FFTW_PATIENT);
+    real* mults        = (real *) malloc0 (NM * sizeof (complex));
+    real* cfft_impulse = (real *) malloc0 (NM * sizeof (complex));
+    fftw_plan ptmp = wisdom_plan_dft_1d(NM, (fftw_complex *) cfft_impulse,
+            (fftw_complex *) mults, FFTW_FORWARD);
     memset (cfft_impulse, 0, NM * sizeof (complex));
     // store complex coefs right-justified in the buffer
     memcpy (&(cfft_impulse[NM - 2]), c_impulse, (NM / 2 + 1) * sizeof(complex));
     fftw_execute (ptmp);
-    fftw_destroy_plan (ptmp);
+    wisdom_destroy_plan (ptmp);
     _aligned_free (cfft_impulse);
     return mults;
 }
 
-double* get_fsamp_window(int N, int wintype)
+real* get_fsamp_window(int N, int wintype)
 {
     int i;
-    double arg0, arg1;
-    double* window = (double *) malloc0 (N * sizeof(double));
+    real arg0, arg1;
+    real* window = (real *) malloc0 (N * sizeof(real));
     switch (wintype)
     {
     case 0:
-        arg0 = 2.0 * PI / ((double)N - 1.0);
+        arg0 = 2.0 * PI / ((real)N - 1.0);
         for (i = 0; i < N; i++)
         {
-            arg1 = cos(arg0 * (double)i);
+            arg1 = cos(arg0 * (real)i);
             window[i]  =   +0.21747
                 + arg1 *  (-0.45325
                 + arg1 *  (+0.28256
@@ -60,10 +60,10 @@ double* get_fsamp_window(int N, int wintype)
         }
         break;
     case 1:
-        arg0 = 2.0 * PI / ((double)N - 1.0);
+        arg0 = 2.0 * PI / ((real)N - 1.0);
         for (i = 0; i < N; ++i)
         {
-            arg1 = cos(arg0 * (double)i);
+            arg1 = cos(arg0 * (real)i);
             window[i]  =   +6.3964424114390378e-02
                 + arg1 *  (-2.3993864599352804e-01
                 + arg1 *  (+3.5015956323820469e-01
@@ -80,20 +80,20 @@ double* get_fsamp_window(int N, int wintype)
     return window;
 }
 
-double* fir_fsamp_odd (int N, double* A, int rtype, double scale, int wintype)
+real* fir_fsamp_odd (int N, real* A, int rtype, real scale, int wintype)
 {
     int i, j;
     int mid = (N - 1) / 2;
-    double mag, phs;
-    double* window;
-    double *fcoef     = (double *) malloc0 (N * sizeof (complex));
-    double *c_impulse = (double *) malloc0 (N * sizeof (complex));
-    fftw_plan ptmp = fftw_plan_dft_1d(N, (fftw_complex *)fcoef, (fftw_complex *)c_impulse, FFTW_BACKWARD, FFTW_PATIENT);
-    double local_scale = 1.0 / (double)N;
+    real mag, phs;
+    real* window;
+    real *fcoef     = (real *) malloc0 (N * sizeof (complex));
+    real *c_impulse = (real *) malloc0 (N * sizeof (complex));
+    fftw_plan ptmp = wisdom_plan_dft_1d(N, (fftw_complex *)fcoef, (fftw_complex *)c_impulse, FFTW_BACKWARD);
+    real local_scale = 1.0 / (real)N;
     for (i = 0; i <= mid; i++)
     {
         mag = A[i] * local_scale;
-        phs = - (double)mid * TWOPI * (double)i / (double)N;
+        phs = - (real)mid * TWOPI * (real)i / (real)N;
         fcoef[2 * i + 0] = mag * cos (phs);
         fcoef[2 * i + 1] = mag * sin (phs);
     }
@@ -103,7 +103,7 @@ double* fir_fsamp_odd (int N, double* A, int rtype, double scale, int wintype)
         fcoef[2 * i + 1] = - fcoef[2 * (mid - j) + 1];
     }
     fftw_execute (ptmp);
-    fftw_destroy_plan (ptmp);
+    wisdom_destroy_plan (ptmp);
     _aligned_free (fcoef);
     window = get_fsamp_window(N, wintype);
     switch (rtype)
@@ -124,12 +124,12 @@ double* fir_fsamp_odd (int N, double* A, int rtype, double scale, int wintype)
     return c_impulse;
 }
 
-double* fir_fsamp (int N, double* A, int rtype, double scale, int wintype)
+real* fir_fsamp (int N, real* A, int rtype, real scale, int wintype)
 {
     int n, i, j, k;
-    double sum;
-    double* window;
-    double *c_impulse = (double *) malloc0 (N * sizeof (complex));
+    real sum;
+    real* window;
+    real *c_impulse = (real *) malloc0 (N * sizeof (complex));
 
     if (N & 1)
     {
@@ -150,7 +150,7 @@ double* fir_fsamp (int N, double* A, int rtype, double scale, int wintype)
     }
     else
     {
-        double M = (double)(N - 1) / 2.0;
+        real M = (real)(N - 1) / 2.0;
         for (n = 0; n < N / 2; n++)
         {
             sum = 0.0;
@@ -184,18 +184,18 @@ double* fir_fsamp (int N, double* A, int rtype, double scale, int wintype)
     return c_impulse;
 }
 
-double* fir_bandpass (int N, double f_low, double f_high, double samplerate, int wintype, int rtype, double scale)
+real* fir_bandpass (int N, real f_low, real f_high, real samplerate, int wintype, int rtype, real scale)
 {
-    double *c_impulse = (double *) malloc0 (N * sizeof (complex));
-    double ft = (f_high - f_low) / (2.0 * samplerate);
-    double ft_rad = TWOPI * ft;
-    double w_osc = PI * (f_high + f_low) / samplerate;
+    real *c_impulse = (real *) malloc0 (N * sizeof (complex));
+    real ft = (f_high - f_low) / (2.0 * samplerate);
+    real ft_rad = TWOPI * ft;
+    real w_osc = PI * (f_high + f_low) / samplerate;
     int i, j;
-    double m = 0.5 * (double)(N - 1);
-    double delta = PI / m;
-    double cosphi;
-    double posi, posj;
-    double sinc, window, coef;
+    real m = 0.5 * (real)(N - 1);
+    real delta = PI / m;
+    real cosphi;
+    real posi, posj;
+    real sinc, window, coef;
 
     if (N & 1)
     {
@@ -212,8 +212,8 @@ double* fir_bandpass (int N, double f_low, double f_high, double samplerate, int
     }
     for (i = (N + 1) / 2, j = N / 2 - 1; i < N; i++, j--)
     {
-        posi = (double)i - m;
-        posj = (double)j - m;
+        posi = (real)i - m;
+        posj = (real)j - m;
         sinc = sin (ft_rad * posi) / (PI * posi);
         switch (wintype)
         {
@@ -253,7 +253,7 @@ double* fir_bandpass (int N, double f_low, double f_high, double samplerate, int
     return c_impulse;
 }
 
-double *fir_read (int N, const char *filename, int rtype, double scale)
+real *fir_read (int N, const char *filename, int rtype, real scale)
     // N = number of real or complex coefficients (see rtype)
     // *filename = filename
     // rtype = 0:  real coefficients
@@ -264,8 +264,8 @@ double *fir_read (int N, const char *filename, int rtype, double scale)
 {
     FILE *file;
     int i;
-    double I, Q;
-    double *c_impulse = (double *) malloc0 (N * sizeof (complex));
+    real I, Q;
+    real *c_impulse = (real *) malloc0 (N * sizeof (complex));
     file = fopen (filename, "r");
     for (i = 0; i < N; i++)
     {
@@ -274,12 +274,12 @@ double *fir_read (int N, const char *filename, int rtype, double scale)
         switch (rtype)
         {
         case 0:
-            fscanf (file, "%le", &I);
+            fscanf (file, SCNreal, &I);
             c_impulse[i] = + scale * I;
             break;
         case 1:
-            fscanf (file, "%le", &I);
-            fscanf (file, "%le", &Q);
+            fscanf (file, SCNreal, &I);
+            fscanf (file, SCNreal, &Q);
             c_impulse[2 * i + 0] = + scale * I;
             c_impulse[2 * i + 1] = - scale * Q;
             break;
@@ -289,16 +289,16 @@ double *fir_read (int N, const char *filename, int rtype, double scale)
     return c_impulse;
 }
 
-void analytic (int N, double* in, double* out)
+void analytic (int N, real* in, real* out)
 {
     int i;
-    double inv_N = 1.0 / (double)N;
-    double two_inv_N = 2.0 * inv_N;
-    double* x = (double *) malloc0 (N * sizeof (complex));
-    fftw_plan pfor = fftw_plan_dft_1d (N, (fftw_complex *) in,
-            (fftw_complex *) x, FFTW_FORWARD, FFTW_PATIENT);
-    fftw_plan prev = fftw_plan_dft_1d (N, (fftw_complex *) x,
-            (fftw_complex *) out, FFTW_BACKWARD, FFTW_PATIENT);
+    real inv_N = 1.0 / (real)N;
+    real two_inv_N = 2.0 * inv_N;
+    real* x = (real *) malloc0 (N * sizeof (complex));
+    fftw_plan pfor = wisdom_plan_dft_1d (N, (fftw_complex *) in,
+            (fftw_complex *) x, FFTW_FORWARD);
+    fftw_plan prev = wisdom_plan_dft_1d (N, (fftw_complex *) x,
+            (fftw_complex *) out, FFTW_BACKWARD);
     fftw_execute (pfor);
     x[0] *= inv_N;
     x[1] *= inv_N;
@@ -309,29 +309,29 @@ void analytic (int N, double* in, double* out)
     }
     x[N + 0] *= inv_N;
     x[N + 1] *= inv_N;
-    memset (&x[N + 2], 0, (N - 2) * sizeof (double));
+    memset (&x[N + 2], 0, (N - 2) * sizeof (real));
     fftw_execute (prev);
-    fftw_destroy_plan (prev);
-    fftw_destroy_plan (pfor);
+    wisdom_destroy_plan (prev);
+    wisdom_destroy_plan (pfor);
     _aligned_free (x);
 }
 
-void mp_imp (int N, double* fir, double* mpfir, int pfactor, int polarity)
+void mp_imp (int N, real* fir, real* mpfir, int pfactor, int polarity)
 {
     int i;
     int size = N * pfactor;
-    double inv_PN = 1.0 / (double)size;
-    double* firpad  = (double *) malloc0 (size * sizeof (complex));
-    double* firfreq = (double *) malloc0 (size * sizeof (complex));
-    double* mag     = (double *) malloc0 (size * sizeof (double));
-    double* ana     = (double *) malloc0 (size * sizeof (complex));
-    double* impulse = (double *) malloc0 (size * sizeof (complex));
-    double* newfreq = (double *) malloc0 (size * sizeof (complex));
+    real inv_PN = 1.0 / (real)size;
+    real* firpad  = (real *) malloc0 (size * sizeof (complex));
+    real* firfreq = (real *) malloc0 (size * sizeof (complex));
+    real* mag     = (real *) malloc0 (size * sizeof (real));
+    real* ana     = (real *) malloc0 (size * sizeof (complex));
+    real* impulse = (real *) malloc0 (size * sizeof (complex));
+    real* newfreq = (real *) malloc0 (size * sizeof (complex));
     memcpy (firpad, fir, N * sizeof (complex));
-    fftw_plan pfor = fftw_plan_dft_1d (size, (fftw_complex *) firpad,
-            (fftw_complex *) firfreq, FFTW_FORWARD, FFTW_PATIENT);
-    fftw_plan prev = fftw_plan_dft_1d (size, (fftw_complex *) newfreq,
-            (fftw_complex *) impulse, FFTW_BACKWARD, FFTW_PATIENT);
+    fftw_plan pfor = wisdom_plan_dft_1d (size, (fftw_complex *) firpad,
+            (fftw_complex *) firfreq, FFTW_FORWARD);
+    fftw_plan prev = wisdom_plan_dft_1d (size, (fftw_complex *) newfreq,
+            (fftw_complex *) impulse, FFTW_BACKWARD);
     // print_impulse("orig_imp.txt", N, fir, 1, 0);
     fftw_execute (pfor);
     for (i = 0; i < size; i++)
@@ -357,8 +357,8 @@ void mp_imp (int N, double* fir, double* mpfir, int pfactor, int polarity)
     else
         memcpy (mpfir, impulse, N * sizeof (complex));
     // print_impulse("min_imp.txt", N, mpfir, 1, 0);
-    fftw_destroy_plan (prev);
-    fftw_destroy_plan (pfor);
+    wisdom_destroy_plan (prev);
+    wisdom_destroy_plan (pfor);
     _aligned_free (newfreq);
     _aligned_free (impulse);
     _aligned_free (ana);
@@ -369,21 +369,21 @@ void mp_imp (int N, double* fir, double* mpfir, int pfactor, int polarity)
 
 // impulse response of a zero frequency filter comprising a cascade of two resonators,
 //    each followed by a detrending filter
-double* zff_impulse(int nc, double scale)
+real* zff_impulse(int nc, real scale)
 {
     // nc = number of coefficients (power of two)
     int n_resdet = nc / 2 - 1;          // size of single zero-frequency resonator with detrender
     int n_dresdet = 2 * n_resdet - 1;   // size of two cascaded units; when we convolve these we get 2 * n - 1 length
     // allocate the single and make the values
-    double* resdet = (double*)malloc0 (n_resdet * sizeof(double));
+    real* resdet = (real*)malloc0 (n_resdet * sizeof(real));
     for (int i = 1, j = 0, k = n_resdet - 1; i < nc / 4; i++, j++, k--)
-        resdet[j] = resdet[k] = (double)(i * (i + 1) / 2);
-    resdet[nc / 4 - 1] = (double)(nc / 4 * (nc / 4 + 1) / 2);
+        resdet[j] = resdet[k] = (real)(i * (i + 1) / 2);
+    resdet[nc / 4 - 1] = (real)(nc / 4 * (nc / 4 + 1) / 2);
     // print_impulse ("resdet", n_resdet, resdet, 0, 0);
-    // allocate the double and complex versions and make the values
-    double* dresdet = (double*)malloc0 (n_dresdet * sizeof(double));
-    double div = (double)((nc / 2 + 1) * (nc / 2 + 1));                 // calculate divisor
-    double* c_dresdet = (double*)malloc0 (nc * sizeof(complex));
+    // allocate the real and complex versions and make the values
+    real* dresdet = (real*)malloc0 (n_dresdet * sizeof(real));
+    real div = (real)((nc / 2 + 1) * (nc / 2 + 1));                     // calculate divisor
+    real* c_dresdet = (real*)malloc0 (nc * sizeof(complex));
     for (int n = 0; n < n_dresdet; n++) // convolve to make the cascade
     {
         for (int k = 0; k < n_resdet; k++)
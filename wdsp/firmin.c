@@ -37,12 +37,12 @@ void calc_firmin (FIRMIN a)
     a->h = fir_bandpass (a->nc, a->f_low, a->f_high, a->samplerate, a->wintype, 1, a->gain);
     a->rsize = a->nc;
     a->mask = a->rsize - 1;
-    a->ring = (double *) malloc0 (a->rsize * sizeof (complex));
+    a->ring = (real *) malloc0 (a->rsize * sizeof (complex));
     a->idx = 0;
 }
 
-FIRMIN create_firmin (int run, int position, int size, double* in, double* out,
-    int nc, double f_low, double f_high, int samplerate, int wintype, double gain)
+FIRMIN create_firmin (int run, int position, int size, real* in, real* out,
+    int nc, real f_low, real f_high, int samplerate, int wintype, real gain)
 {
     FIRMIN a = (FIRMIN) malloc0 (sizeof (firmin));
     a->run = run;
@@ -98,7 +98,7 @@ void xfirmin (FIRMIN a, int pos)
         memcpy (a->out, a->in, a->size * sizeof (complex));
 }
 
-void setBuffers_firmin (FIRMIN a, double* in, double* out)
+void setBuffers_firmin (FIRMIN a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -106,7 +106,7 @@ void setBuffers_firmin (FIRMIN a, double* in, double* out)
 
 void setSamplerate_firmin (FIRMIN a, int rate)
 {
-    a->samplerate = (double)rate;
+    a->samplerate = (real)rate;
     calc_firmin (a);
 }
 
@@ -115,7 +115,7 @@ void setSize_firmin (FIRMIN a, int size)
     a->size = size;
 }
 
-void setFreqs_firmin (FIRMIN a, double f_low, double f_high)
+void setFreqs_firmin (FIRMIN a, real f_low, real f_high)
 {
     a->f_low = f_low;
     a->f_high = f_high;
@@ -135,21 +135,21 @@ void plan_firopt (FIROPT a)
     a->nfor = a->nc / a->size;
     a->buffidx = 0;
     a->idxmask = a->nfor - 1;
-    a->fftin = (double *) malloc0 (2 * a->size * sizeof (complex));
-    a->fftout = (double **) malloc0 (a->nfor * sizeof (double *));
-    a->fmask = (double **) malloc0 (a->nfor * sizeof (double *));
-    a->maskgen = (double *) malloc0 (2 * a->size * sizeof (complex));
+    a->fftin = (real *) malloc0 (2 * a->size * sizeof (complex));
+    a->fftout = (real **) malloc0 (a->nfor * sizeof (real *));
+    a->fmask = (real **) malloc0 (a->nfor * sizeof (real *));
+    a->maskgen = (real *) malloc0 (2 * a->size * sizeof (complex));
     a->pcfor = (fftw_plan *) malloc0 (a->nfor * sizeof (fftw_plan));
     a->maskplan = (fftw_plan *) malloc0 (a->nfor * sizeof (fftw_plan));
     for (i = 0; i < a->nfor; i++)
     {
-        a->fftout[i] = (double *) malloc0 (2 * a->size * sizeof (complex));
-        a->fmask[i] = (double *) malloc0 (2 * a->size * sizeof (complex));
-        a->pcfor[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD, FFTW_PATIENT);
-        a->maskplan[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[i], FFTW_FORWARD, FFTW_PATIENT);
+        a->fftout[i] = (real *) malloc0 (2 * a->size * sizeof (complex));
+        a->fmask[i] = (real *) malloc0 (2 * a->size * sizeof (complex));
+        a->pcfor[i] = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD);
+        a->maskplan[i] = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[i], FFTW_FORWARD);
     }
-    a->accum = (double *) malloc0 (2 * a->size * sizeof (complex));
-    a->crev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+    a->accum = (real *) malloc0 (2 * a->size * sizeof (complex));
+    a->crev = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD);
 }
 
 void calc_firopt (FIROPT a)
@@ -157,7 +157,7 @@ void calc_firopt (FIROPT a)
     // call for change in frequency, rate, wintype, gain
     // must also call after a call to plan_firopt()
     int i;
-    double* impulse = fir_bandpass (a->nc, a->f_low, a->f_high, a->samplerate, a->wintype, 1, a->gain);
+    real* impulse = fir_bandpass (a->nc, a->f_low, a->f_high, a->samplerate, a->wintype, 1, a->gain);
     a->buffidx = 0;
     for (i = 0; i < a->nfor; i++)
     {
@@ -169,8 +169,8 @@ void calc_firopt (FIROPT a)
     _aligned_free (impulse);
 }
 
-FIROPT create_firopt (int run, int position, int size, double* in, double* out,
-    int nc, double f_low, double f_high, int samplerate, int wintype, double gain)
+FIROPT create_firopt (int run, int position, int size, real* in, real* out,
+    int nc, real f_low, real f_high, int samplerate, int wintype, real gain)
 {
     FIROPT a = (FIROPT) malloc0 (sizeof (firopt));
     a->run = run;
@@ -192,14 +192,14 @@ FIROPT create_firopt (int run, int position, int size, double* in, double* out,
 void deplan_firopt (FIROPT a)
 {
     int i;
-    fftw_destroy_plan (a->crev);
+    wisdom_destroy_plan (a->crev);
     _aligned_free (a->accum);
     for (i = 0; i < a->nfor; i++)
     {
         _aligned_free (a->fftout[i]);
         _aligned_free (a->fmask[i]);
-        fftw_destroy_plan (a->pcfor[i]);
-        fftw_destroy_plan (a->maskplan[i]);
+        wisdom_destroy_plan (a->pcfor[i]);
+        wisdom_destroy_plan (a->maskplan[i]);
     }
     _aligned_free (a->maskplan);
     _aligned_free (a->pcfor);
@@ -250,7 +250,7 @@ void xfiropt (FIROPT a, int pos)
         memcpy (a->out, a->in, a->size * sizeof (complex));
 }
 
-void setBuffers_firopt (FIROPT a, double* in, double* out)
+void setBuffers_firopt (FIROPT a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -273,7 +273,7 @@ void setSize_firopt (FIROPT a, int size)
     calc_firopt (a);
 }
 
-void setFreqs_firopt (FIROPT a, double f_low, double f_high)
+void setFreqs_firopt (FIROPT a, real f_low, real f_high)
 {
     a->f_low = f_low;
     a->f_high = f_high;
@@ -286,6 +286,86 @@ void setFreqs_firopt (FIROPT a, double f_low, double f_high)
 *                                                                                                       *
 ********************************************************************************************************/
 
+// Complex multiply-accumulate, acc[i] += x[i] * m[i] for n complex values
+// (interleaved re/im as delivered by FFTW), called through simd_cmac.
+
+void cmac_scalar (real* acc, const real* x, const real* m, int n)
+{
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        acc[2 * i + 0] += x[2 * i + 0] * m[2 * i + 0] - x[2 * i + 1] * m[2 * i + 1];
+        acc[2 * i + 1] += x[2 * i + 0] * m[2 * i + 1] + x[2 * i + 1] * m[2 * i + 0];
+    }
+}
+
+#ifdef WDSP_AVX2
+#include <immintrin.h>
+
+// fmaddsub yields x.re*m.re - x.im*m.im in the even (real) lanes and
+// x.im*m.re + x.re*m.im in the odd (imaginary) lanes
+__attribute__((target("avx2,fma")))
+void cmac_avx2 (real* acc, const real* x, const real* m, int n)
+{
+    int i = 0;
+#ifdef WDSP_FLOAT
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256 vx = _mm256_loadu_ps (x + 2 * i);
+        __m256 vm = _mm256_loadu_ps (m + 2 * i);
+        __m256 t  = _mm256_mul_ps (_mm256_permute_ps (vx, 0xB1), _mm256_movehdup_ps (vm));
+        __m256 p  = _mm256_fmaddsub_ps (vx, _mm256_moveldup_ps (vm), t);
+        _mm256_storeu_ps (acc + 2 * i, _mm256_add_ps (_mm256_loadu_ps (acc + 2 * i), p));
+    }
+#else
+    for (; i + 2 <= n; i += 2)
+    {
+        __m256d vx = _mm256_loadu_pd (x + 2 * i);
+        __m256d vm = _mm256_loadu_pd (m + 2 * i);
+        __m256d t  = _mm256_mul_pd (_mm256_permute_pd (vx, 0x5), _mm256_permute_pd (vm, 0xF));
+        __m256d p  = _mm256_fmaddsub_pd (vx, _mm256_movedup_pd (vm), t);
+        _mm256_storeu_pd (acc + 2 * i, _mm256_add_pd (_mm256_loadu_pd (acc + 2 * i), p));
+    }
+#endif
+    cmac_scalar (acc + 2 * i, x + 2 * i, m + 2 * i, n - i);
+}
+#endif
+
+#ifdef WDSP_NEON
+#include <arm_neon.h>
+
+// de-interleaving loads/stores give separate re and im vectors
+void cmac_neon (real* acc, const real* x, const real* m, int n)
+{
+    int i = 0;
+#ifdef WDSP_FLOAT
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4x2_t vx = vld2q_f32 (x + 2 * i);
+        float32x4x2_t vm = vld2q_f32 (m + 2 * i);
+        float32x4x2_t va = vld2q_f32 (acc + 2 * i);
+        va.val[0] = vfmaq_f32 (va.val[0], vx.val[0], vm.val[0]);
+        va.val[0] = vfmsq_f32 (va.val[0], vx.val[1], vm.val[1]);
+        va.val[1] = vfmaq_f32 (va.val[1], vx.val[0], vm.val[1]);
+        va.val[1] = vfmaq_f32 (va.val[1], vx.val[1], vm.val[0]);
+        vst2q_f32 (acc + 2 * i, va);
+    }
+#else
+    for (; i + 2 <= n; i += 2)
+    {
+        float64x2x2_t vx = vld2q_f64 (x + 2 * i);
+        float64x2x2_t vm = vld2q_f64 (m + 2 * i);
+        float64x2x2_t va = vld2q_f64 (acc + 2 * i);
+        va.val[0] = vfmaq_f64 (va.val[0], vx.val[0], vm.val[0]);
+        va.val[0] = vfmsq_f64 (va.val[0], vx.val[1], vm.val[1]);
+        va.val[1] = vfmaq_f64 (va.val[1], vx.val[0], vm.val[1]);
+        va.val[1] = vfmaq_f64 (va.val[1], vx.val[1], vm.val[0]);
+        vst2q_f64 (acc + 2 * i, va);
+    }
+#endif
+    cmac_scalar (acc + 2 * i, x + 2 * i, m + 2 * i, n - i);
+}
+#endif
 
 void plan_fircore (FIRCORE a)
 {
@@ -295,27 +375,41 @@ void plan_fircore (FIRCORE a)
     a->cset = 0;
     a->buffidx = 0;
     a->idxmask = a->nfor - 1;
-    a->fftin = (double *) malloc0 (2 * a->size * sizeof (complex));
-    a->fftout   = (double **) malloc0 (a->nfor * sizeof (double *));
-    a->fmask    = (double ***) malloc0 (2 * sizeof (double **));
-    a->fmask[0] = (double **) malloc0 (a->nfor * sizeof (double *));
-    a->fmask[1] = (double **) malloc0 (a->nfor * sizeof (double *));
-    a->maskgen = (double *) malloc0 (2 * a->size * sizeof (complex));
+    a->fftin = (real *) malloc0 (2 * a->size * sizeof (complex));
+    a->fftout   = (real **) malloc0 (a->nfor * sizeof (real *));
+    a->fmask    = (real ***) malloc0 (2 * sizeof (real **));
+    a->fmask[0] = (real **) malloc0 (a->nfor * sizeof (real *));
+    a->fmask[1] = (real **) malloc0 (a->nfor * sizeof (real *));
+    a->maskgen = (real *) malloc0 (2 * a->size * sizeof (complex));
     a->pcfor = (fftw_plan *) malloc0 (a->nfor * sizeof (fftw_plan));
     a->maskplan    = (fftw_plan **) malloc0 (2 * sizeof (fftw_plan *));
     a->maskplan[0] = (fftw_plan *) malloc0 (a->nfor * sizeof (fftw_plan));
     a->maskplan[1] = (fftw_plan *) malloc0 (a->nfor * sizeof (fftw_plan));
     for (i = 0; i < a->nfor; i++)
     {
-        a->fftout[i]   = (double *) malloc0 (2 * a->size * sizeof (complex));
-        a->fmask[0][i] = (double *) malloc0 (2 * a->size * sizeof (complex));
-        a->fmask[1][i] = (double *) malloc0 (2 * a->size * sizeof (complex));
-        a->pcfor[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD, FFTW_PATIENT);
-        a->maskplan[0][i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[0][i], FFTW_FORWARD, FFTW_PATIENT);
-        a->maskplan[1][i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[1][i], FFTW_FORWARD, FFTW_PATIENT);
+        a->fftout[i]   = (real *) malloc0 (2 * a->size * sizeof (complex));
+        a->fmask[0][i] = (real *) malloc0 (2 * a->size * sizeof (complex));
+        a->fmask[1][i] = (real *) malloc0 (2 * a->size * sizeof (complex));
+        a->pcfor[i] = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD);
+        a->maskplan[0][i] = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[0][i], FFTW_FORWARD);
+        a->maskplan[1][i] = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[1][i], FFTW_FORWARD);
     }
-    a->accum = (double *) malloc0 (2 * a->size * sizeof (complex));
-    a->crev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+    a->accum = (real *) malloc0 (2 * a->size * sizeof (complex));
+    a->crev = wisdom_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD);
+    a->masks_ready = 0;
+}
+
+// Make the masks just computed by calc_fircore() the active set. xfircore()
+// only holds the lock while picking up the active set, so after the flip we
+// wait until a MAC that may still use the old set has finished: only then may
+// the next calc_fircore() overwrite it.
+static void flip_fircore (FIRCORE a)
+{
+    EnterCriticalSection (&a->update);
+    a->cset = 1 - a->cset;
+    LeaveCriticalSection (&a->update);
+    while (__atomic_load_n (&a->mac_busy, __ATOMIC_ACQUIRE))
+        Sleep (0);
     a->masks_ready = 0;
 }
 
@@ -337,15 +431,10 @@ void calc_fircore (FIRCORE a, int flip)
     }
     a->masks_ready = 1;
     if (flip)
-    {
-        EnterCriticalSection (&a->update);
-        a->cset = 1 - a->cset;
-        LeaveCriticalSection (&a->update);
-        a->masks_ready = 0;
-    }
+        flip_fircore (a);
 }
 
-FIRCORE create_fircore (int size, double* in, double* out, int nc, int mp, double* impulse)
+FIRCORE create_fircore (int size, real* in, real* out, int nc, int mp, real* impulse)
 {
     FIRCORE a = (FIRCORE) malloc0 (sizeof (fircore));
     a->size = size;
@@ -355,8 +444,8 @@ FIRCORE create_fircore (int size, double* in, double* out, int nc, int mp, doubl
     a->mp = mp;
     InitializeCriticalSectionAndSpinCount (&a->update, 2500);
     plan_fircore (a);
-    a->impulse = (double *) malloc0 (a->nc * sizeof (complex));
-    a->imp     = (double *) malloc0 (a->nc * sizeof (complex));
+    a->impulse = (real *) malloc0 (a->nc * sizeof (complex));
+    a->imp     = (real *) malloc0 (a->nc * sizeof (complex));
     memcpy (a->impulse, impulse, a->nc * sizeof (complex));
     calc_fircore (a, 1);
     return a;
@@ -365,16 +454,16 @@ FIRCORE create_fircore (int size, double* in, double* out, int nc, int mp, doubl
 void deplan_fircore (FIRCORE a)
 {
     int i;
-    fftw_destroy_plan (a->crev);
+    wisdom_destroy_plan (a->crev);
     _aligned_free (a->accum);
     for (i = 0; i < a->nfor; i++)
     {
         _aligned_free (a->fftout[i]);
         _aligned_free (a->fmask[0][i]);
         _aligned_free (a->fmask[1][i]);
-        fftw_destroy_plan (a->pcfor[i]);
-        fftw_destroy_plan (a->maskplan[0][i]);
-        fftw_destroy_plan (a->maskplan[1][i]);
+        wisdom_destroy_plan (a->pcfor[i]);
+        wisdom_destroy_plan (a->maskplan[0][i]);
+        wisdom_destroy_plan (a->maskplan[1][i]);
     }
     _aligned_free (a->maskplan[0]);
     _aligned_free (a->maskplan[1]);
@@ -408,28 +497,28 @@ void flush_fircore (FIRCORE a)
 
 void xfircore (FIRCORE a)
 {
-    int i, j, k;
+    int j, k;
+    real** fmask;
     memcpy (&(a->fftin[2 * a->size]), a->in, a->size * sizeof (complex));
     fftw_execute (a->pcfor[a->buffidx]);
     k = a->buffidx;
     memset (a->accum, 0, 2 * a->size * sizeof (complex));
     EnterCriticalSection (&a->update);
+    fmask = a->fmask[a->cset];
+    __atomic_store_n (&a->mac_busy, 1, __ATOMIC_RELAXED);
+    LeaveCriticalSection (&a->update);
     for (j = 0; j < a->nfor; j++)
     {
-        for (i = 0; i < 2 * a->size; i++)
-        {
-            a->accum[2 * i + 0] += a->fftout[k][2 * i + 0] * a->fmask[a->cset][j][2 * i + 0] - a->fftout[k][2 * i + 1] * a->fmask[a->cset][j][2 * i + 1];
-            a->accum[2 * i + 1] += a->fftout[k][2 * i + 0] * a->fmask[a->cset][j][2 * i + 1] + a->fftout[k][2 * i + 1] * a->fmask[a->cset][j][2 * i + 0];
-        }
+        simd_cmac (a->accum, a->fftout[k], fmask[j], 2 * a->size);
         k = (k + a->idxmask) & a->idxmask;
     }
-    LeaveCriticalSection (&a->update);
+    __atomic_store_n (&a->mac_busy, 0, __ATOMIC_RELEASE);
     a->buffidx = (a->buffidx + 1) & a->idxmask;
     fftw_execute (a->crev);
     memcpy (a->fftin, &(a->fftin[2 * a->size]), a->size * sizeof(complex));
 }
 
-void setBuffers_fircore (FIRCORE a, double* in, double* out)
+void setBuffers_fircore (FIRCORE a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -446,13 +535,13 @@ void setSize_fircore (FIRCORE a, int size)
     calc_fircore (a, 1);
 }
 
-void setImpulse_fircore (FIRCORE a, double* impulse, int update)
+void setImpulse_fircore (FIRCORE a, real* impulse, int update)
 {
     memcpy (a->impulse, impulse, a->nc * sizeof (complex));
     calc_fircore (a, update);
 }
 
-void setNc_fircore (FIRCORE a, int nc, double* impulse)
+void setNc_fircore (FIRCORE a, int nc, real* impulse)
 {
     // because of FFT planning, this will probably cause a glitch in audio if done during dataflow
     deplan_fircore (a);
@@ -460,8 +549,8 @@ void setNc_fircore (FIRCORE a, int nc, double* impulse)
     _aligned_free (a->imp);
     a->nc = nc;
     plan_fircore (a);
-    a->imp     = (double *) malloc0 (a->nc * sizeof (complex));
-    a->impulse = (double *) malloc0 (a->nc * sizeof (complex));
+    a->imp     = (real *) malloc0 (a->nc * sizeof (complex));
+    a->impulse = (real *) malloc0 (a->nc * sizeof (complex));
     memcpy (a->impulse, impulse, a->nc * sizeof (complex));
     calc_fircore (a, 1);
 }
@@ -475,10 +564,5 @@ void setMp_fircore (FIRCORE a, int mp)
 void setUpdate_fircore (FIRCORE a)
 {
     if (a->masks_ready)
-    {
-        EnterCriticalSection (&a->update);
-        a->cset = 1 - a->cset;
-        LeaveCriticalSection (&a->update);
-        a->masks_ready = 0;
-    }
+        flip_fircore (a);
 }
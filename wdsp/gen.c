@@ -73,7 +73,7 @@ void calc_triangle (GEN a)
 void calc_pulse (GEN a)
 {
     int i;
-    double delta, theta;
+    real delta, theta;
     a->pulse.pperiod = 1.0 / a->pulse.pf;
     a->pulse.tphs = 0.0;
     a->pulse.tdelta = TWOPI * a->pulse.tf / a->rate;
@@ -85,8 +85,8 @@ void calc_pulse (GEN a)
     if (a->pulse.pnoff < 0) a->pulse.pnoff = 0;
     a->pulse.pcount = a->pulse.pnoff;
     a->pulse.state = 0;
-    a->pulse.ctrans = (double *) malloc0 ((a->pulse.pntrans + 1) * sizeof (double));
-    delta = PI / (double)a->pulse.pntrans;
+    a->pulse.ctrans = (real *) malloc0 ((a->pulse.pntrans + 1) * sizeof (real));
+    delta = PI / (real)a->pulse.pntrans;
     theta = 0.0;
     for (i = 0; i <= a->pulse.pntrans; i++)
     {
@@ -110,14 +110,14 @@ void decalc_gen (GEN a)
     _aligned_free (a->pulse.ctrans);
 }
 
-GEN create_gen (int run, int size, double* in, double* out, int rate, int mode)
+GEN create_gen (int run, int size, real* in, real* out, int rate, int mode)
 {
     GEN a = (GEN) malloc0 (sizeof (gen));
     a->run = run;
     a->size = size;
     a->in = in;
     a->out = out;
-    a->rate = (double)rate;
+    a->rate = (real)rate;
     a->mode = mode;
     // tone
     a->tone.mag = 1.0;
@@ -179,9 +179,9 @@ void xgen (GEN a)
         case 0: // tone
             {
                 int i;
-                double t1, t2;
-                double cosphase = cos (a->tone.phs);
-                double sinphase = sin (a->tone.phs);
+                real t1, t2;
+                real cosphase = cos (a->tone.phs);
+                real sinphase = sin (a->tone.phs);
                 for (i = 0; i < a->size; i++)
                 {
                     a->out[2 * i + 0] = + a->tone.mag * cosphase;
@@ -199,11 +199,11 @@ void xgen (GEN a)
         case 1: // two-tone
             {
                 int i;
-                double tcos, tsin;
-                double cosphs1 = cos (a->tt.phs1);
-                double sinphs1 = sin (a->tt.phs1);
-                double cosphs2 = cos (a->tt.phs2);
-                double sinphs2 = sin (a->tt.phs2);
+                real tcos, tsin;
+                real cosphs1 = cos (a->tt.phs1);
+                real sinphs1 = sin (a->tt.phs1);
+                real cosphs2 = cos (a->tt.phs2);
+                real sinphs2 = sin (a->tt.phs2);
                 for (i = 0; i < a->size; i++)
                 {
                     a->out[2 * i + 0] = + a->tt.mag1 * cosphs1 + a->tt.mag2 * cosphs2;
@@ -228,13 +228,13 @@ void xgen (GEN a)
         case 2: // noise
             {
                 int i;
-                double r1, r2, c, rad;
+                real r1, r2, c, rad;
                 for (i = 0; i < a->size; i++)
                 {
                     do
                     {
-                        r1 = 2.0 * (double)rand() / (double)RAND_MAX - 1.0;
-                        r2 = 2.0 * (double)rand() / (double)RAND_MAX - 1.0;
+                        r1 = 2.0 * (real)rand() / (real)RAND_MAX - 1.0;
+                        r2 = 2.0 * (real)rand() / (real)RAND_MAX - 1.0;
                         c = r1 * r1 + r2 * r2;
                     } while (c >= 1.0);
                     rad = sqrt (-2.0 * log (c) / c);
@@ -288,9 +288,9 @@ void xgen (GEN a)
         case 6:  // pulse (audio only)
             {
                 int i;
-                double t1, t2;
-                double cosphase = cos (a->pulse.tphs);
-                double sinphase = sin (a->pulse.tphs);
+                real t1, t2;
+                real cosphase = cos (a->pulse.tphs);
+                real sinphase = sin (a->pulse.tphs);
                 for (i = 0; i < a->size; i++)
                 {
                     if (a->pulse.pnoff != 0)
@@ -353,7 +353,7 @@ void xgen (GEN a)
         memcpy (a->out, a->in, a->size * sizeof (complex));
 }
 
-void setBuffers_gen (GEN a, double* in, double* out)
+void setBuffers_gen (GEN a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -34,8 +34,8 @@ warren@wpratt.com
 
 void calc_snotch (SNOTCH a)
 {
-    double fn, qk, qr, csn;
-    fn = a->f / (double)a->rate;
+    real fn, qk, qr, csn;
+    fn = a->f / (real)a->rate;
     csn = cos (TWOPI * fn);
     qr = 1.0 - 3.0 * a->bw;
     qk = (1.0 - 2.0 * qr * csn + qr * qr) / (2.0 * (1.0 - csn));
@@ -47,7 +47,7 @@ void calc_snotch (SNOTCH a)
     flush_snotch (a);
 }
 
-SNOTCH create_snotch (int run, int size, double* in, double* out, int rate, double f, double bw)
+SNOTCH create_snotch (int run, int size, real* in, real* out, int rate, real f, real bw)
 {
     SNOTCH a = (SNOTCH) malloc0 (sizeof (snotch));
     a->run = run;
@@ -94,7 +94,7 @@ void xsnotch (SNOTCH a)
     LeaveCriticalSection (&a->cs_update);
 }
 
-void setBuffers_snotch (SNOTCH a, double* in, double* out)
+void setBuffers_snotch (SNOTCH a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -118,7 +118,7 @@ void setSize_snotch (SNOTCH a, int size)
 *                                                                                                       *
 ********************************************************************************************************/
 
-void SetSNCTCSSFreq (SNOTCH a, double freq)
+void SetSNCTCSSFreq (SNOTCH a, real freq)
 {
     EnterCriticalSection (&a->cs_update);
     a->f = freq;
@@ -142,8 +142,8 @@ void SetSNCTCSSRun (SNOTCH a, int run)
 
 void calc_speak (SPEAK a)
 {
-    double ratio;
-    double f_corr, g_corr, bw_corr, bw_parm, A, f_min;
+    real ratio;
+    real f_corr, g_corr, bw_corr, bw_parm, A, f_min;
 
     switch (a->design)
     {
@@ -163,11 +163,11 @@ void calc_speak (SPEAK a)
             break;
         }
         {
-            double fn, qk, qr, csn;
+            real fn, qk, qr, csn;
             a->fgain = a->gain / g_corr;
-            fn = a->f / (double)a->rate / f_corr;
+            fn = a->f / (real)a->rate / f_corr;
             csn = cos (TWOPI * fn);
-            qr = 1.0 - 3.0 * a->bw / (double)a->rate * bw_parm;
+            qr = 1.0 - 3.0 * a->bw / (real)a->rate * bw_parm;
             qk = (1.0 - 2.0 * qr * csn + qr * qr) / (2.0 * (1.0 - csn));
             a->a0 = 1.0 - qk;
             a->a1 = 2.0 * (qk - qr) * csn;
@@ -197,9 +197,9 @@ void calc_speak (SPEAK a)
             break;
         }
         {
-            double w0, sn, c, den;
+            real w0, sn, c, den;
             if (a->f < f_min) a->f = f_min;
-            w0 = TWOPI * a->f / (double)a->rate;
+            w0 = TWOPI * a->f / (real)a->rate;
             sn = sin (w0);
             a->cbw = bw_corr * a->f;
             c = sn * sinh(0.5 * log((a->f + 0.5 * a->cbw * bw_parm) / (a->f - 0.5 * a->cbw * bw_parm)) * w0 / sn);
@@ -209,14 +209,14 @@ void calc_speak (SPEAK a)
             a->a2 = (1 - c * A) / den;
             a->b1 = - a->a1;
             a->b2 = - (1 - c / A ) / den;
-            a->fgain = a->gain / pow (A * A, (double)a->nstages);
+            a->fgain = a->gain / pow (A * A, (real)a->nstages);
         }
         break;
     }
     flush_speak (a);
 }
 
-SPEAK create_speak (int run, int size, double* in, double* out, int rate, double f, double bw, double gain, int nstages, int design)
+SPEAK create_speak (int run, int size, real* in, real* out, int rate, real f, real bw, real gain, int nstages, int design)
 {
     SPEAK a = (SPEAK) malloc0 (sizeof (speak));
     a->run = run;
@@ -229,12 +229,12 @@ SPEAK create_speak (int run, int size, double* in, double* out, int rate, double
     a->gain = gain;
     a->nstages = nstages;
     a->design = design;
-    a->x0 = (double *) malloc0 (a->nstages * sizeof (complex));
-    a->x1 = (double *) malloc0 (a->nstages * sizeof (complex));
-    a->x2 = (double *) malloc0 (a->nstages * sizeof (complex));
-    a->y0 = (double *) malloc0 (a->nstages * sizeof (complex));
-    a->y1 = (double *) malloc0 (a->nstages * sizeof (complex));
-    a->y2 = (double *) malloc0 (a->nstages * sizeof (complex));
+    a->x0 = (real *) malloc0 (a->nstages * sizeof (complex));
+    a->x1 = (real *) malloc0 (a->nstages * sizeof (complex));
+    a->x2 = (real *) malloc0 (a->nstages * sizeof (complex));
+    a->y0 = (real *) malloc0 (a->nstages * sizeof (complex));
+    a->y1 = (real *) malloc0 (a->nstages * sizeof (complex));
+    a->y2 = (real *) malloc0 (a->nstages * sizeof (complex));
     InitializeCriticalSectionAndSpinCount ( &a->cs_update, 2500 );
     calc_speak (a);
     return a;
@@ -295,7 +295,7 @@ void xspeak (SPEAK a)
     LeaveCriticalSection (&a->cs_update);
 }
 
-void setBuffers_speak (SPEAK a, double* in, double* out)
+void setBuffers_speak (SPEAK a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -367,8 +367,8 @@ void SetRXASPCWGain (int channel, double gain)
 void calc_mpeak (MPEAK a)
 {
     int i;
-    a->tmp = (double *) malloc0 (a->size * sizeof (complex));
-    a->mix = (double *) malloc0 (a->size * sizeof (complex));
+    a->tmp = (real *) malloc0 (a->size * sizeof (complex));
+    a->mix = (real *) malloc0 (a->size * sizeof (complex));
     for (i = 0; i < a->npeaks; i++)
     {
         a->pfil[i] = create_speak ( 1,
@@ -393,7 +393,7 @@ void decalc_mpeak (MPEAK a)
     _aligned_free (a->tmp);
 }
 
-MPEAK create_mpeak (int run, int size, double* in, double* out, int rate, int npeaks, int* enable, double* f, double* bw, double* gain, int nstages)
+MPEAK create_mpeak (int run, int size, real* in, real* out, int rate, int npeaks, int* enable, real* f, real* bw, real* gain, int nstages)
 {
     MPEAK a = (MPEAK) malloc0 (sizeof (mpeak));
     a->run = run;
@@ -404,13 +404,13 @@ MPEAK create_mpeak (int run, int size, double* in, double* out, int rate, int np
     a->npeaks = npeaks;
     a->nstages = nstages;
     a->enable  = (int *) malloc0 (a->npeaks * sizeof (int));
-    a->f    = (double *) malloc0 (a->npeaks * sizeof (double));
-    a->bw   = (double *) malloc0 (a->npeaks * sizeof (double));
-    a->gain = (double *) malloc0 (a->npeaks * sizeof (double));
+    a->f    = (real *) malloc0 (a->npeaks * sizeof (real));
+    a->bw   = (real *) malloc0 (a->npeaks * sizeof (real));
+    a->gain = (real *) malloc0 (a->npeaks * sizeof (real));
     memcpy (a->enable, enable, a->npeaks * sizeof (int));
-    memcpy (a->f, f, a->npeaks * sizeof (double));
-    memcpy (a->bw, bw, a->npeaks * sizeof (double));
-    memcpy (a->gain, gain, a->npeaks * sizeof (double));
+    memcpy (a->f, f, a->npeaks * sizeof (real));
+    memcpy (a->bw, bw, a->npeaks * sizeof (real));
+    memcpy (a->gain, gain, a->npeaks * sizeof (real));
     a->pfil = (SPEAK *) malloc0 (a->npeaks * sizeof (SPEAK));
     InitializeCriticalSectionAndSpinCount ( &a->cs_update, 2500 );
     calc_mpeak (a);
@@ -459,7 +459,7 @@ void xmpeak (MPEAK a)
     LeaveCriticalSection (&a->cs_update);
 }
 
-void setBuffers_mpeak (MPEAK a, double* in, double* out)
+void setBuffers_mpeak (MPEAK a, real* in, real* out)
 {
     decalc_mpeak (a);
     a->in = in;
@@ -556,18 +556,18 @@ void SetRXAmpeakFilGain (int channel, int fil, double gain)
 
 void calc_phrot (PHROT a)
 {
-    double g;
-    a->x0 = (double *) malloc0 (a->nstages * sizeof (double));
-    a->x1 = (double *) malloc0 (a->nstages * sizeof (double));
-    a->y0 = (double *) malloc0 (a->nstages * sizeof (double));
-    a->y1 = (double *) malloc0 (a->nstages * sizeof (double));
-    g = tan (PI * a->fc / (double)a->rate);
+    real g;
+    a->x0 = (real *) malloc0 (a->nstages * sizeof (real));
+    a->x1 = (real *) malloc0 (a->nstages * sizeof (real));
+    a->y0 = (real *) malloc0 (a->nstages * sizeof (real));
+    a->y1 = (real *) malloc0 (a->nstages * sizeof (real));
+    g = tan (PI * a->fc / (real)a->rate);
     a->b0 = (g - 1.0) / (g + 1.0);
     a->b1 = 1.0;
     a->a1 = a->b0;
 }
 
-PHROT create_phrot (int run, int size, double* in, double* out, int rate, double fc, int nstages)
+PHROT create_phrot (int run, int size, real* in, real* out, int rate, real fc, int nstages)
 {
     PHROT a = (PHROT) malloc0 (sizeof (phrot));
     a->reverse = 0;
@@ -600,10 +600,10 @@ void destroy_phrot (PHROT a)
 
 void flush_phrot (PHROT a)
 {
-    memset (a->x0, 0, a->nstages * sizeof (double));
-    memset (a->x1, 0, a->nstages * sizeof (double));
-    memset (a->y0, 0, a->nstages * sizeof (double));
-    memset (a->y1, 0, a->nstages * sizeof (double));
+    memset (a->x0, 0, a->nstages * sizeof (real));
+    memset (a->x1, 0, a->nstages * sizeof (real));
+    memset (a->y0, 0, a->nstages * sizeof (real));
+    memset (a->y1, 0, a->nstages * sizeof (real));
 }
 
 void xphrot (PHROT a)
@@ -637,7 +637,7 @@ void xphrot (PHROT a)
     LeaveCriticalSection (&a->cs_update);
 }
 
-void setBuffers_phrot (PHROT a, double* in, double* out)
+void setBuffers_phrot (PHROT a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -711,8 +711,8 @@ void SetTXAPHROTReverse (int channel, int reverse)
 
 void calc_bqlp(BQLP a)
 {
-    double w0, cs, c, den;
-    w0 = TWOPI * a->fc / (double)a->rate;
+    real w0, cs, c, den;
+    w0 = TWOPI * a->fc / (real)a->rate;
     cs = cos(w0);
     c = sin(w0) / (2.0 * a->Q);
     den = 1.0 + c;
@@ -724,7 +724,7 @@ void calc_bqlp(BQLP a)
     flush_bqlp(a);
 }
 
-BQLP create_bqlp(int run, int size, double* in, double* out, double rate, double fc, double Q, double gain, int nstages)
+BQLP create_bqlp(int run, int size, real* in, real* out, real rate, real fc, real Q, real gain, int nstages)
 {
     BQLP a = (BQLP)malloc0(sizeof(bqlp));
     a->run = run;
@@ -736,12 +736,12 @@ BQLP create_bqlp(int run, int size, double* in, double* out, double rate, double
     a->Q = Q;
     a->gain = gain;
     a->nstages = nstages;
-    a->x0 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->x1 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->x2 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y0 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y1 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y2 = (double*)malloc0(a->nstages * sizeof(complex));
+    a->x0 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->x1 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->x2 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y0 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y1 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y2 = (real*)malloc0(a->nstages * sizeof(complex));
     InitializeCriticalSectionAndSpinCount(&a->cs_update, 2500);
     calc_bqlp(a);
     return a;
@@ -802,7 +802,7 @@ void xbqlp(BQLP a)
     LeaveCriticalSection(&a->cs_update);
 }
 
-void setBuffers_bqlp(BQLP a, double* in, double* out)
+void setBuffers_bqlp(BQLP a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -828,8 +828,8 @@ void setSize_bqlp(BQLP a, int size)
 
 void calc_dbqlp(BQLP a)
 {
-    double w0, cs, c, den;
-    w0 = TWOPI * a->fc / (double)a->rate;
+    real w0, cs, c, den;
+    w0 = TWOPI * a->fc / (real)a->rate;
     cs = cos(w0);
     c = sin(w0) / (2.0 * a->Q);
     den = 1.0 + c;
@@ -841,7 +841,7 @@ void calc_dbqlp(BQLP a)
     flush_dbqlp(a);
 }
 
-BQLP create_dbqlp(int run, int size, double* in, double* out, double rate, double fc, double Q, double gain, int nstages)
+BQLP create_dbqlp(int run, int size, real* in, real* out, real rate, real fc, real Q, real gain, int nstages)
 {
     BQLP a = (BQLP)malloc0(sizeof(bqlp));
     a->run = run;
@@ -853,12 +853,12 @@ BQLP create_dbqlp(int run, int size, double* in, double* out, double rate, doubl
     a->Q = Q;
     a->gain = gain;
     a->nstages = nstages;
-    a->x0 = (double*)malloc0(a->nstages * sizeof(double));
-    a->x1 = (double*)malloc0(a->nstages * sizeof(double));
-    a->x2 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y0 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y1 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y2 = (double*)malloc0(a->nstages * sizeof(double));
+    a->x0 = (real*)malloc0(a->nstages * sizeof(real));
+    a->x1 = (real*)malloc0(a->nstages * sizeof(real));
+    a->x2 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y0 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y1 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y2 = (real*)malloc0(a->nstages * sizeof(real));
     InitializeCriticalSectionAndSpinCount(&a->cs_update, 2500);
     calc_dbqlp(a);
     return a;
@@ -911,11 +911,11 @@ void xdbqlp(BQLP a)
         }
     }
     else if (a->out != a->in)
-        memcpy(a->out, a->in, a->size * sizeof(double));
+        memcpy(a->out, a->in, a->size * sizeof(real));
     LeaveCriticalSection(&a->cs_update);
 }
 
-void setBuffers_dbqlp(BQLP a, double* in, double* out)
+void setBuffers_dbqlp(BQLP a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -942,7 +942,7 @@ void setSize_dbqlp(BQLP a, int size)
 
 void calc_bqbp(BQBP a)
 {
-    double f0, w0, bw, q, sn, cs, c, den;
+    real f0, w0, bw, q, sn, cs, c, den;
     bw = a->f_high - a->f_low;
     f0 = (a->f_high + a->f_low) / 2.0;
     q = f0 / bw;
@@ -959,7 +959,7 @@ void calc_bqbp(BQBP a)
     flush_bqbp(a);
 }
 
-BQBP create_bqbp(int run, int size, double* in, double* out, double rate, double f_low, double f_high, double gain, int nstages)
+BQBP create_bqbp(int run, int size, real* in, real* out, real rate, real f_low, real f_high, real gain, int nstages)
 {
     BQBP a = (BQBP)malloc0(sizeof(bqbp));
     a->run = run;
@@ -971,12 +971,12 @@ BQBP create_bqbp(int run, int size, double* in, double* out, double rate, double
     a->f_high = f_high;
     a->gain = gain;
     a->nstages = nstages;
-    a->x0 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->x1 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->x2 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y0 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y1 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y2 = (double*)malloc0(a->nstages * sizeof(complex));
+    a->x0 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->x1 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->x2 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y0 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y1 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y2 = (real*)malloc0(a->nstages * sizeof(complex));
     InitializeCriticalSectionAndSpinCount(&a->cs_update, 2500);
     calc_bqbp(a);
     return a;
@@ -1037,7 +1037,7 @@ void xbqbp(BQBP a)
     LeaveCriticalSection(&a->cs_update);
 }
 
-void setBuffers_bqbp(BQBP a, double* in, double* out)
+void setBuffers_bqbp(BQBP a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -1063,7 +1063,7 @@ void setSize_bqbp(BQBP a, int size)
 
 void calc_dbqbp(BQBP a)
 {
-    double f0, w0, bw, q, sn, cs, c, den;
+    real f0, w0, bw, q, sn, cs, c, den;
     bw = a->f_high - a->f_low;
     f0 = (a->f_high + a->f_low) / 2.0;
     q = f0 / bw;
@@ -1080,7 +1080,7 @@ void calc_dbqbp(BQBP a)
     flush_dbqbp(a);
 }
 
-BQBP create_dbqbp(int run, int size, double* in, double* out, double rate, double f_low, double f_high, double gain, int nstages)
+BQBP create_dbqbp(int run, int size, real* in, real* out, real rate, real f_low, real f_high, real gain, int nstages)
 {
     BQBP a = (BQBP)malloc0(sizeof(bqbp));
     a->run = run;
@@ -1092,12 +1092,12 @@ BQBP create_dbqbp(int run, int size, double* in, double* out, double rate, doubl
     a->f_high = f_high;
     a->gain = gain;
     a->nstages = nstages;
-    a->x0 = (double*)malloc0(a->nstages * sizeof(double));
-    a->x1 = (double*)malloc0(a->nstages * sizeof(double));
-    a->x2 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y0 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y1 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y2 = (double*)malloc0(a->nstages * sizeof(double));
+    a->x0 = (real*)malloc0(a->nstages * sizeof(real));
+    a->x1 = (real*)malloc0(a->nstages * sizeof(real));
+    a->x2 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y0 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y1 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y2 = (real*)malloc0(a->nstages * sizeof(real));
     InitializeCriticalSectionAndSpinCount(&a->cs_update, 2500);
     calc_dbqbp(a);
     return a;
@@ -1150,11 +1150,11 @@ void xdbqbp(BQBP a)
         }
     }
     else if (a->out != a->in)
-        memcpy(a->out, a->in, a->size * sizeof(double));
+        memcpy(a->out, a->in, a->size * sizeof(real));
     LeaveCriticalSection(&a->cs_update);
 }
 
-void setBuffers_dbqbp(BQBP a, double* in, double* out)
+void setBuffers_dbqbp(BQBP a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -1180,18 +1180,18 @@ void setSize_dbqbp(BQBP a, int size)
 
 void calc_sphp(SPHP a)
 {
-    double g;
-    a->x0 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->x1 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y0 = (double*)malloc0(a->nstages * sizeof(complex));
-    a->y1 = (double*)malloc0(a->nstages * sizeof(complex));
+    real g;
+    a->x0 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->x1 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y0 = (real*)malloc0(a->nstages * sizeof(complex));
+    a->y1 = (real*)malloc0(a->nstages * sizeof(complex));
     g = exp(-TWOPI * a->fc / a->rate);
     a->b0 = +0.5 * (1.0 + g);
     a->b1 = -0.5 * (1.0 + g);
     a->a1 = -g;
 }
 
-SPHP create_sphp(int run, int size, double* in, double* out, double rate, double fc, int nstages)
+SPHP create_sphp(int run, int size, real* in, real* out, real rate, real fc, int nstages)
 {
     SPHP a = (SPHP)malloc0(sizeof(sphp));
     a->run = run;
@@ -1258,7 +1258,7 @@ void xsphp(SPHP a)
     LeaveCriticalSection(&a->cs_update);
 }
 
-void setBuffers_sphp(SPHP a, double* in, double* out)
+void setBuffers_sphp(SPHP a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -1285,18 +1285,18 @@ void setSize_sphp(SPHP a, int size)
 
 void calc_dsphp(SPHP a)
 {
-    double g;
-    a->x0 = (double*)malloc0(a->nstages * sizeof(double));
-    a->x1 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y0 = (double*)malloc0(a->nstages * sizeof(double));
-    a->y1 = (double*)malloc0(a->nstages * sizeof(double));
+    real g;
+    a->x0 = (real*)malloc0(a->nstages * sizeof(real));
+    a->x1 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y0 = (real*)malloc0(a->nstages * sizeof(real));
+    a->y1 = (real*)malloc0(a->nstages * sizeof(real));
     g = exp(-TWOPI * a->fc / a->rate);
     a->b0 = +0.5 * (1.0 + g);
     a->b1 = -0.5 * (1.0 + g);
     a->a1 = -g;
 }
 
-SPHP create_dsphp(int run, int size, double* in, double* out, double rate, double fc, int nstages)
+SPHP create_dsphp(int run, int size, real* in, real* out, real rate, real fc, int nstages)
 {
     SPHP a = (SPHP)malloc0(sizeof(sphp));
     a->run = run;
@@ -1328,10 +1328,10 @@ void destroy_dsphp(SPHP a)
 
 void flush_dsphp(SPHP a)
 {
-    memset(a->x0, 0, a->nstages * sizeof(double));
-    memset(a->x1, 0, a->nstages * sizeof(double));
-    memset(a->y0, 0, a->nstages * sizeof(double));
-    memset(a->y1, 0, a->nstages * sizeof(double));
+    memset(a->x0, 0, a->nstages * sizeof(real));
+    memset(a->x1, 0, a->nstages * sizeof(real));
+    memset(a->y0, 0, a->nstages * sizeof(real));
+    memset(a->y1, 0, a->nstages * sizeof(real));
 }
 
 void xdsphp(SPHP a)
@@ -1356,11 +1356,11 @@ void xdsphp(SPHP a)
         }
     }
     else if (a->out != a->in)
-        memcpy(a->out, a->in, a->size * sizeof(double));
+        memcpy(a->out, a->in, a->size * sizeof(real));
     LeaveCriticalSection(&a->cs_update);
 }
 
-void setBuffers_dsphp(SPHP a, double* in, double* out)
+void setBuffers_dsphp(SPHP a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
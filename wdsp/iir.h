@@ -37,17 +37,17 @@ typedef struct _snotch
 {
     int run;
     int size;
-    double* in;
-    double* out;
-    double rate;
-    double f;
-    double bw;
-    double a0, a1, a2, b1, b2;
-    double x0, x1, x2, y1, y2;
+    real* in;
+    real* out;
+    real rate;
+    real f;
+    real bw;
+    real a0, a1, a2, b1, b2;
+    real x0, x1, x2, y1, y2;
     CRITICAL_SECTION cs_update;
 } snotch, *SNOTCH;
 
-extern SNOTCH create_snotch (int run, int size, double* in, double* out, int rate, double f, double bw);
+extern SNOTCH create_snotch (int run, int size, real* in, real* out, int rate, real f, real bw);
 
 extern void destroy_snotch (SNOTCH a);
 
@@ -55,13 +55,13 @@ extern void flush_snotch (SNOTCH a);
 
 extern void xsnotch (SNOTCH a);
 
-extern void setBuffers_snotch (SNOTCH a, double* in, double* out);
+extern void setBuffers_snotch (SNOTCH a, real* in, real* out);
 
 extern void setSamplerate_snotch (SNOTCH a, int rate);
 
 extern void setSize_snotch (SNOTCH a, int size);
 
-extern void SetSNCTCSSFreq (SNOTCH a, double freq);
+extern void SetSNCTCSSFreq (SNOTCH a, real freq);
 
 extern void SetSNCTCSSRun (SNOTCH a, int run);
 
@@ -80,22 +80,22 @@ typedef struct _speak
 {
     int run;
     int size;
-    double* in;
-    double* out;
-    double rate;
-    double f;
-    double bw;
-    double cbw;
-    double gain;
-    double fgain;
+    real* in;
+    real* out;
+    real rate;
+    real f;
+    real bw;
+    real cbw;
+    real gain;
+    real fgain;
     int nstages;
     int design;
-    double a0, a1, a2, b1, b2;
-    double *x0, *x1, *x2, *y0, *y1, *y2;
+    real a0, a1, a2, b1, b2;
+    real *x0, *x1, *x2, *y0, *y1, *y2;
     CRITICAL_SECTION cs_update;
 } speak, *SPEAK;
 
-extern SPEAK create_speak (int run, int size, double* in, double* out, int rate, double f, double bw, double gain, int nstages, int design);
+extern SPEAK create_speak (int run, int size, real* in, real* out, int rate, real f, real bw, real gain, int nstages, int design);
 
 extern void destroy_speak (SPEAK a);
 
@@ -103,7 +103,7 @@ extern void flush_speak (SPEAK a);
 
 extern void xspeak (SPEAK a);
 
-extern void setBuffers_speak (SPEAK a, double* in, double* out);
+extern void setBuffers_speak (SPEAK a, real* in, real* out);
 
 extern void setSamplerate_speak (SPEAK a, int rate);
 
@@ -124,22 +124,22 @@ typedef struct _mpeak
 {
     int run;
     int size;
-    double* in;
-    double* out;
+    real* in;
+    real* out;
     int rate;
     int npeaks;
     int* enable;
-    double* f;
-    double* bw;
-    double* gain;
+    real* f;
+    real* bw;
+    real* gain;
     int nstages;
     SPEAK* pfil;
-    double* tmp;
-    double* mix;
+    real* tmp;
+    real* mix;
     CRITICAL_SECTION cs_update;
 } mpeak, *MPEAK;
 
-extern MPEAK create_mpeak (int run, int size, double* in, double* out, int rate, int npeaks, int* enable, double* f, double* bw, double* gain, int nstages);
+extern MPEAK create_mpeak (int run, int size, real* in, real* out, int rate, int npeaks, int* enable, real* f, real* bw, real* gain, int nstages);
 
 extern void destroy_mpeak (MPEAK a);
 
@@ -147,7 +147,7 @@ extern void flush_mpeak (MPEAK a);
 
 extern void xmpeak (MPEAK a);
 
-extern void setBuffers_mpeak (MPEAK a, double* in, double* out);
+extern void setBuffers_mpeak (MPEAK a, real* in, real* out);
 
 extern void setSamplerate_mpeak (MPEAK a, int rate);
 
@@ -169,18 +169,18 @@ typedef struct _phrot
     int reverse;
     int run;
     int size;
-    double* in;
-    double* out;
+    real* in;
+    real* out;
     int rate;
-    double fc;
+    real fc;
     int nstages;
     // normalized such that a0 = 1
-    double a1, b0, b1;
-    double *x0, *x1, *y0, *y1;
+    real a1, b0, b1;
+    real *x0, *x1, *y0, *y1;
     CRITICAL_SECTION cs_update;
 } phrot, *PHROT;
 
-extern PHROT create_phrot (int run, int size, double* in, double* out, int rate, double fc, int nstages);
+extern PHROT create_phrot (int run, int size, real* in, real* out, int rate, real fc, int nstages);
 
 extern void destroy_phrot (PHROT a);
 
@@ -188,7 +188,7 @@ extern void flush_phrot (PHROT a);
 
 extern void xphrot (PHROT a);
 
-extern void setBuffers_phrot (PHROT a, double* in, double* out);
+extern void setBuffers_phrot (PHROT a, real* in, real* out);
 
 extern void setSamplerate_phrot (PHROT a, int rate);
 
@@ -209,19 +209,19 @@ typedef struct _bqlp
 {
     int run;
     int size;
-    double* in;
-    double* out;
-    double rate;
-    double fc;
-    double Q;
-    double gain;
+    real* in;
+    real* out;
+    real rate;
+    real fc;
+    real Q;
+    real gain;
     int nstages;
-    double a0, a1, a2, b1, b2;
-    double* x0, * x1, * x2, * y0, * y1, * y2;
+    real a0, a1, a2, b1, b2;
+    real* x0, * x1, * x2, * y0, * y1, * y2;
     CRITICAL_SECTION cs_update;
 } bqlp, *BQLP;
 
-extern BQLP create_bqlp(int run, int size, double* in, double* out, double rate, double fc, double Q, double gain, int nstages);
+extern BQLP create_bqlp(int run, int size, real* in, real* out, real rate, real fc, real Q, real gain, int nstages);
 
 extern void destroy_bqlp(BQLP a);
 
@@ -229,7 +229,7 @@ extern void flush_bqlp(BQLP a);
 
 extern void xbqlp(BQLP a);
 
-extern void setBuffers_bqlp(BQLP a, double* in, double* out);
+extern void setBuffers_bqlp(BQLP a, real* in, real* out);
 
 extern void setSamplerate_bqlp(BQLP a, int rate);
 
@@ -246,7 +246,7 @@ extern void setSize_bqlp(BQLP a, int size);
 #ifndef _dbqlp_h
 #define _dbqlp_h
 
-extern BQLP create_dbqlp(int run, int size, double* in, double* out, double rate, double fc, double Q, double gain, int nstages);
+extern BQLP create_dbqlp(int run, int size, real* in, real* out, real rate, real fc, real Q, real gain, int nstages);
 
 extern void destroy_dbqlp(BQLP a);
 
@@ -254,7 +254,7 @@ extern void flush_dbqlp(BQLP a);
 
 extern void xdbqlp(BQLP a);
 
-extern void setBuffers_dbqlp(BQLP a, double* in, double* out);
+extern void setBuffers_dbqlp(BQLP a, real* in, real* out);
 
 extern void setSamplerate_dbqlp(BQLP a, int rate);
 
@@ -275,19 +275,19 @@ typedef struct _bqbp
 {
     int run;
     int size;
-    double* in;
-    double* out;
-    double rate;
-    double f_low;
-    double f_high;
-    double gain;
+    real* in;
+    real* out;
+    real rate;
+    real f_low;
+    real f_high;
+    real gain;
     int nstages;
-    double a0, a1, a2, b1, b2;
-    double* x0, * x1, * x2, * y0, * y1, * y2;
+    real a0, a1, a2, b1, b2;
+    real* x0, * x1, * x2, * y0, * y1, * y2;
     CRITICAL_SECTION cs_update;
 } bqbp, * BQBP;
 
-extern BQBP create_bqbp(int run, int size, double* in, double* out, double rate, double f_low, double f_high, double gain, int nstages);
+extern BQBP create_bqbp(int run, int size, real* in, real* out, real rate, real f_low, real f_high, real gain, int nstages);
 
 extern void destroy_bqbp(BQBP a);
 
@@ -295,7 +295,7 @@ extern void flush_bqbp(BQBP a);
 
 extern void xbqbp(BQBP a);
 
-extern void setBuffers_bqbp(BQBP a, double* in, double* out);
+extern void setBuffers_bqbp(BQBP a, real* in, real* out);
 
 extern void setSamplerate_bqbp(BQBP a, int rate);
 
@@ -312,7 +312,7 @@ extern void setSize_bqbp(BQBP a, int size);
 #ifndef _dbqbp_h
 #define _dbqbp_h
 
-extern BQBP create_dbqbp(int run, int size, double* in, double* out, double rate, double f_low, double f_high, double gain, int nstages);
+extern BQBP create_dbqbp(int run, int size, real* in, real* out, real rate, real f_low, real f_high, real gain, int nstages);
 
 extern void destroy_dbqbp(BQBP a);
 
@@ -320,7 +320,7 @@ extern void flush_dbqbp(BQBP a);
 
 extern void xdbqbp(BQBP a);
 
-extern void setBuffers_dbqbp(BQBP a, double* in, double* out);
+extern void setBuffers_dbqbp(BQBP a, real* in, real* out);
 
 extern void setSamplerate_dbqbp(BQBP a, int rate);
 
@@ -341,17 +341,17 @@ typedef struct _sphp
 {
     int run;
     int size;
-    double* in;
-    double* out;
-    double rate;
-    double fc;
+    real* in;
+    real* out;
+    real rate;
+    real fc;
     int nstages;
-    double a1, b0, b1;
-    double* x0, * x1, * y0, * y1;
+    real a1, b0, b1;
+    real* x0, * x1, * y0, * y1;
     CRITICAL_SECTION cs_update;
 } sphp, * SPHP;
 
-extern SPHP create_dsphp(int run, int size, double* in, double* out, double rate, double fc, int nstages);
+extern SPHP create_dsphp(int run, int size, real* in, real* out, real rate, real fc, int nstages);
 
 extern void destroy_dsphp(SPHP a);
 
@@ -359,7 +359,7 @@ extern void flush_dsphp(SPHP a);
 
 extern void xdsphp(SPHP a);
 
-extern void setBuffers_dsphp(SPHP a, double* in, double* out);
+extern void setBuffers_dsphp(SPHP a, real* in, real* out);
 
 extern void setSamplerate_dsphp(SPHP a, int rate);
 
@@ -376,7 +376,7 @@ extern void setSize_dsphp(SPHP a, int size);
 #ifndef _dphp_h
 #define _dphp_h
 
-extern SPHP create_sphp(int run, int size, double* in, double* out, double rate, double fc, int nstages);
+extern SPHP create_sphp(int run, int size, real* in, real* out, real rate, real fc, int nstages);
 
 extern void destroy_sphp(SPHP a);
 
@@ -384,7 +384,7 @@ extern void flush_sphp(SPHP a);
 
 extern void xsphp(SPHP a);
 
-extern void setBuffers_sphp(SPHP a, double* in, double* out);
+extern void setBuffers_sphp(SPHP a, real* in, real* out);
 
 extern void setSamplerate_sphp(SPHP a, int rate);
 
@@ -26,6 +26,7 @@ john.d.melton@googlemail.com
 */
 
 #include <errno.h>
+#include <sched.h>
 
 #include "linux_port.h"
 #include "comm.h"
@@ -38,10 +39,183 @@ john.d.melton@googlemail.com
 
 #if defined(linux) || defined(__APPLE__)
 
+//
+// QueueUserWorkItem() hands a work item to the system thread pool on Windows.
+// Here we emulate this with a fixed-size pool of worker threads, which is
+// started upon the first call. Work items are passed through a bounded
+// lock-free multi-producer/multi-consumer ring (D. Vyukov's algorithm), so
+// queuing an analyzer FFT costs a queue push plus a sem_post, instead of
+// creating and joining a new thread for each FFT as was done earlier.
+//
+// If the queue is full, or the pool could not be started, the work item is
+// executed synchronously by the caller (which is the old behaviour).
+//
+#define WQ_SIZE        256          // number of queue slots, must be a power of two
+#define WQ_MAX_WORKERS 8            // upper limit for the number of worker threads
+
+typedef DWORD (*WQ_FUNCTION)(void *);
+
+typedef struct _wq_slot {
+    volatile unsigned long seq;
+    WQ_FUNCTION function;
+    void *context;
+    uint64_t stamp;                 // time of enqueue (nanoseconds)
+} WQ_SLOT;
+
+static WQ_SLOT wq_slot[WQ_SIZE];
+
+//
+// enqueue and dequeue positions on separate cache lines
+//
+static volatile unsigned long wq_enq __attribute__((aligned(64))) = 0;
+static volatile unsigned long wq_deq __attribute__((aligned(64))) = 0;
+
+static sem_t *wq_sem = NULL;
+static int wq_workers = 0;
+static pthread_once_t wq_once = PTHREAD_ONCE_INIT;
+
+//
+// statistics, see WorkQueueStatistics(). The counters and the latency sum
+// are 64 bits wide since a long would overflow within hours on 32-bit systems.
+//
+static volatile uint64_t wq_jobs = 0;       // number of jobs executed by the pool
+static volatile uint64_t wq_inline = 0;     // number of jobs executed by the caller (queue full)
+static volatile long wq_max_depth = 0;      // highest queue depth seen
+static volatile uint64_t wq_lat_sum = 0;    // sum of queue latencies (microseconds)
+static volatile long wq_lat_max = 0;        // largest queue latency (microseconds)
+
+static uint64_t wq_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void wq_update_max(volatile long *max, long val) {
+    long old = __atomic_load_n(max, __ATOMIC_RELAXED);
+    while (val > old) {
+        if (__atomic_compare_exchange_n(max, &old, val, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+    }
+}
+
+static int wq_push(WQ_FUNCTION function, void *context) {
+    unsigned long pos = __atomic_load_n(&wq_enq, __ATOMIC_RELAXED);
+    for (;;) {
+        WQ_SLOT *slot = &wq_slot[pos & (WQ_SIZE - 1)];
+        long diff = (long)__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (long)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&wq_enq, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot->function = function;
+                slot->context = context;
+                slot->stamp = wq_now();
+                __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;   // queue full
+        } else {
+            pos = __atomic_load_n(&wq_enq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int wq_pop(WQ_FUNCTION *function, void **context, uint64_t *stamp) {
+    unsigned long pos = __atomic_load_n(&wq_deq, __ATOMIC_RELAXED);
+    for (;;) {
+        WQ_SLOT *slot = &wq_slot[pos & (WQ_SIZE - 1)];
+        long diff = (long)__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (long)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&wq_deq, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *function = slot->function;
+                *context = slot->context;
+                *stamp = slot->stamp;
+                __atomic_store_n(&slot->seq, pos + WQ_SIZE, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;   // queue empty
+        } else {
+            pos = __atomic_load_n(&wq_deq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void *wq_worker(void *arg) {
+    WQ_FUNCTION function;
+    void *context;
+    uint64_t stamp;
+#ifdef __APPLE__
+    (void) pthread_setname_np("WDSP pool");
+#else
+    (void) pthread_setname_np(pthread_self(), "WDSP pool");
+#endif
+    for (;;) {
+        sem_wait(wq_sem);
+        //
+        // Each semaphore count corresponds to exactly one queued item, but
+        // the item may not yet be visible if a producer has been pre-empted
+        // between claiming and publishing its slot.
+        //
+        while (!wq_pop(&function, &context, &stamp)) {
+            sched_yield();
+        }
+        long lat = (long)((wq_now() - stamp) / 1000);
+        __atomic_add_fetch(&wq_lat_sum, (uint64_t)lat, __ATOMIC_RELAXED);
+        wq_update_max(&wq_lat_max, lat);
+        (*function)(context);
+        __atomic_add_fetch(&wq_jobs, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+static void wq_init() {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    int n = (ncpu < 1) ? 1 : (ncpu > WQ_MAX_WORKERS) ? WQ_MAX_WORKERS : (int) ncpu;
+
+    for (int i = 0; i < WQ_SIZE; i++) {
+        wq_slot[i].seq = i;
+    }
+    wq_sem = LinuxCreateSemaphore(0, 0, 0, 0);
+    if (wq_sem == NULL || wq_sem == SEM_FAILED) {
+        wq_sem = NULL;
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        pthread_t t;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&t, &attr, wq_worker, NULL) == 0) {
+            wq_workers++;
+        }
+        pthread_attr_destroy(&attr);
+    }
+}
+
 void QueueUserWorkItem(void *function,void *context,int flags) {
-    pthread_t t;
-    pthread_create(&t, NULL, function, context);
-    pthread_join(t, NULL);
+    pthread_once(&wq_once, wq_init);
+
+    if (wq_workers > 0 && wq_push((WQ_FUNCTION) function, context)) {
+        long depth = (long)(__atomic_load_n(&wq_enq, __ATOMIC_RELAXED) - __atomic_load_n(&wq_deq, __ATOMIC_RELAXED));
+        wq_update_max(&wq_max_depth, depth);
+        sem_post(wq_sem);
+    } else {
+        __atomic_add_fetch(&wq_inline, 1, __ATOMIC_RELAXED);
+        ((WQ_FUNCTION) function)(context);
+    }
+}
+
+void WorkQueueStatistics(int *workers, long *depth, long *max_depth, long long *jobs, long long *overflows,
+                         double *avg_latency, double *max_latency) {
+    uint64_t n = __atomic_load_n(&wq_jobs, __ATOMIC_RELAXED);
+    long d = (long)(__atomic_load_n(&wq_enq, __ATOMIC_RELAXED) - __atomic_load_n(&wq_deq, __ATOMIC_RELAXED));
+    *workers = wq_workers;
+    *depth = (d < 0) ? 0 : d;
+    *max_depth = __atomic_load_n(&wq_max_depth, __ATOMIC_RELAXED);
+    *jobs = (long long) n;
+    *overflows = (long long) __atomic_load_n(&wq_inline, __ATOMIC_RELAXED);
+    // latencies are reported in milli-seconds
+    *avg_latency = (n > 0) ? 0.001 * (double) __atomic_load_n(&wq_lat_sum, __ATOMIC_RELAXED) / (double) n : 0.0;
+    *max_latency = 0.001 * (double) __atomic_load_n(&wq_lat_max, __ATOMIC_RELAXED);
 }
 
 void InitializeCriticalSectionAndSpinCount(pthread_mutex_t *mutex,int count) {
@@ -244,6 +418,20 @@ if (sem_destroy((sem_t *)hObject) < 0) {
 return;
 }
 
+//
+// posix_memalign() needs an alignment that is a power of two and a
+// multiple of sizeof(void *), memory obtained from it is released with free()
+//
+void *linux_aligned_malloc(size_t size, size_t alignment) {
+  void *p;
+
+  if (alignment < sizeof(void *)) { alignment = sizeof(void *); }
+
+  if (posix_memalign(&p, alignment, size) != 0) { return NULL; }
+
+  return p;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //
 // MALLOC debug facility.
@@ -273,7 +461,7 @@ return;
 //
 // P.S.3: The standard definitions in linux_port.h are
 //
-//        __aligned_malloc(a,b) ==>   malloc(a)
+//        __aligned_malloc(a,b) ==>   linux_aligned_malloc(a,b)
 //        __aligned_free(a)     ==>   free(a)
 //
 //        and with these, "MALLOC debug" code is not used.
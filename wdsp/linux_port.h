@@ -61,12 +61,13 @@ john.d.melton@googlemail.com
 #define __stdcall
 #define __forceinline
 
-#define _aligned_malloc(x,y) malloc(x)
+#define _aligned_malloc(x,y) linux_aligned_malloc(x,y)
 #define _aligned_free(x)     free(x)
 // Activate these for malloc debug
 //#define _aligned_malloc(x,y) my_malloc(x);
 //#define _aligned_free(x) my_free(x);
 
+void *linux_aligned_malloc(size_t size, size_t alignment);
 void *my_malloc(size_t size);
 void my_free(void *p);
 
@@ -87,6 +88,9 @@ void my_free(void *p);
 
 void QueueUserWorkItem(void *function,void *context,int flags);
 
+void WorkQueueStatistics(int *workers, long *depth, long *max_depth, long long *jobs, long long *overflows,
+                         double *avg_latency, double *max_latency);
+
 void InitializeCriticalSectionAndSpinCount(pthread_mutex_t *mutex,int count);
 
 void EnterCriticalSection(pthread_mutex_t *mutex);
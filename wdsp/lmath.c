@@ -26,11 +26,11 @@ warren@wpratt.com
 
 #include "comm.h"
 
-void dR (int n, double* r, double* y, double* z)
+void dR (int n, real* r, real* y, real* z)
 {
     int i, j, k;
-    double alpha, beta, gamma;
-    memset (z, 0, (n - 1) * sizeof (double));   // work space
+    real alpha, beta, gamma;
+    memset (z, 0, (n - 1) * sizeof (real));     // work space
     y[0] = -r[1];
     alpha = -r[1];
     beta = 1.0;
@@ -43,24 +43,24 @@ void dR (int n, double* r, double* y, double* z)
         alpha = - (r[k + 2] + gamma) / beta;
         for (i = 0, j = k; i <= k; i++, j--)
             z[i] = y[i] + alpha * y[j];
-        memcpy (y, z, (k + 1) * sizeof (double));
+        memcpy (y, z, (k + 1) * sizeof (real));
         y[k + 1] = alpha;
     }
 }
 
 void trI (
     int n,
-    double* r,
-    double* B,
-    double* y,
-    double* v,
-    double* dR_z
+    real* r,
+    real* B,
+    real* y,
+    real* v,
+    real* dR_z
     )
 {
     int i, j, ni, nj;
-    double gamma, t, scale, b;
-    memset (y, 0, (n - 1) * sizeof (double));   // work space
-    memset (v, 0, (n - 1) * sizeof (double));   // work space
+    real gamma, t, scale, b;
+    memset (y, 0, (n - 1) * sizeof (real));     // work space
+    memset (v, 0, (n - 1) * sizeof (real));     // work space
     scale = 1.0 / r[0];
     for (i = 0; i < n; i++)
         r[i] *= scale;
@@ -90,12 +90,12 @@ void trI (
         }
 }
 
-void asolve(int xsize, int asize, double* x, double* a, double* r, double* z)
+void asolve(int xsize, int asize, real* x, real* a, real* r, real* z)
 {
     int i, j, k;
-    double beta, alpha, t;
-    memset(r, 0, (asize + 1) * sizeof(double));     // work space
-    memset(z, 0, (asize + 1) * sizeof(double));     // work space
+    real beta, alpha, t;
+    memset(r, 0, (asize + 1) * sizeof(real));       // work space
+    memset(z, 0, (asize + 1) * sizeof(real));       // work space
     for (i = 0; i <= asize; i++)
     {
         for (j = 0; j < xsize; j++)
@@ -124,10 +124,10 @@ void asolve(int xsize, int asize, double* x, double* a, double* r, double* z)
     }
 }
 
-void median (int n, double* a, double* med)
+void median (int n, real* a, real* med)
 {
     int S0, S1, i, j, m, k;
-    double x, t;
+    real x, t;
     S0 = 0;
     S1 = n - 1;
     k = n / 2;
@@ -187,38 +187,38 @@ BLDR create_builder(int points, int ints)
 {
     // for the create function, 'points' and 'ints' are the MAXIMUM values that will be encountered
     BLDR a = (BLDR)malloc0 (sizeof(bldr));
-    a->catxy = (double*)malloc0(2 * points * sizeof(double));
-    a->sx    = (double*)malloc0(    points * sizeof(double));
-    a->sy    = (double*)malloc0(    points * sizeof(double));
-    a->h     = (double*)malloc0(    ints   * sizeof(double));
+    a->catxy = (real*)malloc0(2 * points * sizeof(real));
+    a->sx    = (real*)malloc0(    points * sizeof(real));
+    a->sy    = (real*)malloc0(    points * sizeof(real));
+    a->h     = (real*)malloc0(    ints   * sizeof(real));
     a->p     = (int*)   malloc0(    ints   * sizeof(int));
     a->np    = (int*)   malloc0(    ints   * sizeof(int));
-    a->taa   = (double*)malloc0(    ints   * sizeof(double));
-    a->tab   = (double*)malloc0(    ints   * sizeof(double));
-    a->tag   = (double*)malloc0(    ints   * sizeof(double));
-    a->tad   = (double*)malloc0(    ints   * sizeof(double));
-    a->tbb   = (double*)malloc0(    ints   * sizeof(double));
-    a->tbg   = (double*)malloc0(    ints   * sizeof(double));
-    a->tbd   = (double*)malloc0(    ints   * sizeof(double));
-    a->tgg   = (double*)malloc0(    ints   * sizeof(double));
-    a->tgd   = (double*)malloc0(    ints   * sizeof(double));
-    a->tdd   = (double*)malloc0(    ints   * sizeof(double));
+    a->taa   = (real*)malloc0(    ints   * sizeof(real));
+    a->tab   = (real*)malloc0(    ints   * sizeof(real));
+    a->tag   = (real*)malloc0(    ints   * sizeof(real));
+    a->tad   = (real*)malloc0(    ints   * sizeof(real));
+    a->tbb   = (real*)malloc0(    ints   * sizeof(real));
+    a->tbg   = (real*)malloc0(    ints   * sizeof(real));
+    a->tbd   = (real*)malloc0(    ints   * sizeof(real));
+    a->tgg   = (real*)malloc0(    ints   * sizeof(real));
+    a->tgd   = (real*)malloc0(    ints   * sizeof(real));
+    a->tdd   = (real*)malloc0(    ints   * sizeof(real));
     int nsize = 3 * ints + 1;
     int intp1 = ints + 1;
     int intm1 = ints - 1;
-    a->A     = (double*)malloc0(intp1 * intp1 * sizeof(double));
-    a->B     = (double*)malloc0(intp1 * intp1 * sizeof(double));
-    a->C     = (double*)malloc0(intm1 * intp1 * sizeof(double));
-    a->D     = (double*)malloc0(intp1         * sizeof(double));
-    a->E     = (double*)malloc0(intp1 * intp1 * sizeof(double));
-    a->F     = (double*)malloc0(intm1 * intp1 * sizeof(double));
-    a->G     = (double*)malloc0(intp1         * sizeof(double));
-    a->MAT   = (double*)malloc0(nsize * nsize * sizeof(double));
-    a->RHS   = (double*)malloc0(nsize         * sizeof(double));
-    a->SLN   = (double*)malloc0(nsize         * sizeof(double));
-    a->z     = (double*)malloc0(intp1         * sizeof(double));
-    a->zp    = (double*)malloc0(intp1         * sizeof(double));
-    a->wrk   = (double*)malloc0(nsize         * sizeof(double));
+    a->A     = (real*)malloc0(intp1 * intp1 * sizeof(real));
+    a->B     = (real*)malloc0(intp1 * intp1 * sizeof(real));
+    a->C     = (real*)malloc0(intm1 * intp1 * sizeof(real));
+    a->D     = (real*)malloc0(intp1         * sizeof(real));
+    a->E     = (real*)malloc0(intp1 * intp1 * sizeof(real));
+    a->F     = (real*)malloc0(intm1 * intp1 * sizeof(real));
+    a->G     = (real*)malloc0(intp1         * sizeof(real));
+    a->MAT   = (real*)malloc0(nsize * nsize * sizeof(real));
+    a->RHS   = (real*)malloc0(nsize         * sizeof(real));
+    a->SLN   = (real*)malloc0(nsize         * sizeof(real));
+    a->z     = (real*)malloc0(intp1         * sizeof(real));
+    a->zp    = (real*)malloc0(intp1         * sizeof(real));
+    a->wrk   = (real*)malloc0(nsize         * sizeof(real));
     a->ipiv  = (int*)   malloc0(nsize         * sizeof(int));
     return a;
 }
@@ -265,56 +265,56 @@ void destroy_builder(BLDR a)
 
 void flush_builder(BLDR a, int points, int ints)
 {
-    memset(a->catxy, 0, 2 * points * sizeof(double));
-    memset(a->sx,    0, points * sizeof(double));
-    memset(a->sy,    0, points * sizeof(double));
-    memset(a->h,     0, ints * sizeof(double));
+    memset(a->catxy, 0, 2 * points * sizeof(real));
+    memset(a->sx,    0, points * sizeof(real));
+    memset(a->sy,    0, points * sizeof(real));
+    memset(a->h,     0, ints * sizeof(real));
     memset(a->p,     0, ints * sizeof(int));
     memset(a->np,    0, ints * sizeof(int));
-    memset(a->taa,   0, ints * sizeof(double));
-    memset(a->tab,   0, ints * sizeof(double));
-    memset(a->tag,   0, ints * sizeof(double));
-    memset(a->tad,   0, ints * sizeof(double));
-    memset(a->tbb,   0, ints * sizeof(double));
-    memset(a->tbg,   0, ints * sizeof(double));
-    memset(a->tbd,   0, ints * sizeof(double));
-    memset(a->tgg,   0, ints * sizeof(double));
-    memset(a->tgd,   0, ints * sizeof(double));
-    memset(a->tdd,   0, ints * sizeof(double));
+    memset(a->taa,   0, ints * sizeof(real));
+    memset(a->tab,   0, ints * sizeof(real));
+    memset(a->tag,   0, ints * sizeof(real));
+    memset(a->tad,   0, ints * sizeof(real));
+    memset(a->tbb,   0, ints * sizeof(real));
+    memset(a->tbg,   0, ints * sizeof(real));
+    memset(a->tbd,   0, ints * sizeof(real));
+    memset(a->tgg,   0, ints * sizeof(real));
+    memset(a->tgd,   0, ints * sizeof(real));
+    memset(a->tdd,   0, ints * sizeof(real));
     int nsize = 3 * ints + 1;
     int intp1 = ints + 1;
     int intm1 = ints - 1;
-    memset(a->A,     0, intp1 * intp1 * sizeof(double));
-    memset(a->B,     0, intp1 * intp1 * sizeof(double));
-    memset(a->C,     0, intm1 * intp1 * sizeof(double));
-    memset(a->D,     0, intp1         * sizeof(double));
-    memset(a->E,     0, intp1 * intp1 * sizeof(double));
-    memset(a->F,     0, intm1 * intp1 * sizeof(double));
-    memset(a->G,     0, intp1         * sizeof(double));
-    memset(a->MAT,   0, nsize * nsize * sizeof(double));
-    memset(a->RHS,   0, nsize * sizeof(double));
-    memset(a->SLN,   0, nsize * sizeof(double));
-    memset(a->z,     0, intp1 * sizeof(double));
-    memset(a->zp,    0, intp1 * sizeof(double));
-    memset(a->wrk,   0, nsize * sizeof(double));
+    memset(a->A,     0, intp1 * intp1 * sizeof(real));
+    memset(a->B,     0, intp1 * intp1 * sizeof(real));
+    memset(a->C,     0, intm1 * intp1 * sizeof(real));
+    memset(a->D,     0, intp1         * sizeof(real));
+    memset(a->E,     0, intp1 * intp1 * sizeof(real));
+    memset(a->F,     0, intm1 * intp1 * sizeof(real));
+    memset(a->G,     0, intp1         * sizeof(real));
+    memset(a->MAT,   0, nsize * nsize * sizeof(real));
+    memset(a->RHS,   0, nsize * sizeof(real));
+    memset(a->SLN,   0, nsize * sizeof(real));
+    memset(a->z,     0, intp1 * sizeof(real));
+    memset(a->zp,    0, intp1 * sizeof(real));
+    memset(a->wrk,   0, nsize * sizeof(real));
     memset(a->ipiv,  0, nsize * sizeof(int));
 }
 
 int fcompare(const void* a, const void* b)
 {
-    if (*(double*)a < *(double*)b)
+    if (*(real*)a < *(real*)b)
         return -1;
-    else if (*(double*)a == *(double*)b)
+    else if (*(real*)a == *(real*)b)
         return 0;
     else
         return 1;
 }
 
-void decomp(int n, double* a, int* piv, int* info, double* wrk)
+void decomp(int n, real* a, int* piv, int* info, real* wrk)
 {
     int i, j, k;
     int t_piv;
-    double m_row, mt_row, m_col, mt_col;
+    real m_row, mt_row, m_col, mt_col;
     *info = 0;
     for (i = 0; i < n; i++)
     {
@@ -369,10 +369,10 @@ cleanup:
     return;
 }
 
-void dsolve(int n, double* a, int* piv, double* b, double* x)
+void dsolve(int n, real* a, int* piv, real* b, real* x)
 {
     int j, k;
-    double sum;
+    real sum;
 
     for (k = 0; k < n; k++)
     {
@@ -391,7 +391,7 @@ void dsolve(int n, double* a, int* piv, double* b, double* x)
     }
 }
 
-void cull(int* n, int ints, double* x, double* t, double ptol)
+void cull(int* n, int ints, real* x, real* t, real ptol)
 {
     int k = 0;
     int i = *n;
@@ -408,9 +408,9 @@ void cull(int* n, int ints, double* x, double* t, double ptol)
     *n -= k;
 }
 
-void xbuilder(BLDR a, int points, double* x, double* y, int ints, double* t, int* info, double* c, double ptol)
+void xbuilder(BLDR a, int points, real* x, real* y, int ints, real* t, int* info, real* c, real ptol)
 {
-    double u, v, alpha, beta, gamma, delta;
+    real u, v, alpha, beta, gamma, delta;
     int nsize = 3 * ints + 1;
     int intp1 = ints + 1;
     int intm1 = ints - 1;
@@ -422,7 +422,7 @@ void xbuilder(BLDR a, int points, double* x, double* y, int ints, double* t, int
         a->catxy[2 * i + 0] = x[i];
         a->catxy[2 * i + 1] = y[i];
     }
-    qsort(a->catxy, points, 2 * sizeof(double), fcompare);
+    qsort(a->catxy, points, 2 * sizeof(real), fcompare);
     for (i = 0; i < points; i++)
     {
         a->sx[i] = a->catxy[2 * i + 0];
@@ -553,3 +553,141 @@ void xbuilder(BLDR a, int points, double* x, double* y, int ints, double* t, int
 cleanup:
     return;
 }
+
+/********************************************************************************************************
+*                                                                                                       *
+*                                           LMS Kernels                                                 *
+*                                                                                                       *
+********************************************************************************************************/
+
+// Filter (dot product), energy and weight update for the LMS filters of
+// ANR and ANF. These operate on a contiguous (linearized) section of the
+// delay line, called through simd_lms_dot and simd_lms_update.
+
+real lms_dot_scalar (const real* w, const real* x, int n)
+{
+    int j;
+    real y = 0.0;
+    for (j = 0; j < n; j++)
+        y += w[j] * x[j];
+    return y;
+}
+
+void lms_update_scalar (real* w, const real* x, int n, real c0, real c1)
+{
+    int j;
+    for (j = 0; j < n; j++)
+        w[j] = c0 * w[j] + c1 * x[j];
+}
+
+#ifdef WDSP_AVX2
+#include <immintrin.h>
+
+__attribute__((target("avx2,fma")))
+real lms_dot_avx2 (const real* w, const real* x, int n)
+{
+    int j = 0;
+#ifdef WDSP_FLOAT
+    __m256 s0 = _mm256_setzero_ps ();
+    __m256 s1 = _mm256_setzero_ps ();
+    __m128 s;
+    for (; j + 16 <= n; j += 16)
+    {
+        s0 = _mm256_fmadd_ps (_mm256_loadu_ps (w + j + 0), _mm256_loadu_ps (x + j + 0), s0);
+        s1 = _mm256_fmadd_ps (_mm256_loadu_ps (w + j + 8), _mm256_loadu_ps (x + j + 8), s1);
+    }
+    s0 = _mm256_add_ps (s0, s1);
+    s  = _mm_add_ps (_mm256_castps256_ps128 (s0), _mm256_extractf128_ps (s0, 1));
+    s  = _mm_add_ps (s, _mm_movehl_ps (s, s));
+    s  = _mm_add_ss (s, _mm_shuffle_ps (s, s, 0x55));
+    return _mm_cvtss_f32 (s) + lms_dot_scalar (w + j, x + j, n - j);
+#else
+    __m256d s0 = _mm256_setzero_pd ();
+    __m256d s1 = _mm256_setzero_pd ();
+    __m128d s;
+    for (; j + 8 <= n; j += 8)
+    {
+        s0 = _mm256_fmadd_pd (_mm256_loadu_pd (w + j + 0), _mm256_loadu_pd (x + j + 0), s0);
+        s1 = _mm256_fmadd_pd (_mm256_loadu_pd (w + j + 4), _mm256_loadu_pd (x + j + 4), s1);
+    }
+    s0 = _mm256_add_pd (s0, s1);
+    s  = _mm_add_pd (_mm256_castpd256_pd128 (s0), _mm256_extractf128_pd (s0, 1));
+    s  = _mm_add_sd (s, _mm_unpackhi_pd (s, s));
+    return _mm_cvtsd_f64 (s) + lms_dot_scalar (w + j, x + j, n - j);
+#endif
+}
+
+__attribute__((target("avx2,fma")))
+void lms_update_avx2 (real* w, const real* x, int n, real c0, real c1)
+{
+    int j = 0;
+#ifdef WDSP_FLOAT
+    __m256 v0 = _mm256_set1_ps (c0);
+    __m256 v1 = _mm256_set1_ps (c1);
+    for (; j + 8 <= n; j += 8)
+        _mm256_storeu_ps (w + j, _mm256_fmadd_ps (v0, _mm256_loadu_ps (w + j), _mm256_mul_ps (v1, _mm256_loadu_ps (x + j))));
+#else
+    __m256d v0 = _mm256_set1_pd (c0);
+    __m256d v1 = _mm256_set1_pd (c1);
+    for (; j + 4 <= n; j += 4)
+        _mm256_storeu_pd (w + j, _mm256_fmadd_pd (v0, _mm256_loadu_pd (w + j), _mm256_mul_pd (v1, _mm256_loadu_pd (x + j))));
+#endif
+    lms_update_scalar (w + j, x + j, n - j, c0, c1);
+}
+#endif
+
+#ifdef WDSP_NEON
+#include <arm_neon.h>
+
+real lms_dot_neon (const real* w, const real* x, int n)
+{
+    int j = 0;
+#ifdef WDSP_FLOAT
+    float32x4_t s0 = vdupq_n_f32 (0.0f);
+    float32x4_t s1 = vdupq_n_f32 (0.0f);
+    for (; j + 8 <= n; j += 8)
+    {
+        s0 = vfmaq_f32 (s0, vld1q_f32 (w + j + 0), vld1q_f32 (x + j + 0));
+        s1 = vfmaq_f32 (s1, vld1q_f32 (w + j + 4), vld1q_f32 (x + j + 4));
+    }
+    return vaddvq_f32 (vaddq_f32 (s0, s1)) + lms_dot_scalar (w + j, x + j, n - j);
+#else
+    float64x2_t s0 = vdupq_n_f64 (0.0);
+    float64x2_t s1 = vdupq_n_f64 (0.0);
+    for (; j + 4 <= n; j += 4)
+    {
+        s0 = vfmaq_f64 (s0, vld1q_f64 (w + j + 0), vld1q_f64 (x + j + 0));
+        s1 = vfmaq_f64 (s1, vld1q_f64 (w + j + 2), vld1q_f64 (x + j + 2));
+    }
+    return vaddvq_f64 (vaddq_f64 (s0, s1)) + lms_dot_scalar (w + j, x + j, n - j);
+#endif
+}
+
+void lms_update_neon (real* w, const real* x, int n, real c0, real c1)
+{
+    int j = 0;
+#ifdef WDSP_FLOAT
+    for (; j + 4 <= n; j += 4)
+        vst1q_f32 (w + j, vfmaq_n_f32 (vmulq_n_f32 (vld1q_f32 (x + j), c1), vld1q_f32 (w + j), c0));
+#else
+    for (; j + 2 <= n; j += 2)
+        vst1q_f64 (w + j, vfmaq_n_f64 (vmulq_n_f64 (vld1q_f64 (x + j), c1), vld1q_f64 (w + j), c0));
+#endif
+    lms_update_scalar (w + j, x + j, n - j, c0, c1);
+}
+#endif
+
+real lms_dot (const real* w, const real* x, int n)
+{
+    return simd_lms_dot (w, x, n);
+}
+
+real lms_energy (const real* x, int n)
+{
+    return simd_lms_dot (x, x, n);
+}
+
+void lms_update (real* w, const real* x, int n, real c0, real c1)
+{
+    simd_lms_update (w, x, n, c0, c1);
+}
@@ -24,55 +24,63 @@ warren@wpratt.com
 
 */
 
-extern void dR (int n, double* r, double* y, double* z);
+extern void dR (int n, real* r, real* y, real* z);
 
 extern void trI (
     int n,
-    double* r,
-    double* B,
-    double* y,
-    double* v,
-    double* dR_z
+    real* r,
+    real* B,
+    real* y,
+    real* v,
+    real* dR_z
     );
 
-extern void asolve(int xsize, int asize, double* x, double* a, double* r, double* z);
+extern void asolve(int xsize, int asize, real* x, real* a, real* r, real* z);
 
-extern void median(int n, double* a, double* med);
+extern void median(int n, real* a, real* med);
+
+// LMS kernels (ANR, ANF)
+
+extern real lms_dot (const real* w, const real* x, int n);
+
+extern real lms_energy (const real* x, int n);
+
+extern void lms_update (real* w, const real* x, int n, real c0, real c1);
 
 #ifndef _bldr_h
 #define _bldr_h
 
 typedef struct _bldr
 {
-    double* catxy;
-    double* sx;
-    double* sy;
-    double* h;
+    real* catxy;
+    real* sx;
+    real* sy;
+    real* h;
     int* p;
     int* np;
-    double* taa;
-    double* tab;
-    double* tag;
-    double* tad;
-    double* tbb;
-    double* tbg;
-    double* tbd;
-    double* tgg;
-    double* tgd;
-    double* tdd;
-    double* A;
-    double* B;
-    double* C;
-    double* D;
-    double* E;
-    double* F;
-    double* G;
-    double* MAT;
-    double* RHS;
-    double* SLN;
-    double* z;
-    double* zp;
-    double* wrk;
+    real* taa;
+    real* tab;
+    real* tag;
+    real* tad;
+    real* tbb;
+    real* tbg;
+    real* tbd;
+    real* tgg;
+    real* tgd;
+    real* tdd;
+    real* A;
+    real* B;
+    real* C;
+    real* D;
+    real* E;
+    real* F;
+    real* G;
+    real* MAT;
+    real* RHS;
+    real* SLN;
+    real* z;
+    real* zp;
+    real* wrk;
     int* ipiv;
 } bldr, *BLDR;
 
@@ -82,12 +90,12 @@ extern void destroy_builder(BLDR a);
 
 extern void flush_builder(BLDR a, int points, int ints);
 
-extern void xbuilder(BLDR a, int points, double* x, double* y, int ints, double* t, int* info, double* c, double ptol);
+extern void xbuilder(BLDR a, int points, real* x, real* y, int ints, real* t, int* info, real* c, real ptol);
 
 extern int fcompare(const void* a, const void* b);
 
-extern void decomp(int n, double* a, int* piv, int* info, double* wrk);
+extern void decomp(int n, real* a, int* piv, int* info, real* wrk);
 
-extern void dsolve(int n, double* a, int* piv, double* b, double* x);
+extern void dsolve(int n, real* a, int* piv, real* b, real* x);
 
 #endif
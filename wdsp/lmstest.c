@@ -0,0 +1,222 @@
+/*  lmstest.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+*/
+
+// Tolerance check of xanr() and xanf() (mirrored delay line, running tap
+// energy, vector kernels from lmath.c) against the original LMS loops, which
+// are copied below as the reference and always run in double precision.
+// "make lmstest" builds and runs it against libwdsp.a.
+//
+// For each (taps, delay) pair the same signal (tones plus noise) is fed
+// through both, and the SNR of the output relative to the reference is
+// printed.  The program fails if it is below TOL_DB, or if create_anr()
+// and create_anf() do not clamp taps and delay to the delay line.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "comm.h"
+
+#define BSIZE       1024
+#define NBLOCKS     500
+
+#ifdef WDSP_FLOAT
+#define TOL_DB      60.0
+#else
+#define TOL_DB      120.0
+#endif
+
+typedef struct _ref_lms
+{
+    int n_taps;
+    int delay;
+    int mask;
+    int in_idx;
+    double two_mu;
+    double gamma;
+    double lidx;
+    double lidx_min;
+    double lidx_max;
+    double ngamma;
+    double den_mult;
+    double lincr;
+    double ldecr;
+    double d[ANR_DLINE_SIZE];
+    double w[ANR_DLINE_SIZE];
+} ref_lms;
+
+// the original xanr() (notch == 0) and xanf() (notch == 1)
+static void xref (ref_lms* a, int notch, const double* in, double* out)
+{
+    int i, j, idx;
+    double c0, c1;
+    double y, error, sigma, inv_sigp;
+    double nel, nev;
+    for (i = 0; i < BSIZE; i++)
+    {
+        a->d[a->in_idx] = in[2 * i + 0];
+
+        y = 0;
+        sigma = 0;
+
+        for (j = 0; j < a->n_taps; j++)
+        {
+            idx = (a->in_idx + j + a->delay) & a->mask;
+            y += a->w[j] * a->d[idx];
+            sigma += a->d[idx] * a->d[idx];
+        }
+        inv_sigp = 1.0 / (sigma + 1e-10);
+        error = a->d[a->in_idx] - y;
+
+        out[2 * i + 0] = notch ? error : y;
+        out[2 * i + 1] = 0.0;
+
+        if((nel = error * (1.0 - a->two_mu * sigma * inv_sigp)) < 0.0) nel = -nel;
+        if((nev = a->d[a->in_idx] - (1.0 - a->two_mu * a->ngamma) * y - a->two_mu * error * sigma * inv_sigp) < 0.0) nev = -nev;
+        if (nev < nel)
+        {
+            if ((a->lidx += a->lincr) > a->lidx_max) a->lidx = a->lidx_max;
+        }
+        else
+        {
+            if ((a->lidx -= a->ldecr) < a->lidx_min) a->lidx = a->lidx_min;
+        }
+        a->ngamma = a->gamma * (a->lidx * a->lidx) * (a->lidx * a->lidx) * a->den_mult;
+
+        c0 = 1.0 - a->two_mu * a->ngamma;
+        c1 = a->two_mu * error * inv_sigp;
+
+        for (j = 0; j < a->n_taps; j++)
+        {
+            idx = (a->in_idx + j + a->delay) & a->mask;
+            a->w[j] = c0 * a->w[j] + c1 * a->d[idx];
+        }
+        a->in_idx = (a->in_idx + a->mask) & a->mask;
+    }
+}
+
+static unsigned int seed;
+
+static double noise (void)
+{
+    // uniform in [-1, 1)
+    seed = seed * 1664525u + 1013904223u;
+    return (double)(int)seed / 2147483648.0;
+}
+
+// parameters as in create_rxa(), gain and leakage as set by the GUI
+static double check (int notch, int taps, int delay)
+{
+    static real in[2 * BSIZE], out[2 * BSIZE];
+    static double rin[2 * BSIZE], rout[2 * BSIZE];
+    double sig = 0.0, err = 0.0;
+    ref_lms* r = (ref_lms *)calloc (1, sizeof (ref_lms));
+    ANR anr = NULL;
+    ANF anf = NULL;
+    long n = 0;
+    int block, i;
+
+    r->n_taps = taps;
+    r->delay = delay;
+    r->mask = ANR_DLINE_SIZE - 1;
+    r->two_mu = 16e-4;
+    r->gamma = 10e-7;
+    r->lidx = notch ? 1.0 : 120.0;
+    r->lidx_min = notch ? 0.0 : 120.0;
+    r->lidx_max = 200.0;
+    r->ngamma = notch ? 6.25e-12 : 0.001;
+    r->den_mult = 6.25e-10;
+    r->lincr = 1.0;
+    r->ldecr = 3.0;
+    if (notch)
+        anf = create_anf (1, 0, BSIZE, in, out, ANF_DLINE_SIZE, taps, delay, r->two_mu, r->gamma,
+            r->lidx, r->lidx_min, r->lidx_max, r->ngamma, r->den_mult, r->lincr, r->ldecr);
+    else
+        anr = create_anr (1, 0, BSIZE, in, out, ANR_DLINE_SIZE, taps, delay, r->two_mu, r->gamma,
+            r->lidx, r->lidx_min, r->lidx_max, r->ngamma, r->den_mult, r->lincr, r->ldecr);
+
+    seed = 4711;
+    for (block = 0; block < NBLOCKS; block++)
+    {
+        for (i = 0; i < BSIZE; i++, n++)
+        {
+            double t = (double)n / 48000.0;
+            rin[2 * i + 0] = 0.1 * sin (2.0 * M_PI * 700.0 * t) + 0.05 * sin (2.0 * M_PI * 1900.0 * t)
+                           + 0.02 * noise ();
+            rin[2 * i + 1] = 0.0;
+            in[2 * i + 0] = (real)rin[2 * i + 0];
+            in[2 * i + 1] = (real)rin[2 * i + 1];
+        }
+        xref (r, notch, rin, rout);
+        if (notch)
+            xanf (anf, 0);
+        else
+            xanr (anr, 0);
+        for (i = 0; i < BSIZE; i++)
+        {
+            sig += rout[2 * i] * rout[2 * i];
+            err += (rout[2 * i] - out[2 * i]) * (rout[2 * i] - out[2 * i]);
+        }
+    }
+    if (notch)
+        destroy_anf (anf);
+    else
+        destroy_anr (anr);
+    free (r);
+    return err > 0.0 ? 10.0 * log10 (sig / err) : 999.0;
+}
+
+int main (void)
+{
+    static const int taps[] = {64, 16, 128, 256, 1024, 256};
+    static const int delay[] = {16, 2, 32, 1792, 1024, 0};
+    static real buf[2 * BSIZE];
+    int i, notch, fail = 0;
+    ANR anr;
+    ANF anf;
+
+    init_simd ();
+    printf ("  type  taps delay   SNR(dB)\n");
+    for (notch = 0; notch <= 1; notch++)
+    {
+        for (i = 0; i < (int)(sizeof (taps) / sizeof (taps[0])); i++)
+        {
+            double snr = check (notch, taps[i], delay[i]);
+            printf ("  %s  %4d  %4d  %8.1f%s\n", notch ? "ANF" : "ANR", taps[i], delay[i], snr,
+                snr < TOL_DB ? "  FAIL" : "");
+            if (snr < TOL_DB) fail = 1;
+        }
+    }
+
+    // taps and delay must be clamped so that delay + taps <= dline_size
+    anr = create_anr (1, 0, BSIZE, buf, buf, ANR_DLINE_SIZE, 3000, 100, 16e-4, 10e-7,
+        120.0, 120.0, 200.0, 0.001, 6.25e-10, 1.0, 3.0);
+    anf = create_anf (1, 0, BSIZE, buf, buf, ANF_DLINE_SIZE, 2000, 100, 16e-4, 10e-7,
+        1.0, 0.0, 200.0, 6.25e-12, 6.25e-10, 1.0, 3.0);
+    printf ("  clamped: ANR taps %d delay %d, ANF taps %d delay %d\n",
+        anr->n_taps, anr->delay, anf->n_taps, anf->delay);
+    if (anr->n_taps + anr->delay > ANR_DLINE_SIZE || anf->n_taps + anf->delay > ANF_DLINE_SIZE)
+        fail = 1;
+    destroy_anr (anr);
+    destroy_anf (anf);
+
+    printf ("%s (tolerance %.0f dB)\n", fail ? "FAIL" : "PASS", TOL_DB);
+    return fail;
+}
@@ -55,8 +55,8 @@ PORT
 ANB create_anb  (
     int run,
     int buffsize,
-    double* in,
-    double* out,
+    real* in,
+    real* out,
     double samplerate,
     double tau,
     double hangtime,
@@ -77,12 +77,12 @@ ANB create_anb  (
     a->advtime = advtime;
     a->backtau = backtau;
     a->threshold = threshold;
-    a->wave = (double *) malloc0 (((int)(MAX_SAMPLERATE * MAX_TAU) + 1) * sizeof(double));
+    a->wave = (real *) malloc0 (((int)(MAX_SAMPLERATE * MAX_TAU) + 1) * sizeof(real));
     a->dline_size = (int)((MAX_TAU + MAX_ADVTIME) * MAX_SAMPLERATE) + 1;
-    a->dline = (double *) malloc0 (a->dline_size * sizeof(complex));
+    a->dline = (real *) malloc0 (a->dline_size * sizeof(complex));
     InitializeCriticalSectionAndSpinCount (&a->cs_update, 2500);
     initBlanker(a);
-    a->legacy = (double *) malloc0 (2048 * sizeof (complex));                                                       /////////////// legacy interface - remove
+    a->legacy = (real *) malloc0 (2048 * sizeof (complex));                                                         /////////////// legacy interface - remove
     return a;
 }
 
@@ -107,8 +107,8 @@ void flush_anb (ANB a)
 PORT
 void xanb (ANB a)
 {
-    double scale;
-    double mag;
+    real scale;
+    real mag;
     int i;
     if (a->run)
     {
@@ -186,7 +186,7 @@ void xanb (ANB a)
         memcpy (a->out, a->in, a->buffsize * sizeof (complex));
 }
 
-void setBuffers_anb (ANB a, double* in, double* out)
+void setBuffers_anb (ANB a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -249,7 +249,7 @@ PORT
 void pSetRCVRANBSamplerate (ANB a, int rate)
 {
     EnterCriticalSection (&a->cs_update);
-    a->samplerate = (double) rate;
+    a->samplerate = (real) rate;
     initBlanker (a);
     LeaveCriticalSection (&a->cs_update);
 }
@@ -336,7 +336,7 @@ void flush_anbEXT (int id)
 }
 
 PORT
-void xanbEXT (int id, double* in, double* out)
+void xanbEXT (int id, real* in, real* out)
 {
     ANB a = panb[id];
     a->in = in;
@@ -367,7 +367,7 @@ void SetEXTANBSamplerate (int id, int rate)
 {
     ANB a = panb[id];
     EnterCriticalSection (&a->cs_update);
-    a->samplerate = (double) rate;
+    a->samplerate = (real) rate;
     initBlanker (a);
     LeaveCriticalSection (&a->cs_update);
 }
@@ -436,8 +436,8 @@ void xanbEXTF (int id, float *I, float *Q)
     a->out = a->legacy;
     for (i = 0; i < a->buffsize; i++)
     {
-        a->legacy[2 * i + 0] = (double)I[i];
-        a->legacy[2 * i + 1] = (double)Q[i];
+        a->legacy[2 * i + 0] = (real)I[i];
+        a->legacy[2 * i + 1] = (real)Q[i];
     }
     xanb (a);
     for (i = 0; i < a->buffsize; i++)
@@ -36,7 +36,7 @@ warren@wpratt.com
 void init_nob (NOB a)
 {
     int i;
-    double coef;
+    real coef;
     a->adv_slew_count = (int)(a->advslewtime * a->samplerate);
     a->adv_count = (int)(a->advtime * a->samplerate);
     a->hang_count = (int)(a->hangtime * a->samplerate);
@@ -64,8 +64,8 @@ PORT
 NOB create_nob (
     int run,
     int buffsize,
-    double* in,
-    double* out,
+    real* in,
+    real* out,
     double samplerate,
     int mode,
     double advslewtime,
@@ -96,15 +96,15 @@ NOB create_nob (
                                             MAX_HANG_SLEW_TIME +
                                             MAX_HANG_TIME +
                                             MAX_SEQ_TIME ) + 2);
-    a->dline = (double *)malloc0 (a->dline_size * sizeof (complex));
+    a->dline = (real *)malloc0 (a->dline_size * sizeof (complex));
     a->imp = (int *)malloc0 (a->dline_size * sizeof (int));
-    a->awave = (double *)malloc0 ((int)(MAX_ADV_SLEW_TIME  * MAX_SAMPLERATE + 1) * sizeof (double));
-    a->hwave = (double *)malloc0 ((int)(MAX_HANG_SLEW_TIME * MAX_SAMPLERATE + 1) * sizeof (double));
+    a->awave = (real *)malloc0 ((int)(MAX_ADV_SLEW_TIME  * MAX_SAMPLERATE + 1) * sizeof (real));
+    a->hwave = (real *)malloc0 ((int)(MAX_HANG_SLEW_TIME * MAX_SAMPLERATE + 1) * sizeof (real));
 
     a->filterlen = 10;
-    a->bfbuff = (double *)malloc0 (a->filterlen * sizeof (complex));
-    a->ffbuff = (double *)malloc0 (a->filterlen * sizeof (complex));
-    a->fcoefs = (double *)malloc0 (a->filterlen * sizeof (double));
+    a->bfbuff = (real *)malloc0 (a->filterlen * sizeof (complex));
+    a->ffbuff = (real *)malloc0 (a->filterlen * sizeof (complex));
+    a->fcoefs = (real *)malloc0 (a->filterlen * sizeof (real));
     a->fcoefs[0] = 0.308720593;
     a->fcoefs[1] = 0.216104415;
     a->fcoefs[2] = 0.151273090;
@@ -119,7 +119,7 @@ NOB create_nob (
     InitializeCriticalSectionAndSpinCount (&a->cs_update, 2500);
     init_nob (a);
 
-    a->legacy = (double *) malloc0 (2048 * sizeof (complex));                                                       /////////////// legacy interface - remove
+    a->legacy = (real *) malloc0 (2048 * sizeof (complex));                                                         /////////////// legacy interface - remove
     return a;
 }
 
@@ -157,8 +157,8 @@ void flush_nob (NOB a)
 PORT
 void xnob (NOB a)
 {
-    double scale;
-    double mag;
+    real scale;
+    real mag;
     int bf_idx;
     int ff_idx;
     int lidx, tidx;
@@ -494,7 +494,7 @@ void xnob (NOB a)
     LeaveCriticalSection (&a->cs_update);
 }
 
-void setBuffers_nob (NOB a, double* in, double* out)
+void setBuffers_nob (NOB a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -546,7 +546,7 @@ PORT
 void pSetRCVRNOBSamplerate (NOB a, int rate)
 {
     EnterCriticalSection (&a->cs_update);
-    a->samplerate = (double) rate;
+    a->samplerate = (real) rate;
     init_nob (a);
     LeaveCriticalSection (&a->cs_update);
 }
@@ -619,9 +619,9 @@ void create_nobEXT  (
     double threshold
                     )
 {
-    double advslewtime = slewtime;
-    double hangslewtime = slewtime;
-    double max_imp_seq_time = 0.025;
+    real advslewtime = slewtime;
+    real hangslewtime = slewtime;
+    real max_imp_seq_time = 0.025;
     pnob[id] = create_nob (run, buffsize, 0, 0, samplerate, mode, advslewtime, advtime, hangslewtime, hangtime, max_imp_seq_time, backtau, threshold);
 }
 
@@ -638,7 +638,7 @@ void flush_nobEXT (int id)
 }
 
 PORT
-void xnobEXT (int id, double* in, double* out)
+void xnobEXT (int id, real* in, real* out)
 {
     NOB a = pnob[id];
     a->in = in;
@@ -678,7 +678,7 @@ void SetEXTNOBSamplerate (int id, int rate)
 {
     NOB a = pnob[id];
     EnterCriticalSection (&a->cs_update);
-    a->samplerate = (double) rate;
+    a->samplerate = (real) rate;
     init_nob (a);
     LeaveCriticalSection (&a->cs_update);
 }
@@ -748,8 +748,8 @@ void xnobEXTF (int id, float *I, float *Q)
     a->out = a->legacy;
     for (i = 0; i < a->buffsize; i++)
     {
-        a->legacy[2 * i + 0] = (double)I[i];
-        a->legacy[2 * i + 1] = (double)Q[i];
+        a->legacy[2 * i + 0] = (real)I[i];
+        a->legacy[2 * i + 1] = (real)Q[i];
     }
     xnob (a);
     for (i = 0; i < a->buffsize; i++)
@@ -32,14 +32,112 @@ warren@wpratt.com
 *                                                                                               *
 ************************************************************************************************/
 
+// Dot product of the coefficients of one phase with the history of complex
+// input samples. The coefficients are stored twice (once for I, once for Q),
+// so that both the coefficient and the history arrays can be processed as
+// a contiguous sequence of 2 * n reals, with the even lanes accumulating I
+// and the odd lanes Q.  Called through simd_cdot.
+
+void cdot_scalar (const real* h, const real* x, int n, real* I, real* Q)
+{
+    int j;
+    real sI = 0.0, sQ = 0.0;
+    for (j = 0; j < n; j++)
+    {
+        sI += h[2 * j + 0] * x[2 * j + 0];
+        sQ += h[2 * j + 1] * x[2 * j + 1];
+    }
+    *I = sI;
+    *Q = sQ;
+}
+
+#ifdef WDSP_AVX2
+#include <immintrin.h>
+
+// two accumulators to hide the FMA latency
+__attribute__((target("avx2,fma")))
+void cdot_avx2 (const real* h, const real* x, int n, real* I, real* Q)
+{
+    int j = 0;
+    real rI, rQ;
+#ifdef WDSP_FLOAT
+    __m256 s0 = _mm256_setzero_ps ();
+    __m256 s1 = _mm256_setzero_ps ();
+    __m128 s;
+    for (; j + 8 <= n; j += 8)
+    {
+        s0 = _mm256_fmadd_ps (_mm256_loadu_ps (h + 2 * j + 0), _mm256_loadu_ps (x + 2 * j + 0), s0);
+        s1 = _mm256_fmadd_ps (_mm256_loadu_ps (h + 2 * j + 8), _mm256_loadu_ps (x + 2 * j + 8), s1);
+    }
+    s0 = _mm256_add_ps (s0, s1);
+    s  = _mm_add_ps (_mm256_castps256_ps128 (s0), _mm256_extractf128_ps (s0, 1));
+    s  = _mm_add_ps (s, _mm_movehl_ps (s, s));
+    cdot_scalar (h + 2 * j, x + 2 * j, n - j, &rI, &rQ);
+    *I = _mm_cvtss_f32 (s) + rI;
+    *Q = _mm_cvtss_f32 (_mm_shuffle_ps (s, s, 0x55)) + rQ;
+#else
+    __m256d s0 = _mm256_setzero_pd ();
+    __m256d s1 = _mm256_setzero_pd ();
+    __m128d s;
+    for (; j + 4 <= n; j += 4)
+    {
+        s0 = _mm256_fmadd_pd (_mm256_loadu_pd (h + 2 * j + 0), _mm256_loadu_pd (x + 2 * j + 0), s0);
+        s1 = _mm256_fmadd_pd (_mm256_loadu_pd (h + 2 * j + 4), _mm256_loadu_pd (x + 2 * j + 4), s1);
+    }
+    s0 = _mm256_add_pd (s0, s1);
+    s  = _mm_add_pd (_mm256_castpd256_pd128 (s0), _mm256_extractf128_pd (s0, 1));
+    cdot_scalar (h + 2 * j, x + 2 * j, n - j, &rI, &rQ);
+    *I = _mm_cvtsd_f64 (s) + rI;
+    *Q = _mm_cvtsd_f64 (_mm_unpackhi_pd (s, s)) + rQ;
+#endif
+}
+#endif
+
+#ifdef WDSP_NEON
+#include <arm_neon.h>
+
+void cdot_neon (const real* h, const real* x, int n, real* I, real* Q)
+{
+    int j = 0;
+    real rI, rQ;
+#ifdef WDSP_FLOAT
+    float32x4_t s0 = vdupq_n_f32 (0.0f);
+    float32x4_t s1 = vdupq_n_f32 (0.0f);
+    float32x2_t s;
+    for (; j + 4 <= n; j += 4)
+    {
+        s0 = vfmaq_f32 (s0, vld1q_f32 (h + 2 * j + 0), vld1q_f32 (x + 2 * j + 0));
+        s1 = vfmaq_f32 (s1, vld1q_f32 (h + 2 * j + 4), vld1q_f32 (x + 2 * j + 4));
+    }
+    s0 = vaddq_f32 (s0, s1);
+    s  = vadd_f32 (vget_low_f32 (s0), vget_high_f32 (s0));
+    cdot_scalar (h + 2 * j, x + 2 * j, n - j, &rI, &rQ);
+    *I = vget_lane_f32 (s, 0) + rI;
+    *Q = vget_lane_f32 (s, 1) + rQ;
+#else
+    float64x2_t s0 = vdupq_n_f64 (0.0);
+    float64x2_t s1 = vdupq_n_f64 (0.0);
+    for (; j + 2 <= n; j += 2)
+    {
+        s0 = vfmaq_f64 (s0, vld1q_f64 (h + 2 * j + 0), vld1q_f64 (x + 2 * j + 0));
+        s1 = vfmaq_f64 (s1, vld1q_f64 (h + 2 * j + 2), vld1q_f64 (x + 2 * j + 2));
+    }
+    s0 = vaddq_f64 (s0, s1);
+    cdot_scalar (h + 2 * j, x + 2 * j, n - j, &rI, &rQ);
+    *I = vgetq_lane_f64 (s0, 0) + rI;
+    *Q = vgetq_lane_f64 (s0, 1) + rQ;
+#endif
+}
+#endif
+
 void calc_resample (RESAMPLE a)
 {
     int x, y, z;
     int i, j, k;
     int min_rate;
-    double full_rate;
-    double fc_norm_high, fc_norm_low;
-    double* impulse;
+    real full_rate;
+    real fc_norm_high, fc_norm_low;
+    real* impulse;
     a->fc = a->fcin;
     a->ncoef = a->ncoefin;
     x = a->in_rate;
@@ -54,8 +152,8 @@ void calc_resample (RESAMPLE a)
     a->M = a->in_rate / x;
     if (a->in_rate < a->out_rate) min_rate = a->in_rate;
     else min_rate = a->out_rate;
-    if (a->fc == 0.0) a->fc = 0.45 * (double)min_rate;
-    full_rate = (double)(a->in_rate * a->L);
+    if (a->fc == 0.0) a->fc = 0.45 * (real)min_rate;
+    full_rate = (real)(a->in_rate * a->L);
     fc_norm_high = a->fc / full_rate;
     if (a->fc_low < 0.0)
         fc_norm_low = - fc_norm_high;
@@ -64,14 +162,19 @@ void calc_resample (RESAMPLE a)
     if (a->ncoef == 0) a->ncoef = (int)(140.0 * full_rate / min_rate);
     a->ncoef = (a->ncoef / a->L + 1) * a->L;
     a->cpp = a->ncoef / a->L;
-    a->h = (double *)malloc0(a->ncoef * sizeof(double));
-    impulse = fir_bandpass(a->ncoef, fc_norm_low, fc_norm_high, 1.0, 1, 0, a->gain * (double)a->L);
+    a->h = (real *)malloc0(a->ncoef * sizeof(complex));
+    impulse = fir_bandpass(a->ncoef, fc_norm_low, fc_norm_high, 1.0, 1, 0, a->gain * (real)a->L);
     i = 0;
     for (j = 0; j < a->L; j++)
         for (k = 0; k < a->ncoef; k += a->L)
+        {
+            a->h[i++] = impulse[j + k];
             a->h[i++] = impulse[j + k];
+        }
     a->ringsize = a->cpp;
-    a->ring = (double *)malloc0(a->ringsize * sizeof(complex));
+    // mirrored ring: each sample is stored at idx_in and idx_in + ringsize,
+    // so the cpp samples starting at idx_in are always contiguous
+    a->ring = (real *)malloc0(2 * a->ringsize * sizeof(complex));
     a->idx_in = a->ringsize - 1;
     a->phnum = 0;
     _aligned_free(impulse);
@@ -84,7 +187,7 @@ void decalc_resample (RESAMPLE a)
 }
 
 PORT
-RESAMPLE create_resample ( int run, int size, double* in, double* out, int in_rate, int out_rate, double fc, int ncoef, double gain)
+RESAMPLE create_resample ( int run, int size, real* in, real* out, int in_rate, int out_rate, double fc, int ncoef, double gain)
 {
     RESAMPLE a = (RESAMPLE) malloc0 (sizeof (resample));
 
@@ -112,7 +215,7 @@ void destroy_resample (RESAMPLE a)
 PORT
 void flush_resample (RESAMPLE a)
 {
-    memset (a->ring, 0, a->ringsize * sizeof (complex));
+    memset (a->ring, 0, 2 * a->ringsize * sizeof (complex));
     a->idx_in = a->ringsize - 1;
     a->phnum = 0;
 }
@@ -123,32 +226,43 @@ int xresample (RESAMPLE a)
     int outsamps = 0;
     if (a->run)
     {
-        int i, j, n;
-        int idx_out;
-        double I, Q;
-
-        for (i = 0; i < a->size; i++)
+        int i;
+        real* r;
+        if (a->L == 1)
         {
-            a->ring[2 * a->idx_in + 0] = a->in[2 * i + 0];
-            a->ring[2 * a->idx_in + 1] = a->in[2 * i + 1];
-            while (a->phnum < a->L)
+            // integer decimation: only one phase, an output sample is
+            // produced for every M-th input sample (when phnum hits zero)
+            for (i = 0; i < a->size; i++)
             {
-                I = 0.0;
-                Q = 0.0;
-                n = a->cpp * a->phnum;
-                for (j = 0; j < a->cpp; j++)
+                r = a->ring + 2 * a->idx_in;
+                r[0] = r[2 * a->ringsize + 0] = a->in[2 * i + 0];
+                r[1] = r[2 * a->ringsize + 1] = a->in[2 * i + 1];
+                if (a->phnum == 0)
                 {
-                    if ((idx_out = a->idx_in + j) >= a->ringsize) idx_out -= a->ringsize;
-                    I += a->h[n + j] * a->ring[2 * idx_out + 0];
-                    Q += a->h[n + j] * a->ring[2 * idx_out + 1];
+                    simd_cdot (a->h, r, a->cpp, &a->out[2 * outsamps + 0], &a->out[2 * outsamps + 1]);
+                    outsamps++;
+                    a->phnum = a->M;
                 }
-                a->out[2 * outsamps + 0] = I;
-                a->out[2 * outsamps + 1] = Q;
-                outsamps++;
-                a->phnum += a->M;
+                a->phnum--;
+                if (--a->idx_in < 0) a->idx_in = a->ringsize - 1;
+            }
+        }
+        else
+        {
+            for (i = 0; i < a->size; i++)
+            {
+                r = a->ring + 2 * a->idx_in;
+                r[0] = r[2 * a->ringsize + 0] = a->in[2 * i + 0];
+                r[1] = r[2 * a->ringsize + 1] = a->in[2 * i + 1];
+                while (a->phnum < a->L)
+                {
+                    simd_cdot (a->h + 2 * a->cpp * a->phnum, r, a->cpp, &a->out[2 * outsamps + 0], &a->out[2 * outsamps + 1]);
+                    outsamps++;
+                    a->phnum += a->M;
+                }
+                a->phnum -= a->L;
+                if (--a->idx_in < 0) a->idx_in = a->ringsize - 1;
             }
-            a->phnum -= a->L;
-            if (--a->idx_in < 0) a->idx_in = a->ringsize - 1;
         }
     }
     else if (a->in != a->out)
@@ -156,7 +270,7 @@ int xresample (RESAMPLE a)
     return outsamps;
 }
 
-void setBuffers_resample(RESAMPLE a, double* in, double* out)
+void setBuffers_resample(RESAMPLE a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -182,7 +296,7 @@ void setOutRate_resample(RESAMPLE a, int rate)
     calc_resample (a);
 }
 
-void setFCLow_resample (RESAMPLE a, double fc_low)
+void setFCLow_resample (RESAMPLE a, real fc_low)
 {
     if (fc_low != a->fc_low)
     {
@@ -192,7 +306,7 @@ void setFCLow_resample (RESAMPLE a, double fc_low)
     }
 }
 
-void setBandwidth_resample (RESAMPLE a, double fc_low, double fc_high)
+void setBandwidth_resample (RESAMPLE a, real fc_low, real fc_high)
 {
     if (fc_low != a->fc_low || fc_high != a->fcin)
     {
@@ -212,7 +326,7 @@ void* create_resampleV (int in_rate, int out_rate)
 }
 
 PORT
-void xresampleV (double* input, double* output, int numsamps, int* outsamps, void* ptr)
+void xresampleV (real* input, real* output, int numsamps, int* outsamps, void* ptr)
 {
     RESAMPLE a = (RESAMPLE)ptr;
     a->in = input;
@@ -239,10 +353,10 @@ RESAMPLEF create_resampleF ( int run, int size, float* in, float* out, int in_ra
     int x, y, z;
     int i, j, k;
     int min_rate;
-    double full_rate;
-    double fc;
-    double fc_norm;
-    double* impulse;
+    real full_rate;
+    real fc;
+    real fc_norm;
+    real* impulse;
     a->run = run;
     a->size = size;
     a->in = in;
@@ -259,20 +373,20 @@ RESAMPLEF create_resampleF ( int run, int size, float* in, float* out, int in_ra
     a->M = in_rate / x;
     if (in_rate < out_rate) min_rate = in_rate;
     else min_rate = out_rate;
-    fc = 0.45 * (double)min_rate;
-    full_rate = (double)(in_rate * a->L);
+    fc = 0.45 * (real)min_rate;
+    full_rate = (real)(in_rate * a->L);
     fc_norm = fc / full_rate;
     a->ncoef = (int)(60.0 / fc_norm);
     a->ncoef = (a->ncoef / a->L + 1) * a->L;
     a->cpp = a->ncoef / a->L;
-    a->h = (double *) malloc0 (a->ncoef * sizeof (double));
-    impulse = fir_bandpass (a->ncoef, -fc_norm, +fc_norm, 1.0, 1, 0, (double)a->L);
+    a->h = (real *) malloc0 (a->ncoef * sizeof (real));
+    impulse = fir_bandpass (a->ncoef, -fc_norm, +fc_norm, 1.0, 1, 0, (real)a->L);
     i = 0;
     for (j = 0; j < a->L; j ++)
         for (k = 0; k < a->ncoef; k += a->L)
             a->h[i++] = impulse[j + k];
     a->ringsize = a->cpp;
-    a->ring = (double *) malloc0 (a->ringsize * sizeof (double));
+    a->ring = (real *) malloc0 (a->ringsize * sizeof (real));
     a->idx_in = a->ringsize - 1;
     a->phnum = 0;
     _aligned_free (impulse);
@@ -288,7 +402,7 @@ void destroy_resampleF (RESAMPLEF a)
 
 void flush_resampleF (RESAMPLEF a)
 {
-    memset (a->ring, 0, a->ringsize * sizeof (double));
+    memset (a->ring, 0, a->ringsize * sizeof (real));
     a->idx_in = a->ringsize - 1;
     a->phnum = 0;
 }
@@ -300,11 +414,11 @@ int xresampleF (RESAMPLEF a)
     {
         int i, j, n;
         int idx_out;
-        double I;
+        real I;
 
         for (i = 0; i < a->size; i++)
         {
-            a->ring[a->idx_in] = (double)a->in[i];
+            a->ring[a->idx_in] = (real)a->in[i];
 
             while (a->phnum < a->L)
             {
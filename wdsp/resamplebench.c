@@ -0,0 +1,267 @@
+/*  resamplebench.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+*/
+
+// Throughput of xresample() (mirrored ring, duplicated coefficients, vector
+// dot product from simd.c) compared with the original resampler, which is
+// copied below.  "make resamplebench" builds and runs it against libwdsp.a.
+//
+// For each rate pair the same signal is fed through
+//   old     the original xresample()
+//   scalar  the current xresample() with the scalar dot product
+//   vector  the current xresample() with the kernel selected by init_simd()
+// and the number of input samples processed per second is printed, together
+// with the largest difference of the outputs (relative to full scale).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "comm.h"
+
+#define BSIZE       1024            // input samples per call, as for a channel
+#define MIN_TIME    0.3             // seconds per measurement
+
+typedef struct _ref_resample
+{
+    int size;
+    real* in;
+    real* out;
+    int idx_in;
+    int ncoef;
+    int L;
+    int M;
+    real* h;
+    int ringsize;
+    real* ring;
+    int cpp;
+    int phnum;
+} ref_resample;
+
+// the original calc_resample(), with fc = 0, ncoef = 0 and fc_low = -1
+static void ref_calc (ref_resample* a, int in_rate, int out_rate, double gain)
+{
+    int x, y, z;
+    int i, j, k;
+    int min_rate;
+    real full_rate, fc, fc_norm_high, fc_norm_low;
+    real* impulse;
+    x = in_rate;
+    y = out_rate;
+    while (y != 0)
+    {
+        z = y;
+        y = x % y;
+        x = z;
+    }
+    a->L = out_rate / x;
+    a->M = in_rate / x;
+    min_rate = in_rate < out_rate ? in_rate : out_rate;
+    fc = 0.45 * (real)min_rate;
+    full_rate = (real)(in_rate * a->L);
+    fc_norm_high = fc / full_rate;
+    fc_norm_low = - fc_norm_high;
+    a->ncoef = (int)(140.0 * full_rate / min_rate);
+    a->ncoef = (a->ncoef / a->L + 1) * a->L;
+    a->cpp = a->ncoef / a->L;
+    a->h = (real *)malloc0(a->ncoef * sizeof(real));
+    impulse = fir_bandpass(a->ncoef, fc_norm_low, fc_norm_high, 1.0, 1, 0, gain * (real)a->L);
+    i = 0;
+    for (j = 0; j < a->L; j++)
+        for (k = 0; k < a->ncoef; k += a->L)
+            a->h[i++] = impulse[j + k];
+    a->ringsize = a->cpp;
+    a->ring = (real *)malloc0(a->ringsize * sizeof(complex));
+    a->idx_in = a->ringsize - 1;
+    a->phnum = 0;
+    _aligned_free(impulse);
+}
+
+// the original xresample()
+static int ref_xresample (ref_resample* a)
+{
+    int outsamps = 0;
+    int i, j, n;
+    int idx_out;
+    real I, Q;
+
+    for (i = 0; i < a->size; i++)
+    {
+        a->ring[2 * a->idx_in + 0] = a->in[2 * i + 0];
+        a->ring[2 * a->idx_in + 1] = a->in[2 * i + 1];
+        while (a->phnum < a->L)
+        {
+            I = 0.0;
+            Q = 0.0;
+            n = a->cpp * a->phnum;
+            for (j = 0; j < a->cpp; j++)
+            {
+                if ((idx_out = a->idx_in + j) >= a->ringsize) idx_out -= a->ringsize;
+                I += a->h[n + j] * a->ring[2 * idx_out + 0];
+                Q += a->h[n + j] * a->ring[2 * idx_out + 1];
+            }
+            a->out[2 * outsamps + 0] = I;
+            a->out[2 * outsamps + 1] = Q;
+            outsamps++;
+            a->phnum += a->M;
+        }
+        a->phnum -= a->L;
+        if (--a->idx_in < 0) a->idx_in = a->ringsize - 1;
+    }
+    return outsamps;
+}
+
+static double now (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.0e-9 * (double)ts.tv_nsec;
+}
+
+static void fill (real* in, int in_rate)
+{
+    int i;
+    for (i = 0; i < BSIZE; i++)
+    {
+        double t = (double)i / (double)in_rate;
+        in[2 * i + 0] = (real)(0.5 * cos (2.0 * M_PI * 3000.0 * t) + 0.25 * cos (2.0 * M_PI * 11000.0 * t));
+        in[2 * i + 1] = (real)(0.5 * sin (2.0 * M_PI * 3000.0 * t) - 0.25 * sin (2.0 * M_PI * 11000.0 * t));
+    }
+}
+
+// input samples per second (in millions) for one path; the output of the
+// first call (after the history has been filled) is left in out
+static double run_old (ref_resample* a, real* out, int* nout)
+{
+    double t0, t;
+    long n = 0;
+    int k;
+    for (k = 0; k < 4; k++)
+        *nout = ref_xresample (a);
+    memcpy (out, a->out, 2 * *nout * sizeof (real));
+    t0 = now ();
+    do
+    {
+        for (k = 0; k < 16; k++)
+            ref_xresample (a);
+        n += 16 * BSIZE;
+    } while ((t = now () - t0) < MIN_TIME);
+    return 1.0e-6 * (double)n / t;
+}
+
+static double run_new (RESAMPLE a, real* out, int* nout)
+{
+    double t0, t;
+    long n = 0;
+    int k;
+    for (k = 0; k < 4; k++)
+        *nout = xresample (a);
+    memcpy (out, a->out, 2 * *nout * sizeof (real));
+    t0 = now ();
+    do
+    {
+        for (k = 0; k < 16; k++)
+            xresample (a);
+        n += 16 * BSIZE;
+    } while ((t = now () - t0) < MIN_TIME);
+    return 1.0e-6 * (double)n / t;
+}
+
+static double maxdiff (const real* x, const real* y, int n)
+{
+    double d = 0.0;
+    int i;
+    for (i = 0; i < 2 * n; i++)
+        if (fabs ((double)x[i] - (double)y[i]) > d) d = fabs ((double)x[i] - (double)y[i]);
+    return d;
+}
+
+int main (void)
+{
+    // receiver (radio rate -> 48k) and transmitter (48k -> radio rate) paths,
+    // and the 8k/16k audio of the client/server remote connection
+    static const int rates[][2] =
+    {
+        {  96000,  48000}, { 192000,  48000}, { 384000,  48000}, { 768000,  48000}, {1536000,  48000},
+        {  48000,  96000}, {  48000, 192000}, {  48000, 384000}, {  48000, 768000}, {  48000, 1536000},
+        {  48000,   8000}, {  48000,  16000}, {   8000,  48000}, {  16000,  48000}
+    };
+    static real in[2 * BSIZE];
+    real *out, *ref_out, *scalar_out, *vector_out;
+    void (*vector_cdot) (const real* h, const real* x, int n, real* I, real* Q);
+    int i, nmax = BSIZE * 1536000 / 8000;
+    int nold, nscalar, nvector, fail = 0;
+
+    init_simd ();
+    vector_cdot = simd_cdot;
+    out = (real *)malloc0 (nmax * sizeof (complex));
+    ref_out = (real *)malloc0 (nmax * sizeof (complex));
+    scalar_out = (real *)malloc0 (nmax * sizeof (complex));
+    vector_out = (real *)malloc0 (nmax * sizeof (complex));
+
+    printf ("%s, %s kernel, %d input samples per call\n",
+#ifdef WDSP_FLOAT
+        "float",
+#else
+        "double",
+#endif
+        vector_cdot == cdot_scalar ? "scalar" : "vector", BSIZE);
+    printf ("                           input Msamples/s                speed-up\n");
+    printf ("     in ->     out  ncoef     old  scalar  vector   scalar  vector  max diff\n");
+    for (i = 0; i < (int)(sizeof (rates) / sizeof (rates[0])); i++)
+    {
+        int in_rate = rates[i][0], out_rate = rates[i][1];
+        ref_resample* r = (ref_resample *)calloc (1, sizeof (ref_resample));
+        RESAMPLE a;
+        double t_old, t_scalar, t_vector, diff;
+
+        fill (in, in_rate);
+        r->size = BSIZE;
+        r->in = in;
+        r->out = out;
+        ref_calc (r, in_rate, out_rate, 1.0);
+        t_old = run_old (r, ref_out, &nold);
+
+        a = create_resample (1, BSIZE, in, out, in_rate, out_rate, 0.0, 0, 1.0);
+        simd_cdot = cdot_scalar;
+        t_scalar = run_new (a, scalar_out, &nscalar);
+        flush_resample (a);
+        simd_cdot = vector_cdot;
+        t_vector = run_new (a, vector_out, &nvector);
+        destroy_resample (a);
+
+        diff = maxdiff (ref_out, scalar_out, nold);
+        if (maxdiff (ref_out, vector_out, nold) > diff) diff = maxdiff (ref_out, vector_out, nold);
+        if (nscalar != nold || nvector != nold) diff = 1.0;
+        printf ("%7d -> %7d  %5d  %6.2f  %6.2f  %6.2f   %5.2fx  %5.2fx  %8.1e%s\n",
+            in_rate, out_rate, r->ncoef, t_old, t_scalar, t_vector,
+            t_scalar / t_old, t_vector / t_old, diff, diff > 1.0e-3 ? "  FAIL" : "");
+        if (diff > 1.0e-3) fail = 1;
+
+        _aligned_free (r->h);
+        _aligned_free (r->ring);
+        free (r);
+    }
+    _aligned_free (out);
+    _aligned_free (ref_out);
+    _aligned_free (scalar_out);
+    _aligned_free (vector_out);
+    return fail;
+}
@@ -0,0 +1,61 @@
+/*  simd.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+*/
+
+#include "comm.h"
+
+void (*simd_cmac) (real* acc, const real* x, const real* m, int n) = cmac_scalar;
+void (*simd_cdot) (const real* h, const real* x, int n, real* I, real* Q) = cdot_scalar;
+real (*simd_lms_dot) (const real* w, const real* x, int n) = lms_dot_scalar;
+void (*simd_lms_update) (real* w, const real* x, int n, real c0, real c1) = lms_update_scalar;
+
+int wdsp_cpu_has_avx2_fma (void)
+{
+#ifdef WDSP_AVX2
+    __builtin_cpu_init ();
+    return __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+#else
+    return 0;
+#endif
+}
+
+static void select_kernels (void)
+{
+#ifdef WDSP_AVX2
+    if (wdsp_cpu_has_avx2_fma ())
+    {
+        simd_cmac = cmac_avx2;
+        simd_cdot = cdot_avx2;
+        simd_lms_dot = lms_dot_avx2;
+        simd_lms_update = lms_update_avx2;
+    }
+#endif
+#ifdef WDSP_NEON
+    simd_cmac = cmac_neon;
+    simd_cdot = cdot_neon;
+    simd_lms_dot = lms_dot_neon;
+    simd_lms_update = lms_update_neon;
+#endif
+}
+
+void init_simd (void)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once (&once, select_kernels);
+}
@@ -0,0 +1,68 @@
+/*  simd.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+*/
+
+#ifndef _simd_h
+#define _simd_h
+
+// Vector kernels selected at run-time
+//
+// The kernels live with their users (fircore MAC in firmin.c, polyphase dot
+// product in resample.c, LMS filter in lmath.c) and are called through the
+// function pointers below.  These point to the scalar kernels until
+// init_simd(), which is called by OpenChannel(), selects AVX2+FMA on x86 if
+// the CPU has it, or NEON on 64-bit ARM.  The vector kernels handle whole
+// vectors and leave the rest to the scalar code.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define WDSP_AVX2
+#endif
+
+#if defined(__aarch64__)
+#define WDSP_NEON
+#endif
+
+extern int wdsp_cpu_has_avx2_fma (void);
+
+extern void init_simd (void);
+
+// firmin.c: acc[i] += x[i] * m[i] for n complex values
+extern void cmac_scalar (real* acc, const real* x, const real* m, int n);
+extern void cmac_avx2 (real* acc, const real* x, const real* m, int n);
+extern void cmac_neon (real* acc, const real* x, const real* m, int n);
+extern void (*simd_cmac) (real* acc, const real* x, const real* m, int n);
+
+// resample.c: I/Q dot products of n complex values with duplicated coefficients
+extern void cdot_scalar (const real* h, const real* x, int n, real* I, real* Q);
+extern void cdot_avx2 (const real* h, const real* x, int n, real* I, real* Q);
+extern void cdot_neon (const real* h, const real* x, int n, real* I, real* Q);
+extern void (*simd_cdot) (const real* h, const real* x, int n, real* I, real* Q);
+
+// lmath.c: LMS filter (dot product) and weight update
+extern real lms_dot_scalar (const real* w, const real* x, int n);
+extern real lms_dot_avx2 (const real* w, const real* x, int n);
+extern real lms_dot_neon (const real* w, const real* x, int n);
+extern real (*simd_lms_dot) (const real* w, const real* x, int n);
+
+extern void lms_update_scalar (real* w, const real* x, int n, real c0, real c1);
+extern void lms_update_avx2 (real* w, const real* x, int n, real c0, real c1);
+extern void lms_update_neon (real* w, const real* x, int n, real c0, real c1);
+extern void (*simd_lms_update) (real* w, const real* x, int n, real c0, real c1);
+
+#endif
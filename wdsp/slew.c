@@ -37,14 +37,14 @@ enum _USLEW
 void calc_uslew (USLEW a)
 {
     int i;
-    double delta, theta;
+    real delta, theta;
     a->runmode = 0;
     a->state = BEGIN;
     a->count = 0;
     a->ndelup = (int)(a->tdelay * a->rate);
     a->ntup = (int)(a->tupslew * a->rate);
-    a->cup = (double *) malloc0 ((a->ntup + 1) * sizeof (double));
-    delta = PI / (double)a->ntup;
+    a->cup = (real *) malloc0 ((a->ntup + 1) * sizeof (real));
+    delta = PI / (real)a->ntup;
     theta = 0.0;
     for (i = 0; i <= a->ntup; i++)
     {
@@ -59,7 +59,7 @@ void decalc_uslew (USLEW a)
     _aligned_free (a->cup);
 }
 
-USLEW create_uslew (int channel, volatile long *ch_upslew, int size, double* in, double* out, double rate, double tdelay, double tupslew)
+USLEW create_uslew (int channel, volatile long *ch_upslew, int size, real* in, real* out, double rate, double tdelay, double tupslew)
 {
     USLEW a = (USLEW)malloc0 (sizeof (uslew));
     a->channel = channel;
@@ -95,7 +95,7 @@ void xuslew (USLEW a)
     if (a->runmode && _InterlockedAnd (a->ch_upslew, 1))
     {
         int i;
-        double I, Q;
+        real I, Q;
         for (i = 0; i < a->size; i++)
         {
             I = a->in[2 * i + 0];
@@ -154,7 +154,7 @@ void xuslew (USLEW a)
         memcpy (a->out, a->in, a->size * sizeof (complex));
 }
 
-void setBuffers_uslew (USLEW a, double* in, double* out)
+void setBuffers_uslew (USLEW a, real* in, real* out)
 {
     a->in = in;
     a->out = out;
@@ -0,0 +1,214 @@
+/*  snrtest.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+*/
+
+// Regression check of the single-precision build (WDSP_REAL=float) against
+// the double-precision build.  "make snrtest" builds this program twice, once
+// against each variant of libwdsp.a.
+//
+//   snrtest run <file> [nr]      feed a fixed test signal through an RX channel
+//                                and write the audio output (as doubles) to <file>;
+//                                nr is one of none, anr, anf, emnr, snb
+//   snrtest compare <ref> <test> print the SNR of <test> relative to <ref>, for
+//                                every output block and in total
+//
+// The samples are fed in at about 2.5 times the real-time rate.
+//
+// The test signal (192 kHz, USB, 24-bit quantized) contains two tones in the
+// pass band, a strong tone outside of it, and white noise, so that the filters,
+// the AGC and the noise reduction all have some work to do.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "wdsp.h"
+
+#define IN_RATE     192000
+#define IN_SIZE     1024
+#define OUT_SIZE    (IN_SIZE * 48000 / IN_RATE)
+#define NBLOCKS     2000
+#define SEGMENT     20              // blocks per line of the compare output (~107 msec)
+
+static unsigned int seed = 12345;
+
+static double noise (void)
+{
+    // uniform in [-1, 1)
+    seed = seed * 1664525u + 1013904223u;
+    return (double)(int)seed / 2147483648.0;
+}
+
+static double quantize (double x)
+{
+    return floor (x * 8388608.0 + 0.5) / 8388608.0;
+}
+
+static int run (const char* file, const char* nr)
+{
+    static WDSP_REAL in[2 * IN_SIZE];
+    static WDSP_REAL out[2 * OUT_SIZE];
+    static double buf[2 * OUT_SIZE];
+    FILE* fp;
+    long n = 0;
+    int block, i, error;
+
+    if ((fp = fopen (file, "wb")) == NULL)
+    {
+        perror (file);
+        return 1;
+    }
+    OpenChannel (0, IN_SIZE, IN_SIZE, IN_RATE, 48000, 48000, 0, 1, 0.010, 0.025, 0.0, 0.010, 1);
+    SetRXAMode (0, 1);                          // USB
+    RXANBPSetFreqs (0, 150.0, 2850.0);
+    SetRXABandpassFreqs (0, 150.0, 2850.0);
+    SetRXAAGCMode (0, 3);                       // MEDIUM
+    SetRXAAGCTop (0, 80.0);
+    SetRXAPanelRun (0, 1);
+    SetRXAANRVals (0, 64, 16, 16e-4, 10e-7);
+    SetRXAANRRun (0, strcmp (nr, "anr") == 0);
+    SetRXAANFRun (0, strcmp (nr, "anf") == 0);
+    SetRXAEMNRRun (0, strcmp (nr, "emnr") == 0);
+    SetRXASNBARun (0, strcmp (nr, "snb") == 0);
+
+    for (block = 0; block < NBLOCKS; block++)
+    {
+        for (i = 0; i < IN_SIZE; i++, n++)
+        {
+            double t = (double)n / IN_RATE;
+            double I = 1.0e-3 * cos (2.0 * M_PI * 1000.0 * t) + 3.0e-4 * cos (2.0 * M_PI * 1700.0 * t)
+                     + 3.0e-2 * cos (2.0 * M_PI * 20000.0 * t) + 1.0e-4 * noise ();
+            double Q = 1.0e-3 * sin (2.0 * M_PI * 1000.0 * t) + 3.0e-4 * sin (2.0 * M_PI * 1700.0 * t)
+                     + 3.0e-2 * sin (2.0 * M_PI * 20000.0 * t) + 1.0e-4 * noise ();
+            in[2 * i + 0] = (WDSP_REAL)quantize (I);
+            in[2 * i + 1] = (WDSP_REAL)quantize (Q);
+        }
+        fexchange0 (0, in, out, &error);
+        // the input ring of the channel holds only two buffers, so the samples
+        // must not come in faster than the DSP thread processes them
+        usleep (2000);
+        for (i = 0; i < 2 * OUT_SIZE; i++)
+            buf[i] = out[i];
+        fwrite (buf, sizeof (double), 2 * OUT_SIZE, fp);
+    }
+    fclose (fp);
+    return 0;
+}
+
+static double snr_db (double sig, double err)
+{
+    if (err <= 0.0) return 999.0;
+    return 10.0 * log10 (sig / err);
+}
+
+static int cmp_double (const void* a, const void* b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double* load (const char* file, int* nblocks)
+{
+    double* buf = (double *)malloc (NBLOCKS * 2 * OUT_SIZE * sizeof (double));
+    FILE* fp;
+
+    if ((fp = fopen (file, "rb")) == NULL)
+    {
+        perror (file);
+        free (buf);
+        return NULL;
+    }
+    *nblocks = (int)(fread (buf, 2 * OUT_SIZE * sizeof (double), NBLOCKS, fp));
+    fclose (fp);
+    return buf;
+}
+
+static int compare (const char* ref_file, const char* test_file)
+{
+    static double s[NBLOCKS], e[NBLOCKS], snr[NBLOCKS];
+    double *ref, *test;
+    double mean = 0.0, sig = 0.0, err = 0.0, seg_sig = 0.0, seg_err = 0.0, sum = 0.0;
+    int nref, ntest, nblocks, n = 0, block, i;
+
+    ref = load (ref_file, &nref);
+    test = load (test_file, &ntest);
+    if (ref == NULL || test == NULL)
+        return 1;
+    nblocks = nref < ntest ? nref : ntest;
+    for (block = 0; block < nblocks; block++)
+    {
+        double* r = ref + block * 2 * OUT_SIZE;
+        double* t = test + block * 2 * OUT_SIZE;
+        s[block] = e[block] = 0.0;
+        for (i = 0; i < 2 * OUT_SIZE; i++)
+        {
+            s[block] += r[i] * r[i];
+            e[block] += (r[i] - t[i]) * (r[i] - t[i]);
+        }
+        mean += s[block];
+    }
+    free (ref);
+    free (test);
+    mean /= nblocks;
+
+    // blocks more than 60 dB below the average (channel start-up, slew-up)
+    // only show the noise floor of the single-precision arithmetic: skip them
+    printf ("  blocks        SNR(dB)\n");
+    for (block = 0; block < nblocks; block++)
+    {
+        if (s[block] > 1.0e-6 * mean)
+        {
+            snr[n++] = snr_db (s[block], e[block]);
+            sig += s[block];
+            err += e[block];
+            seg_sig += s[block];
+            seg_err += e[block];
+        }
+        if ((block + 1) % SEGMENT == 0)
+        {
+            if (seg_sig > 0.0)
+                printf ("  %4d-%4d  %8.1f\n", block + 1 - SEGMENT, block, snr_db (seg_sig, seg_err));
+            seg_sig = seg_err = 0.0;
+        }
+    }
+    if (n == 0)
+    {
+        printf ("no output\n");
+        return 1;
+    }
+    for (i = 0; i < n; i++)
+        sum += snr[i];
+    qsort (snr, n, sizeof (double), cmp_double);
+    printf ("per block (%d samples): n=%d (%d skipped) min=%.1f median=%.1f mean=%.1f max=%.1f dB\n",
+        OUT_SIZE, n, nblocks - n, snr[0], snr[n / 2], sum / n, snr[n - 1]);
+    printf ("total: %.1f dB\n", snr_db (sig, err));
+    return 0;
+}
+
+int main (int argc, char** argv)
+{
+    if (argc >= 3 && strcmp (argv[1], "run") == 0)
+        return run (argv[2], argc >= 4 ? argv[3] : "none");
+    if (argc == 4 && strcmp (argv[1], "compare") == 0)
+        return compare (argv[2], argv[3]);
+    fprintf (stderr, "usage: %s run <file> [none|anr|anf|emnr|snb]\n"
+                     "       %s compare <ref> <test>\n", argv[0], argv[0]);
+    return 2;
+}
@@ -32,7 +32,7 @@ warren@pratt.one
 *                                                                                                       *
 ********************************************************************************************************/
 
-FTOV create_ftov (int run, int size, int rate, int rsize, double fmax, double* in, double* out)
+FTOV create_ftov (int run, int size, int rate, int rsize, real fmax, real* in, real* out)
 {
     FTOV a = (FTOV) malloc0 (sizeof (ftov));
     a->run = run;
@@ -85,7 +85,7 @@ void xftov (FTOV a)
             a->rcount++;                                        // increment the count
         }
         if (++a->rptr == a->rsize) a->rptr = 0;                 // increment and wrap the pointer as needed
-        a->out[0] = min (1.0, (double)a->rcount / a->div);      // calculate the output sample
+        a->out[0] = min (1.0, (real)a->rcount / a->div);        // calculate the output sample
         a->inlast = a->in[a->size - 1];                         // save the last input sample for next buffer
         for (int i = 1; i < a->size; i++)
         {
@@ -101,7 +101,7 @@ void xftov (FTOV a)
                 a->rcount++;                                    // increment the count
             }
             if (++a->rptr == a->rsize) a->rptr = 0;             // increment and wrap the pointer as needed
-            a->out[i] = min(1.0, (double)a->rcount / a->div);   // calculate the output sample
+            a->out[i] = min(1.0, (real)a->rcount / a->div);     // calculate the output sample
         }
     }
 }
@@ -113,15 +113,15 @@ void xftov (FTOV a)
 void compute_ssql_slews(SSQL a)
 {
     int i;
-    double delta, theta;
-    delta = PI / (double)a->ntup;
+    real delta, theta;
+    delta = PI / (real)a->ntup;
     theta = 0.0;
     for (i = 0; i <= a->ntup; i++)
     {
         a->cup[i] = a->muted_gain + (1.0 - a->muted_gain) * 0.5 * (1.0 - cos(theta));
         theta += delta;
     }
-    delta = PI / (double)a->ntdown;
+    delta = PI / (real)a->ntdown;
     theta = 0.0;
     for (i = 0; i <= a->ntdown; i++)
     {
@@ -132,12 +132,12 @@ void compute_ssql_slews(SSQL a)
 
 void calc_ssql (SSQL a)
 {
-    a->b1 = (double*) malloc0 (a->size * sizeof (complex));
+    a->b1 = (real*) malloc0 (a->size * sizeof (complex));
     a->dcbl = create_cbl (1, a->size, a->in, a->b1, 0, a->rate, 0.02);
-    a->ibuff = (double*) malloc0 (a->size * sizeof (double));
-    a->ftovbuff = (double*) malloc0(a->size * sizeof (double));
+    a->ibuff = (real*) malloc0 (a->size * sizeof (real));
+    a->ftovbuff = (real*) malloc0(a->size * sizeof (real));
     a->cvtr = create_ftov (1, a->size, a->rate, a->ftov_rsize, a->ftov_fmax, a->ibuff, a->ftovbuff);
-    a->lpbuff = (double*) malloc0 (a->size * sizeof (double));
+    a->lpbuff = (real*) malloc0 (a->size * sizeof (real));
     a->filt = create_dbqlp (1, a->size, a->ftovbuff, a->lpbuff, a->rate, 11.3, 1.0, 1.0, 1);
     a->wdbuff = (int*) malloc0 (a->size * sizeof (int));
     a->tr_signal = (int*) malloc0 (a->size * sizeof (int));
@@ -151,8 +151,8 @@ void calc_ssql (SSQL a)
     // level change
     a->ntup = (int)(a->tup * a->rate);
     a->ntdown = (int)(a->tdown * a->rate);
-    a->cup = (double*) malloc0 ((a->ntup + 1) * sizeof (double));
-    a->cdown = (double*) malloc0 ((a->ntdown + 1) * sizeof (double));
+    a->cup = (real*) malloc0 ((a->ntup + 1) * sizeof (real));
+    a->cdown = (real*) malloc0 ((a->ntdown + 1) * sizeof (real));
     compute_ssql_slews (a);
     // control
     a->state = 0;
@@ -174,8 +174,8 @@ void decalc_ssql (SSQL a)
     _aligned_free (a->cup);
 }
 
-SSQL create_ssql (int run, int size, double* in, double* out, int rate, double tup, double tdown,
-    double muted_gain, double tau_mute, double tau_unmute, double wthresh, double tr_thresh, int rsize, double fmax)
+SSQL create_ssql (int run, int size, real* in, real* out, int rate, real tup, real tdown,
+    real muted_gain, real tau_mute, real tau_unmute, real wthresh, real tr_thresh, int rsize, real fmax)
 {
     SSQL a = (SSQL) malloc0 (sizeof (ssql));
     a->run = run;
@@ -210,10 +210,10 @@ void flush_ssql (SSQL a)
 
     memset (a->b1, 0, a->size * sizeof (complex));
     flush_cbl (a->dcbl);
-    memset (a->ibuff, 0, a->size * sizeof (double));
-    memset (a->ftovbuff, 0, a->size * sizeof (double));
+    memset (a->ibuff, 0, a->size * sizeof (real));
+    memset (a->ftovbuff, 0, a->size * sizeof (real));
     flush_ftov (a->cvtr);
-    memset (a->lpbuff, 0, a->size * sizeof (double));
+    memset (a->lpbuff, 0, a->size * sizeof (real));
     flush_dbqlp (a->filt);
     memset (a->wdbuff, 0, a->size * sizeof (int));
     memset (a->tr_signal, 0, a->size * sizeof (int));
@@ -299,7 +299,7 @@ void xssql (SSQL a)
         memcpy (a->out, a->in, a->size * sizeof(complex));
 }
 
-void setBuffers_ssql (SSQL a, double* in, double* out)
+void setBuffers_ssql (SSQL a, real* in, real* out)
 {
     decalc_ssql (a);
     a->in = in;
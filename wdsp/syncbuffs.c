@@ -32,7 +32,7 @@ void start_syncbthread (SYNCB a)
     SetThreadPriority (handle, THREAD_PRIORITY_HIGHEST);
 }
 
-SYNCB create_syncbuffs (int accept, int nstreams, int max_insize, int max_outsize, int outsize, double** out, void (*exf)(void))
+SYNCB create_syncbuffs (int accept, int nstreams, int max_insize, int max_outsize, int outsize, real** out, void (*exf)(void))
 {
     SYNCB a = (SYNCB) malloc0 (sizeof(syncb));
     int i;
@@ -49,9 +49,9 @@ SYNCB create_syncbuffs (int accept, int nstreams, int max_insize, int max_outsiz
     else
         a->r1_size = a->max_in_size;
     a->r1_active_buffsize = SYNCB_MULT * a->r1_size;
-    a->r1_baseptr = (double **) malloc0 (a->nstreams * sizeof (double *));
+    a->r1_baseptr = (real **) malloc0 (a->nstreams * sizeof (real *));
     for (i = 0; i < a->nstreams; i++)
-        a->r1_baseptr[i] = (double *) malloc0 (a->r1_active_buffsize * sizeof (complex));
+        a->r1_baseptr[i] = (real *) malloc0 (a->r1_active_buffsize * sizeof (complex));
     a->r1_inidx = 0;
     a->r1_outidx = 0;
     a->r1_unqueuedsamps = 0;
@@ -94,7 +94,7 @@ void flush_syncbuffs (SYNCB a)
     while (!WaitForSingleObject (a->Sem_BuffReady, 1)) ;
 }
 
-void Syncbound (SYNCB a, int nsamples, double** in)
+void Syncbound (SYNCB a, int nsamples, real** in)
 {
     int i, n;
     int first, second;
@@ -196,7 +196,7 @@ void SetSYNCBRingOutsize (SYNCB a, int size)
 *                                                                                                       *
 ********************************************************************************************************/
 
-DUMFILT create_dumfilt (int run, int delay, int opsize, double* in, double* out)
+DUMFILT create_dumfilt (int run, int delay, int opsize, real* in, real* out)
 {
     DUMFILT a = (DUMFILT) malloc0 (sizeof (dumfilt));
     a->run = run;
@@ -205,7 +205,7 @@ DUMFILT create_dumfilt (int run, int delay, int opsize, double* in, double* out)
     a->rsize = a->opsize + a->delay;
     a->in = in;
     a->out = out;
-    a->ring = (double *) malloc0 (a->rsize * sizeof (complex));
+    a->ring = (real *) malloc0 (a->rsize * sizeof (complex));
     a->outidx = 0;
     a->inidx = a->delay;
     return a;
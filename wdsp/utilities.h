@@ -26,25 +26,25 @@ warren@wpratt.com
 
 __declspec (dllexport) void *malloc0 (int size);
 
-extern void print_impulse (const char* filename, int N, double* impulse, int rtype, int pr_mode);
+extern void print_impulse (const char* filename, int N, real* impulse, int rtype, int pr_mode);
 
 extern __declspec (dllexport) void analyze_bandpass_filter (int N, double f_low, double f_high, double samplerate, int wintype, int rtype, double scale);
 
-void print_peak_val(const char* filename, int N, double* buff, double thresh);
+void print_peak_val(const char* filename, int N, real* buff, real thresh);
 
-void print_peak_env (const char* filename, int N, double* buff, double thresh);
+void print_peak_env (const char* filename, int N, real* buff, real thresh);
 
 extern void print_peak_env_f2 (const char* filename, int N, float* Ibuff, float* Qbuff);
 
-extern void print_iqc_values(const char* file, int state, double env_in, double I, double Q, double ym, double yc, double ys, double thresh);
+extern void print_iqc_values(const char* file, int state, real env_in, real I, real Q, real ym, real yc, real ys, real thresh);
 
-extern void print_meter (const char* filename, double* meter, int enum_av, int enum_pk, int enum_gain);
+extern void print_meter (const char* filename, real* meter, int enum_av, int enum_pk, int enum_gain);
 
 extern void print_message (const char* filename, const char* message, int p0, int p1, int p2);
 
-extern void print_window_gain (const char* filename, int wintype, double inv_coherent_gain, double inherent_gain);
+extern void print_window_gain (const char* filename, int wintype, real inv_coherent_gain, real inherent_gain);
 
-extern void print_deviation (const char* filename, double dpmax, double rate);
+extern void print_deviation (const char* filename, real dpmax, real rate);
 
 extern void doCalccPrintSamples(int channel);
 
@@ -52,10 +52,10 @@ __declspec (dllexport) void print_buffer_parameters (const char* filename, int c
 
 extern void print_anb_parms (const char* filename, ANB a);
 
-extern void WriteAudioWDSP(double seconds, int rate, int size, double* indata, int mode, double gain);
+extern void WriteAudioWDSP(real seconds, int rate, int size, real* indata, int mode, real gain);
 
 extern void WriteScaledAudio (
-    double seconds,         // number of seconds of audio to record
+    real seconds,           // number of seconds of audio to record
     int rate,               // sample rate
     int size,               // incoming buffer size
-    double* indata );       // pointer to incoming data buffer
+    real* indata );         // pointer to incoming data buffer
@@ -39,64 +39,64 @@ typedef struct _wcpagc
     int run;
     int mode;
     int pmode;
-    double* in;
-    double* out;
+    real* in;
+    real* out;
     int io_buffsize;
-    double sample_rate;
+    double sample_rate;         // double in all builds: in float, ceil(48000 * 4 * 0.001f) is 193
 
     double tau_attack;
-    double tau_decay;
+    real tau_decay;
     int n_tau;
-    double max_gain;
-    double var_gain;
-    double fixed_gain;
-    double min_volts;
-    double max_input;
-    double out_targ;
-    double out_target;
-    double inv_max_input;
-    double slope_constant;
-
-    double gain;
-    double inv_out_target;
+    real max_gain;
+    real var_gain;
+    real fixed_gain;
+    real min_volts;
+    real max_input;
+    real out_targ;
+    real out_target;
+    real inv_max_input;
+    real slope_constant;
+
+    real gain;
+    real inv_out_target;
 
     int out_index;
     int in_index;
     int attack_buffsize;
 
-    double* ring;
-    double* abs_ring;
+    real* ring;
+    real* abs_ring;
     int ring_buffsize;
-    double ring_max;
-
-    double attack_mult;
-    double decay_mult;
-    double volts;
-    double save_volts;
-    double out_sample[2];
-    double abs_out_sample;
+    real ring_max;
+
+    real attack_mult;
+    real decay_mult;
+    real volts;
+    real save_volts;
+    real out_sample[2];
+    real abs_out_sample;
     int state;
 
-    double tau_fast_backaverage;
-    double fast_backmult;
-    double onemfast_backmult;
-    double fast_backaverage;
-    double tau_fast_decay;
-    double fast_decay_mult;
-    double pop_ratio;
+    real tau_fast_backaverage;
+    real fast_backmult;
+    real onemfast_backmult;
+    real fast_backaverage;
+    real tau_fast_decay;
+    real fast_decay_mult;
+    real pop_ratio;
 
     int hang_enable;
-    double hang_backaverage;
-    double tau_hang_backmult;
-    double hang_backmult;
-    double onemhang_backmult;
+    real hang_backaverage;
+    real tau_hang_backmult;
+    real hang_backmult;
+    real onemhang_backmult;
     int hang_counter;
-    double hangtime;
-    double hang_thresh;
-    double hang_level;
+    real hangtime;
+    real hang_thresh;
+    real hang_level;
 
-    double tau_hang_decay;
-    double hang_decay_mult;
+    real tau_hang_decay;
+    real hang_decay_mult;
     int decay_type;
 } wcpagc, *WCPAGC;
 
@@ -107,33 +107,33 @@ extern void xwcpagc (WCPAGC a);
 extern WCPAGC create_wcpagc (   int run,
                                 int mode,
                                 int pmode,
-                                double* in,
-                                double* out,
+                                real* in,
+                                real* out,
                                 int io_buffsize,
                                 int sample_rate,
                                 double tau_attack,
-                                double tau_decay,
+                                real tau_decay,
                                 int n_tau,
-                                double max_gain,
-                                double var_gain,
-                                double fixed_gain,
-                                double max_input,
-                                double out_targ,
-                                double tau_fast_backaverage,
-                                double tau_fast_decay,
-                                double pop_ratio,
+                                real max_gain,
+                                real var_gain,
+                                real fixed_gain,
+                                real max_input,
+                                real out_targ,
+                                real tau_fast_backaverage,
+                                real tau_fast_decay,
+                                real pop_ratio,
                                 int hang_enable,
-                                double tau_hang_backmult,
-                                double hangtime,
-                                double hang_thresh,
-                                double tau_hang_decay
+                                real tau_hang_backmult,
+                                real hangtime,
+                                real hang_thresh,
+                                real tau_hang_decay
                                 );
 
 extern void destroy_wcpagc (WCPAGC a);
 
 extern void flush_wcpagc (WCPAGC a);
 
-extern void setBuffers_wcpagc (WCPAGC a, double* in, double* out);
+extern void setBuffers_wcpagc (WCPAGC a, real* in, real* out);
 
 extern void setSamplerate_wcpagc (WCPAGC a, int rate);
 
@@ -4,9 +4,23 @@
 extern "C" {
 #endif
 
+//
+// Sample buffers and tables passed by pointer are of type WDSP_REAL, which
+// is float if WDSP has been compiled with -DWDSP_FLOAT, and double otherwise.
+// Scalar parameters and return values (also those returned via a pointer)
+// are always double.
+//
+#ifndef WDSP_REAL
+#ifdef WDSP_FLOAT
+#define WDSP_REAL float
+#else
+#define WDSP_REAL double
+#endif
+#endif
+
 #define INREAL    float
 #define OUTREAL   float
-#define dINREAL   float
+#define dINREAL   WDSP_REAL
 #define dOUTREAL  float
 #define DWORD     unsigned long
 
@@ -171,23 +185,23 @@ extern void GetPixels   (   int disp,
 extern void SnapSpectrum(   int disp,
                     int ss,
                     int LO,
-                    double *snap_buff);
+                    WDSP_REAL *snap_buff);
 extern void SnapSpectrumTimeout(int disp,
     int ss,
     int LO,
-    double* snap_buff,
+    WDSP_REAL* snap_buff,
     DWORD timeout,
     int* flag);
 extern void SetCalibration (    int disp,
                         int set_num,
                         int n_points,
-                        double (*cal)[dMAX_M+1]
+                        WDSP_REAL (*cal)[dMAX_M+1]
                     );
 extern void OpenBuffer(int disp, int ss, int LO, void **Ipointer, void **Qpointer);
 extern void CloseBuffer(int disp, int ss, int LO);
 extern void Spectrum(int disp, int ss, int LO, dINREAL* pI, dINREAL* pQ);
 extern void Spectrum2(int run, int disp, int ss, int LO, dINREAL* pbuff);
-extern void Spectrum0(int run, int disp, int ss, int LO, double* pbuff);
+extern void Spectrum0(int run, int disp, int ss, int LO, WDSP_REAL* pbuff);
 extern void SetDisplayDetectorMode (int disp, int pixout, int mode);
 extern void SetDisplayAverageMode (int disp, int pixout, int mode);
 extern void SetDisplayNumAverage (int disp, int pixout, int num);
@@ -244,7 +258,7 @@ extern void SetTXABandpassMP (int channel, int mp);
 // Interfaces from calcc.c
 //
 
-extern void pscc (int channel, int size, double* tx, double* rx);
+extern void pscc (int channel, int size, WDSP_REAL* tx, WDSP_REAL* rx);
 extern void psccF (int channel, int size, float *Itxbuff, float *Qtxbuff, float *Irxbuff, float *Qrxbuff, int mox, int solidmox);
 extern void PSSaveCorr (int channel, char* filename);
 extern void PSRestoreCorr (int channel, char* filename);
@@ -263,7 +277,7 @@ extern void SetPSHWPeak (int channel, double peak);
 extern void GetPSHWPeak (int channel, double* peak);
 extern void GetPSMaxTX (int channel, double* maxtx);
 extern void SetPSPtol (int channel, double ptol);
-extern void GetPSDisp (int channel, double* x, double* ym, double* yc, double* ys, double* cm, double* cc, double* cs);
+extern void GetPSDisp (int channel, WDSP_REAL* x, WDSP_REAL* ym, WDSP_REAL* yc, WDSP_REAL* ys, WDSP_REAL* cm, WDSP_REAL* cc, WDSP_REAL* cs);
 extern void SetPSFeedbackRate (int channel, int rate);
 extern void SetPSPinMode (int channel, int pin);
 extern void SetPSMapMode (int channel, int map);
@@ -282,11 +296,11 @@ extern  void SetRXACBLRun(int channel, int setit);
 
 extern void SetTXACFCOMPRun (int channel, int run);
 extern void SetTXACFCOMPPosition (int channel, int pos);
-extern void SetTXACFCOMPprofile (int channel, int nfreqs, double* F, double* G, double *E);
+extern void SetTXACFCOMPprofile (int channel, int nfreqs, WDSP_REAL* F, WDSP_REAL* G, WDSP_REAL *E);
 extern void SetTXACFCOMPPrecomp (int channel, double precomp);
 extern void SetTXACFCOMPPeqRun (int channel, int run);
 extern void SetTXACFCOMPPrePeq (int channel, double prepeq);
-extern void GetTXACFCOMPDisplayCompression (int channel, double* comp_values, int* ready);
+extern void GetTXACFCOMPDisplayCompression (int channel, WDSP_REAL* comp_values, int* ready);
 
 //
 // Interfaces from cfir.c
@@ -326,7 +340,7 @@ extern  void SetTXACompressorGain (int channel, double gain);
 // Interfaces from dexp.c
 //
 
-extern void create_dexp (int id, int run_dexp, int size, double* in, double* out, int rate, double dettau, double tattack, double tdecay,
+extern void create_dexp (int id, int run_dexp, int size, WDSP_REAL* in, WDSP_REAL* out, int rate, double dettau, double tattack, double tdecay,
     double thold, double exp_ratio, double hyst_ratio, double attack_thresh, int nc, int wtype, double lowcut, double highcut,
     int run_filt, int run_vox, int run_audelay, double audelay, void (__stdcall *pushvox)(int id, int active),
     int antivox_run, int antivox_size, int antivox_rate, double antivox_gain, double antivox_tau);
@@ -336,7 +350,7 @@ extern void xdexp (int id);
 extern void SendCBPushDexpVox (int id, void (__stdcall *pushvox)(int id, int active));
 extern void SetDEXPRun (int id, int run);
 extern void SetDEXPSize (int id, int size);
-extern void SetDEXPIOBuffers (int id, double* in, double* out);
+extern void SetDEXPIOBuffers (int id, WDSP_REAL* in, WDSP_REAL* out);
 extern void SetDEXPRate (int id, double rate);
 extern void SetDEXPDetectorTau (int id, double tau);
 extern void SetDEXPAttackTime (int id, double time);
@@ -359,7 +373,7 @@ extern void SetAntiVOXSize (int id, int size);
 extern void SetAntiVOXRate (int id, double rate);
 extern void SetAntiVOXGain (int id, double gain);
 extern void SetAntiVOXDetectorTau (int id, double tau);
-extern void SendAntiVOXData (int id, int nsamples, double* data);
+extern void SendAntiVOXData (int id, int nsamples, WDSP_REAL* data);
 
 //
 // Interfaces from div.c
@@ -368,19 +382,19 @@ extern void SendAntiVOXData (int id, int nsamples, double* data);
 extern void create_divEXT (int id, int run, int nr, int size);
 extern void destroy_divEXT (int id);
 extern void flush_divEXT (int id);
-extern void xdivEXT (int id, int nsamples, double **in, double *out);
+extern void xdivEXT (int id, int nsamples, WDSP_REAL **in, WDSP_REAL *out);
 extern void SetEXTDIVRun (int id, int run);
 extern void SetEXTDIVBuffsize (int id, int size);
 extern void SetEXTDIVNr (int id, int nr);
 extern void SetEXTDIVOutput (int id, int output);
-extern void SetEXTDIVRotate (int id, int nr, double *Irotate, double *Qrotate);
+extern void SetEXTDIVRotate (int id, int nr, WDSP_REAL *Irotate, WDSP_REAL *Qrotate);
 extern void xdivEXTF (int id, int size, float **input, float *Iout, float *Qout);
 
 //
 // Interfaces from eer.c
 //
 
-extern EER create_eer (int run, int size, double* in, double* out, double* outM, int rate, double mgain, double pgain, int rundelays, double mdelay, double pdelay, int amiq);
+extern EER create_eer (int run, int size, WDSP_REAL* in, WDSP_REAL* out, WDSP_REAL* outM, int rate, double mgain, double pgain, int rundelays, double mdelay, double pdelay, int amiq);
 extern void destroy_eer (EER a);
 extern void flush_eer (EER a);
 extern void xeer (EER a);
@@ -436,7 +450,7 @@ extern void SetTXAFMEmphPosition (int channel, int position);
 extern void SetRXAEQRun (int channel, int run);
 extern void SetRXAEQNC (int channel, int nc);
 extern void SetRXAEQMP (int channel, int mp);
-extern void SetRXAEQProfile (int channel, int nfreqs, double* F, double* G);
+extern void SetRXAEQProfile (int channel, int nfreqs, WDSP_REAL* F, WDSP_REAL* G);
 extern void SetRXAEQCtfmode (int channel, int mode);
 extern void SetRXAEQWintype (int channel, int wintype);
 extern void SetRXAGrphEQ (int channel, int *rxeq);
@@ -444,19 +458,19 @@ extern void SetRXAGrphEQ10 (int channel, int *rxeq);
 extern void SetTXAEQRun (int channel, int run);
 extern void SetTXAEQNC (int channel, int nc);
 extern void SetTXAEQMP (int channel, int mp);
-extern void SetTXAEQProfile (int channel, int nfreqs, double* F, double* G);
+extern void SetTXAEQProfile (int channel, int nfreqs, WDSP_REAL* F, WDSP_REAL* G);
 extern void SetTXAEQCtfmode (int channel, int mode);
 extern void SetTXAEQWintype (int channel, int wintype);
 extern void SetTXAGrphEQ (int channel, int *txeq);
 extern void SetTXAGrphEQ10 (int channel, int *txeq);
 extern void SetRXAEQRun (int channel, int run);
-extern void SetRXAEQProfile (int channel, int nfreqs, double* F, double* G);
+extern void SetRXAEQProfile (int channel, int nfreqs, WDSP_REAL* F, WDSP_REAL* G);
 extern void SetRXAEQCtfmode (int channel, int mode);
 extern void SetRXAEQWintype (int channel, int wintype);
 extern void SetRXAGrphEQ (int channel, int *rxeq);
 extern void SetRXAGrphEQ10 (int channel, int *rxeq);
 extern void SetTXAEQRun (int channel, int run);
-extern void SetTXAEQProfile (int channel, int nfreqs, double* F, double* G);
+extern void SetTXAEQProfile (int channel, int nfreqs, WDSP_REAL* F, WDSP_REAL* G);
 extern void SetTXAEQCtfmode (int channel, int mode);
 extern void SetTXAEQMethod (int channel, int wintype);
 extern void SetTXAGrphEQ (int channel, int *txeq);
@@ -501,7 +515,7 @@ extern void SetRXAFMSQMP (int channel, int mp);
 // Interfaces from gain.c
 //
 
-extern GAIN create_gain (int run, int* prun, int size, double* in, double* out, double Igain, double Qgain);
+extern GAIN create_gain (int run, int* prun, int size, WDSP_REAL* in, WDSP_REAL* out, double Igain, double Qgain);
 extern void destroy_gain (GAIN a);
 extern void flush_gain (GAIN a);
 extern void xgain (GAIN a);
@@ -571,19 +585,26 @@ extern void SetTXAPHROTReverse (int channel, int reverse);
 // Interfaces from iobuffs.c
 //
 
-extern void fexchange0 (int channel, double* in, double* out, int* error);
+extern void fexchange0 (int channel, WDSP_REAL* in, WDSP_REAL* out, int* error);
 extern void fexchange2 (int channel, INREAL *Iin, INREAL *Qin, OUTREAL *Iout, OUTREAL *Qout, int* error);
 
 //
 // Interfaces from iqc.c
 //
 
-extern void GetTXAiqcValues (int channel, double* cm, double* cc, double* cs);
-extern void SetTXAiqcValues (int channel, double* cm, double* cc, double* cs);
-extern void SetTXAiqcSwap (int channel, double* cm, double* cc, double* cs);
-extern void SetTXAiqcStart (int channel, double* cm, double* cc, double* cs);
+extern void GetTXAiqcValues (int channel, WDSP_REAL* cm, WDSP_REAL* cc, WDSP_REAL* cs);
+extern void SetTXAiqcValues (int channel, WDSP_REAL* cm, WDSP_REAL* cc, WDSP_REAL* cs);
+extern void SetTXAiqcSwap (int channel, WDSP_REAL* cm, WDSP_REAL* cc, WDSP_REAL* cs);
+extern void SetTXAiqcStart (int channel, WDSP_REAL* cm, WDSP_REAL* cc, WDSP_REAL* cs);
 extern void SetTXAiqcEnd (int channel);
 
+//
+// Interfaces from linux_port.c
+//
+
+extern void WorkQueueStatistics (int *workers, long *depth, long *max_depth, long long *jobs, long long *overflows,
+                                 double *avg_latency, double *max_latency);
+
 //
 // Interfaces from meter.c
 //
@@ -618,8 +639,8 @@ extern void RXANBPSetAutoIncrease (int channel, int autoincr);
 extern ANB create_anb   (
     int run,
     int buffsize,
-    double* in,
-    double* out,
+    WDSP_REAL* in,
+    WDSP_REAL* out,
     double samplerate,
     double tau,
     double hangtime,
@@ -651,7 +672,7 @@ extern void create_anbEXT   (
                     );
 extern void destroy_anbEXT (int id);
 extern void flush_anbEXT (int id);
-extern void xanbEXT (int id, double* in, double* out);
+extern void xanbEXT (int id, WDSP_REAL* in, WDSP_REAL* out);
 extern void SetEXTANBRun (int id, int run);
 extern void SetEXTANBBuffsize (int id, int size);
 extern void SetEXTANBSamplerate (int id, int rate);
@@ -669,8 +690,8 @@ extern void xanbEXTF (int id, float *I, float *Q);
 extern NOB create_nob (
     int run,
     int buffsize,
-    double* in,
-    double* out,
+    WDSP_REAL* in,
+    WDSP_REAL* out,
     double samplerate,
     int mode,
     double advslewtime,
@@ -707,7 +728,7 @@ extern void create_nobEXT   (
                     );
 extern void destroy_nobEXT (int id);
 extern void flush_nobEXT (int id);
-extern void xnobEXT (int id, double* in, double* out);
+extern void xnobEXT (int id, WDSP_REAL* in, WDSP_REAL* out);
 extern void SetEXTNOBRun (int id, int run);
 extern void SetEXTNOBMode (int id, int mode);
 extern void SetEXTNOBBuffsize (int id, int size);
@@ -744,12 +765,12 @@ extern void SetTXAPanelSelect (int channel, int select);
 // Interfaces from resample.c
 //
 
-extern RESAMPLE create_resample ( int run, int size, double* in, double* out, int in_rate, int out_rate, double fc, int ncoef, double gain);
+extern RESAMPLE create_resample ( int run, int size, WDSP_REAL* in, WDSP_REAL* out, int in_rate, int out_rate, double fc, int ncoef, double gain);
 extern void destroy_resample (RESAMPLE a);
 extern void flush_resample (RESAMPLE a);
 extern int xresample (RESAMPLE a);
 extern void* create_resampleV (int in_rate, int out_rate);
-extern void xresampleV (double* input, double* output, int numsamps, int* outsamps, void* ptr);
+extern void xresampleV (WDSP_REAL* input, WDSP_REAL* output, int numsamps, int* outsamps, void* ptr);
 extern void destroy_resampleV (void* ptr);
 extern void* create_resampleFV (int in_rate, int out_rate);
 extern void xresampleFV (float* input, float* output, int numsamps, int* outsamps, void* ptr);
@@ -759,8 +780,8 @@ extern void destroy_resampleFV (void* ptr);
 // Interfaces from rmatch.c
 //
 
-extern void xrmatchIN (void* b, double* in);
-extern void xrmatchOUT (void* b, double* out);
+extern void xrmatchIN (void* b, WDSP_REAL* in);
+extern void xrmatchOUT (void* b, WDSP_REAL* out);
 extern void getRMatchDiags (void* b, int* underflows, int* overflows, double* var, int* ringsize, int* nring);
 extern void resetRMatchDiags (void* b);
 extern void forceRMatchVar (void* b, int force, double fvar);
@@ -811,7 +832,7 @@ extern void TXAGetSpecF1 (int channel, float* out);
 extern void create_siphonEXT (int id, int run, int insize, int sipsize, int fftsize, int specmode);
 extern void destroy_siphonEXT (int id);
 extern void flush_siphonEXT (int id);
-extern void xsiphonEXT (int id, double* buff);
+extern void xsiphonEXT (int id, WDSP_REAL* buff);
 extern void GetaSipF1EXT (int id, float* out, int size);
 extern void SetSiphonInsize (int id, int size);
 
@@ -863,7 +884,7 @@ extern void print_buffer_parameters (const char* filename, int channel);
 //
 
 extern void* create_varsampV (int in_rate, int out_rate, int R);
-extern void xvarsampV (double* input, double* output, int numsamps, double var, int* outsamps, void* ptr);
+extern void xvarsampV (WDSP_REAL* input, WDSP_REAL* output, int numsamps, double var, int* outsamps, void* ptr);
 extern void destroy_varsampV (void* ptr);
 
 //
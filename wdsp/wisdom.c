@@ -26,7 +26,66 @@ warren@wpratt.com
 
 #define _CRT_SECURE_NO_WARNINGS
 #include "comm.h"
+#include <stdio.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+// FFTW wisdom management
+//
+// The wisdom is kept in a file whose name contains a hash of the CPU model and
+// its SIMD features, so a props directory copied to another machine does not
+// import wisdom measured elsewhere.  The plan shapes requested at run time are
+// recorded in a second file, such that in the next session they are planned
+// (if necessary) before the generic power-of-two sizes.
+//
+// WDSPwisdom() only imports the wisdom file and returns.  Shapes for which there
+// is no wisdom yet are planned with FFTW_PATIENT in a child process with low
+// priority.  Since the FFTW planner is not thread-safe, all planner calls of this
+// process are serialized by plan_lock; doing the patient planning in a separate
+// process means that plan_lock is never held for longer than it takes to make a
+// plan from wisdom or with FFTW_ESTIMATE.  When the child has finished, the
+// wisdom file it has written is imported.
+
+enum _wisdom_kind
+{
+    WISDOM_C_FWD,
+    WISDOM_C_BWD,
+    WISDOM_R2C,
+    WISDOM_C2R
+};
+
+typedef struct _wisdom_shape
+{
+    int kind;
+    int n;
+    int inplace;
+    int runtime;        // requested at run time (in this or an earlier session)
+    int done;           // wisdom is available, or planning has been tried
+} WISDOM_SHAPE;
 
+#define MAX_WISDOM_SHAPES 512
+
+static WISDOM_SHAPE shapes[MAX_WISDOM_SHAPES];
+static int nshapes = 0;
+static int shapes_dirty = 0;
+static pthread_mutex_t shape_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t shape_cond = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t plan_lock = PTHREAD_MUTEX_INITIALIZER;
+static int planner_started = 0;
+
+static char wisdom_file[1024];
+static char shapes_file[1024];
 static char status[128];
 
 PORT
@@ -35,87 +94,356 @@ char* wisdom_get_status()
     return status;
 }
 
+// Add a shape to the list, if it is not already there.  Returns 1 if the
+// shape has been added.  Must be called with shape_lock held.
+static int add_shape (int kind, int n, int inplace, int runtime)
+{
+    int i;
+    for (i = 0; i < nshapes; i++)
+    {
+        if (shapes[i].kind == kind && shapes[i].n == n && shapes[i].inplace == inplace)
+        {
+            if (runtime && !shapes[i].runtime)
+            {
+                shapes[i].runtime = 1;
+                shapes_dirty = 1;
+            }
+            return 0;
+        }
+    }
+    if (nshapes >= MAX_WISDOM_SHAPES) return 0;
+    shapes[nshapes].kind = kind;
+    shapes[nshapes].n = n;
+    shapes[nshapes].inplace = inplace;
+    shapes[nshapes].runtime = runtime;
+    shapes[nshapes].done = 0;
+    nshapes++;
+    if (runtime) shapes_dirty = 1;
+    return 1;
+}
+
+static void record_shape (int kind, int n, int inplace)
+{
+    pthread_mutex_lock (&shape_lock);
+    if (add_shape (kind, n, inplace, 1))
+        pthread_cond_signal (&shape_cond);
+    pthread_mutex_unlock (&shape_lock);
+}
+
+static fftw_plan plan_shape (const WISDOM_SHAPE* s, void* in, void* out, unsigned flags)
+{
+    if (s->inplace) out = in;
+    switch (s->kind)
+    {
+    case WISDOM_C_FWD:
+        return fftw_plan_dft_1d (s->n, (fftw_complex *)in, (fftw_complex *)out, FFTW_FORWARD, flags);
+    case WISDOM_C_BWD:
+        return fftw_plan_dft_1d (s->n, (fftw_complex *)in, (fftw_complex *)out, FFTW_BACKWARD, flags);
+    case WISDOM_R2C:
+        return fftw_plan_dft_r2c_1d (s->n, (real *)in, (fftw_complex *)out, flags);
+    default:
+        return fftw_plan_dft_c2r_1d (s->n, (fftw_complex *)in, (real *)out, flags);
+    }
+}
+
+// Plan creation used by WDSP
+
 PORT
-void WDSPwisdom (char* directory)
+fftw_plan wisdom_plan_dft_1d (int n, fftw_complex* in, fftw_complex* out, int sign)
 {
-    fftw_plan tplan;
-    int psize;
-#ifdef _WIN32
-    FILE *stream;
-#endif
-    double* fftin;
-    double* fftout;
-    char wisdom_file[1024];
-    const int maxsize = max (MAX_WISDOM_SIZE_DISPLAY, MAX_WISDOM_SIZE_FILTER + 1);
-    strcpy (wisdom_file, directory);
-    strncat (wisdom_file, "wdspWisdom00", 16);
-    if(!fftw_import_wisdom_from_filename(wisdom_file))
+    fftw_plan p;
+    record_shape (sign == FFTW_FORWARD ? WISDOM_C_FWD : WISDOM_C_BWD, n, in == out);
+    pthread_mutex_lock (&plan_lock);
+    p = fftw_plan_dft_1d (n, in, out, sign, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+    if (!p) p = fftw_plan_dft_1d (n, in, out, sign, FFTW_ESTIMATE);
+    pthread_mutex_unlock (&plan_lock);
+    return p;
+}
+
+PORT
+fftw_plan wisdom_plan_dft_r2c_1d (int n, real* in, fftw_complex* out)
+{
+    fftw_plan p;
+    record_shape (WISDOM_R2C, n, (void *)in == (void *)out);
+    pthread_mutex_lock (&plan_lock);
+    p = fftw_plan_dft_r2c_1d (n, in, out, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+    if (!p) p = fftw_plan_dft_r2c_1d (n, in, out, FFTW_ESTIMATE);
+    pthread_mutex_unlock (&plan_lock);
+    return p;
+}
+
+PORT
+fftw_plan wisdom_plan_dft_c2r_1d (int n, fftw_complex* in, real* out)
+{
+    fftw_plan p;
+    record_shape (WISDOM_C2R, n, (void *)in == (void *)out);
+    pthread_mutex_lock (&plan_lock);
+    p = fftw_plan_dft_c2r_1d (n, in, out, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+    if (!p) p = fftw_plan_dft_c2r_1d (n, in, out, FFTW_ESTIMATE);
+    pthread_mutex_unlock (&plan_lock);
+    return p;
+}
+
+PORT
+void wisdom_destroy_plan (fftw_plan p)
+{
+    pthread_mutex_lock (&plan_lock);
+    fftw_destroy_plan (p);
+    pthread_mutex_unlock (&plan_lock);
+}
+
+// CPU key: FNV-1a hash of the CPU model name(s) and the SIMD features
+
+static unsigned int hash_string (unsigned int h, const char* s)
+{
+    while (*s)
     {
-        fftin =  (double *) malloc0 (maxsize * sizeof (complex));
-        fftout = (double *) malloc0 (maxsize * sizeof (complex));
-#ifdef _WIN32
-        AllocConsole();                             // create console
-        freopen_s(&stream, "conout$", "w", stdout); // redirect output to console
-#endif
-        fprintf(stdout, "Optimizing FFT sizes through %d\n\n", maxsize);
-        fprintf(stdout, "Please do not close this window until wisdom plans are completed.\n\n");
-        sprintf(status, "Optimizing FFT sizes through %d", maxsize);
-#ifdef __ANDROID__
-        utf8 = (*env)->NewStringUTF(env,status);
-        (*env)->CallVoidMethod(env, obj, update, utf8);
-#endif
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
 
-        psize = 64;
-        while (psize <= MAX_WISDOM_SIZE_FILTER)
+static unsigned int cpu_key (void)
+{
+    unsigned int h = 2166136261u;
+    char line[256];
+#ifdef __APPLE__
+    size_t len = sizeof (line);
+    if (sysctlbyname ("machdep.cpu.brand_string", line, &len, NULL, 0) == 0)
+        h = hash_string (h, line);
+#else
+    FILE* fp = fopen ("/proc/cpuinfo", "r");
+    if (fp)
+    {
+        // x86: "model name", ARM: "CPU implementer", "CPU part", "Model"
+        while (fgets (line, sizeof (line), fp))
         {
-            fprintf(stdout, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
-            fflush(stdout);
-            sprintf(status, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
-            tplan = fftw_plan_dft_1d(psize, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_FORWARD, FFTW_PATIENT);
-            fftw_execute (tplan);
-            fftw_destroy_plan (tplan);
-            fprintf(stdout, "Planning COMPLEX BACKWARD FFT size %d\n", psize);
-            fflush(stdout);
-            sprintf(status, "Planning COMPLEX BACKWARD FFT size %d\n", psize);
-            tplan = fftw_plan_dft_1d(psize, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_BACKWARD, FFTW_PATIENT);
-            fftw_execute (tplan);
-            fftw_destroy_plan (tplan);
-            fprintf(stdout, "Planning COMPLEX BACKWARD FFT size %d\n", psize + 1);
-            fflush(stdout);
-            sprintf(status, "Planning COMPLEX BACKWARD FFT size %d\n", psize + 1);
-            tplan = fftw_plan_dft_1d(psize + 1, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_BACKWARD, FFTW_PATIENT);
-            fftw_execute (tplan);
-            fftw_destroy_plan (tplan);
-            psize *= 2;
+            if (strncmp (line, "model name", 10) == 0 || strncmp (line, "CPU implementer", 15) == 0 ||
+                strncmp (line, "CPU part", 8) == 0 || strncmp (line, "Model", 5) == 0)
+                h = hash_string (h, line);
         }
-        psize = 64;
-        while (psize <= MAX_WISDOM_SIZE_DISPLAY)
+        fclose (fp);
+    }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx"))     h = hash_string (h, "avx");
+    if (__builtin_cpu_supports ("avx2"))    h = hash_string (h, "avx2");
+    if (__builtin_cpu_supports ("fma"))     h = hash_string (h, "fma");
+    if (__builtin_cpu_supports ("avx512f")) h = hash_string (h, "avx512f");
+#endif
+#if defined(__aarch64__)
+    h = hash_string (h, "neon");
+#endif
+    return h;
+}
+
+static void load_shapes (void)
+{
+    FILE* fp = fopen (shapes_file, "r");
+    int kind, n, inplace;
+    if (!fp) return;
+    pthread_mutex_lock (&shape_lock);
+    while (fscanf (fp, "%d %d %d", &kind, &n, &inplace) == 3)
+    {
+        if (kind >= WISDOM_C_FWD && kind <= WISDOM_C2R && n > 0 && n <= 2 * MAX_WISDOM_SIZE_DISPLAY)
+            add_shape (kind, n, inplace != 0, 1);
+    }
+    shapes_dirty = 0;
+    pthread_mutex_unlock (&shape_lock);
+    fclose (fp);
+}
+
+// Must be called with shape_lock held
+static void save_shapes (void)
+{
+    int i;
+    FILE* fp = fopen (shapes_file, "w");
+    if (!fp) return;
+    for (i = 0; i < nshapes; i++)
+        if (shapes[i].runtime)
+            fprintf (fp, "%d %d %d\n", shapes[i].kind, shapes[i].n, shapes[i].inplace);
+    fclose (fp);
+    shapes_dirty = 0;
+}
+
+// The power-of-two sizes that have always been planned by WDSPwisdom
+static void add_generic_shapes (void)
+{
+    int psize;
+    pthread_mutex_lock (&shape_lock);
+    for (psize = 64; psize <= MAX_WISDOM_SIZE_FILTER; psize *= 2)
+    {
+        add_shape (WISDOM_C_FWD, psize, 0, 0);
+        add_shape (WISDOM_C_BWD, psize, 0, 0);
+        add_shape (WISDOM_C_BWD, psize + 1, 0, 0);
+    }
+    for (psize = 64; psize <= MAX_WISDOM_SIZE_DISPLAY; psize *= 2)
+    {
+        if (psize > MAX_WISDOM_SIZE_FILTER)
+            add_shape (WISDOM_C_FWD, psize, 0, 0);
+        add_shape (WISDOM_R2C, psize, 0, 0);
+    }
+    pthread_mutex_unlock (&shape_lock);
+}
+
+// The child inherits every file descriptor of the parent (radio sockets, the
+// listening sockets of the CAT and client/server code, audio devices).  They are
+// closed first thing, such that a child that outlives the parent (there is no
+// PR_SET_PDEATHSIG on macOS) keeps no ports bound.  stdin/stdout/stderr stay.
+static void close_inherited_fds (void)
+{
+    long fd, max;
+#if defined(__linux__) && defined(SYS_close_range)
+    if (syscall (SYS_close_range, 3U, ~0U, 0U) == 0) return;
+#endif
+    max = sysconf (_SC_OPEN_MAX);
+    if (max < 0 || max > 65536) max = 65536;
+    for (fd = 3; fd < max; fd++)
+        close ((int)fd);
+}
+
+// Runs in the child process: patiently plan the shapes in list[] (shapes
+// requested at run time first), and write the wisdom file after each one
+// such that nothing is lost if the program terminates in-between.
+// The child has been forked from a multi-threaded process, so it must not
+// touch stdout (another thread may have held its lock at the time of the
+// fork).  It returns the number of shapes planned, which becomes its exit
+// status and is reported by the parent.
+static int plan_in_child (int* list, int count)
+{
+    char tmp_file[1100];
+    int pass, i;
+    int planned = 0;
+    snprintf (tmp_file, sizeof (tmp_file), "%s.tmp", wisdom_file);
+    (void) setpriority (PRIO_PROCESS, 0, 19);
+    for (pass = 1; pass >= 0; pass--)
+    {
+        for (i = 0; i < count; i++)
         {
-            if (psize > MAX_WISDOM_SIZE_FILTER)
+            WISDOM_SHAPE* s = &shapes[list[i]];
+            void *in, *out;
+            fftw_plan p;
+            if (s->runtime != pass) continue;
+            in  = fftw_malloc ((s->n + 2) * sizeof (complex));
+            out = fftw_malloc ((s->n + 2) * sizeof (complex));
+            if (in && out && (p = plan_shape (s, in, out, FFTW_PATIENT | FFTW_WISDOM_ONLY)) != NULL)
+            {
+                fftw_destroy_plan (p);
+            }
+            else if (in && out)
             {
-                fprintf(stdout, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
-                fflush(stdout);
-                sprintf(status, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
-                tplan = fftw_plan_dft_1d(psize, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_FORWARD, FFTW_PATIENT);
-                fftw_execute (tplan);
-                fftw_destroy_plan (tplan);
+                p = plan_shape (s, in, out, FFTW_PATIENT);
+                if (p) fftw_destroy_plan (p);
+                if (fftw_export_wisdom_to_filename (tmp_file))
+                    rename (tmp_file, wisdom_file);
+                planned++;
             }
-            fprintf(stdout, "Planning REAL    FORWARD  FFT size %d\n", psize);
-            fflush(stdout);
-            sprintf(status, "Planning REAL    FORWARD  FFT size %d\n", psize);
-            tplan = fftw_plan_dft_r2c_1d(psize, fftin, (fftw_complex *)fftout, FFTW_PATIENT);
-            fftw_execute (tplan);
-            fftw_destroy_plan (tplan);
-            psize *= 2;
+            fftw_free (in);
+            fftw_free (out);
         }
-        fprintf(stdout, "\nFFTW planning complete.\n");
-        fflush(stdout);
-        sprintf(status, "\nFFTW planning complete.\n");
-        fftw_export_wisdom_to_filename(wisdom_file);
-        _aligned_free (fftout);
-        _aligned_free (fftin);
-#ifdef _WIN32
-        FreeConsole();                          // dismiss console
+    }
+    return planned;
+}
+
+static void* planner_thread (void* arg)
+{
+    int list[MAX_WISDOM_SHAPES];
+    int count, i, wstatus;
+    pid_t pid;
+    for (;;)
+    {
+        pthread_mutex_lock (&shape_lock);
+        for (;;)
+        {
+            count = 0;
+            for (i = 0; i < nshapes; i++)
+                if (!shapes[i].done) list[count++] = i;
+            if (count > 0) break;
+            pthread_cond_wait (&shape_cond, &shape_lock);
+        }
+        if (shapes_dirty) save_shapes ();
+        pthread_mutex_unlock (&shape_lock);
+        // plans are usually requested in bursts (opening a channel, changing a
+        // filter); wait a little so that they are handled by a single child
+        sleep (2);
+        pthread_mutex_lock (&shape_lock);
+        count = 0;
+        for (i = 0; i < nshapes; i++)
+            if (!shapes[i].done) list[count++] = i;
+        if (shapes_dirty) save_shapes ();
+        pthread_mutex_unlock (&shape_lock);
+        snprintf (status, sizeof (status), "Planning %d FFT sizes in the background", count);
+        // fork with plan_lock held, so the child does not inherit a planner
+        // that is in use by another thread
+        pthread_mutex_lock (&plan_lock);
+        pid = fork ();
+        if (pid == 0)
+        {
+            close_inherited_fds ();
+#ifdef __linux__
+            prctl (PR_SET_PDEATHSIG, SIGKILL);
 #endif
+            int planned = plan_in_child (list, count);
+            _exit (planned > 255 ? 255 : planned);
+        }
+        pthread_mutex_unlock (&plan_lock);
+        if (pid < 0)
+        {
+            fprintf (stderr, "WDSP wisdom: fork failed, no background planning\n");
+            return NULL;
+        }
+        wstatus = 0;
+        while (waitpid (pid, &wstatus, 0) < 0 && errno == EINTR);
+        if (WIFEXITED (wstatus) && WEXITSTATUS (wstatus) > 0)
+        {
+            fprintf (stdout, "WDSP wisdom: %d%s new FFT sizes planned\n", WEXITSTATUS (wstatus),
+                WEXITSTATUS (wstatus) == 255 ? " or more" : "");
+        }
+        pthread_mutex_lock (&plan_lock);
+        fftw_import_wisdom_from_filename (wisdom_file);
+        pthread_mutex_unlock (&plan_lock);
+        pthread_mutex_lock (&shape_lock);
+        for (i = 0; i < count; i++)
+            shapes[list[i]].done = 1;
+        pthread_mutex_unlock (&shape_lock);
+        snprintf (status, sizeof (status), "FFTW planning complete.");
+        fprintf (stdout, "WDSP wisdom: background planning of %d FFT sizes complete\n", count);
+        fflush (stdout);
+    }
+    return NULL;
+}
+
+PORT
+void WDSPwisdom (char* directory)
+{
+    char legacy_file[1024];
+    pthread_t tid;
+    unsigned int key = cpu_key ();
+#ifdef WDSP_FLOAT
+    snprintf (wisdom_file, sizeof (wisdom_file), "%swdspWisdom01-%08xf", directory, key);   // single-precision plans
+    snprintf (legacy_file, sizeof (legacy_file), "%swdspWisdom00f", directory);
+#else
+    snprintf (wisdom_file, sizeof (wisdom_file), "%swdspWisdom01-%08x", directory, key);
+    snprintf (legacy_file, sizeof (legacy_file), "%swdspWisdom00", directory);
+#endif
+    snprintf (shapes_file, sizeof (shapes_file), "%swdspPlanShapes", directory);
+    pthread_mutex_lock (&plan_lock);
+    if (fftw_import_wisdom_from_filename (wisdom_file))
+        snprintf (status, sizeof (status), "Wisdom imported from %s", wisdom_file);
+    else if (fftw_import_wisdom_from_filename (legacy_file))
+        snprintf (status, sizeof (status), "Wisdom imported from %s", legacy_file);
+    else
+        snprintf (status, sizeof (status), "No wisdom file found");
+    pthread_mutex_unlock (&plan_lock);
+    fprintf (stdout, "WDSP wisdom: %s\n", status);
+    fflush (stdout);
+    load_shapes ();
+    add_generic_shapes ();
+    if (!planner_started && pthread_create (&tid, NULL, planner_thread, NULL) == 0)
+    {
+        pthread_detach (tid);
+        planner_started = 1;
     }
 }
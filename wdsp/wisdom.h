@@ -0,0 +1,40 @@
+/*  wisdom.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+*/
+
+#ifndef _wisdom_h
+#define _wisdom_h
+
+// All FFTW plans in WDSP are created and destroyed through these functions.
+// They never measure: a plan is made from wisdom if there is some, otherwise
+// with FFTW_ESTIMATE, and the plan shape is handed to the background planner.
+
+extern fftw_plan wisdom_plan_dft_1d (int n, fftw_complex* in, fftw_complex* out, int sign);
+
+extern fftw_plan wisdom_plan_dft_r2c_1d (int n, real* in, fftw_complex* out);
+
+extern fftw_plan wisdom_plan_dft_c2r_1d (int n, fftw_complex* in, real* out);
+
+extern void wisdom_destroy_plan (fftw_plan p);
+
+extern char* wisdom_get_status (void);
+
+extern void WDSPwisdom (char* directory);
+
+#endif